@@ -1,27 +1,123 @@
 #include <iostream>
 #include <cstdint>
+#include <cassert>
 #include <random>
-#include <chrono>
 #include <array>
 
 #include <boost/program_options.hpp>
 
 #include "Move.h"
+#include "Conversion.h"
 #include "BitBoard.h"
+#include "LineNeighborhood.h"
+#include "Benchmark.h"
 
 using namespace std;
 using namespace boost;
 using namespace boost::program_options;
 using namespace realcore;
 
+//! @brief 座標計算でindex/shiftを求めて黒石を設定する(テーブル参照化前の実装)
+void SetBlackStoneArithmetic(const MovePosition move, Bitboard * const bit_board)
+{
+  Cordinate x, y;
+  GetMoveCordinate(move, &x, &y);
+
+  if(!IsInBoard(x, y)){
+    return;
+  }
+
+  std::array<size_t, kBoardDirectionNum> index_list, shift_list;
+  GetBitBoardIndexList(x, y, &index_list);
+  GetBitBoardShiftList(x, y, &shift_list);
+
+  constexpr StateBit black_stone_xor_mask = 0b10ULL;
+
+  for(size_t i=0; i<kBoardDirectionNum; i++){
+    (*bit_board)[index_list[i]] ^= (black_stone_xor_mask << shift_list[i]);
+  }
+}
+
+//! @brief 座標計算でindex/shiftを求めて直線近傍の状態を取得する(テーブル参照化前の実装)
+template<size_t N>
+void GetLineNeighborhoodStateBitArithmetic(const Bitboard &bit_board, const MovePosition move, std::array<StateBit, kBoardDirectionNum> * const line_neighborhood_list)
+{
+  std::fill(line_neighborhood_list->begin(), line_neighborhood_list->end(), 0);
+
+  Cordinate x = 0, y = 0;
+  GetMoveCordinate(move, &x, &y);
+
+  if(!IsInBoard(x, y)){
+    return;
+  }
+
+  std::array<size_t, kBoardDirectionNum> index_list, shift_list;
+  GetBitBoardIndexList(x, y, &index_list);
+  GetBitBoardShiftList(x, y, &shift_list);
+
+  constexpr size_t kBitNumber = 2 * (2 * N + 1);
+  constexpr uint64_t kLineNeighborhoodMask = GetConsectiveBit<kBitNumber>();
+  constexpr size_t kMaskShift = 2 * N;
+  constexpr size_t kCenterAlignment = 14;
+
+  for(auto direction : GetBoardDirection()){
+    const size_t index = index_list[direction];
+    const size_t shift = shift_list[direction];
+
+    uint64_t neighborhood_mask = kLineNeighborhoodMask;
+
+    if(shift >= kMaskShift){
+      neighborhood_mask <<= shift - kMaskShift;
+    }else{
+      neighborhood_mask >>= kMaskShift - shift;
+    }
+
+    const StateBit neighborhood_state_bit = (bit_board[index] & neighborhood_mask);
+
+    if(shift >= kCenterAlignment){
+      (*line_neighborhood_list)[direction] = neighborhood_state_bit >> (shift - kCenterAlignment);
+    }else{
+      (*line_neighborhood_list)[direction] = neighborhood_state_bit << (kCenterAlignment - shift);
+    }
+  }
+}
+
+//! @brief 実行時の長さ指定で直線近傍を取得し結合する(Create<N>導入前のLineNeighborhoodコンストラクタの実装)
+void GetLocalBitBoardSwitch(const BitBoard &bit_board, const MovePosition move, const size_t distance, LocalBitBoard * const local_bit_board)
+{
+  std::array<StateBit, kBoardDirectionNum> line_neighborhood{{0}};
+
+  switch(distance){
+  case 4:
+    bit_board.GetLineNeighborhoodStateBit<4>(move, &line_neighborhood);
+    break;
+  case 5:
+    bit_board.GetLineNeighborhoodStateBit<5>(move, &line_neighborhood);
+    break;
+  case 6:
+    bit_board.GetLineNeighborhoodStateBit<6>(move, &line_neighborhood);
+    break;
+  default:
+    assert(false);
+  }
+
+  local_bit_board->fill(0);
+  (*local_bit_board)[0] |= line_neighborhood[kLateralDirection];
+  (*local_bit_board)[0] |= line_neighborhood[kVerticalDirection] << 32ULL;
+  (*local_bit_board)[1] |= line_neighborhood[kLeftDiagonalDirection];
+  (*local_bit_board)[1] |= line_neighborhood[kRightDiagonalDirection] << 32ULL;
+}
+
 int main(int argc, char* argv[])
 {
   // オプション設定
   options_description option;
 
   option.add_options()
-    ("count,c", value<uint64_t>()->default_value(100 * 10000), "反復回数(default: 100万回)")
+    ("count,c", value<uint64_t>()->default_value(10 * 10000), "1試行あたりの反復回数(default: 10万回)")
     ("help,h", "ヘルプを表示");
+
+  Benchmark::AddOption(&option, kDefaultBenchmarkWarmupCount, kDefaultBenchmarkTrialCount);
   
   variables_map arg_map;
   store(parse_command_line(argc, argv, option), arg_map);
@@ -37,20 +133,30 @@ int main(int argc, char* argv[])
     cout << " 4. SetState BlackStone/WhiteStone alternately along with the shuffled list" << endl;
     cout << " 5. SetState OpenPosition along with the shuffled list" << endl;
     cout << " 6. GetState along with the shuffled list" << endl;
+    cout << " 7. SetState BlackStone/GetLineNeighborhoodStateBit with (index, shift) computed from (x, y) (before)" << endl;
+    cout << "    and with the precomputed (mask, index, shift) table (after)" << endl;
     cout << endl;
 
     return 0;
   }
 
+  Benchmark benchmark("board_get_set");
+
+  if(!benchmark.SetOption(arg_map)){
+    cerr << "Failed to pin the CPU." << endl;
+  }
+
   const uint64_t iteration_count = arg_map["count"].as<uint64_t>();
   auto in_board_move = GetAllInBoardMove();
+  const uint64_t operation_count = iteration_count * in_board_move.size();
+
+  // 最適化で盤面更新が削除されないよう各反復の盤面状態を集計し結果表示する
+  uint64_t check_sum = 0;
 
   // SetState: kBlackStone
   shuffle(in_board_move.begin(), in_board_move.end(), mt19937_64());
 
-  {
-    auto start_time = chrono::system_clock::now();
-
+  benchmark.Run("SetState<kBlackStone>", operation_count, [&]{
     for(size_t i=0; i<iteration_count; i++)
     {
       BitBoard bit_board;
@@ -58,17 +164,12 @@ int main(int argc, char* argv[])
       for(const auto move : in_board_move){
         bit_board.SetState<kBlackStone>(move);
       }
-    }
 
-    auto elapsed_time = chrono::system_clock::now() - start_time;
-    
-    cout << "SetState<kBlackStone>:\t";
-    cout << chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
-    cout << " ms" << endl;
-  }
-  {
-    auto start_time = chrono::system_clock::now();
+      check_sum += bit_board.GetState(kMoveHH);
+    }
+  });
 
+  benchmark.Run("SetState<kWhiteStone>", operation_count, [&]{
     for(size_t i=0; i<iteration_count; i++)
     {
       BitBoard bit_board;
@@ -76,16 +177,11 @@ int main(int argc, char* argv[])
       for(const auto move : in_board_move){
         bit_board.SetState<kWhiteStone>(move);
       }
+      check_sum += bit_board.GetState(kMoveHH);
     }
+  });
 
-    auto elapsed_time = chrono::system_clock::now() - start_time;
-    
-    cout << "SetState<kWhiteStone>:\t";
-    cout << chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
-    cout << " ms" << endl;
-  }
-  {
-    auto start_time = chrono::system_clock::now();
+  benchmark.Run("SetState(Alternately)", operation_count, [&]{
     PositionState state = kBlackStone;
 
     for(size_t i=0; i<iteration_count; i++)
@@ -96,17 +192,12 @@ int main(int argc, char* argv[])
         bit_board.SetState(move, state);
         state = static_cast<PositionState>(3 - state);
       }
-    }
 
-    auto elapsed_time = chrono::system_clock::now() - start_time;
-    
-    cout << "SetState(Alternately):\t";
-    cout << chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
-    cout << " ms" << endl;
-  }
-  {
-    auto start_time = chrono::system_clock::now();
+      check_sum += bit_board.GetState(kMoveHH);
+    }
+  });
 
+  benchmark.Run("SetState<kOpenPosition>", operation_count, [&]{
     for(size_t i=0; i<iteration_count; i++)
     {
       BitBoard bit_board;
@@ -114,37 +205,117 @@ int main(int argc, char* argv[])
       for(const auto move : in_board_move){
         bit_board.SetState<kOpenPosition>(move);
       }
+      check_sum += bit_board.GetState(kMoveHH);
     }
+  });
 
-    auto elapsed_time = chrono::system_clock::now() - start_time;
-    
-    cout << "SetState<kOpenPosition>:\t";
-    cout << chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
-    cout << " ms" << endl;
-  }
   {
     // 状態取得のみだと最適化された際に不要な参照として削除されることがあるため簡単な集計＆結果表示を行う
-    auto start_time = chrono::system_clock::now();
     std::array<uint64_t, 4> state_count{{0}};
 
+    benchmark.Run("GetState", operation_count, [&]{
+      for(size_t i=0; i<iteration_count; i++)
+      {
+        BitBoard bit_board;
+
+        for(const auto move : in_board_move){
+          const auto state = bit_board.GetState(move);
+          ++state_count[state];
+        }
+      }
+    });
+
+    cout << "Summary result: " << state_count[0] << "," << state_count[1] << "," << state_count[2] << "," << state_count[3] << endl;
+  }
+
+  // before: (x, y)座標からindex/shiftを計算
+  benchmark.Run("SetState<kBlackStone>(before)", operation_count, [&]{
+    for(size_t i=0; i<iteration_count; i++)
+    {
+      Bitboard bit_board;
+      bit_board.fill(~0ULL);
+
+      for(const auto move : in_board_move){
+        SetBlackStoneArithmetic(move, &bit_board);
+      }
+
+      check_sum += bit_board[i % kBitBoardElementNum];
+    }
+  });
+
+  // after: (mask, index, shift)テーブルを参照
+  benchmark.Run("SetState<kBlackStone>(after)", operation_count, [&]{
     for(size_t i=0; i<iteration_count; i++)
     {
       BitBoard bit_board;
 
       for(const auto move : in_board_move){
-        const auto state = bit_board.GetState(move);
-        ++state_count[state];
+        bit_board.SetState<kBlackStone>(move);
       }
+
+      check_sum += bit_board.GetState(kMoveHH);
     }
+  });
 
-    auto elapsed_time = chrono::system_clock::now() - start_time;
-    
-    cout << "GetState:\t";
-    cout << chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
-    cout << " ms" << endl;
+  {
+    // 白黒交互に石を置いた盤面で直線近傍を取得する
+    Bitboard arithmetic_bit_board;
+    arithmetic_bit_board.fill(~0ULL);
+    BitBoard bit_board;
 
-    cout << "Summary result: " << state_count[0] << "," << state_count[1] << "," << state_count[2] << "," << state_count[3] << endl;
+    for(size_t i=0, size=in_board_move.size(); i<size / 2; i++){
+      SetBlackStoneArithmetic(in_board_move[i], &arithmetic_bit_board);
+      bit_board.SetState(in_board_move[i], i % 2 == 0 ? kBlackStone : kWhiteStone);
+    }
+
+    std::array<StateBit, kBoardDirectionNum> line_neighborhood;
+    LocalBitBoard local_bit_board;
+
+    benchmark.Run("GetLineNeighborhoodStateBit<5>(before)", operation_count, [&]{
+      for(size_t i=0; i<iteration_count; i++)
+      {
+        for(const auto move : in_board_move){
+          GetLineNeighborhoodStateBitArithmetic<5>(arithmetic_bit_board, move, &line_neighborhood);
+          check_sum += line_neighborhood[kLateralDirection];
+        }
+      }
+    });
+
+    benchmark.Run("GetLineNeighborhoodStateBit<5>(after)", operation_count, [&]{
+      for(size_t i=0; i<iteration_count; i++)
+      {
+        for(const auto move : in_board_move){
+          bit_board.GetLineNeighborhoodStateBit<5>(move, &line_neighborhood);
+          check_sum += line_neighborhood[kLateralDirection];
+        }
+      }
+    });
+
+    // before: 実行時の長さ指定(switch分岐 + 方向ごとの直線近傍を結合)
+    benchmark.Run("LineNeighborhood(before)", operation_count, [&]{
+      for(size_t i=0; i<iteration_count; i++)
+      {
+        for(const auto move : in_board_move){
+          GetLocalBitBoardSwitch(bit_board, move, kOpenStateNeighborhoodSize, &local_bit_board);
+          check_sum += local_bit_board[0];
+        }
+      }
+    });
+
+    // after: コンパイル時の長さ指定(LineNeighborhood::Create<N>)
+    benchmark.Run("LineNeighborhood(after)", operation_count, [&]{
+      for(size_t i=0; i<iteration_count; i++)
+      {
+        for(const auto move : in_board_move){
+          const LineNeighborhood line_neighbor = LineNeighborhood::Create<kOpenStateNeighborhoodSize>(move, bit_board);
+          line_neighbor.GetLocalBitBoard(&local_bit_board);
+          check_sum += local_bit_board[0];
+        }
+      }
+    });
   }
 
-  return 0;
-}
\ No newline at end of file
+  cout << "Check sum: " << check_sum << endl;
+
+  return benchmark.Report() ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <map>
+
+#include <boost/program_options.hpp>
+
+#include "CSVReader.h"
+#include "MoveList.h"
+#include "BitBoard.h"
+#include "BitPlaneBoard.h"
+
+using namespace std;
+using namespace boost::program_options;
+using namespace realcore;
+
+//! @brief 天元付近に石が集まった棋譜を生成する
+//! @param game_count 生成する棋譜数
+//! @param game_record_list 棋譜の格納先
+void GetRandomGameRecord(const size_t game_count, vector<MoveList> * const game_record_list)
+{
+  mt19937_64 random_engine(0);
+  uniform_real_distribution<double> noise(0.0, 6.0);
+  uniform_int_distribution<size_t> move_count(20, 60);
+
+  for(size_t i=0; i<game_count; i++){
+    vector< pair<double, MovePosition> > move_priority_list;
+
+    for(const auto move : GetAllInBoardMove()){
+      Cordinate x = 0, y = 0;
+      GetMoveCordinate(move, &x, &y);
+
+      const double distance = abs(static_cast<int>(x) - 8) + abs(static_cast<int>(y) - 8) + noise(random_engine);
+      move_priority_list.emplace_back(distance, move);
+    }
+
+    sort(move_priority_list.begin(), move_priority_list.end());
+
+    MoveList move_list;
+
+    for(size_t j=0, size=move_count(random_engine); j<size; j++){
+      move_list += move_priority_list[j].second;
+    }
+
+    game_record_list->emplace_back(move_list);
+  }
+}
+
+//! @brief 経過時間と1局面あたりの時間を出力する
+void PrintElapsedTime(const string &label, const chrono::system_clock::duration &elapsed_time, const size_t board_count, const size_t result_count)
+{
+  const auto elapsed_ns = chrono::duration_cast<chrono::nanoseconds>(elapsed_time).count();
+
+  cout << label << ":\t";
+  cout << chrono::duration_cast<chrono::milliseconds>(elapsed_time).count() << " ms\t";
+  cout << static_cast<double>(elapsed_ns) / board_count << " ns/board\t";
+  cout << "result: " << result_count << endl;
+}
+
+int main(int argc, char* argv[])
+{
+  // オプション設定
+  options_description option;
+
+  option.add_options()
+    ("db", value<string>(), "棋譜データベース(csv)")
+    ("random", value<size_t>()->default_value(1000), "棋譜データベース未指定時に生成するランダム棋譜数")
+    ("count,c", value<size_t>()->default_value(10), "反復回数")
+    ("help,h", "ヘルプを表示");
+
+  variables_map arg_map;
+  store(parse_command_line(argc, argv, option), arg_map);
+
+  if(arg_map.count("help")){
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << option;
+    cout << endl;
+    cout << "Compare BitBoard(2bit StateBit) with BitPlaneBoard(black/white bitplanes) on each position of the game records:" << endl;
+    cout << " 1. EnumerateForbiddenMoves" << endl;
+    cout << " 2. EnumerateFourMoves (black and white)" << endl;
+    cout << endl;
+
+    return 0;
+  }
+
+  // 棋譜の読込
+  vector<MoveList> game_record_list;
+
+  if(arg_map.count("db")){
+    map<string, StringVector> game_record_db;
+    ReadCSV(arg_map["db"].as<string>(), &game_record_db);
+
+    for(const auto &game_record : game_record_db["game_record"]){
+      game_record_list.emplace_back(game_record);
+    }
+  }else{
+    GetRandomGameRecord(arg_map["random"].as<size_t>(), &game_record_list);
+  }
+
+  // 各局面のBitBoard/BitPlaneBoardを生成する
+  vector<BitBoard> bit_board_list;
+  vector<BitPlaneBoard> bit_plane_board_list;
+
+  for(const auto &game_record : game_record_list){
+    BitBoard bit_board;
+    BitPlaneBoard bit_plane_board;
+    bool is_black_turn = true;
+
+    for(const auto move : game_record){
+      const PositionState state = is_black_turn ? kBlackStone : kWhiteStone;
+      bit_board.SetState(move, state);
+      bit_plane_board.SetState(move, state);
+
+      bit_board_list.emplace_back(bit_board);
+      bit_plane_board_list.emplace_back(bit_plane_board);
+
+      is_black_turn = !is_black_turn;
+    }
+  }
+
+  const size_t iteration_count = arg_map["count"].as<size_t>();
+  const size_t board_count = bit_board_list.size() * iteration_count;
+
+  cout << "Game count: " << game_record_list.size() << endl;
+  cout << "Board count: " << bit_board_list.size() << endl;
+
+  {
+    auto start_time = chrono::system_clock::now();
+    size_t forbidden_count = 0;
+
+    for(size_t i=0; i<iteration_count; i++){
+      for(const auto &bit_board : bit_board_list){
+        MoveBitSet forbidden_move_set;
+        bit_board.EnumerateForbiddenMoves(&forbidden_move_set);
+        forbidden_count += forbidden_move_set.count();
+      }
+    }
+
+    auto elapsed_time = chrono::system_clock::now() - start_time;
+    PrintElapsedTime("EnumerateForbiddenMoves(BitBoard)", elapsed_time, board_count, forbidden_count);
+  }
+  {
+    auto start_time = chrono::system_clock::now();
+    size_t forbidden_count = 0;
+
+    for(size_t i=0; i<iteration_count; i++){
+      for(const auto &bit_plane_board : bit_plane_board_list){
+        MoveBitSet forbidden_move_set;
+        bit_plane_board.EnumerateForbiddenMoves(&forbidden_move_set);
+        forbidden_count += forbidden_move_set.count();
+      }
+    }
+
+    auto elapsed_time = chrono::system_clock::now() - start_time;
+    PrintElapsedTime("EnumerateForbiddenMoves(BitPlaneBoard)", elapsed_time, board_count, forbidden_count);
+  }
+  {
+    auto start_time = chrono::system_clock::now();
+    size_t four_count = 0;
+    const UpdateOpenStateFlag black_flag(kUpdateFlagFourBlack), white_flag(kUpdateFlagFourWhite);
+
+    for(size_t i=0; i<iteration_count; i++){
+      for(const auto &bit_board : bit_board_list){
+        {
+          BoardOpenState board_open_state(black_flag);
+          bit_board.GetBoardOpenState(black_flag, &board_open_state);
+
+          MoveBitSet four_move_set;
+          bit_board.EnumerateFourMoves<kBlackTurn>(board_open_state, &four_move_set);
+          four_count += four_move_set.count();
+        }
+        {
+          BoardOpenState board_open_state(white_flag);
+          bit_board.GetBoardOpenState(white_flag, &board_open_state);
+
+          MoveBitSet four_move_set;
+          bit_board.EnumerateFourMoves<kWhiteTurn>(board_open_state, &four_move_set);
+          four_count += four_move_set.count();
+        }
+      }
+    }
+
+    auto elapsed_time = chrono::system_clock::now() - start_time;
+    PrintElapsedTime("EnumerateFourMoves(BitBoard)", elapsed_time, board_count, four_count);
+  }
+  {
+    auto start_time = chrono::system_clock::now();
+    size_t four_count = 0;
+
+    for(size_t i=0; i<iteration_count; i++){
+      for(const auto &bit_plane_board : bit_plane_board_list){
+        {
+          MoveBitSet four_move_set;
+          bit_plane_board.EnumerateFourMoves<kBlackTurn>(&four_move_set);
+          four_count += four_move_set.count();
+        }
+        {
+          MoveBitSet four_move_set;
+          bit_plane_board.EnumerateFourMoves<kWhiteTurn>(&four_move_set);
+          four_count += four_move_set.count();
+        }
+      }
+    }
+
+    auto elapsed_time = chrono::system_clock::now() - start_time;
+    PrintElapsedTime("EnumerateFourMoves(BitPlaneBoard)", elapsed_time, board_count, four_count);
+  }
+
+  return 0;
+}
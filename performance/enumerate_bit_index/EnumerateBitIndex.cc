@@ -1,11 +1,12 @@
 #include <iostream>
 #include <random>
-#include <chrono>
 #include <array>
+#include <numeric>
 
 #include <boost/program_options.hpp>
 
 #include "EnumerateBitIndex.h"
+#include "Benchmark.h"
 
 using namespace std;
 using namespace boost;
@@ -19,7 +20,10 @@ int main(int argc, char* argv[])
 
   option.add_options()
     ("count,c", value<uint64_t>()->default_value(10000), "反復回数(default: 1万回)")
+    ("seed,s", value<size_t>(), "乱数シード(default: random_device)")
     ("help,h", "ヘルプを表示");
+
+  Benchmark::AddOption(&option, kDefaultBenchmarkWarmupCount, kDefaultBenchmarkTrialCount);
   
   variables_map arg_map;
   store(parse_command_line(argc, argv, option), arg_map);
@@ -37,9 +41,15 @@ int main(int argc, char* argv[])
     return 0;
   }
 
-  // 乱数初期化
+  Benchmark benchmark("enumerate_bit_index");
+
+  if(!benchmark.SetOption(arg_map)){
+    cerr << "Failed to pin the CPU." << endl;
+  }
+
+  // 乱数初期化(ベースラインと比較する場合は同じシードを指定する)
   random_device seed_generator;
-  size_t seed = seed_generator();
+  const size_t seed = arg_map.count("seed") ? arg_map["seed"].as<size_t>() : seed_generator();
   mt19937_64 random_generator(seed);
 
   cout << "random seed:\t" << seed << endl;
@@ -77,83 +87,48 @@ int main(int argc, char* argv[])
     }
   }
 
-  // ScanBitSequence
-  vector<uint64_t> time_scan;
-  time_scan.reserve(kBitPattern);
+  // OnBit数ごとに各手法を計測する
+  // 1操作 = 1つの値のOnBit位置の列挙
+  const auto run_benchmark = [&benchmark, &on_bit_value_list](const string &method, const auto &enumerate){
+    vector<double> time_list;
+    time_list.reserve(kBitPattern);
 
-  {
     uint64_t index_sum = 0;
     vector<size_t> index_list;
     index_list.reserve(64);
 
-    for(const auto &value_list : on_bit_value_list){
-      auto start_time = chrono::system_clock::now();
-  
-      for(auto value : value_list){
-        index_list.clear();
-        ScanBitSequence(value, &index_list);
-        index_sum = accumulate(index_list.begin(), index_list.end(), index_sum);
-      }
-
-      auto elapsed_time = chrono::system_clock::now() - start_time;
-      time_scan.emplace_back(chrono::duration_cast<chrono::milliseconds>(elapsed_time).count());
-    }
-
-    cout << "ScanBitSequence index sum: " << index_sum << endl;
-  }
+    for(size_t on_bit_count=0; on_bit_count<kBitPattern; ++on_bit_count){
+      const auto &value_list = on_bit_value_list[on_bit_count];
 
-  // TableLookup
-  vector<uint64_t> time_shift_map;
-  time_shift_map.reserve(kBitPattern);
-  
-  {
-    uint64_t index_sum = 0;
-    vector<size_t> index_list;
-    index_list.reserve(64);
+      const auto &result = benchmark.Run(method + "/" + to_string(on_bit_count), value_list.size(), [&]{
+        for(auto value : value_list){
+          index_list.clear();
+          enumerate(value, &index_list);
+          index_sum = accumulate(index_list.begin(), index_list.end(), index_sum);
+        }
+      });
 
-    for(const auto &value_list : on_bit_value_list){
-      auto start_time = chrono::system_clock::now();
-  
-      for(auto value : value_list){
-        index_list.clear();
-        ShiftMap(value, &index_list);
-        index_sum = accumulate(index_list.begin(), index_list.end(), index_sum);
-      }
-  
-      auto elapsed_time = chrono::system_clock::now() - start_time;
-      time_shift_map.emplace_back(chrono::duration_cast<chrono::milliseconds>(elapsed_time).count());
+      time_list.emplace_back(result.GetTimePerOperation());
     }
 
-    cout << "TableLookup index sum: " << index_sum << endl;
-  }
-
-  // EnumerateRightmostBit
-  vector<uint64_t> time_rightmost;
-  time_rightmost.reserve(kBitPattern);
+    cout << method << " index sum: " << index_sum << endl;
+    return time_list;
+  };
 
-  {
-    uint64_t index_sum = 0;
-    vector<size_t> index_list;
-    index_list.reserve(64);
+  const vector<double> time_scan = run_benchmark("ScanBitSequence", [](const uint64_t value, vector<size_t> * const index_list){
+    ScanBitSequence(value, index_list);
+  });
 
-    for(const auto &value_list : on_bit_value_list){
-      auto start_time = chrono::system_clock::now();
-  
-      for(auto value : value_list){
-        index_list.clear();
-        EnumerateRightmostBit(value, &index_list);
-        index_sum = accumulate(index_list.begin(), index_list.end(), index_sum);
-      }
-  
-      auto elapsed_time = chrono::system_clock::now() - start_time;
-      time_rightmost.emplace_back(chrono::duration_cast<chrono::milliseconds>(elapsed_time).count());
-    }
+  const vector<double> time_shift_map = run_benchmark("TableLookup", [](const uint64_t value, vector<size_t> * const index_list){
+    ShiftMap(value, index_list);
+  });
 
-    cout << "EnumerateRightmostBit index sum: " << index_sum << endl;
-  }
+  const vector<double> time_rightmost = run_benchmark("EnumerateRightmostBit", [](const uint64_t value, vector<size_t> * const index_list){
+    EnumerateRightmostBit(value, index_list);
+  });
 
-  // 経過時間を出力
-  cout << "PopCount,ScanBitSequence(ms),TableLookup(ms),EnumerateRightmostBit(ms)" << endl;
+  // 1操作あたりの所要時間(中央値)を出力
+  cout << "PopCount,ScanBitSequence(ns/op),TableLookup(ns/op),EnumerateRightmostBit(ns/op)" << endl;
 
   for(size_t i=0; i<kBitPattern; i++){
     cout << i << ",";
@@ -162,5 +137,5 @@ int main(int argc, char* argv[])
     cout << time_rightmost[i] << endl;
   }
 
-  return 0;
+  return benchmark.Report() ? 0 : 1;
 }
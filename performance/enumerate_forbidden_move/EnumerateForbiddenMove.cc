@@ -1,12 +1,16 @@
 #include <iostream>
 #include <memory>
-#include <chrono>
 
 #include <boost/program_options.hpp>
 
 #include "EnumerateForbiddenMove.h"
-#include "CSVReader.h"
+#include "GameRecordDB.h"
+#include "GameRecordDBTraverser.h"
+#include "GameRecordTrie.h"
 #include "Board.h"
+#include "ForbiddenMoveTable.h"
+#include "Instrumentation.h"
+#include "Benchmark.h"
 
 using namespace std;
 using namespace boost::program_options;
@@ -18,10 +22,17 @@ int main(int argc, char* argv[])
   options_description option;
   
   option.add_options()
-    ("db", value<string>(), "棋譜データベース(csv)")
+    ("db", value<string>(), "棋譜データベース(csv or ConvertGameRecordDBで変換したバイナリ形式)")
     ("log", "列挙結果を出力する")
     ("mode", value<string>()->default_value("point"), "point:各点チェック, enum:列挙法, enum-diff:差分法列挙")
+    ("cache", value<size_t>(), "禁手点キャッシュのサイズ(MB, enum-diffのみ)")
+    ("thread", value<size_t>()->default_value(1), "列挙のスレッド数")
+    ("trie", "棋譜DBをトライ木に登録し、共通の手順は1度だけ列挙する(enum-diffのみ, シングルスレッド)")
+    ("stats", value<string>(), "処理ごとの計測結果を出力する(json or csv, build_instrumentation.shでビルドした場合のみ計測)")
     ("help,h", "ヘルプを表示");
+
+  // 1試行で棋譜データベース全体を列挙するため試行回数は少なめにする
+  Benchmark::AddOption(&option, 0, 3);
   
   variables_map arg_map;
   store(parse_command_line(argc, argv, option), arg_map);
@@ -29,6 +40,7 @@ int main(int argc, char* argv[])
   const auto mode = arg_map["mode"].as<string>();
   bool is_help = arg_map.count("help") || !arg_map.count("db");
   is_help |= !(mode == "point" || mode == "enum" || mode == "enum-diff");
+  is_help |= arg_map.count("trie") && mode != "enum-diff";
 
   if(is_help){
     cout << "Usage: " << argv[0] << " [options]" << endl;
@@ -44,88 +56,211 @@ int main(int argc, char* argv[])
 
   cerr << "Read game_record DB: " << diagram_db_file << endl;
 
-  map<string, StringVector> diagram_db;
-  ReadCSV(diagram_db_file, &diagram_db);
+  GameRecordDB game_record_db;
+
+  if(!game_record_db.Load(diagram_db_file)){
+    cerr << "Failed to read game_record DB: " << diagram_db_file << endl;
+    return 1;
+  }
+
+  cerr << "Game count: " << game_record_db.size() << endl;
+
+  const bool is_trie = arg_map.count("trie");
+  const size_t thread_num = is_trie ? 1 : max<size_t>(1, arg_map["thread"].as<size_t>());
+  GameRecordDBTraverser traverser(game_record_db, thread_num, kUpdateForbiddenCheck);
 
-  const auto board_str_list = diagram_db["game_record"];
+  cerr << "Thread: " << thread_num << endl;
+
+  // 共通の手順を持つ棋譜の同一局面は禁手点キャッシュを参照する
+  unique_ptr<ForbiddenMoveTable> forbidden_move_table;
+
+  if(arg_map.count("cache")){
+    forbidden_move_table.reset(new ForbiddenMoveTable(arg_map["cache"].as<size_t>(), thread_num == 1 ? kLockFree : kLockTable));
+
+    for(size_t i=0; i<thread_num; i++){
+      traverser.GetBoard(i)->SetForbiddenMoveTable(forbidden_move_table.get());
+    }
+  }
 
-  vector< shared_ptr<MoveList> > board_move_list;
-  board_move_list.reserve(board_str_list.size());
+  Benchmark benchmark("enumerate_forbidden_move");
 
-  for(const auto board_str : board_str_list){
-    auto move_list = make_shared<MoveList>(board_str);
-    board_move_list.emplace_back(move_list);
+  if(!benchmark.SetOption(arg_map)){
+    cerr << "Failed to pin the CPU." << endl;
   }
 
-  cerr << "Game count: " << board_str_list.size() << endl;;
+  // 1操作 = 1局面の禁手列挙
+  uint64_t operation_count = 0;
+
+  for(size_t i=0, size=game_record_db.size(); i<size; i++){
+    operation_count += game_record_db.GetGameRecord(i).size();
+  }
 
   // 禁手の列挙
   cerr << "Enumerate forbidden moves" << endl;
   
-  vector< shared_ptr<MoveList> > forbidden_board_list, forbidden_move_list;
-  auto start_time = chrono::system_clock::now();
-  size_t board_count = 0, forbidden_count = 0;
   const bool is_output_result = arg_map.count("log");
+  const bool is_output_stats = arg_map.count("stats");
+
+  // 集計結果は最後の試行のものを出力する
+  EnumerateForbiddenMoveResult result;
+
+  const auto setup = [&result, &forbidden_move_table]{
+    result = EnumerateForbiddenMoveResult();
+
+    if(forbidden_move_table){
+      forbidden_move_table->Initialize();
+    }
+
+    ResetBitBoardCopyCount();
+    GetThreadInstrumentation().clear();
+  };
+
+  if(is_trie){
+    // 共通の手順は盤面を再生せず、1度だけ列挙する
+    GameRecordTrie game_record_trie;
 
-  for(const auto& move_list : board_move_list){
-    MoveList board_move;
-    Board board(kUpdateForbiddenCheck);
-    BitBoard bit_board;
-    bool is_black_turn = true;
-
-    for(const auto move : (*move_list)){
-      MoveList forbidden_move;
-      board_move += move;
-
-      if(mode == "enum-diff"){
-        board.MakeMove(move);
-        EnumerateOpenState(board, &forbidden_move);
-      }else if(mode == "enum"){
-        if(is_black_turn){
-          bit_board.SetState<kBlackStone>(move);
-        }else{
-          bit_board.SetState<kWhiteStone>(move);
-          EnumerateOpenState(bit_board, &forbidden_move);
+    benchmark.Run("GameRecordTrie::Build", game_record_db.size(), [&]{
+      game_record_trie.Build(game_record_db);
+    });
+
+    cerr << "Trie prefixes: " << game_record_trie.GetPrefixCount() << endl;
+
+    const auto &benchmark_result = benchmark.Run("EnumerateForbiddenMove(" + mode + ",trie)", operation_count, setup, [&]{
+      EnumerateForbiddenMove(game_record_trie, traverser.GetBoard(0), is_output_result, &result);
+
+      if(is_output_stats){
+        result.snapshot.Merge(GetThreadInstrumentation());
+      }
+    });
+
+    cerr << "Time: " << static_cast<uint64_t>(benchmark_result.GetTimePercentile(50) / 1000000) << endl;
+  }else{
+    const auto &benchmark_result = benchmark.Run("EnumerateForbiddenMove(" + mode + ")", operation_count, setup, [&]{
+      traverser.ForEachGame([&mode, is_output_result, is_output_stats](Board * const board, const size_t, const GameRecordView &game_record, EnumerateForbiddenMoveResult * const chunk_result){
+        EnumerateForbiddenMove(mode, board, game_record, is_output_result, chunk_result);
+
+        if(is_output_stats){
+          // 計測結果はスレッドごとに保持しているため棋譜ごとにチャンクの結果に移す
+          InstrumentationSnapshot &thread_snapshot = GetThreadInstrumentation();
+          chunk_result->snapshot.Merge(thread_snapshot);
+          thread_snapshot.clear();
         }
-  
-        is_black_turn = !is_black_turn;
+      }, ReduceEnumerateForbiddenMoveResult, &result);
+    });
+
+    cerr << "Time: " << static_cast<uint64_t>(benchmark_result.GetTimePercentile(50) / 1000000) << endl;
+  }
+
+  cerr << "Board count: " << result.board_count << endl;
+  cerr << "Forbidden moves: " << result.forbidden_count << endl;
+  cerr << "BitBoard copies: " << GetBitBoardCopyCount() << endl;
+
+  if(forbidden_move_table){
+    cerr << "Cache lookups: " << forbidden_move_table->GetLookupCount() << endl;
+    cerr << "Cache hit rate: " << forbidden_move_table->GetHitRate() << endl;
+  }
+
+  if(is_output_stats){
+    const auto &snapshot = result.snapshot;
+    cerr << (arg_map["stats"].as<string>() == "csv" ? snapshot.GetCSV() : snapshot.GetJSON()) << endl;
+  }
+
+  cout << result.log;
+
+  // 計測結果の一覧は列挙結果と混ざらないよう標準エラー出力に出力する
+  return benchmark.Report(cerr) ? 0 : 1;
+}
+
+EnumerateForbiddenMoveResult::EnumerateForbiddenMoveResult()
+: board_count(0), forbidden_count(0)
+{
+}
+
+void ReduceEnumerateForbiddenMoveResult(EnumerateForbiddenMoveResult * const result, const EnumerateForbiddenMoveResult &chunk_result)
+{
+  assert(result != nullptr);
+
+  result->board_count += chunk_result.board_count;
+  result->forbidden_count += chunk_result.forbidden_count;
+  result->log += chunk_result.log;
+  result->snapshot.Merge(chunk_result.snapshot);
+}
+
+void EnumerateForbiddenMove(const std::string &mode, realcore::Board * const board, const realcore::GameRecordView &game_record, const bool is_output_result, EnumerateForbiddenMoveResult * const result)
+{
+  assert(board != nullptr);
+  assert(result != nullptr);
+
+  MoveList board_move;
+  BitBoard bit_board;
+  bool is_black_turn = true;
+
+  for(const auto move : game_record){
+    MoveList forbidden_move;
+    board_move += move;
+
+    if(mode == "enum-diff"){
+      board->MakeMove(move);
+      EnumerateOpenState(board, &forbidden_move);
+    }else if(mode == "enum"){
+      if(is_black_turn){
+        bit_board.SetState<kBlackStone>(move);
       }else{
-        if(is_black_turn){
-          bit_board.SetState<kBlackStone>(move);
-        }else{
-          bit_board.SetState<kWhiteStone>(move);
-          CheckEachPoint(board_move, &forbidden_move);
-        }
-  
-        is_black_turn = !is_black_turn;
+        bit_board.SetState<kWhiteStone>(move);
+        EnumerateOpenState(&bit_board, &forbidden_move);
       }
 
-      forbidden_count += forbidden_move.size();
+      is_black_turn = !is_black_turn;
+    }else{
+      if(is_black_turn){
+        bit_board.SetState<kBlackStone>(move);
+      }else{
+        bit_board.SetState<kWhiteStone>(move);
+        CheckEachPoint(bit_board, &forbidden_move);
+      }
 
-      if(is_output_result && !forbidden_move.empty()){
-        // 禁手が存在する場合は盤面と禁手リストを記録する
-        auto forbidden_board = make_shared<MoveList>(board_move);
-        auto forbidden = make_shared<MoveList>(forbidden_move);
+      is_black_turn = !is_black_turn;
+    }
 
-        forbidden_board_list.emplace_back(forbidden_board);
-        forbidden_move_list.emplace_back(forbidden);
-      }
+    result->forbidden_count += forbidden_move.size();
 
-      board_count++;
+    if(is_output_result && !forbidden_move.empty()){
+      // 禁手が存在する場合は盤面と禁手リストを記録する
+      result->log += board_move.str() + "," + forbidden_move.str() + "\n";
     }
-  }
 
-  auto elapsed_time = chrono::system_clock::now() - start_time;
-  cerr << "Time: " << chrono::duration_cast<chrono::milliseconds>(elapsed_time).count() << endl;
-  cerr << "Board count: " << board_count << endl;
-  cerr << "Forbidden moves: " << forbidden_count << endl;
+    result->board_count++;
+  }
 
-  for(size_t i=0, size=forbidden_board_list.size(); i<size; i++){
-    cout << forbidden_board_list[i]->str() << ",";
-    cout << forbidden_move_list[i]->str() << endl;
+  if(mode == "enum-diff"){
+    for(size_t i=0, size=game_record.size(); i<size; i++){
+      board->UndoMove();
+    }
   }
+}
+
+void EnumerateForbiddenMove(const realcore::GameRecordTrie &game_record_trie, realcore::Board * const board, const bool is_output_result, EnumerateForbiddenMoveResult * const result)
+{
+  assert(board != nullptr);
+  assert(result != nullptr);
+
+  game_record_trie.Traverse(board, [is_output_result, result](const Board &visit_board, const GameRecordTriePosition &position){
+    if(position.depth == 0){
+      // 棋譜ごとの列挙と同様に初期局面は列挙しない
+      return;
+    }
+
+    MoveList forbidden_move;
+    EnumerateOpenState(visit_board, &forbidden_move);
+
+    result->forbidden_count += forbidden_move.size() * position.game_count;
 
-  return 0;
+    if(is_output_result && !forbidden_move.empty()){
+      result->log += position.move_list->str() + "," + forbidden_move.str() + "\n";
+    }
+
+    result->board_count += position.game_count;
+  });
 }
 
 void CheckEachPoint(const BitBoard &bit_board, MoveList * const forbidden_move)
@@ -151,9 +286,20 @@ void EnumerateOpenState(const Board &board, MoveList * const forbidden_move)
   GetMoveList(forbidden_bit_set, forbidden_move);
 }
 
-void EnumerateOpenState(const BitBoard &bit_board, MoveList * const forbidden_move)
+void EnumerateOpenState(Board * const board, MoveList * const forbidden_move)
 {
+  assert(board != nullptr);
+
+  MoveBitSet forbidden_bit_set;
+  board->EnumerateForbiddenMoves(&forbidden_bit_set);
+  GetMoveList(forbidden_bit_set, forbidden_move);
+}
+
+void EnumerateOpenState(BitBoard * const bit_board, MoveList * const forbidden_move)
+{
+  assert(bit_board != nullptr);
+
   MoveBitSet forbidden_bit_set;
-  bit_board.EnumerateForbiddenMoves(&forbidden_bit_set);
+  bit_board->EnumerateForbiddenMoves(&forbidden_bit_set);
   GetMoveList(forbidden_bit_set, forbidden_move);
 }
@@ -1,8 +1,43 @@
 #ifndef ENUMERATE_FORBIDDEN_MOVE_H
 #define ENUMERATE_FORBIDDEN_MOVE_H
 
+#include <string>
+
 #include "MoveList.h"
 #include "Board.h"
+#include "GameRecordDB.h"
+#include "GameRecordTrie.h"
+#include "Instrumentation.h"
+
+//! @brief 禁手列挙の集計結果
+struct EnumerateForbiddenMoveResult
+{
+  EnumerateForbiddenMoveResult();
+
+  size_t board_count;       //!< 列挙した盤面数
+  size_t forbidden_count;   //!< 禁手の数
+  std::string log;          //!< 禁手が存在する盤面と禁手リスト
+  realcore::InstrumentationSnapshot snapshot;   //!< 処理ごとの計測結果
+};
+
+//! @brief チャンクの集計結果を統合する
+void ReduceEnumerateForbiddenMoveResult(EnumerateForbiddenMoveResult * const result, const EnumerateForbiddenMoveResult &chunk_result);
+
+//! @brief 棋譜の各局面の禁手を列挙する
+//! @param mode 列挙方法(point, enum, enum-diff)
+//! @param board 初期局面の盤面(enum-diffのみ使用し、初期局面に戻す)
+//! @param game_record 棋譜
+//! @param is_output_result 禁手が存在する盤面を記録するか
+//! @param result 集計結果
+void EnumerateForbiddenMove(const std::string &mode, realcore::Board * const board, const realcore::GameRecordView &game_record, const bool is_output_result, EnumerateForbiddenMoveResult * const result);
+
+//! @brief トライ木の異なる手順ごとに1度だけ禁手を列挙する(enum-diff)
+//! @param game_record_trie 棋譜DBを登録したトライ木
+//! @param board 初期局面の盤面(走査後は初期局面に戻す)
+//! @param is_output_result 禁手が存在する局面を記録するか(手順ごとに1行, トライ木の走査順)
+//! @param result 集計結果
+//! @note 盤面数と禁手の数は手順を経由する棋譜数で重み付けし、棋譜ごとに列挙した場合と同じ値にする
+void EnumerateForbiddenMove(const realcore::GameRecordTrie &game_record_trie, realcore::Board * const board, const bool is_output_result, EnumerateForbiddenMoveResult * const result);
 
 //! @brief 各空点が禁手かどうかをチェックする
 //! @param board_move チェックする盤面の指し手リスト
@@ -17,6 +52,13 @@ void EnumerateOpenState(const realcore::Board &board, realcore::MoveList * const
 //! @brief 空点状態を使って列挙する
 //! @param board チェックする盤面
 //! @param forbidden_move 禁手の格納先
-void EnumerateOpenState(const realcore::BitBoard &bit_board, realcore::MoveList * const forbidden_move);
+//! @note 盤面をコピーせずに列挙する(列挙後は元の盤面に戻る)
+void EnumerateOpenState(realcore::Board * const board, realcore::MoveList * const forbidden_move);
+
+//! @brief 空点状態を使って列挙する
+//! @param board チェックする盤面
+//! @param forbidden_move 禁手の格納先
+//! @note 盤面をコピーせずに列挙する(列挙後は元の盤面に戻る)
+void EnumerateOpenState(realcore::BitBoard * const bit_board, realcore::MoveList * const forbidden_move);
 
 #endif
@@ -0,0 +1,14 @@
+#!/bin/bash
+compiler=g++
+
+if [ ! -d build ]; then
+	mkdir build
+fi
+
+pushd build
+
+cmake -DCMAKE_CXX_COMPILER=${compiler} -DCMAKE_CXX_FLAGS=-DREALCORE_INSTRUMENTATION ..
+make -j ${MAKE_JOB_NUMBER}
+
+popd
+
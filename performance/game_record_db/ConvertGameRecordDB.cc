@@ -0,0 +1,118 @@
+#include <iostream>
+#include <chrono>
+#include <map>
+
+#include <boost/program_options.hpp>
+
+#include "CSVReader.h"
+#include "GameRecordDB.h"
+#include "MoveList.h"
+
+using namespace std;
+using namespace boost::program_options;
+using namespace realcore;
+
+//! @brief 処理の所要時間(ms)を返す
+template<class Function>
+const double MeasureTime(const Function &function)
+{
+  const auto start_time = chrono::steady_clock::now();
+  function();
+  const auto elapsed_time = chrono::steady_clock::now() - start_time;
+
+  return chrono::duration_cast<chrono::microseconds>(elapsed_time).count() / 1000.0;
+}
+
+int main(int argc, char* argv[])
+{
+  // オプション設定
+  options_description option;
+
+  option.add_options()
+    ("csv", value<string>(), "変換元の棋譜データベース(csv)")
+    ("db", value<string>(), "変換先の棋譜データベース(バイナリ形式)")
+    ("bench", "CSVとバイナリ形式の読込時間を比較する")
+    ("help,h", "ヘルプを表示");
+
+  variables_map arg_map;
+  store(parse_command_line(argc, argv, option), arg_map);
+  notify(arg_map);
+
+  if(arg_map.count("help") || !arg_map.count("csv") || !arg_map.count("db")){
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << option;
+    cout << endl;
+    cout << "Convert the merged game record DB(csv) into the binary format read by GameRecordDB." << endl;
+    cout << endl;
+
+    return 0;
+  }
+
+  const string csv_file = arg_map["csv"].as<string>();
+  const string db_file = arg_map["db"].as<string>();
+
+  // 変換
+  GameRecordDBBuilder builder;
+  size_t skip_count = 0;
+  bool is_converted = false;
+
+  const double convert_ms = MeasureTime([&]{
+    is_converted = builder.AddCSV(csv_file, &skip_count) && builder.WriteFile(db_file);
+  });
+
+  if(!is_converted){
+    cerr << "Failed to convert: " << csv_file << endl;
+    return 1;
+  }
+
+  cout << "Game count: " << builder.size() << endl;
+  cout << "Skipped game records: " << skip_count << endl;
+  cout << "Convert time(ms): " << convert_ms << endl;
+
+  if(!arg_map.count("bench")){
+    return 0;
+  }
+
+  // 全棋譜をMoveListとして参照するまでの時間を比較する
+  size_t csv_move_count = 0, db_move_count = 0;
+
+  const double csv_ms = MeasureTime([&]{
+    map<string, StringVector> game_record_db;
+    ReadCSV(csv_file, &game_record_db);
+
+    for(const auto &game_record : game_record_db["game_record"]){
+      const MoveList move_list(game_record);
+      csv_move_count += move_list.size();
+    }
+  });
+
+  GameRecordDB game_record_db;
+  double db_open_ms = 0;
+
+  const double db_ms = MeasureTime([&]{
+    db_open_ms = MeasureTime([&]{
+      game_record_db.Open(db_file);
+    });
+
+    for(size_t i=0, size=game_record_db.size(); i<size; i++){
+      db_move_count += game_record_db.GetGameRecord(i).size();
+    }
+  });
+
+  double db_move_list_ms = MeasureTime([&]{
+    MoveList move_list;
+
+    for(size_t i=0, size=game_record_db.size(); i<size; i++){
+      game_record_db.GetMoveList(i, &move_list);
+    }
+  });
+
+  cout << endl;
+  cout << "format\ttime(ms)\tmoves" << endl;
+  cout << "csv(ReadCSV + MoveList)\t" << csv_ms << "\t" << csv_move_count << endl;
+  cout << "binary(Open)\t" << db_open_ms << "\t-" << endl;
+  cout << "binary(Open + GameRecordView)\t" << db_ms << "\t" << db_move_count << endl;
+  cout << "binary(GetMoveList)\t" << db_move_list_ms << "\t" << db_move_count << endl;
+
+  return 0;
+}
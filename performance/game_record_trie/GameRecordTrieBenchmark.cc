@@ -0,0 +1,113 @@
+#include <iostream>
+#include <chrono>
+
+#include <boost/program_options.hpp>
+
+#include "GameRecordDB.h"
+#include "GameRecordTrie.h"
+#include "Board.h"
+
+using namespace std;
+using namespace boost::program_options;
+using namespace realcore;
+
+//! @brief 処理の所要時間(ms)を返す
+template<class Function>
+const double MeasureTime(const Function &function)
+{
+  const auto start_time = chrono::steady_clock::now();
+  function();
+  const auto elapsed_time = chrono::steady_clock::now() - start_time;
+
+  return chrono::duration_cast<chrono::microseconds>(elapsed_time).count() / 1000.0;
+}
+
+//! @brief 局面の禁手点の数を返す(白番は0)
+const size_t CountForbiddenMove(const Board &board)
+{
+  MoveBitSet forbidden_move_set;
+  board.EnumerateForbiddenMoves(&forbidden_move_set);
+
+  return forbidden_move_set.count();
+}
+
+int main(int argc, char* argv[])
+{
+  // オプション設定
+  options_description option;
+
+  option.add_options()
+    ("db", value<string>(), "棋譜DBファイル(バイナリ形式 or CSV形式)")
+    ("help,h", "ヘルプを表示");
+
+  variables_map arg_map;
+  store(parse_command_line(argc, argv, option), arg_map);
+  notify(arg_map);
+
+  if(arg_map.count("help") || !arg_map.count("db")){
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << option;
+    cout << endl;
+    cout << "Compare the forbidden move enumeration over all positions between replaying each game and the trie traversal." << endl;
+    cout << endl;
+
+    return 0;
+  }
+
+  GameRecordDB game_record_db;
+
+  if(!game_record_db.Load(arg_map["db"].as<string>())){
+    cerr << "Failed to load the game record DB." << endl;
+    return 1;
+  }
+
+  // 棋譜ごとに初期局面から再生する
+  size_t replay_position_count = 0, replay_forbidden_count = 0;
+
+  const double replay_ms = MeasureTime([&]{
+    for(size_t i=0, size=game_record_db.size(); i<size; i++){
+      const GameRecordView game_record = game_record_db.GetGameRecord(i);
+      Board board(kUpdateForbiddenCheck);
+
+      replay_forbidden_count += CountForbiddenMove(board);
+      replay_position_count++;
+
+      for(const auto move : game_record){
+        board.MakeMove(move);
+
+        replay_forbidden_count += CountForbiddenMove(board);
+        replay_position_count++;
+      }
+    }
+  });
+
+  // トライ木で異なる手順ごとに1度だけ評価する
+  GameRecordTrie game_record_trie;
+
+  const double build_ms = MeasureTime([&]{
+    game_record_trie.Build(game_record_db);
+  });
+
+  size_t trie_prefix_count = 0, trie_forbidden_count = 0;
+
+  const double traverse_ms = MeasureTime([&]{
+    Board board(kUpdateForbiddenCheck);
+
+    game_record_trie.Traverse(&board, [&](const Board &visit_board, const GameRecordTriePosition &position){
+      // 棋譜ごとの再生と比較するため、手順を経由する棋譜数で重み付けする
+      trie_forbidden_count += CountForbiddenMove(visit_board) * position.game_count;
+      trie_prefix_count++;
+    });
+  });
+
+  cout << "Games: " << game_record_db.size() << endl;
+  cout << "Replay positions: " << replay_position_count << endl;
+  cout << "Trie prefixes: " << trie_prefix_count << " (" << 100.0 * trie_prefix_count / max<size_t>(1, replay_position_count) << "%)" << endl;
+  cout << "Replay(ms): " << replay_ms << endl;
+  cout << "Trie build(ms): " << build_ms << endl;
+  cout << "Trie traverse(ms): " << traverse_ms << endl;
+  cout << "Speedup: " << replay_ms / (build_ms + traverse_ms) << endl;
+  cout << "Forbidden moves: " << replay_forbidden_count << " / " << trie_forbidden_count << endl;
+
+  return replay_forbidden_count == trie_forbidden_count ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+#include <iostream>
+#include <chrono>
+
+#include <boost/program_options.hpp>
+#include <boost/thread.hpp>
+
+#include "GameRecordDB.h"
+#include "GameRecordImporter.h"
+
+using namespace std;
+using namespace boost::program_options;
+using namespace realcore;
+
+//! @brief 処理の所要時間(ms)を返す
+template<class Function>
+const double MeasureTime(const Function &function)
+{
+  const auto start_time = chrono::steady_clock::now();
+  function();
+  const auto elapsed_time = chrono::steady_clock::now() - start_time;
+
+  return chrono::duration_cast<chrono::microseconds>(elapsed_time).count() / 1000.0;
+}
+
+int main(int argc, char* argv[])
+{
+  // オプション設定
+  options_description option;
+
+  option.add_options()
+    ("input", value<vector<string>>(), "SGF, POSファイル or ファイルを格納したディレクトリ(複数指定可)")
+    ("db", value<string>(), "出力する棋譜データベース(バイナリ形式)")
+    ("thread", value<size_t>()->default_value(boost::thread::hardware_concurrency()), "読込スレッド数")
+    ("batch", value<size_t>()->default_value(4096), "1回の並列読込で扱うファイル数")
+    ("check", "対局日(DT), 対局者名(PB, PW), 対局結果(RE)のないSGFを読込失敗とする")
+    ("help,h", "ヘルプを表示");
+
+  variables_map arg_map;
+  store(parse_command_line(argc, argv, option), arg_map);
+  notify(arg_map);
+
+  if(arg_map.count("help") || !arg_map.count("input") || !arg_map.count("db")){
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << option;
+    cout << endl;
+    cout << "Import SGF/POS files into the binary game record DB, skipping symmetric duplicates." << endl;
+    cout << endl;
+
+    return 0;
+  }
+
+  const string db_file = arg_map["db"].as<string>();
+  const size_t thread_num = max<size_t>(1, arg_map["thread"].as<size_t>());
+  const SGFCheckBit check_bit = arg_map.count("check") ? kSGFCheckAll : kSGFCheckNone;
+
+  // 対象ファイルの列挙
+  vector<string> file_list;
+
+  const double enumerate_ms = MeasureTime([&]{
+    for(const auto &input : arg_map["input"].as<vector<string>>()){
+      GameRecordImporter::EnumerateGameRecordFile(input, &file_list);
+    }
+  });
+
+  // 読込
+  GameRecordImporter importer(thread_num, check_bit);
+  importer.SetBatchSize(max<size_t>(1, arg_map["batch"].as<size_t>()));
+
+  GameRecordDBBuilder builder;
+
+  const double import_ms = MeasureTime([&]{
+    importer.Import(file_list, &builder);
+  });
+
+  // 出力
+  bool is_written = false;
+
+  const double write_ms = MeasureTime([&]{
+    is_written = builder.WriteFile(db_file);
+  });
+
+  if(!is_written){
+    cerr << "Failed to write: " << db_file << endl;
+    return 1;
+  }
+
+  const GameRecordImportStats &stats = importer.GetStats();
+  const double import_sec = import_ms / 1000.0;
+
+  cout << "Thread: " << thread_num << endl;
+  cout << "Files: " << stats.file_count << endl;
+  cout << "Imported: " << stats.imported_count << endl;
+  cout << "Duplicates: " << stats.duplicate_count << endl;
+  cout << "Errors: " << stats.error_count << endl;
+  cout << "Enumerate time(ms): " << enumerate_ms << endl;
+  cout << "Import time(ms): " << import_ms << endl;
+  cout << "Write time(ms): " << write_ms << endl;
+  cout << "Throughput(files/s): " << stats.file_count / import_sec << endl;
+  cout << "Throughput(MB/s): " << stats.byte_count / (1024.0 * 1024.0) / import_sec << endl;
+
+  return 0;
+}
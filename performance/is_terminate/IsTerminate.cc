@@ -0,0 +1,130 @@
+#include <iostream>
+#include <chrono>
+
+#include <boost/program_options.hpp>
+#include <boost/thread.hpp>
+
+#include "SearchManager.h"
+
+using namespace std;
+using namespace boost::program_options;
+using namespace realcore;
+
+//! @brief 経過時間と1回あたりの時間を出力する
+void PrintElapsedTime(const string &label, const chrono::steady_clock::duration &elapsed_time, const SearchCounter call_count, const SearchCounter terminate_count)
+{
+  const auto elapsed_ns = chrono::duration_cast<chrono::nanoseconds>(elapsed_time).count();
+
+  cout << label << ":\t";
+  cout << chrono::duration_cast<chrono::milliseconds>(elapsed_time).count() << " ms\t";
+  cout << static_cast<double>(elapsed_ns) / call_count << " ns/call\t";
+  cout << "terminate: " << terminate_count << endl;
+}
+
+//! @brief 毎回時計を参照しinterruption pointを実行する終了判定(時計参照の間引き前の実装)
+const bool IsTerminateEveryCall(const chrono::system_clock::time_point &search_start_time, const SearchCounter elapsed_time_limit, const bool catch_interrupt_exception)
+{
+  auto elapsed_time = chrono::system_clock::now() - search_start_time;
+  SearchCounter elapsed_time_ms = chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
+
+  if(elapsed_time_ms > elapsed_time_limit){
+    return true;
+  }
+
+  try{
+    if(catch_interrupt_exception){
+      boost::this_thread::interruption_point();
+    }
+  }catch(boost::thread_interrupted){
+    return true;
+  }
+
+  return false;
+}
+
+void RunBenchmark(const SearchCounter call_count, const bool catch_interrupt_exception)
+{
+  // 探索時間上限に達しないよう十分大きな値を設定する
+  constexpr SearchCounter kTimeLimit = 1000 * 1000;
+
+  {
+    // before: 毎回system_clockを参照する
+    SearchManager search_manager(catch_interrupt_exception);
+    const auto search_start_time = chrono::system_clock::now();
+    SearchCounter terminate_count = 0;
+
+    const auto start_time = chrono::steady_clock::now();
+
+    for(SearchCounter i=0; i<call_count; i++){
+      search_manager.AddNode();
+      terminate_count += IsTerminateEveryCall(search_start_time, kTimeLimit, catch_interrupt_exception);
+    }
+
+    PrintElapsedTime("IsTerminate(every call)", chrono::steady_clock::now() - start_time, call_count, terminate_count);
+  }
+  {
+    // after: 呼出頻度に応じて時計の参照を間引く
+    SearchManager search_manager(catch_interrupt_exception);
+    search_manager.SetSearchTimeLimit(kTimeLimit);
+    search_manager.SearchStart();
+    SearchCounter terminate_count = 0;
+
+    const auto start_time = chrono::steady_clock::now();
+
+    for(SearchCounter i=0; i<call_count; i++){
+      search_manager.AddNode();
+      terminate_count += search_manager.IsTerminate();
+    }
+
+    PrintElapsedTime("IsTerminate(amortized)", chrono::steady_clock::now() - start_time, call_count, terminate_count);
+  }
+  {
+    // 探索時間上限の検出遅れ
+    SearchManager search_manager(catch_interrupt_exception);
+    search_manager.SetSearchTimeLimit(50);
+    search_manager.SearchStart();
+
+    while(!search_manager.IsTerminate()){
+      search_manager.AddNode();
+    }
+
+    cout << "Time limit 50 ms detected at: " << search_manager.GetSearchTime() << " ms" << endl;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  // オプション設定
+  options_description option;
+
+  option.add_options()
+    ("count,c", value<SearchCounter>()->default_value(10000000), "反復回数")
+    ("interrupt", "interruption pointを有効にする")
+    ("help,h", "ヘルプを表示");
+
+  variables_map arg_map;
+  store(parse_command_line(argc, argv, option), arg_map);
+
+  if(arg_map.count("help")){
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << option;
+    cout << endl;
+    cout << "Measure the overhead of SearchManager::IsTerminate called at every node:" << endl;
+    cout << " 1. check the clock(system_clock) and interruption point at every call" << endl;
+    cout << " 2. check the clock(steady_clock) and interruption point every K calls(K adapts to the call rate)" << endl;
+    cout << endl;
+
+    return 0;
+  }
+
+  const SearchCounter call_count = arg_map["count"].as<SearchCounter>();
+  const bool catch_interrupt_exception = arg_map.count("interrupt") != 0;
+
+  cout << "Interruption point: " << (catch_interrupt_exception ? "on" : "off") << endl;
+
+  // interruption pointはboost::thread上で意味を持つため別スレッドで計測する
+  boost::thread benchmark_thread(&RunBenchmark, call_count, catch_interrupt_exception);
+  benchmark_thread.join();
+
+  return 0;
+}
@@ -0,0 +1,173 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+
+#include <boost/program_options.hpp>
+#include <boost/thread.hpp>
+
+#include "MoveList.h"
+#include "HashTable.h"
+#include "GameRecordDB.h"
+#include "OpeningBook.h"
+
+using namespace std;
+using namespace boost::program_options;
+using namespace realcore;
+
+//! @brief 処理の所要時間(ms)を返す
+template<class Function>
+const double MeasureTime(const Function &function)
+{
+  const auto start_time = chrono::steady_clock::now();
+  function();
+  const auto elapsed_time = chrono::steady_clock::now() - start_time;
+
+  return chrono::duration_cast<chrono::microseconds>(elapsed_time).count() / 1000.0;
+}
+
+//! @brief 棋譜DBを走査して局面に到達した対局数を数える
+const size_t ScanGameCount(const GameRecordDB &game_record_db, const MoveList &board_move_sequence)
+{
+  const HashValue hash_value = CalcSymmetricHashValue(board_move_sequence);
+  const size_t depth = board_move_sequence.size();
+  size_t game_count = 0;
+
+  for(size_t i=0, size=game_record_db.size(); i<size; i++){
+    const GameRecordView game_record = game_record_db.GetGameRecord(i);
+
+    if(game_record.size() < depth){
+      continue;
+    }
+
+    MoveList move_list;
+
+    for(size_t j=0; j<depth; j++){
+      move_list += game_record[j];
+    }
+
+    game_count += CalcSymmetricHashValue(move_list) == hash_value ? 1 : 0;
+  }
+
+  return game_count;
+}
+
+int main(int argc, char* argv[])
+{
+  // オプション設定
+  options_description option;
+
+  option.add_options()
+    ("db", value<string>(), "棋譜DBファイル(バイナリ形式 or CSV形式)")
+    ("book", value<string>(), "定跡DBの出力ファイル")
+    ("thread", value<size_t>()->default_value(boost::thread::hardware_concurrency()), "集計スレッド数")
+    ("depth", value<size_t>()->default_value(20), "登録する局面の最大手数")
+    ("min-count", value<size_t>()->default_value(2), "登録する局面の最小対局数")
+    ("query", value<size_t>()->default_value(100000), "検索する局面数")
+    ("scan", value<size_t>()->default_value(3), "棋譜DBの走査で比較する局面数")
+    ("help,h", "ヘルプを表示");
+
+  variables_map arg_map;
+  store(parse_command_line(argc, argv, option), arg_map);
+  notify(arg_map);
+
+  if(arg_map.count("help") || !arg_map.count("db") || !arg_map.count("book")){
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << option;
+    cout << endl;
+    cout << "Build the opening book from the game record DB and compare the lookup with a DB scan." << endl;
+    cout << endl;
+
+    return 0;
+  }
+
+  const string book_file = arg_map["book"].as<string>();
+  const size_t thread_num = max<size_t>(1, arg_map["thread"].as<size_t>());
+  const size_t max_depth = arg_map["depth"].as<size_t>();
+  const size_t query_count = arg_map["query"].as<size_t>();
+  const size_t scan_count = arg_map["scan"].as<size_t>();
+
+  GameRecordDB game_record_db;
+
+  if(!game_record_db.Load(arg_map["db"].as<string>())){
+    cerr << "Failed to load the game record DB." << endl;
+    return 1;
+  }
+
+  // 集計
+  OpeningBookBuilder builder;
+  builder.SetMaxDepth(max_depth);
+  builder.SetMinGameCount(max<size_t>(1, arg_map["min-count"].as<size_t>()));
+
+  const double build_ms = MeasureTime([&]{
+    builder.Build(game_record_db, thread_num);
+  });
+
+  bool is_written = false;
+
+  const double write_ms = MeasureTime([&]{
+    is_written = builder.WriteFile(book_file);
+  });
+
+  OpeningBook opening_book;
+  bool is_opened = false;
+
+  const double open_ms = MeasureTime([&]{
+    is_opened = opening_book.Open(book_file);
+  });
+
+  if(!is_written || !is_opened){
+    cerr << "Failed to write or open the opening book." << endl;
+    return 1;
+  }
+
+  // 棋譜DBの局面を無作為に選んで検索する
+  mt19937_64 random(0);
+  vector<MoveList> query_list;
+
+  for(size_t i=0; i<query_count && game_record_db.size()>0; i++){
+    const GameRecordView game_record = game_record_db.GetGameRecord(random() % game_record_db.size());
+    const size_t depth = min(game_record.size(), max_depth);
+    const size_t query_depth = random() % (depth + 1);
+
+    MoveList query;
+
+    for(size_t j=0; j<query_depth; j++){
+      query += game_record[j];
+    }
+
+    query_list.emplace_back(query);
+  }
+
+  size_t found_count = 0;
+  OpeningBookEntry entry;
+
+  const double query_ms = MeasureTime([&]{
+    for(const auto &query : query_list){
+      found_count += opening_book.Find(query, &entry) ? 1 : 0;
+    }
+  });
+
+  // 棋譜DBの走査と対局数を比較する
+  size_t mismatch_count = 0;
+  const size_t scan_query_count = min(scan_count, query_list.size());
+
+  const double scan_ms = MeasureTime([&]{
+    for(size_t i=0; i<scan_query_count; i++){
+      const size_t game_count = ScanGameCount(game_record_db, query_list[i]);
+      const size_t book_game_count = opening_book.Find(query_list[i], &entry) ? entry.stats.game_count : 0;
+
+      mismatch_count += game_count == book_game_count || book_game_count == 0 ? 0 : 1;
+    }
+  });
+
+  cout << "Games: " << game_record_db.size() << endl;
+  cout << "Positions: " << opening_book.size() << endl;
+  cout << "Thread: " << thread_num << endl;
+  cout << "Build(ms): " << build_ms << endl;
+  cout << "Write(ms): " << write_ms << endl;
+  cout << "Open(ms): " << open_ms << endl;
+  cout << "Query(us/position): " << (query_list.empty() ? 0 : 1000.0 * query_ms / query_list.size()) << ", found: " << found_count << "/" << query_list.size() << endl;
+  cout << "Scan(ms/position): " << (scan_query_count == 0 ? 0 : scan_ms / scan_query_count) << ", mismatch: " << mismatch_count << endl;
+
+  return mismatch_count == 0 ? 0 : 1;
+}
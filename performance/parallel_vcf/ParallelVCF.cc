@@ -0,0 +1,146 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <boost/thread.hpp>
+
+#include "ParallelVCFSearch.h"
+
+using namespace std;
+using namespace boost::program_options;
+using namespace realcore;
+
+//! @brief 局面ファイルを読み込む
+//! @note 空行と#で始まる行は読み飛ばす
+const bool ReadSuiteFile(const string &suite_file, vector<MoveList> * const board_sequence_list)
+{
+  ifstream ifs(suite_file);
+
+  if(!ifs){
+    return false;
+  }
+
+  string line;
+
+  while(getline(ifs, line)){
+    if(line.empty() || line[0] == '#'){
+      continue;
+    }
+
+    board_sequence_list->emplace_back(line);
+  }
+
+  return true;
+}
+
+//! @brief 全局面を指定スレッド数で探索する
+//! @param result_list 各局面の探索結果の格納先
+//! @retval 所要時間(ms)
+const double SolveSuite(const vector<MoveList> &board_sequence_list, const size_t thread_num, const size_t table_space, vector<VCFResult> * const result_list, SearchCounter * const node_count, SearchCounter * const steal_count)
+{
+  // 置換表の確保は計測対象外とし、局面ごとに論理初期化する
+  VCFTable vcf_table(table_space, kLockTable);
+
+  result_list->clear();
+  *node_count = 0;
+  *steal_count = 0;
+
+  double elapsed_ms = 0;
+
+  for(const auto &board_sequence : board_sequence_list){
+    const Board board(board_sequence);
+    vcf_table.Initialize();
+
+    SharedSearchManager search_manager(thread_num, kNoInterruptionPoint);
+    ParallelVCFSearch parallel_vcf_search(board, &vcf_table, &search_manager);
+    MoveList proof_sequence;
+
+    const auto start_time = chrono::steady_clock::now();
+    const VCFResult result = parallel_vcf_search.Solve(&proof_sequence);
+    const auto elapsed_time = chrono::steady_clock::now() - start_time;
+
+    elapsed_ms += chrono::duration_cast<chrono::microseconds>(elapsed_time).count() / 1000.0;
+
+    result_list->emplace_back(result);
+    *node_count += search_manager.GetNode();
+    *steal_count += parallel_vcf_search.GetStealCount();
+  }
+
+  return elapsed_ms;
+}
+
+int main(int argc, char* argv[])
+{
+  // オプション設定
+  options_description option;
+
+  option.add_options()
+    ("suite,s", value<string>()->default_value("../vcf_suite.txt"), "局面ファイル")
+    ("thread,t", value<vector<size_t>>()->multitoken()->default_value(vector<size_t>{1, 2, 4, 8, 16, 32, 64}, "1 2 4 8 16 32 64"), "スレッド数")
+    ("table", value<size_t>()->default_value(64), "置換表のサイズ(MB)")
+    ("help,h", "ヘルプを表示");
+
+  variables_map arg_map;
+  store(parse_command_line(argc, argv, option), arg_map);
+  notify(arg_map);
+
+  if(arg_map.count("help")){
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << option;
+    cout << endl;
+    cout << "Measure the scaling of ParallelVCFSearch over the VCF suite for each thread number." << endl;
+    cout << "Results must be identical to the 1 thread search." << endl;
+    cout << endl;
+
+    return 0;
+  }
+
+  const string suite_file = arg_map["suite"].as<string>();
+  vector<MoveList> board_sequence_list;
+
+  if(!ReadSuiteFile(suite_file, &board_sequence_list)){
+    cerr << "Failed to open " << suite_file << endl;
+    return 1;
+  }
+
+  const size_t table_space = arg_map["table"].as<size_t>();
+  const auto thread_num_list = arg_map["thread"].as<vector<size_t>>();
+
+  cout << "Positions: " << board_sequence_list.size() << endl;
+  cout << "Hardware concurrency: " << boost::thread::hardware_concurrency() << endl;
+  cout << "thread\ttime(ms)\tspeedup\tnode\tnode/s\tsteal\tmismatch" << endl;
+
+  vector<VCFResult> base_result_list;
+  double base_elapsed_ms = 0;
+
+  for(const auto thread_num : thread_num_list){
+    vector<VCFResult> result_list;
+    SearchCounter node_count = 0, steal_count = 0;
+
+    const double elapsed_ms = SolveSuite(board_sequence_list, thread_num, table_space, &result_list, &node_count, &steal_count);
+
+    if(base_result_list.empty()){
+      base_result_list = result_list;
+      base_elapsed_ms = elapsed_ms;
+    }
+
+    size_t mismatch_count = 0;
+
+    for(size_t i=0; i<result_list.size(); i++){
+      mismatch_count += (result_list[i] != base_result_list[i]);
+    }
+
+    cout << thread_num << "\t";
+    cout << elapsed_ms << "\t";
+    cout << base_elapsed_ms / elapsed_ms << "\t";
+    cout << node_count << "\t";
+    cout << static_cast<SearchCounter>(node_count / elapsed_ms * 1000) << "\t";
+    cout << steal_count << "\t";
+    cout << mismatch_count << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,205 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <boost/thread.hpp>
+
+#include "ParallelVCTSearch.h"
+
+using namespace std;
+using namespace boost::program_options;
+using namespace realcore;
+
+//! @brief 問題ファイルを読み込む
+//! @note 空行と#で始まる行は読み飛ばす
+const bool ReadProblemFile(const string &problem_file, vector<MoveList> * const board_sequence_list)
+{
+  ifstream ifs(problem_file);
+
+  if(!ifs){
+    return false;
+  }
+
+  string line;
+
+  while(getline(ifs, line)){
+    if(line.empty() || line[0] == '#'){
+      continue;
+    }
+
+    board_sequence_list->emplace_back(line);
+  }
+
+  return true;
+}
+
+//! @brief 探索結果の文字列を返す
+const string GetResultString(const VCTResult result)
+{
+  switch(result){
+  case kVCTProven:
+    return "proven";
+
+  case kVCTDisproven:
+    return "disproven";
+
+  default:
+    return "unknown";
+  }
+}
+
+//! @brief 全問題を指定スレッド数で探索する
+//! @param solve_ms_list 各問題の所要時間(ms)の格納先
+//! @param result_list 各問題の探索結果の格納先
+void SolveProblem(const vector<MoveList> &board_sequence_list, const size_t thread_num, const size_t table_space, const size_t max_depth, const SearchCounter node_limit, vector<double> * const solve_ms_list, vector<VCTResult> * const result_list, SearchCounter * const node_count, size_t * const gc_count)
+{
+  // 置換表の確保は計測対象外とし、問題ごとに論理初期化する
+  VCTTable vct_table(table_space, kLockTable);
+
+  solve_ms_list->clear();
+  result_list->clear();
+  *node_count = 0;
+
+  for(const auto &board_sequence : board_sequence_list){
+    const Board board(board_sequence);
+    vct_table.Initialize();
+
+    SharedSearchManager search_manager(thread_num, kNoInterruptionPoint);
+    search_manager.SetNodeLimit(node_limit);
+
+    ParallelVCTSearch parallel_vct_search(board, &vct_table, &search_manager);
+    parallel_vct_search.SetMaxDepth(max_depth);
+
+    MoveTree proof_tree;
+
+    const auto start_time = chrono::steady_clock::now();
+    const VCTResult result = parallel_vct_search.Solve(&proof_tree);
+    const auto elapsed_time = chrono::steady_clock::now() - start_time;
+
+    solve_ms_list->emplace_back(chrono::duration_cast<chrono::microseconds>(elapsed_time).count() / 1000.0);
+    result_list->emplace_back(result);
+    *node_count += search_manager.GetNode();
+  }
+
+  *gc_count = vct_table.GetGarbageCollectionCount();
+}
+
+int main(int argc, char* argv[])
+{
+  // オプション設定
+  options_description option;
+
+  option.add_options()
+    ("problem,p", value<string>()->default_value("../vct_problem.txt"), "問題ファイル")
+    ("thread,t", value<vector<size_t>>()->multitoken()->default_value(vector<size_t>{1, 2, 4, 8, 16, 32, 64}, "1 2 4 8 16 32 64"), "スレッド数")
+    ("table", value<size_t>()->default_value(64), "置換表のサイズ(MB)")
+    ("depth,d", value<size_t>()->default_value(6), "攻め方の手数上限")
+    ("node", value<SearchCounter>()->default_value(10000000), "1問あたりの探索ノード数上限(0: 無制限)")
+    ("help,h", "ヘルプを表示");
+
+  variables_map arg_map;
+  store(parse_command_line(argc, argv, option), arg_map);
+  notify(arg_map);
+
+  if(arg_map.count("help")){
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << option;
+    cout << endl;
+    cout << "Measure the solve time of ParallelVCTSearch over the problem set for each thread number." << endl;
+    cout << "Results must be identical to the 1 thread search." << endl;
+    cout << endl;
+
+    return 0;
+  }
+
+  const string problem_file = arg_map["problem"].as<string>();
+  vector<MoveList> board_sequence_list;
+
+  if(!ReadProblemFile(problem_file, &board_sequence_list)){
+    cerr << "Failed to open " << problem_file << endl;
+    return 1;
+  }
+
+  const size_t table_space = arg_map["table"].as<size_t>();
+  const size_t max_depth = arg_map["depth"].as<size_t>();
+  const SearchCounter node_limit = arg_map["node"].as<SearchCounter>();
+  const auto thread_num_list = arg_map["thread"].as<vector<size_t>>();
+
+  const size_t problem_count = board_sequence_list.size();
+  vector<vector<double>> solve_ms_table;
+  vector<vector<VCTResult>> result_table;
+  vector<SearchCounter> node_count_list;
+  vector<size_t> gc_count_list;
+
+  for(const auto thread_num : thread_num_list){
+    vector<double> solve_ms_list;
+    vector<VCTResult> result_list;
+    SearchCounter node_count = 0;
+    size_t gc_count = 0;
+
+    SolveProblem(board_sequence_list, thread_num, table_space, max_depth, node_limit, &solve_ms_list, &result_list, &node_count, &gc_count);
+
+    solve_ms_table.emplace_back(solve_ms_list);
+    result_table.emplace_back(result_list);
+    node_count_list.emplace_back(node_count);
+    gc_count_list.emplace_back(gc_count);
+  }
+
+  cout << "Problems: " << problem_count << endl;
+  cout << "Max depth: " << max_depth << endl;
+  cout << "Hardware concurrency: " << boost::thread::hardware_concurrency() << endl;
+  cout << endl;
+
+  // 問題ごとの所要時間(ms)
+  cout << "problem\tresult";
+
+  for(const auto thread_num : thread_num_list){
+    cout << "\t" << thread_num;
+  }
+
+  cout << endl;
+
+  for(size_t i=0; i<problem_count; i++){
+    cout << i + 1 << "\t" << GetResultString(result_table.front()[i]);
+
+    for(const auto &solve_ms_list : solve_ms_table){
+      cout << "\t" << solve_ms_list[i];
+    }
+
+    cout << endl;
+  }
+
+  cout << endl;
+  cout << "thread\ttime(ms)\tspeedup\tnode\tnode/s\tsolved\tgc\tmismatch" << endl;
+
+  double base_elapsed_ms = 0;
+
+  for(size_t i=0; i<thread_num_list.size(); i++){
+    double elapsed_ms = 0;
+    size_t solved_count = 0, mismatch_count = 0;
+
+    for(size_t j=0; j<problem_count; j++){
+      elapsed_ms += solve_ms_table[i][j];
+      solved_count += (result_table[i][j] != kVCTUnknown);
+      mismatch_count += (result_table[i][j] != result_table.front()[j]);
+    }
+
+    if(i == 0){
+      base_elapsed_ms = elapsed_ms;
+    }
+
+    cout << thread_num_list[i] << "\t";
+    cout << elapsed_ms << "\t";
+    cout << base_elapsed_ms / elapsed_ms << "\t";
+    cout << node_count_list[i] << "\t";
+    cout << static_cast<SearchCounter>(node_count_list[i] / elapsed_ms * 1000) << "\t";
+    cout << solved_count << "\t";
+    cout << gc_count_list[i] << "\t";
+    cout << mismatch_count << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include <random>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <boost/thread.hpp>
+
+#include "MoveList.h"
+#include "POSFileBatch.h"
+
+using namespace std;
+using namespace boost::program_options;
+using namespace realcore;
+
+//! @brief 処理の所要時間(ms)を返す
+template<class Function>
+const double MeasureTime(const Function &function)
+{
+  const auto start_time = chrono::steady_clock::now();
+  function();
+  const auto elapsed_time = chrono::steady_clock::now() - start_time;
+
+  return chrono::duration_cast<chrono::microseconds>(elapsed_time).count() / 1000.0;
+}
+
+//! @brief 重複しない指し手のPOSファイルを生成する
+void GeneratePOSFile(const string &pos_dir, const size_t file_count)
+{
+  boost::filesystem::create_directories(pos_dir);
+  mt19937_64 random(0);
+
+  for(size_t i=0; i<file_count; i++){
+    vector<unsigned char> position_list(kInBoardMoveNum);
+
+    for(size_t position=0; position<kInBoardMoveNum; position++){
+      position_list[position] = static_cast<unsigned char>(position);
+    }
+
+    shuffle(position_list.begin(), position_list.end(), random);
+
+    const size_t move_count = 5 + random() % 60;
+    string pos_data(1, static_cast<char>(move_count));
+    pos_data.append(position_list.begin(), position_list.begin() + move_count);
+
+    ofstream ofs(pos_dir + "/" + to_string(i) + ".pos", ios::out | ios::binary);
+    ofs << pos_data;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  // オプション設定
+  options_description option;
+
+  option.add_options()
+    ("dir", value<string>(), "POSファイルを格納したディレクトリ")
+    ("generate", value<size_t>(), "POSファイルを生成するファイル数(--dirに生成する)")
+    ("thread", value<size_t>()->default_value(boost::thread::hardware_concurrency()), "読込スレッド数")
+    ("help,h", "ヘルプを表示");
+
+  variables_map arg_map;
+  store(parse_command_line(argc, argv, option), arg_map);
+  notify(arg_map);
+
+  if(arg_map.count("help") || !arg_map.count("dir")){
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << option;
+    cout << endl;
+    cout << "Compare ReadPOSFile per file with POSFileBatch::Load." << endl;
+    cout << endl;
+
+    return 0;
+  }
+
+  const string pos_dir = arg_map["dir"].as<string>();
+  const size_t thread_num = max<size_t>(1, arg_map["thread"].as<size_t>());
+
+  if(arg_map.count("generate")){
+    GeneratePOSFile(pos_dir, arg_map["generate"].as<size_t>());
+  }
+
+  vector<string> pos_file_list;
+
+  for(boost::filesystem::recursive_directory_iterator it(pos_dir), it_end; it!=it_end; ++it){
+    if(it->path().extension() == ".pos"){
+      pos_file_list.emplace_back(it->path().string());
+    }
+  }
+
+  sort(pos_file_list.begin(), pos_file_list.end());
+
+  // ファイルごとにReadPOSFileで読み込む
+  vector<MoveList> move_list_vector(pos_file_list.size());
+  size_t read_move_count = 0;
+
+  const double read_ms = MeasureTime([&]{
+    for(size_t i=0, size=pos_file_list.size(); i<size; i++){
+      ReadPOSFile(pos_file_list[i], &move_list_vector[i]);
+      read_move_count += move_list_vector[i].size();
+    }
+  });
+
+  // POSFileBatchで一括して読み込む
+  POSFileBatch pos_file_batch;
+  bool is_loaded = false;
+
+  const double batch_ms = MeasureTime([&]{
+    is_loaded = pos_file_batch.Load(pos_file_list, thread_num);
+  });
+
+  size_t mismatch_count = 0;
+
+  for(size_t i=0, size=pos_file_list.size(); i<size; i++){
+    MoveList move_list;
+    pos_file_batch.GetMoveList(i, &move_list);
+
+    mismatch_count += move_list == move_list_vector[i] ? 0 : 1;
+  }
+
+  cout << "Files: " << pos_file_list.size() << endl;
+  cout << "Moves: " << read_move_count << endl;
+  cout << "Thread: " << thread_num << endl;
+  cout << "ReadPOSFile(ms): " << read_ms << endl;
+  cout << "POSFileBatch(ms): " << batch_ms << endl;
+  cout << "Speedup: " << read_ms / batch_ms << endl;
+  cout << "Loaded: " << (is_loaded ? "all" : "partial") << ", mismatch: " << mismatch_count << endl;
+
+  return mismatch_count == 0 ? 0 : 1;
+}
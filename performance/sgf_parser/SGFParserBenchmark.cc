@@ -0,0 +1,375 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <regex>
+#include <set>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include "SGFParser.h"
+
+using namespace std;
+using namespace boost::program_options;
+using namespace realcore;
+
+//! @brief SGFの読込結果
+struct SGFParseResult
+{
+  string game_date;
+  string event_name;
+  string black_player_name;
+  string black_player_rank;
+  string white_player_name;
+  string white_player_rank;
+  string game_rule;
+  GameEndStatus game_end_status = kUnknownEndStatus;
+  GameResult game_result = kUnknownResult;
+  string game_record;
+  string alternative_moves;
+  string error_message;   //!< logic_error例外のメッセージ(例外なしの場合は空文字列)
+
+  const bool operator==(const SGFParseResult &rhs) const
+  {
+    if(!error_message.empty() || !rhs.error_message.empty()){
+      return error_message == rhs.error_message;
+    }
+
+    return game_date == rhs.game_date && event_name == rhs.event_name
+      && black_player_name == rhs.black_player_name && black_player_rank == rhs.black_player_rank
+      && white_player_name == rhs.white_player_name && white_player_rank == rhs.white_player_rank
+      && game_rule == rhs.game_rule && game_end_status == rhs.game_end_status && game_result == rhs.game_result
+      && game_record == rhs.game_record && alternative_moves == rhs.alternative_moves;
+  }
+};
+
+//! @brief 処理の所要時間(ms)を返す
+template<class Function>
+const double MeasureTime(const Function &function)
+{
+  const auto start_time = chrono::steady_clock::now();
+  function();
+  const auto elapsed_time = chrono::steady_clock::now() - start_time;
+
+  return chrono::duration_cast<chrono::microseconds>(elapsed_time).count() / 1000.0;
+}
+
+//! @brief SGFParserで読み込む
+const SGFParseResult ParseSGFByLexer(const string &sgf_data)
+{
+  SGFParseResult result;
+  SGFParser sgf_parser(kSGFCheckNone);
+
+  try{
+    sgf_parser.ParseSGF(sgf_data);
+  }catch(logic_error &ex){
+    result.error_message = ex.what();
+    return result;
+  }
+
+  result.game_date = sgf_parser.GetGameDate();
+  result.event_name = sgf_parser.GetEventName();
+  result.black_player_name = sgf_parser.GetBlackPlayerName();
+  result.black_player_rank = sgf_parser.GetBlackPlayerRank();
+  result.white_player_name = sgf_parser.GetWhitePlayerName();
+  result.white_player_rank = sgf_parser.GetWhitePlayerRank();
+  result.game_rule = sgf_parser.GetGameRule();
+  result.game_end_status = sgf_parser.GetEndStatus();
+  result.game_result = sgf_parser.GetGameResult();
+  result.game_record = sgf_parser.GetGameRecord();
+  result.alternative_moves = sgf_parser.GetAlternativeMoves();
+
+  return result;
+}
+
+//! @brief 正規表現に最初にマッチした部分文字列を返す
+const string SearchFirst(const string &sgf_data, const regex &expr, const size_t group, const string &default_str)
+{
+  smatch match;
+  return regex_search(sgf_data, match, expr) ? match.str(group) : default_str;
+}
+
+//! @brief 1回の走査に置き換える前の正規表現による読込(比較用)
+const SGFParseResult ParseSGFByRegex(const string &sgf_data)
+{
+  static const regex date_expr("DT\\[(.*?)\\]"), event_expr("EV\\[(.*?)\\]");
+  static const regex black_player_name_expr("PB\\[(.*?)\\]"), black_player_rank_expr("BR\\[(.*?)\\]");
+  static const regex white_player_name_expr("PW\\[(.*?)\\]"), white_player_rank_expr("WR\\[(.*?)\\]");
+  static const regex game_rule_expr("(GN|RU)\\[.*?((RIF)|(Sakata)|(Yamaguchi)|(Tarannikov)|(Jonsson)|(Unknown)).*?\\]");
+  static const regex draw_expr("RE\\[B?W?\\+?Draw\\]"), result_expr("RE\\[(B|W)\\+(Resign|R|Time)\\]");
+  static const regex stone_expr("[a-z][a-z]"), black_stone_expr("AB(\\[[a-z][a-z]\\])+"), white_stone_expr("AW(\\[[a-z][a-z]\\])+");
+  static const regex black_turn_expr("PL\\[B\\]"), white_turn_expr("PL\\[W\\]");
+  static const regex move_expr(";(B|W)\\[([a-z][a-z])\\]");
+  static const regex alternative_expr("(5A|FA)\\[([a-o0-9\\s\\[\\]]*)\\]");
+
+  SGFParseResult result;
+  smatch match;
+
+  result.game_date = SearchFirst(sgf_data, date_expr, 1, "");
+  result.event_name = SearchFirst(sgf_data, event_expr, 1, "");
+  result.black_player_name = SearchFirst(sgf_data, black_player_name_expr, 1, "");
+  result.black_player_rank = SearchFirst(sgf_data, black_player_rank_expr, 1, "");
+  result.white_player_name = SearchFirst(sgf_data, white_player_name_expr, 1, "");
+  result.white_player_rank = SearchFirst(sgf_data, white_player_rank_expr, 1, "");
+  result.game_rule = SearchFirst(sgf_data, game_rule_expr, 2, "Unknown");
+
+  result.game_end_status = kUnknownEndStatus;
+  result.game_result = kUnknownResult;
+
+  if(regex_search(sgf_data, match, draw_expr)){
+    result.game_end_status = kAgreedDraw;
+    result.game_result = kDraw;
+  }else if(regex_search(sgf_data, match, result_expr)){
+    result.game_end_status = match.str(2) == "Time" ? kTimeup : kResign;
+    result.game_result = match.str(1) == "B" ? kBlackWin : kWhiteWin;
+  }
+
+  // 初期局面
+  vector<string> stone_vec[2];
+  const regex *stone_list_expr[2] = {&black_stone_expr, &white_stone_expr};
+
+  for(size_t i=0; i<2; i++){
+    if(regex_search(sgf_data, match, *stone_list_expr[i])){
+      const string stone_list_str = match.str();
+
+      for(sregex_iterator it(stone_list_str.begin(), stone_list_str.end(), stone_expr), it_end; it!=it_end; ++it){
+        stone_vec[i].emplace_back(it->str());
+      }
+    }
+  }
+
+  vector<string> &black_stone_vec = stone_vec[0], &white_stone_vec = stone_vec[1];
+  const size_t black_size = black_stone_vec.size(), white_size = white_stone_vec.size();
+  bool is_black_turn = black_size != white_size + 1;
+
+  if(regex_search(sgf_data, match, black_turn_expr)){
+    is_black_turn = true;
+  }
+
+  if(regex_search(sgf_data, match, white_turn_expr)){
+    is_black_turn = false;
+  }
+
+  const size_t black_target = is_black_turn ? max(black_size, white_size) : max(black_size, white_size + 1);
+  black_stone_vec.resize(black_target, "pp");
+  white_stone_vec.resize(is_black_turn ? black_target : black_target - 1, "pp");
+
+  for(size_t i=0, size=white_stone_vec.size(); i<size; i++){
+    result.game_record += black_stone_vec[i] + white_stone_vec[i];
+  }
+
+  if(!is_black_turn){
+    result.game_record += black_stone_vec.back();
+  }
+
+  // 指し手
+  bool black_turn = true;
+
+  for(sregex_iterator it(sgf_data.begin(), sgf_data.end(), move_expr), it_end; it!=it_end; ++it){
+    const string turn = it->str(1), stone = it->str(2);
+
+    if((black_turn && turn != "B") || (!black_turn && turn != "W")){
+      result.error_message = "Turn is not consistent.";
+      return result;
+    }
+
+    if(stone == "tt"){
+      break;
+    }
+
+    if(stone[0] > 'o' || stone[1] > 'o'){
+      result.error_message = "Illegal move: " + stone;
+      return result;
+    }
+
+    result.game_record += stone;
+    black_turn = !black_turn;
+  }
+
+  if(regex_search(sgf_data, match, alternative_expr)){
+    result.alternative_moves = match.str(2);
+    replace(result.alternative_moves.begin(), result.alternative_moves.end(), '[', ' ');
+    replace(result.alternative_moves.begin(), result.alternative_moves.end(), ']', ';');
+  }
+
+  return result;
+}
+
+//! @brief 指定ディレクトリ(またはファイル)以下のSGFファイルを読み込む
+void ReadSGFCorpus(const string &path, vector<string> * const sgf_corpus)
+{
+  vector<boost::filesystem::path> file_list;
+
+  if(boost::filesystem::is_directory(path)){
+    for(boost::filesystem::recursive_directory_iterator it(path), it_end; it!=it_end; ++it){
+      if(boost::filesystem::is_regular_file(it->path())){
+        file_list.emplace_back(it->path());
+      }
+    }
+  }else{
+    file_list.emplace_back(path);
+  }
+
+  for(const auto &file : file_list){
+    ifstream ifs(file.string(), ios::binary);
+    stringstream ss;
+    ss << ifs.rdbuf();
+    sgf_corpus->emplace_back(ss.str());
+  }
+}
+
+//! @brief 対局サーバ形式の合成SGFを生成する
+void GenerateSGFCorpus(const size_t game_count, const size_t seed, vector<string> * const sgf_corpus)
+{
+  mt19937_64 random(seed);
+  const vector<string> rule_list{"RIF", "Sakata", "Yamaguchi", "Tarannikov", "Jonsson"};
+  const vector<string> result_list{"B+Resign", "W+Resign", "B+Time", "W+R", "Draw", "B+T"};
+
+  for(size_t i=0; i<game_count; i++){
+    stringstream ss;
+
+    ss << "(;GM[4]FF[4]SZ[15]";
+    ss << "PB[player" << random() % 5000 << "]BR[" << random() % 9 + 1 << "d]";
+    ss << "PW[player" << random() % 5000 << "]WR[" << random() % 9 + 1 << "d]";
+    ss << "EV[tournament " << random() % 100 << "]";
+    ss << "DT[" << 2000 + random() % 20 << "-0" << random() % 9 + 1 << "-1" << random() % 10 << "]";
+    ss << "GN[game " << i << " : " << rule_list[random() % rule_list.size()] << " rule]";
+    ss << "RE[" << result_list[random() % result_list.size()] << "]TM[600]";
+
+    if(random() % 2 == 0){
+      ss << "5A[" << static_cast<char>('a' + random() % 15) << static_cast<char>('a' + random() % 15) << "][" << static_cast<char>('a' + random() % 15) << static_cast<char>('a' + random() % 15) << "]";
+    }
+
+    ss << "\n";
+
+    // 重複しない指し手を生成する
+    set<size_t> move_set;
+    const size_t move_count = 5 + random() % 80;
+
+    for(size_t move_index=0; move_index<move_count; move_index++){
+      size_t move = random() % 225;
+
+      while(move_set.count(move) > 0){
+        move = random() % 225;
+      }
+
+      move_set.insert(move);
+      ss << ";" << (move_index % 2 == 0 ? "B" : "W") << "[" << static_cast<char>('a' + move % 15) << static_cast<char>('a' + move / 15) << "]";
+
+      if(random() % 20 == 0){
+        ss << "C[\ngood move\n]";
+      }
+
+      if(move_index % 10 == 9){
+        ss << "\n";
+      }
+    }
+
+    ss << ")\n";
+    sgf_corpus->emplace_back(ss.str());
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  // オプション設定
+  options_description option;
+
+  option.add_options()
+    ("sgf", value<string>(), "SGFファイル or SGFファイルを格納したディレクトリ")
+    ("generate", value<size_t>()->default_value(100000), "--sgf未指定時に生成する合成SGFの棋譜数")
+    ("seed", value<size_t>()->default_value(0), "合成SGFの乱数シード")
+    ("repeat", value<size_t>()->default_value(3), "計測回数(最速値を採用)")
+    ("regex", "正規表現による読込と速度、読込結果を比較する")
+    ("help,h", "ヘルプを表示");
+
+  variables_map arg_map;
+  store(parse_command_line(argc, argv, option), arg_map);
+  notify(arg_map);
+
+  if(arg_map.count("help")){
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << option;
+    cout << endl;
+    cout << "Measure the SGF parse throughput(MB/s) of SGFParser." << endl;
+    cout << endl;
+
+    return 0;
+  }
+
+  vector<string> sgf_corpus;
+
+  if(arg_map.count("sgf")){
+    ReadSGFCorpus(arg_map["sgf"].as<string>(), &sgf_corpus);
+  }else{
+    GenerateSGFCorpus(arg_map["generate"].as<size_t>(), arg_map["seed"].as<size_t>(), &sgf_corpus);
+  }
+
+  size_t corpus_bytes = 0;
+
+  for(const auto &sgf_data : sgf_corpus){
+    corpus_bytes += sgf_data.size();
+  }
+
+  const double corpus_mb = corpus_bytes / (1024.0 * 1024.0);
+  const size_t repeat = max<size_t>(1, arg_map["repeat"].as<size_t>());
+
+  cout << "Game count: " << sgf_corpus.size() << endl;
+  cout << "Corpus size(MB): " << corpus_mb << endl;
+
+  // 最速値を計測する
+  const auto measure = [&](const string &name, SGFParseResult (*parse_function)(const string&), vector<SGFParseResult> * const result_list){
+    double best_ms = 0;
+    size_t error_count = 0;
+
+    for(size_t i=0; i<repeat; i++){
+      result_list->clear();
+      result_list->reserve(sgf_corpus.size());
+
+      const double elapsed_ms = MeasureTime([&]{
+        for(const auto &sgf_data : sgf_corpus){
+          result_list->emplace_back(parse_function(sgf_data));
+        }
+      });
+
+      best_ms = i == 0 ? elapsed_ms : min(best_ms, elapsed_ms);
+    }
+
+    for(const auto &result : *result_list){
+      error_count += result.error_message.empty() ? 0 : 1;
+    }
+
+    cout << name << ": " << best_ms << " ms, " << corpus_mb / (best_ms / 1000.0) << " MB/s, " << sgf_corpus.size() / (best_ms / 1000.0) << " games/s, error: " << error_count << endl;
+    return best_ms;
+  };
+
+  vector<SGFParseResult> lexer_result_list;
+  const double lexer_ms = measure("lexer", [](const string &sgf_data){ return ParseSGFByLexer(sgf_data); }, &lexer_result_list);
+
+  if(!arg_map.count("regex")){
+    return 0;
+  }
+
+  vector<SGFParseResult> regex_result_list;
+  const double regex_ms = measure("regex", [](const string &sgf_data){ return ParseSGFByRegex(sgf_data); }, &regex_result_list);
+
+  size_t mismatch_count = 0;
+
+  for(size_t i=0, size=sgf_corpus.size(); i<size; i++){
+    if(lexer_result_list[i] == regex_result_list[i]){
+      continue;
+    }
+
+    if(mismatch_count++ < 5){
+      cerr << "Mismatch: " << sgf_corpus[i] << endl;
+    }
+  }
+
+  cout << "speedup: " << regex_ms / lexer_ms << endl;
+  cout << "mismatch: " << mismatch_count << endl;
+
+  return mismatch_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "SharedSearchManager.h"
+
+using namespace std;
+using namespace boost::program_options;
+using namespace realcore;
+
+//! @brief 経過時間とスレッドあたり1操作の時間を出力する
+//! @note 同時に実行されるスレッド数はCPUコア数で頭打ちになるため、コア数を上限として1操作の時間を求める
+void PrintElapsedTime(const string &label, const chrono::system_clock::duration &elapsed_time, const size_t thread_num, const SearchCounter operation_count, const SearchCounter node)
+{
+  const auto elapsed_ns = chrono::duration_cast<chrono::nanoseconds>(elapsed_time).count();
+  const size_t running_thread_num = min<size_t>(thread_num, max<size_t>(1, thread::hardware_concurrency()));
+
+  cout << label << ":\t";
+  cout << chrono::duration_cast<chrono::milliseconds>(elapsed_time).count() << " ms\t";
+  cout << static_cast<double>(elapsed_ns) * running_thread_num / operation_count << " ns/op(per thread)\t";
+  cout << "node: " << node << endl;
+}
+
+int main(int argc, char* argv[])
+{
+  // オプション設定
+  options_description option;
+
+  option.add_options()
+    ("thread,t", value<size_t>()->default_value(4), "探索スレッド数")
+    ("count,c", value<SearchCounter>()->default_value(10000000), "スレッドあたりの反復回数")
+    ("help,h", "ヘルプを表示");
+
+  variables_map arg_map;
+  store(parse_command_line(argc, argv, option), arg_map);
+
+  if(arg_map.count("help")){
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << option;
+    cout << endl;
+    cout << "Each thread repeats AddNode and IsTerminate(node limit enabled) with:" << endl;
+    cout << " 1. a single std::atomic counter shared by all threads" << endl;
+    cout << " 2. SharedSearchManager(per-thread sharded counters)" << endl;
+    cout << endl;
+
+    return 0;
+  }
+
+  const size_t thread_num = arg_map["thread"].as<size_t>();
+  const SearchCounter iteration_count = arg_map["count"].as<SearchCounter>();
+  const SearchCounter operation_count = thread_num * iteration_count;
+
+  cout << "Thread: " << thread_num << endl;
+
+  {
+    // before: 全スレッドで1つのatomicカウンタを共有する
+    atomic<SearchCounter> node(0);
+    atomic<bool> stop_flag(false);
+    const SearchCounter node_limit = operation_count + 1;
+
+    auto start_time = chrono::system_clock::now();
+    vector<thread> thread_list;
+
+    for(size_t thread_index=0; thread_index<thread_num; thread_index++){
+      thread_list.emplace_back([&node, &stop_flag, node_limit, iteration_count](){
+        for(SearchCounter i=0; i<iteration_count; i++){
+          if(node.fetch_add(1, memory_order_relaxed) >= node_limit){
+            stop_flag.store(true);
+          }
+
+          if(stop_flag.load(memory_order_relaxed)){
+            break;
+          }
+        }
+      });
+    }
+
+    for(auto &search_thread : thread_list){
+      search_thread.join();
+    }
+
+    auto elapsed_time = chrono::system_clock::now() - start_time;
+    PrintElapsedTime("std::atomic(shared)", elapsed_time, thread_num, operation_count, node);
+  }
+  {
+    // after: SharedSearchManager
+    SharedSearchManager search_manager(thread_num, kNoInterruptionPoint);
+    search_manager.SetNodeLimit(operation_count + 1);
+
+    auto start_time = chrono::system_clock::now();
+    vector<thread> thread_list;
+
+    for(size_t thread_index=0; thread_index<thread_num; thread_index++){
+      thread_list.emplace_back([&search_manager, thread_index, iteration_count](){
+        for(SearchCounter i=0; i<iteration_count; i++){
+          search_manager.AddNode(thread_index);
+
+          if(search_manager.IsTerminate(thread_index)){
+            break;
+          }
+        }
+      });
+    }
+
+    for(auto &search_thread : thread_list){
+      search_thread.join();
+    }
+
+    auto elapsed_time = chrono::system_clock::now() - start_time;
+    PrintElapsedTime("SharedSearchManager", elapsed_time, thread_num, operation_count, search_manager.GetNode());
+  }
+
+  return 0;
+}
@@ -0,0 +1,332 @@
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace boost::program_options;
+
+namespace realcore
+{
+
+//! @brief JSONの文字列値をエスケープする
+string EscapeJSONString(const string &value)
+{
+  string escaped;
+  escaped.reserve(value.size());
+
+  for(const auto c : value){
+    if(static_cast<unsigned char>(c) < 0x20){
+      // 制御文字は\u00XX形式で出力する
+      static constexpr char kHexDigit[] = "0123456789abcdef";
+
+      escaped += "\\u00";
+      escaped += kHexDigit[static_cast<unsigned char>(c) >> 4];
+      escaped += kHexDigit[static_cast<unsigned char>(c) & 0xF];
+      continue;
+    }
+
+    if(c == '"' || c == '\\'){
+      escaped += '\\';
+    }
+
+    escaped += c;
+  }
+
+  return escaped;
+}
+
+const double GetPercentile(const vector<uint64_t> &sorted_list, const double percentile)
+{
+  assert(0 <= percentile && percentile <= 100);
+  assert(is_sorted(sorted_list.begin(), sorted_list.end()));
+
+  if(sorted_list.empty()){
+    return 0;
+  }
+
+  const double position = (sorted_list.size() - 1) * percentile / 100.0;
+  const size_t lower_index = static_cast<size_t>(floor(position));
+  const size_t upper_index = min(lower_index + 1, sorted_list.size() - 1);
+  const double weight = position - lower_index;
+
+  return (1 - weight) * sorted_list[lower_index] + weight * sorted_list[upper_index];
+}
+
+BenchmarkResult::BenchmarkResult()
+: operation_count(0)
+{
+}
+
+const double BenchmarkResult::GetTimePercentile(const double percentile) const
+{
+  return GetPercentile(time_list, percentile);
+}
+
+const double BenchmarkResult::GetCyclePercentile(const double percentile) const
+{
+  return GetPercentile(cycle_list, percentile);
+}
+
+const double BenchmarkResult::GetTimePerOperation() const
+{
+  return operation_count == 0 ? 0.0 : GetTimePercentile(50) / operation_count;
+}
+
+const double BenchmarkResult::GetCyclePerOperation() const
+{
+  return operation_count == 0 ? 0.0 : GetCyclePercentile(50) / operation_count;
+}
+
+BenchmarkComparison::BenchmarkComparison()
+: baseline_time(0), current_time(0), is_regression(false)
+{
+}
+
+Benchmark::Benchmark(const string &name)
+: name_(name), warmup_count_(kDefaultBenchmarkWarmupCount), trial_count_(kDefaultBenchmarkTrialCount),
+  regression_threshold_(kDefaultRegressionThreshold), cpu_(-1)
+{
+}
+
+void Benchmark::AddOption(options_description * const option, const size_t warmup_count, const size_t trial_count)
+{
+  assert(option != nullptr);
+
+  option->add_options()
+    ("warmup", value<size_t>()->default_value(warmup_count), "ウォームアップの試行回数")
+    ("trial", value<size_t>()->default_value(trial_count), "計測の試行回数")
+    ("cpu", value<int>(), "実行するCPU番号(Linuxのみ)")
+    ("json", value<string>(), "計測結果をJSON形式で出力するファイル")
+    ("baseline", value<string>(), "比較するベースライン(--jsonで出力したファイル)")
+    ("threshold", value<double>()->default_value(kDefaultRegressionThreshold), "回帰と判定する1操作あたりの所要時間の増加率");
+}
+
+const bool Benchmark::SetOption(const variables_map &arg_map)
+{
+  SetWarmupCount(arg_map["warmup"].as<size_t>());
+  SetTrialCount(max<size_t>(1, arg_map["trial"].as<size_t>()));
+  SetRegressionThreshold(arg_map["threshold"].as<double>());
+
+  if(arg_map.count("json")){
+    json_file_ = arg_map["json"].as<string>();
+  }
+
+  if(arg_map.count("baseline")){
+    baseline_file_ = arg_map["baseline"].as<string>();
+  }
+
+  if(arg_map.count("cpu")){
+    return PinCPU(arg_map["cpu"].as<int>());
+  }
+
+  return true;
+}
+
+void Benchmark::SetWarmupCount(const size_t warmup_count)
+{
+  warmup_count_ = warmup_count;
+}
+
+void Benchmark::SetTrialCount(const size_t trial_count)
+{
+  assert(trial_count > 0);
+  trial_count_ = trial_count;
+}
+
+void Benchmark::SetRegressionThreshold(const double regression_threshold)
+{
+  regression_threshold_ = regression_threshold;
+}
+
+const bool Benchmark::PinCPU(const int cpu)
+{
+#ifdef __linux__
+  if(cpu < 0 || cpu >= CPU_SETSIZE){
+    return false;
+  }
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+
+  if(sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0){
+    return false;
+  }
+
+  cpu_ = cpu;
+  return true;
+#else
+  return false;
+#endif
+}
+
+string Benchmark::GetSummary() const
+{
+  stringstream ss;
+  ss << fixed << setprecision(2);
+
+  for(const auto &result : result_list_){
+    ss << result.label << ":\t";
+    ss << result.GetTimePercentile(50) / 1000000 << " ms\t";
+    ss << "[p10 " << result.GetTimePercentile(10) / 1000000 << ", p90 " << result.GetTimePercentile(90) / 1000000 << "]\t";
+    ss << result.GetTimePerOperation() << " ns/op\t";
+    ss << result.GetCyclePerOperation() << " " << GetCycleCounterUnit() << "/op" << endl;
+  }
+
+  return ss.str();
+}
+
+string Benchmark::GetJSON() const
+{
+  stringstream ss;
+
+  // 所要時間/サイクル数の桁落ちを防ぐため、doubleを丸めずに出力する
+  ss << setprecision(numeric_limits<double>::max_digits10);
+
+  ss << "{\"name\":\"" << EscapeJSONString(name_) << "\",";
+  ss << "\"cycle_unit\":\"" << GetCycleCounterUnit() << "\",";
+  ss << "\"cpu\":" << cpu_ << ",";
+  ss << "\"warmup\":" << warmup_count_ << ",";
+  ss << "\"trial\":" << trial_count_ << ",";
+  ss << "\"results\":[";
+
+  for(size_t i=0, size=result_list_.size(); i<size; i++){
+    const BenchmarkResult &result = result_list_[i];
+
+    if(i != 0){
+      ss << ",";
+    }
+
+    ss << "{\"label\":\"" << EscapeJSONString(result.label) << "\",";
+    ss << "\"operation_count\":" << result.operation_count << ",";
+    ss << "\"time_per_operation\":" << result.GetTimePerOperation() << ",";
+    ss << "\"cycle_per_operation\":" << result.GetCyclePerOperation() << ",";
+    ss << "\"time\":{\"min\":" << result.GetTimePercentile(0) << ",\"p10\":" << result.GetTimePercentile(10);
+    ss << ",\"median\":" << result.GetTimePercentile(50) << ",\"p90\":" << result.GetTimePercentile(90);
+    ss << ",\"max\":" << result.GetTimePercentile(100) << "},";
+    ss << "\"cycle\":{\"min\":" << result.GetCyclePercentile(0) << ",\"p10\":" << result.GetCyclePercentile(10);
+    ss << ",\"median\":" << result.GetCyclePercentile(50) << ",\"p90\":" << result.GetCyclePercentile(90);
+    ss << ",\"max\":" << result.GetCyclePercentile(100) << "}}";
+  }
+
+  ss << "]}";
+
+  return ss.str();
+}
+
+const bool Benchmark::LoadBaseline(const string &json_file, map<string, double> * const baseline_map)
+{
+  ifstream ifs(json_file);
+
+  if(!ifs){
+    return false;
+  }
+
+  stringstream ss;
+  ss << ifs.rdbuf();
+
+  return ParseBaseline(ss.str(), baseline_map);
+}
+
+const bool Benchmark::ParseBaseline(const string &json, map<string, double> * const baseline_map)
+{
+  assert(baseline_map != nullptr);
+
+  try{
+    stringstream ss(json);
+    boost::property_tree::ptree json_tree;
+    boost::property_tree::read_json(ss, json_tree);
+
+    for(const auto &result : json_tree.get_child("results")){
+      const string label = result.second.get<string>("label");
+      (*baseline_map)[label] = result.second.get<double>("time_per_operation");
+    }
+  }catch(const boost::property_tree::ptree_error &){
+    return false;
+  }
+
+  return true;
+}
+
+void Benchmark::CompareBaseline(const map<string, double> &baseline_map, vector<BenchmarkComparison> * const comparison_list) const
+{
+  assert(comparison_list != nullptr);
+
+  for(const auto &result : result_list_){
+    const auto find_it = baseline_map.find(result.label);
+
+    if(find_it == baseline_map.end()){
+      continue;
+    }
+
+    BenchmarkComparison comparison;
+    comparison.label = result.label;
+    comparison.baseline_time = find_it->second;
+    comparison.current_time = result.GetTimePerOperation();
+    comparison.is_regression = comparison.current_time > comparison.baseline_time * (1 + regression_threshold_);
+
+    comparison_list->emplace_back(comparison);
+  }
+}
+
+const bool Benchmark::Report(ostream &os) const
+{
+  os << GetSummary();
+
+  if(!json_file_.empty()){
+    ofstream ofs(json_file_);
+    ofs << GetJSON() << endl;
+
+    if(!ofs){
+      cerr << "Failed to write the benchmark result: " << json_file_ << endl;
+      return false;
+    }
+  }
+
+  if(baseline_file_.empty()){
+    return true;
+  }
+
+  map<string, double> baseline_map;
+
+  if(!LoadBaseline(baseline_file_, &baseline_map)){
+    cerr << "Failed to read the baseline: " << baseline_file_ << endl;
+    return false;
+  }
+
+  vector<BenchmarkComparison> comparison_list;
+  CompareBaseline(baseline_map, &comparison_list);
+
+  bool is_regression = false;
+  ostringstream ss;
+  ss << "Baseline: " << baseline_file_ << endl;
+  ss << fixed << setprecision(2);
+
+  for(const auto &comparison : comparison_list){
+    const double ratio = comparison.baseline_time == 0 ? 0.0 : comparison.current_time / comparison.baseline_time;
+
+    ss << (comparison.is_regression ? "[REGRESSION] " : "") << comparison.label << ":\t";
+    ss << comparison.baseline_time << " -> " << comparison.current_time << " ns/op\t";
+    ss << "(x" << ratio << ")" << endl;
+
+    is_regression |= comparison.is_regression;
+  }
+
+  os << ss.str();
+
+  return !is_regression;
+}
+
+}   // namespace realcore
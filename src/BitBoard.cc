@@ -4,6 +4,7 @@
 #include "MoveList.h"
 #include "LineNeighborhood.h"
 #include "BoardOpenState.h"
+#include "Instrumentation.h"
 #include "BitBoard.h"
 
 using namespace std;
@@ -11,6 +12,43 @@ using namespace std;
 namespace realcore
 {
 
+//! @brief 指し手位置の1方向分のBitBoard配列上の位置を求める
+template<BoardDirection kDirection>
+constexpr StateBitPosition MakeStateBitPosition(const Cordinate x, const Cordinate y)
+{
+  const size_t index = GetBitBoardIndex<kDirection>(x, y);
+  const size_t shift = GetBitBoardShift<kDirection>(x, y);
+  constexpr StateBit state_mask = 0b11ULL;
+
+  return StateBitPosition{state_mask << shift, static_cast<uint32_t>(index), static_cast<uint32_t>(shift)};
+}
+
+//! @brief 全指し手位置のBitBoard配列上の位置テーブルを生成する
+constexpr StateBitPositionTable MakeStateBitPositionTable()
+{
+  StateBitPositionTable table{};
+
+  for(size_t move=0; move<kMoveNum; move++){
+    const Cordinate x = move % 16;
+    const Cordinate y = move / 16;
+
+    if(!IsInBoard(x, y)){
+      // 盤外の指し手はmaskを0とし、StateBit配列を更新しないようにする
+      continue;
+    }
+
+    table.position_list[move][kLateralDirection] = MakeStateBitPosition<kLateralDirection>(x, y);
+    table.position_list[move][kVerticalDirection] = MakeStateBitPosition<kVerticalDirection>(x, y);
+    table.position_list[move][kLeftDiagonalDirection] = MakeStateBitPosition<kLeftDiagonalDirection>(x, y);
+    table.position_list[move][kRightDiagonalDirection] = MakeStateBitPosition<kRightDiagonalDirection>(x, y);
+  }
+
+  return table;
+}
+
+// constexprで定義してコンパイル時に生成することを保証し、静的初期化順序の影響を受けないようにする
+extern constexpr StateBitPositionTable kStateBitPositionTable = MakeStateBitPositionTable();
+
 BitBoard::BitBoard()
 : bit_board_{{
   #include "def/BitBoardDefinition.h"
@@ -58,10 +96,35 @@ const bool BitBoard::operator!=(const BitBoard &bit_board) const{
   return !(*this == bit_board);
 }
 
+#ifdef REALCORE_COUNT_BIT_BOARD_COPY
+//! スレッドごとのBitBoardのコピー回数
+thread_local uint64_t bit_board_copy_count = 0;
+#endif
+
+const uint64_t GetBitBoardCopyCount()
+{
+#ifdef REALCORE_COUNT_BIT_BOARD_COPY
+  return bit_board_copy_count;
+#else
+  return 0;
+#endif
+}
+
+void ResetBitBoardCopyCount()
+{
+#ifdef REALCORE_COUNT_BIT_BOARD_COPY
+  bit_board_copy_count = 0;
+#endif
+}
+
 void Copy(const BitBoard &bit_board_from, BitBoard * const bit_board_to)
 {
   assert(bit_board_to != nullptr);
 
+#ifdef REALCORE_COUNT_BIT_BOARD_COPY
+  ++bit_board_copy_count;
+#endif
+
   bit_board_to->bit_board_ = bit_board_from.bit_board_;
 }
 
@@ -77,44 +140,81 @@ const BitBoard& BitBoard::operator=(const BitBoard &bit_board)
 template<>
 const bool BitBoard::IsForbiddenMove<kBlackTurn>(const MovePosition move, MoveBitSet * const downward_influence_area, MoveBitSet * const black_upward_influence_area, MoveBitSet * const white_upward_influence_area) const
 {
+  ScopedOperationTimer<kInstrumentIsForbiddenMove> operation_timer;
+
   if(!IsInBoardMove(move)){
     return false;
   }
   
-  assert(GetState(move) == kOpenPosition);
   assert((downward_influence_area == nullptr && black_upward_influence_area == nullptr && white_upward_influence_area == nullptr) || 
    (downward_influence_area != nullptr && black_upward_influence_area != nullptr && white_upward_influence_area != nullptr));
 
+  vector<BoardPosition> next_open_four_list;
+  const ForbiddenCheckState forbidden_state = CheckLineNeighborhoodForbidden(move, &next_open_four_list, downward_influence_area, black_upward_influence_area);
+
+  if(forbidden_state != kPossibleForbiddenMove){
+    return forbidden_state == kForbiddenMove;
+  }
+
+  // 見かけの三々が存在する(kPossibleForbiddenMove)
+  // 盤面のコピーは1度だけ行い、以降の再帰チェックはコピーした盤面への着手/取り消しで行う
+  BitBoard board(*this);
+  return board.IsDoubleThreeInPlace(move, next_open_four_list, downward_influence_area, black_upward_influence_area, white_upward_influence_area);
+}
+
+const ForbiddenCheckState BitBoard::CheckLineNeighborhoodForbidden(const MovePosition move, vector<BoardPosition> * const next_open_four_list, MoveBitSet * const downward_influence_area, MoveBitSet * const black_upward_influence_area) const
+{
+  assert(GetState(move) == kOpenPosition);
+  assert(next_open_four_list != nullptr);
+
   // 禁手チェックはmoveの長さ5の直線近傍をチェックすれば十分
   // @see doc/06_forbidden_check/forbidden_check.pptx
   constexpr size_t kForbiddenCheck = 5;
-  LineNeighborhood line_neighbor(move, kForbiddenCheck, *this);
+  LineNeighborhood line_neighbor = LineNeighborhood::Create<kForbiddenCheck>(move, *this);
 
   line_neighbor.SetCenterState<kBlackStone>();
 
   // 直線近傍の禁手チェック
   // @note 直線近傍の禁手チェックでの上向き影響領域は黒石のみ存在
-  vector<BoardPosition> next_open_four_list;
-  const ForbiddenCheckState forbidden_state = line_neighbor.ForbiddenCheck(&next_open_four_list, downward_influence_area, black_upward_influence_area);
+  const ForbiddenCheckState forbidden_state = line_neighbor.ForbiddenCheck(next_open_four_list, downward_influence_area, black_upward_influence_area);
 
   if(forbidden_state == kForbiddenMove){
     if(black_upward_influence_area != nullptr){
       black_upward_influence_area->reset();
     }
-
-    return true;
   }else if(forbidden_state == kNonForbiddenMove){
     if(downward_influence_area != nullptr){
       downward_influence_area->reset();
     }
+  }
 
+  return forbidden_state;
+}
+
+const bool BitBoard::IsForbiddenMoveInPlace(const MovePosition move, MoveBitSet * const downward_influence_area, MoveBitSet * const black_upward_influence_area, MoveBitSet * const white_upward_influence_area)
+{
+  if(!IsInBoardMove(move)){
     return false;
   }
+  
+  vector<BoardPosition> next_open_four_list;
+  const ForbiddenCheckState forbidden_state = CheckLineNeighborhoodForbidden(move, &next_open_four_list, downward_influence_area, black_upward_influence_area);
+
+  if(forbidden_state != kPossibleForbiddenMove){
+    return forbidden_state == kForbiddenMove;
+  }
+
+  return IsDoubleThreeInPlace(move, next_open_four_list, downward_influence_area, black_upward_influence_area, white_upward_influence_area);
+}
+
+const bool BitBoard::IsDoubleThreeInPlace(const MovePosition move, const vector<BoardPosition> &next_open_four_list, MoveBitSet * const downward_influence_area, MoveBitSet * const black_upward_influence_area, MoveBitSet * const white_upward_influence_area)
+{
+  assert((downward_influence_area == nullptr && black_upward_influence_area == nullptr && white_upward_influence_area == nullptr) || 
+   (downward_influence_area != nullptr && black_upward_influence_area != nullptr && white_upward_influence_area != nullptr));
 
-  // 見かけの三々が存在する(kPossibleForbiddenMove)
   // 達四を作る位置が禁手かどうかを再帰的にチェックする
-  BitBoard board(*this);
-  board.SetState<kBlackStone>(move);
+  // @note moveの黒石はスコープを抜ける際に取り除く
+  ScopedStone<kBlackStone> black_stone(move, this);
 
   size_t three_count = 0;
   bitset<kBoardDirectionNum> checked_direction;
@@ -130,11 +230,11 @@ const bool BitBoard::IsForbiddenMove<kBlackTurn>(const MovePosition move, MoveBi
     bool is_forbidden = false;
 
     if(downward_influence_area == nullptr && black_upward_influence_area == nullptr && white_upward_influence_area == nullptr){
-      is_forbidden = board.IsForbiddenMove<kBlackTurn>(next_open_four_move, nullptr, nullptr, nullptr);
+      is_forbidden = IsForbiddenMoveInPlace(next_open_four_move, nullptr, nullptr, nullptr);
     }else{
       MoveBitSet upward_three;    // 達四点が禁手成立 -> 不成立になると三が生じる
       MoveBitSet black_downward_three, white_downward_three;  // 達四点が否禁 -> 禁手となると三が生じない
-      is_forbidden = board.IsForbiddenMove<kBlackTurn>(next_open_four_move, &upward_three, &black_downward_three, &white_downward_three);
+      is_forbidden = IsForbiddenMoveInPlace(next_open_four_move, &upward_three, &black_downward_three, &white_downward_three);
 
       if(is_forbidden){
         // 三になっていない
@@ -261,6 +361,32 @@ void BitBoard::GetBoardOpenState(const UpdateOpenStateFlag &update_flag, BoardOp
 }
 
 void BitBoard::EnumerateForbiddenMoves(const BoardOpenState &board_open_state, MoveBitSet * const forbidden_move_set) const
+{
+  MoveBitSet double_semi_three_bit;
+  EnumerateForbiddenCandidates(board_open_state, forbidden_move_set, &double_semi_three_bit);
+
+  if(double_semi_three_bit.none()){
+    return;
+  }
+
+  // 盤面のコピーは1度だけ行い、各チェックはコピーした盤面への着手/取り消しで行う
+  BitBoard check_bit_board(*this);
+  check_bit_board.EnumerateDoubleThreeMovesInPlace(board_open_state, double_semi_three_bit, forbidden_move_set);
+}
+
+void BitBoard::EnumerateForbiddenMoves(const BoardOpenState &board_open_state, MoveBitSet * const forbidden_move_set)
+{
+  MoveBitSet double_semi_three_bit;
+  EnumerateForbiddenCandidates(board_open_state, forbidden_move_set, &double_semi_three_bit);
+
+  if(double_semi_three_bit.none()){
+    return;
+  }
+
+  EnumerateDoubleThreeMovesInPlace(board_open_state, double_semi_three_bit, forbidden_move_set);
+}
+
+void BitBoard::EnumerateForbiddenCandidates(const BoardOpenState &board_open_state, MoveBitSet * const forbidden_move_set, MoveBitSet * const double_semi_three_move_set) const
 {
   assert(board_open_state.GetUpdateOpenStateFlag().test(kNextOverline));
   assert(board_open_state.GetUpdateOpenStateFlag().test(kNextOpenFourBlack));
@@ -288,21 +414,24 @@ void BitBoard::EnumerateForbiddenMoves(const BoardOpenState &board_open_state, M
     (*forbidden_move_set) |= double_four_bit;
   }
   
-  // 三々点
   {
-    MoveBitSet double_semi_three_bit;
-    EnumerateDoubleSemiThreeMoves<kBlackTurn>(board_open_state, &double_semi_three_bit);
+    // 見かけの三々点
+    EnumerateDoubleSemiThreeMoves<kBlackTurn>(board_open_state, double_semi_three_move_set);
+  }
+}
 
-    if(double_semi_three_bit.none()){
-      return;
-    }
+void BitBoard::EnumerateDoubleThreeMovesInPlace(const BoardOpenState &board_open_state, const MoveBitSet &double_semi_three_move_set, MoveBitSet * const forbidden_move_set)
+{
+  assert(forbidden_move_set != nullptr);
 
+  // 三々点
+  {
     MoveList multi_semi_three_move_list;
-    GetMoveList(double_semi_three_bit, &multi_semi_three_move_list);
+    GetMoveList(double_semi_three_move_set, &multi_semi_three_move_list);
 
     // 「見かけの三々」が「三々」かチェックする
+    // @note 各チェックは盤面への着手/取り消しで行い、チェック後は元の盤面に戻る
     array<bitset<kBoardDirectionNum>, kMoveNum> move_direction_three;
-    BitBoard check_bit_board(*this);
 
     assert(board_open_state.GetUpdateOpenStateFlag().test(kNextSemiThreeBlack));
     const auto& next_semi_three_list = board_open_state.GetList(kNextSemiThreeBlack);
@@ -328,9 +457,12 @@ void BitBoard::EnumerateForbiddenMoves(const BoardOpenState &board_open_state, M
       const auto check_position = open_state.GetCheckPosition();
       const auto check_move = GetBoardMove(check_position);
 
-      check_bit_board.SetState<kBlackStone>(move);
-      const bool is_forbidden = check_bit_board.IsForbiddenMove<kBlackTurn>(check_move);
-      check_bit_board.SetState<kOpenPosition>(move);
+      bool is_forbidden = false;
+
+      {
+        ScopedStone<kBlackStone> black_stone(move, this);
+        is_forbidden = IsForbiddenMoveInPlace(check_move, nullptr, nullptr, nullptr);
+      }
 
       if(is_forbidden){
         continue;
@@ -382,6 +514,8 @@ void BitBoard::EnumerateOpenFourMoves<kWhiteTurn>(const BoardOpenState &board_op
 template<>
 void BitBoard::EnumerateFourMoves<kBlackTurn>(const BoardOpenState &board_open_state, MoveBitSet * const four_move_set) const
 {
+  ScopedOperationTimer<kInstrumentEnumerateFourMoves> operation_timer;
+
   assert(board_open_state.GetUpdateOpenStateFlag().test(kNextFourBlack));
   assert(four_move_set != nullptr);
   assert(four_move_set->none());
@@ -399,6 +533,8 @@ void BitBoard::EnumerateFourMoves<kBlackTurn>(const BoardOpenState &board_open_s
 template<>
 void BitBoard::EnumerateFourMoves<kBlackTurn>(const BoardOpenState &board_open_state, vector<MovePair> * const four_move_list) const
 {
+  ScopedOperationTimer<kInstrumentEnumerateFourMoves> operation_timer;
+
   assert(board_open_state.GetUpdateOpenStateFlag().test(kNextFourBlack));
   assert(four_move_list != nullptr);
   assert(four_move_list->empty());
@@ -432,6 +568,8 @@ void BitBoard::EnumerateFourMoves<kBlackTurn>(const BoardOpenState &board_open_s
 template<>
 void BitBoard::EnumerateFourMoves<kWhiteTurn>(const BoardOpenState &board_open_state, MoveBitSet * const four_move_set) const
 {
+  ScopedOperationTimer<kInstrumentEnumerateFourMoves> operation_timer;
+
   assert(board_open_state.GetUpdateOpenStateFlag().test(kNextFourWhite));
   assert(four_move_set != nullptr);
   assert(four_move_set->none());
@@ -449,6 +587,8 @@ void BitBoard::EnumerateFourMoves<kWhiteTurn>(const BoardOpenState &board_open_s
 template<>
 void BitBoard::EnumerateFourMoves<kWhiteTurn>(const BoardOpenState &board_open_state, vector<MovePair> * const four_move_list) const
 {
+  ScopedOperationTimer<kInstrumentEnumerateFourMoves> operation_timer;
+
   assert(board_open_state.GetUpdateOpenStateFlag().test(kNextFourWhite));
   assert(four_move_list != nullptr);
   assert(four_move_list->empty());
@@ -695,10 +835,10 @@ const bool BitBoard::GetMakeForbiddenGuard(const BoardOpenState &board_open_stat
     const auto four_move = four_pair.first;
     const auto four_guard_move = four_pair.second;
 
-    check_bit_board.SetState<kWhiteStone>(four_move);
+    ScopedStone<kWhiteStone> white_stone(four_move, &check_bit_board);
 
     MoveBitSet downward_influence_area, black_upward_influence_area, white_upward_influence_area;
-    const bool is_forbidden = check_bit_board.IsForbiddenMove<kBlackTurn>(four_guard_move, &downward_influence_area, &black_upward_influence_area, &white_upward_influence_area);
+    const bool is_forbidden = check_bit_board.IsForbiddenMoveInPlace(four_guard_move, &downward_influence_area, &black_upward_influence_area, &white_upward_influence_area);
 
     if(is_forbidden){
       is_make_forbidden = true;
@@ -706,8 +846,6 @@ const bool BitBoard::GetMakeForbiddenGuard(const BoardOpenState &board_open_stat
       downward_influence_area.set(four_move);
       *guard_move_set &= downward_influence_area;
     }
-
-    check_bit_board.SetState<kOpenPosition>(four_move);
   }
 
   if(!is_make_forbidden){
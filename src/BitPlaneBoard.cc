@@ -0,0 +1,175 @@
+#include "MoveList.h"
+#include "BitPlaneBoard.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+const BitPlane& GetInBoardBitPlane()
+{
+  static const BitPlane in_board_plane = [](){
+    // BitBoardの初期値(盤内が空点)の空点フラグを結合する
+    const Bitboard initial_bit_board{{
+      #include "def/BitBoardDefinition.h"
+    }};
+
+    BitPlane plane;
+
+    for(size_t plane_index=0; plane_index<kBitPlaneElementNum; plane_index++){
+      const auto open_bit_even = GetOpenPositionBit(initial_bit_board[2 * plane_index]);
+      const auto open_bit_odd = GetOpenPositionBit(initial_bit_board[2 * plane_index + 1]);
+
+      plane[plane_index] = GetCombinedBit(open_bit_even, open_bit_odd);
+    }
+
+    return plane;
+  }();
+
+  return in_board_plane;
+}
+
+BitPlaneBoard::BitPlaneBoard()
+: black_plane_{{0}}, white_plane_{{0}}
+{
+}
+
+BitPlaneBoard::BitPlaneBoard(const MoveList &move_list)
+: BitPlaneBoard()
+{
+  bool is_black_turn = true;
+
+  for(const auto move : move_list){
+    if(is_black_turn){
+      SetState<kBlackStone>(move);
+    }else{
+      SetState<kWhiteStone>(move);
+    }
+
+    is_black_turn = !is_black_turn;
+  }
+}
+
+BitPlaneBoard::BitPlaneBoard(const BitBoard &bit_board)
+: BitPlaneBoard()
+{
+  for(const auto move : GetAllInBoardMove()){
+    const auto state = bit_board.GetState(move);
+
+    if(state == kBlackStone || state == kWhiteStone){
+      SetState(move, state);
+    }
+  }
+}
+
+const bool BitPlaneBoard::operator==(const BitPlaneBoard &bit_plane_board) const
+{
+  return black_plane_ == bit_plane_board.black_plane_ && white_plane_ == bit_plane_board.white_plane_;
+}
+
+const bool BitPlaneBoard::operator!=(const BitPlaneBoard &bit_plane_board) const
+{
+  return !(*this == bit_plane_board);
+}
+
+void BitPlaneBoard::GetOpenPositionPlane(BitPlane * const open_position_plane) const
+{
+  assert(open_position_plane != nullptr);
+  const BitPlane &in_board_plane = GetInBoardBitPlane();
+
+  for(size_t plane_index=0; plane_index<kBitPlaneElementNum; plane_index++){
+    (*open_position_plane)[plane_index] = in_board_plane[plane_index] & ~(black_plane_[plane_index] | white_plane_[plane_index]);
+  }
+}
+
+void BitPlaneBoard::GetBoardOpenState(const UpdateOpenStateFlag &update_flag, BoardOpenState * const board_open_state) const
+{
+  assert(board_open_state != nullptr);
+  assert(board_open_state->empty());
+
+  const BitPlane &in_board_plane = GetInBoardBitPlane();
+
+  for(size_t plane_index=0; plane_index<kBitPlaneElementNum; plane_index++)
+  {
+    // 石フラグはbitplaneをそのまま用い、空点フラグは盤内フラグから石フラグを除いて求める
+    const auto black_bit = black_plane_[plane_index];
+    const auto white_bit = white_plane_[plane_index];
+    const auto open_bit = in_board_plane[plane_index] & ~(black_bit | white_bit);
+
+    if(update_flag[kNextOverline]){
+      GetOpenState<kNextOverline>(plane_index, black_bit, open_bit, board_open_state);
+    }
+
+    if(update_flag[kNextOpenFourBlack]){
+      GetOpenState<kNextOpenFourBlack>(plane_index, black_bit, open_bit, board_open_state);
+    }
+
+    if(update_flag[kNextOpenFourWhite]){
+      GetOpenState<kNextOpenFourWhite>(plane_index, white_bit, open_bit, board_open_state);
+    }
+
+    if(update_flag[kNextFourBlack]){
+      GetOpenState<kNextFourBlack>(plane_index, black_bit, open_bit, board_open_state);
+    }
+
+    if(update_flag[kNextFourWhite]){
+      GetOpenState<kNextFourWhite>(plane_index, white_bit, open_bit, board_open_state);
+    }
+
+    if(update_flag[kNextSemiThreeBlack]){
+      GetOpenState<kNextSemiThreeBlack>(plane_index, black_bit, open_bit, board_open_state);
+    }
+
+    if(update_flag[kNextSemiThreeWhite]){
+      GetOpenState<kNextSemiThreeWhite>(plane_index, white_bit, open_bit, board_open_state);
+    }
+
+    if(update_flag[kNextPointOfSwordBlack]){
+      GetOpenState<kNextPointOfSwordBlack>(plane_index, black_bit, open_bit, board_open_state);
+    }
+
+    if(update_flag[kNextPointOfSwordWhite]){
+      GetOpenState<kNextPointOfSwordWhite>(plane_index, white_bit, open_bit, board_open_state);
+    }
+
+    if(update_flag[kNextTwoBlack]){
+      GetOpenState<kNextTwoBlack>(plane_index, black_bit, open_bit, board_open_state);
+    }
+
+    if(update_flag[kNextTwoWhite]){
+      GetOpenState<kNextTwoWhite>(plane_index, white_bit, open_bit, board_open_state);
+    }
+  }
+}
+
+void BitPlaneBoard::EnumerateForbiddenMoves(MoveBitSet * const forbidden_move_set) const
+{
+  BoardOpenState board_open_state(kUpdateForbiddenCheck);
+  GetBoardOpenState(kUpdateForbiddenCheck, &board_open_state);
+
+  // 長連点, 四々点, 三々点の判定は空点状態から行う
+  // 見かけの三々の判定にはLineNeighborhoodを用いるためBitBoardに変換する
+  BitBoard bit_board;
+  GetBitBoard(&bit_board);
+
+  bit_board.EnumerateForbiddenMoves(board_open_state, forbidden_move_set);
+}
+
+void BitPlaneBoard::GetBitBoard(BitBoard * const bit_board) const
+{
+  assert(bit_board != nullptr);
+  const BitPlane &in_board_plane = GetInBoardBitPlane();
+
+  for(size_t index=0; index<kBitBoardElementNum; index++){
+    // 下位bit: 空点 or 黒石(盤内かつ白石以外), 上位bit: 空点 or 白石(盤内かつ黒石以外)
+    const size_t plane_index = index / 2;
+    const size_t plane_shift = index % 2;
+
+    const uint64_t lower_bit = ((in_board_plane[plane_index] & ~white_plane_[plane_index]) >> plane_shift) & kUpperBitMask;
+    const uint64_t upper_bit = ((in_board_plane[plane_index] & ~black_plane_[plane_index]) >> plane_shift) & kUpperBitMask;
+
+    bit_board->bit_board_[index] = lower_bit | (upper_bit << 1);
+  }
+}
+
+}   // namespace realcore
@@ -4,6 +4,9 @@
 #include "Move.h"
 #include "MoveList.h"
 #include "LineNeighborhood.h"
+#include "Instrumentation.h"
+#include "HashTable.h"
+#include "ForbiddenMoveTable.h"
 #include "Board.h"
 
 using namespace std;
@@ -12,35 +15,50 @@ namespace realcore
 {
 
 Board::Board()
+: forbidden_move_table_(nullptr)
 {
   board_open_state_list_.reserve(kMoveNum);
   board_open_state_list_.emplace_back();
+
+  board_hash_value_list_.reserve(kMoveNum);
+  board_hash_value_list_.emplace_back(0);
 }
 
 Board::Board(const UpdateOpenStateFlag &update_flag)
+: forbidden_move_table_(nullptr)
 {
   board_open_state_list_.reserve(kMoveNum);
   board_open_state_list_.emplace_back(update_flag);
+
+  board_hash_value_list_.reserve(kMoveNum);
+  board_hash_value_list_.emplace_back(0);
 }
 
 Board::Board(const MoveList &move_list, const UpdateOpenStateFlag &update_flag)
+: forbidden_move_table_(nullptr)
 {
   board_open_state_list_.reserve(kMoveNum);
   board_open_state_list_.emplace_back(update_flag);
 
+  board_hash_value_list_.reserve(kMoveNum);
+  board_hash_value_list_.emplace_back(0);
+
   for(const auto move : move_list){
     MakeMove(move);
   }
 }
 
 Board::Board(const Board &board)
+: forbidden_move_table_(nullptr)
 {
   *this = board;
 }
 
 Board::Board(const MoveList &move_list)
+: forbidden_move_table_(nullptr)
 {
   board_open_state_list_.emplace_back();
+  board_hash_value_list_.emplace_back(0);
 
   for(const auto move : move_list){
     MakeMove(move);
@@ -79,6 +97,8 @@ void Copy(const Board &board_from, Board * const board_to)
   board_to->bit_board_ = board_from.bit_board_;
   board_to->board_move_sequence_ = board_from.board_move_sequence_;
   board_to->board_open_state_list_ = board_from.board_open_state_list_;
+  board_to->board_hash_value_list_ = board_from.board_hash_value_list_;
+  board_to->forbidden_move_table_ = board_from.forbidden_move_table_;
 }
 
 const Board& Board::operator=(const Board &board)
@@ -92,6 +112,7 @@ const Board& Board::operator=(const Board &board)
 
 void Board::MakeMove(const MovePosition move, const UpdateOpenStateFlag &update_flag)
 {
+  ScopedOperationTimer<kInstrumentMakeMove> operation_timer;
   const bool is_black_turn = board_move_sequence_.IsBlackTurn();
   assert(IsNormalMove(move));
   assert(!IsTerminateMove(move));
@@ -106,6 +127,10 @@ void Board::MakeMove(const MovePosition move, const UpdateOpenStateFlag &update_
 
   const auto &current_board_open_state = board_open_state_list_.back();
   board_open_state_list_.emplace_back(current_board_open_state, is_black_turn, move, bit_board_, update_flag);
+
+  // パスは手番ごとのパス回数でHash値が変わるため指し手リストから計算する
+  const HashValue hash_value = move != kNullMove ? CalcHashValue(is_black_turn, move, board_hash_value_list_.back()) : CalcHashValue(board_move_sequence_);
+  board_hash_value_list_.emplace_back(hash_value);
 }
 
 void Board::MakeMove(const MovePosition move)
@@ -116,6 +141,7 @@ void Board::MakeMove(const MovePosition move)
 
 void Board::UndoMove()
 {
+  ScopedOperationTimer<kInstrumentUndoMove> operation_timer;
   assert(!board_move_sequence_.empty());
 
   const auto move = board_move_sequence_.GetLastMove();
@@ -123,6 +149,7 @@ void Board::UndoMove()
   --board_move_sequence_;
 
   board_open_state_list_.pop_back();
+  board_hash_value_list_.pop_back();
 }
 
 const bool Board::IsNormalMove(const MovePosition move) const
@@ -224,8 +251,11 @@ const bool Board::IsTerminateMove(const MovePair &four_pair) const
   return false;
 }
 
-void Board::EnumerateForbiddenMoves(MoveBitSet * const forbidden_move_set) const
+template<class BitBoardType>
+void Board::EnumerateForbiddenMoves(BitBoardType * const bit_board, MoveBitSet * const forbidden_move_set) const
 {
+  assert(bit_board != nullptr);
+
   const bool is_black_turn = board_move_sequence_.IsBlackTurn();
 
   if(!is_black_turn){
@@ -234,7 +264,31 @@ void Board::EnumerateForbiddenMoves(MoveBitSet * const forbidden_move_set) const
   }
 
   const auto& board_open_state = board_open_state_list_.back();
-  bit_board_.EnumerateForbiddenMoves(board_open_state, forbidden_move_set);
+
+  if(forbidden_move_table_ == nullptr){
+    bit_board->EnumerateForbiddenMoves(board_open_state, forbidden_move_set);
+    return;
+  }
+
+  // 禁手は石の配置のみで決まるため、局面のHash値で禁手点キャッシュを参照する
+  const HashValue hash_value = board_hash_value_list_.back();
+
+  if(forbidden_move_table_->Find(hash_value, forbidden_move_set)){
+    return;
+  }
+
+  bit_board->EnumerateForbiddenMoves(board_open_state, forbidden_move_set);
+  forbidden_move_table_->Store(hash_value, *forbidden_move_set);
+}
+
+void Board::EnumerateForbiddenMoves(MoveBitSet * const forbidden_move_set) const
+{
+  EnumerateForbiddenMoves(&bit_board_, forbidden_move_set);
+}
+
+void Board::EnumerateForbiddenMoves(MoveBitSet * const forbidden_move_set)
+{
+  EnumerateForbiddenMoves(&bit_board_, forbidden_move_set);
 }
 
 const bool Board::IsOpponentFour(MovePosition * const guard_move) const
@@ -1,3 +1,5 @@
+#include "Instrumentation.h"
+#include "BitBoard.h"
 #include "BoardOpenState.h"
 
 using namespace std;
@@ -22,6 +24,7 @@ BoardOpenState::BoardOpenState(const BoardOpenState &board_open_state)
 
 void BoardOpenState::Initialize(const BoardOpenState &board_open_state, const bool is_black_turn, const MovePosition move, const BitBoard &bit_board, const UpdateOpenStateFlag &update_flag)
 {
+  ScopedOperationTimer<kInstrumentBoardOpenState> operation_timer;
   SetUpdateOpenStateFlag(update_flag);
 
   // @note OpenStatePatternリストのfor文にすると30%程度遅くなったのでfor文を展開した実装を採用
@@ -102,7 +105,7 @@ void BoardOpenState::Initialize(const BoardOpenState &board_open_state, const bo
     ClearInfluencedOpenState(is_black_turn, base_list, move, &open_state_list_[Pattern]);
   }
 
-  LineNeighborhood line_neighborhood(move, kOpenStateNeighborhoodSize, bit_board);
+  LineNeighborhood line_neighborhood = LineNeighborhood::Create<kOpenStateNeighborhoodSize>(move, bit_board);
 
   if(is_black_turn){
     line_neighborhood.AddOpenState<kBlackTurn>(update_flag_, this);
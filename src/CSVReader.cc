@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <cassert>
-#include <fstream>
+#include <cstring>
 #include <iostream>
+#include <limits>
 
 #include <boost/tokenizer.hpp>
 
@@ -11,107 +13,227 @@ using namespace boost;
 
 namespace realcore
 {
+//! @brief 読み込まないカラムの読込先index
+constexpr size_t kNoProjection = numeric_limits<size_t>::max();
+
 bool ReadCSV(const std::string &csv_file, std::map<std::string, StringVector> * const csv_data)
 {
   assert(csv_data != nullptr);
   assert(csv_data->empty());
   
-  // ヘッダリストと行数を取得する
-  size_t line_num = 0;
-  StringVector header;
+  MappedCSVReader csv_reader;
 
-  {
-    ifstream file_data(csv_file.c_str());
+  if(!csv_reader.Open(csv_file)){
+    cerr << "Failed to open the file: " << csv_file << endl;
+    return false;
+  }
 
-    if(file_data.fail()){
-      cerr << "Failed to open the file: " << csv_file << endl;
-      return false;
+  // リストサイズを初期化
+  const StringVector &header = csv_reader.GetHeader();
+  const size_t line_num = csv_reader.CountLine(csv_reader.GetChunk()) + 1;
+  vector<StringVector*> column_list;
+  column_list.reserve(header.size());
+
+  for(const auto &col : header){
+    auto &string_list = (*csv_data)[col];
+    string_list.reserve(line_num);
+    column_list.emplace_back(&string_list);
+  }
+
+  // CSVデータを1パスで読み込む
+  return csv_reader.ForEachRow(
+    [&column_list](const CSVRow &row){
+      for(size_t i=0, size=row.size(); i<size; i++){
+        column_list[i]->emplace_back(row[i].data(), row[i].size());
+      }
     }
+  );
+}
 
-    while(!file_data.eof())
-    {
-      string line;
-      getline(file_data, line);
+void CSVSplitter(const std::string &line, StringVector * const line_data)
+{
+  assert(line_data != nullptr);
+  assert(line_data->empty());
+  
+  typedef char_separator<char> char_sep;
+  char_sep sep(",", "", keep_empty_tokens);
 
-      if(line_num == 0){
-        // header
-        CSVSplitter(line, &header);
-        line_num++;
-        continue;
-      }
+  tokenizer<char_sep> tokens(line, sep);
+  tokenizer<char_sep>::iterator it = tokens.begin(), it_end = tokens.end();
 
-      if(line.size() == 0){
-        // 空行はスキップする
-        continue;
-      }
+  size_t size = distance(it, it_end);
+  line_data->reserve(size);
 
-      line_num++;
-    }
+  for(; it!=it_end; ++it){
+    line_data->emplace_back(*it);
   }
+}
 
-  // リストサイズを初期化
-  for(const auto col : header){
-    (*csv_data)[col].reserve(line_num);
+MappedCSVReader::MappedCSVReader()
+: data_(nullptr), data_end_(nullptr), projection_size_(0)
+{
+}
+
+const bool MappedCSVReader::Open(const std::string &csv_file)
+{
+  namespace bip = boost::interprocess;
+  Close();
+
+  try{
+    file_mapping_.reset(new bip::file_mapping(csv_file.c_str(), bip::read_only));
+    mapped_region_.reset(new bip::mapped_region(*file_mapping_, bip::read_only));
+  }catch(bip::interprocess_exception &){
+    // 空ファイルはmapできない
+    Close();
+    return false;
   }
 
-  // CSVデータを読み込む
-  ifstream file_data(csv_file.c_str());
-  bool is_header = true;
+  // 先頭から順に読み込むため、OSに先読みを促す
+  mapped_region_->advise(bip::mapped_region::advice_sequential);
 
-  while(!file_data.eof())
-  {
-    string line;
-    getline(file_data, line);
+  const auto data = static_cast<const char*>(mapped_region_->get_address());
 
-    if(is_header){
-      is_header = false;
-      continue;
-    }
+  if(!Attach(data, mapped_region_->get_size())){
+    Close();
+    return false;
+  }
 
-    if(line.size() == 0){
-      // 空行はスキップする
-      continue;
-    }
+  return true;
+}
 
-    StringVector line_data;
-    CSVSplitter(line, &line_data);
+const bool MappedCSVReader::Attach(const char * const data, const size_t data_size)
+{
+  assert(data != nullptr || data_size == 0);
 
-    if(header.size() != line_data.size()){
-      // ヘッダとデータ行の列数が異なる
-      cerr << "Column numbers are not same." << endl;
-      cerr << "\theader num: " << header.size() << endl;
-      cerr << "\tline num: " << line_data.size() << endl;
-      cerr << "\tline data: " << line << endl;
+  if(data_size == 0){
+    return false;
+  }
+
+  const char * const data_end = data + data_size;
+  const char *header_end = static_cast<const char*>(memchr(data, '\n', data_size));
+  const char *data_begin = header_end == nullptr ? data_end : header_end + 1;
+
+  if(header_end == nullptr){
+    header_end = data_end;
+  }
+
+  if(header_end != data && *(header_end - 1) == '\r'){
+    --header_end;
+  }
+
+  header_.clear();
+  CSVSplitter(string(data, header_end), &header_);
+
+  data_ = data_begin;
+  data_end_ = data_end;
+
+  projection_index_list_.resize(header_.size());
+
+  for(size_t i=0, size=header_.size(); i<size; i++){
+    projection_index_list_[i] = i;
+  }
+
+  projection_size_ = header_.size();
+  return true;
+}
+
+void MappedCSVReader::Close()
+{
+  data_ = nullptr;
+  data_end_ = nullptr;
+  header_.clear();
+  projection_index_list_.clear();
+  projection_size_ = 0;
+
+  mapped_region_.reset();
+  file_mapping_.reset();
+}
+
+const bool MappedCSVReader::SetProjection(const StringVector &column_list)
+{
+  vector<size_t> projection_index_list(header_.size(), kNoProjection);
+
+  for(size_t i=0, size=column_list.size(); i<size; i++){
+    const auto it = find(header_.begin(), header_.end(), column_list[i]);
+
+    if(it == header_.end()){
+      cerr << "Column not found: " << column_list[i] << endl;
       return false;
     }
 
-    for(size_t i=0, size=line_data.size(); i<size; i++){
-      const auto col = header[i];
-      (*csv_data)[col].emplace_back(line_data[i]);
-    }
+    projection_index_list[distance(header_.begin(), it)] = i;
   }
 
+  projection_index_list_.swap(projection_index_list);
+  projection_size_ = column_list.size();
+
   return true;
 }
 
-void CSVSplitter(const std::string &line, StringVector * const line_data)
+void MappedCSVReader::SplitChunk(const size_t chunk_count, std::vector<CSVChunk> * const chunk_list) const
 {
-  assert(line_data != nullptr);
-  assert(line_data->empty());
-  
-  typedef char_separator<char> char_sep;
-  char_sep sep(",", "", keep_empty_tokens);
+  assert(chunk_count > 0);
+  assert(chunk_list != nullptr);
 
-  tokenizer<char_sep> tokens(line, sep);
-  tokenizer<char_sep>::iterator it = tokens.begin(), it_end = tokens.end();
+  chunk_list->clear();
 
-  size_t size = distance(it, it_end);
-  line_data->reserve(size);
+  const size_t data_size = data_end_ - data_;
+  const char *chunk_begin = data_;
 
-  for(; it!=it_end; ++it){
-    line_data->emplace_back(*it);
+  for(size_t i=1; i<=chunk_count && chunk_begin < data_end_; i++){
+    const char *chunk_end = data_end_;
+
+    if(i < chunk_count){
+      // 分割位置を含む行の終端までをチャンクとする
+      chunk_end = max(chunk_begin, data_ + data_size * i / chunk_count);
+      const char *line_end = static_cast<const char*>(memchr(chunk_end, '\n', data_end_ - chunk_end));
+      chunk_end = line_end == nullptr ? data_end_ : line_end + 1;
+    }
+
+    chunk_list->emplace_back(CSVChunk{chunk_begin, chunk_end});
+    chunk_begin = chunk_end;
   }
 }
 
+const size_t MappedCSVReader::CountLine(const CSVChunk &chunk) const
+{
+  assert(chunk.begin <= chunk.end);
+  return count(chunk.begin, chunk.end, '\n');
 }
 
+const bool MappedCSVReader::SplitRow(const char * const line_begin, const char * const line_end, CSVRow * const row) const
+{
+  assert(row != nullptr);
+  assert(row->size() == projection_size_);
+
+  const size_t column_num = projection_index_list_.size();
+  const char *field_begin = line_begin;
+
+  for(size_t i=0; i<column_num; i++){
+    const char *field_end = static_cast<const char*>(memchr(field_begin, ',', line_end - field_begin));
+
+    if(field_end == nullptr){
+      if(i + 1 != column_num){
+        // カラムが不足している
+        return false;
+      }
+
+      field_end = line_end;
+    }else if(i + 1 == column_num){
+      // カラムが過剰
+      return false;
+    }
+
+    const size_t projection_index = projection_index_list_[i];
+
+    if(projection_index != kNoProjection){
+      (*row)[projection_index] = boost::string_view(field_begin, field_end - field_begin);
+    }
+
+    field_begin = field_end + 1;
+  }
+
+  return true;
+}
+
+}
@@ -0,0 +1,487 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#include "CSVReader.h"
+#include "MoveList.h"
+#include "GameRecordDB.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+//! @brief 4byte little endianで追記する
+inline void WriteGameRecordFixed32(const uint32_t value, string * const binary)
+{
+  for(size_t i=0; i<4; i++){
+    binary->push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+//! @brief 8byte little endianで追記する
+inline void WriteGameRecordFixed64(const uint64_t value, string * const binary)
+{
+  for(size_t i=0; i<8; i++){
+    binary->push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+//! @brief 8byte little endianの符号なし整数を読み込む
+inline const uint64_t ReadGameRecordFixed64(const char * const data)
+{
+  uint64_t value = 0;
+
+  for(size_t i=0; i<8; i++){
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+  }
+
+  return value;
+}
+
+//! @brief 8byte境界に揃えたサイズを返す
+inline const size_t AlignGameRecordSection(const size_t size)
+{
+  return (size + 7) & ~static_cast<size_t>(7);
+}
+
+//! @brief 8byte境界まで0で埋める
+inline void PadGameRecordSection(string * const binary)
+{
+  binary->resize(AlignGameRecordSection(binary->size()), '\0');
+}
+
+const GameResult GetGameResult(const boost::string_view &result_string)
+{
+  if(result_string == "BlackWin"){
+    return kBlackWin;
+  }else if(result_string == "WhiteWin"){
+    return kWhiteWin;
+  }else if(result_string == "Draw"){
+    return kDraw;
+  }
+
+  return kUnknownResult;
+}
+
+const GameEndStatus GetGameEndStatus(const boost::string_view &end_status_string)
+{
+  if(end_status_string == "Resign"){
+    return kResign;
+  }else if(end_status_string == "Timeup"){
+    return kTimeup;
+  }else if(end_status_string == "AgreedDraw"){
+    return kAgreedDraw;
+  }
+
+  return kUnknownEndStatus;
+}
+
+const uint32_t GetGameDate(const boost::string_view &date_string)
+{
+  constexpr size_t kDateDigit = 8;    // yyyymmdd
+  uint32_t game_date = 0;
+  size_t digit_count = 0;
+
+  for(const auto c : date_string){
+    if('0' <= c && c <= '9'){
+      game_date = 10 * game_date + (c - '0');
+
+      if(++digit_count == kDateDigit){
+        return game_date;
+      }
+    }
+  }
+
+  return 0;
+}
+
+GameRecordDBBuilder::GameRecordDBBuilder()
+{
+  record_offset_list_.emplace_back(0);
+}
+
+void GameRecordDBBuilder::Add(const MoveList &game_record, const GameResult game_result, const GameEndStatus end_status, const std::uint32_t game_date, const std::string &black_player_name, const std::string &white_player_name)
+{
+  assert(move_list_.size() + game_record.size() <= numeric_limits<uint32_t>::max());
+
+  move_list_.insert(move_list_.end(), game_record.begin(), game_record.end());
+  record_offset_list_.emplace_back(static_cast<uint32_t>(move_list_.size()));
+
+  game_result_list_.emplace_back(static_cast<uint8_t>(game_result));
+  end_status_list_.emplace_back(static_cast<uint8_t>(end_status));
+  game_date_list_.emplace_back(game_date);
+  black_player_list_.emplace_back(GetPlayerID(black_player_name));
+  white_player_list_.emplace_back(GetPlayerID(white_player_name));
+}
+
+const uint32_t GameRecordDBBuilder::GetPlayerID(const std::string &player_name)
+{
+  const auto find_it = player_id_map_.find(player_name);
+
+  if(find_it != player_id_map_.end()){
+    return find_it->second;
+  }
+
+  const uint32_t player_id = static_cast<uint32_t>(player_name_list_.size());
+
+  player_name_list_.emplace_back(player_name);
+  player_id_map_.emplace(player_name, player_id);
+
+  return player_id;
+}
+
+void GameRecordDBBuilder::Serialize(std::string * const binary) const
+{
+  assert(binary != nullptr);
+
+  const size_t game_count = size();
+
+  size_t name_size = 0;
+
+  for(const auto &player_name : player_name_list_){
+    name_size += player_name.size();
+  }
+
+  assert(name_size <= numeric_limits<uint32_t>::max());
+
+  binary->clear();
+
+  // ヘッダ
+  binary->append(kGameRecordDBMagic, kGameRecordDBMagicSize);
+  binary->push_back(static_cast<char>(kGameRecordDBVersion));
+  binary->append(3, '\0');
+  WriteGameRecordFixed64(game_count, binary);
+  WriteGameRecordFixed64(move_list_.size(), binary);
+  WriteGameRecordFixed64(player_name_list_.size(), binary);
+  WriteGameRecordFixed64(name_size, binary);
+  assert(binary->size() == kGameRecordDBHeaderSize);
+
+  // 指し手
+  for(const auto offset : record_offset_list_){
+    WriteGameRecordFixed32(offset, binary);
+  }
+
+  PadGameRecordSection(binary);
+  binary->append(reinterpret_cast<const char*>(move_list_.data()), move_list_.size());
+  PadGameRecordSection(binary);
+
+  // 対局情報
+  binary->append(reinterpret_cast<const char*>(game_result_list_.data()), game_count);
+  PadGameRecordSection(binary);
+  binary->append(reinterpret_cast<const char*>(end_status_list_.data()), game_count);
+  PadGameRecordSection(binary);
+
+  for(const auto &column : {&game_date_list_, &black_player_list_, &white_player_list_}){
+    for(const auto value : *column){
+      WriteGameRecordFixed32(value, binary);
+    }
+
+    PadGameRecordSection(binary);
+  }
+
+  // 対局者名
+  uint32_t name_offset = 0;
+  WriteGameRecordFixed32(name_offset, binary);
+
+  for(const auto &player_name : player_name_list_){
+    name_offset += static_cast<uint32_t>(player_name.size());
+    WriteGameRecordFixed32(name_offset, binary);
+  }
+
+  PadGameRecordSection(binary);
+
+  for(const auto &player_name : player_name_list_){
+    binary->append(player_name);
+  }
+}
+
+const bool GameRecordDBBuilder::WriteFile(const std::string &db_file) const
+{
+  string binary;
+  Serialize(&binary);
+
+  ofstream ofs(db_file, ios::binary);
+
+  if(!ofs){
+    cerr << "Failed to open the file: " << db_file << endl;
+    return false;
+  }
+
+  ofs.write(binary.data(), binary.size());
+  return static_cast<bool>(ofs);
+}
+
+const bool GameRecordDBBuilder::AddCSV(const std::string &csv_file, size_t * const skip_count)
+{
+  MappedCSVReader csv_reader;
+
+  if(!csv_reader.Open(csv_file)){
+    cerr << "Failed to open the file: " << csv_file << endl;
+    return false;
+  }
+
+  // 存在するカラムのみ読み込む
+  const StringVector column_list{"game_record", "game_result", "game_end_status", "game_date", "black_player_name", "white_player_name"};
+  const StringVector &header = csv_reader.GetHeader();
+  StringVector projection_list;
+  vector<size_t> projection_index_list(column_list.size(), column_list.size());
+
+  for(size_t i=0, size=column_list.size(); i<size; i++){
+    if(find(header.begin(), header.end(), column_list[i]) == header.end()){
+      continue;
+    }
+
+    projection_index_list[i] = projection_list.size();
+    projection_list.emplace_back(column_list[i]);
+  }
+
+  if(projection_index_list[0] != 0){
+    cerr << "Column not found: " << column_list[0] << endl;
+    return false;
+  }
+
+  csv_reader.SetProjection(projection_list);
+
+  const size_t line_count = csv_reader.CountLine(csv_reader.GetChunk());
+  game_result_list_.reserve(game_result_list_.size() + line_count);
+  end_status_list_.reserve(end_status_list_.size() + line_count);
+  game_date_list_.reserve(game_date_list_.size() + line_count);
+  black_player_list_.reserve(black_player_list_.size() + line_count);
+  white_player_list_.reserve(white_player_list_.size() + line_count);
+  record_offset_list_.reserve(record_offset_list_.size() + line_count);
+
+  size_t skip = 0;
+  MoveList game_record;
+  string record_string, black_player_name, white_player_name;
+
+  const auto get_column = [&projection_index_list](const CSVRow &row, const size_t column_index){
+    const size_t index = projection_index_list[column_index];
+    return index < row.size() ? row[index] : boost::string_view();
+  };
+
+  const bool is_read = csv_reader.ForEachRow(
+    [&](const CSVRow &row){
+      const auto record = get_column(row, 0);
+      record_string.assign(record.data(), record.size());
+      game_record.clear();
+
+      if(!realcore::GetMoveList(record_string, &game_record)){
+        ++skip;
+        return;
+      }
+
+      const auto black_name = get_column(row, 4);
+      const auto white_name = get_column(row, 5);
+      black_player_name.assign(black_name.data(), black_name.size());
+      white_player_name.assign(white_name.data(), white_name.size());
+
+      Add(game_record, GetGameResult(get_column(row, 1)), GetGameEndStatus(get_column(row, 2)), GetGameDate(get_column(row, 3)), black_player_name, white_player_name);
+    }
+  );
+
+  if(skip_count != nullptr){
+    *skip_count = skip;
+  }
+
+  return is_read;
+}
+
+GameRecordDB::GameRecordDB()
+: game_count_(0), move_count_(0), player_count_(0), generation_(0), record_offset_(nullptr), move_data_(nullptr),
+  game_result_(nullptr), end_status_(nullptr), game_date_(nullptr), black_player_(nullptr), white_player_(nullptr),
+  player_name_offset_(nullptr), player_name_(nullptr)
+{
+}
+
+const bool GameRecordDB::Attach(const char * const data, const size_t data_size)
+{
+  assert(data != nullptr || data_size == 0);
+
+  if(data_size < kGameRecordDBHeaderSize){
+    return false;
+  }
+
+  if(memcmp(data, kGameRecordDBMagic, kGameRecordDBMagicSize) != 0 || static_cast<uint8_t>(data[kGameRecordDBMagicSize]) != kGameRecordDBVersion){
+    return false;
+  }
+
+  const uint64_t game_count = ReadGameRecordFixed64(data + 8);
+  const uint64_t move_count = ReadGameRecordFixed64(data + 16);
+  const uint64_t player_count = ReadGameRecordFixed64(data + 24);
+  const uint64_t name_size = ReadGameRecordFixed64(data + 32);
+
+  // 不正な値によるoverflowを避けるため、各セクションはdata_sizeを上限として確認する
+  if(game_count >= data_size || move_count > data_size || player_count >= data_size || name_size > data_size){
+    return false;
+  }
+
+  // 各セクションの開始位置
+  size_t offset = kGameRecordDBHeaderSize;
+  const size_t record_offset = offset;
+  offset = AlignGameRecordSection(offset + 4 * (game_count + 1));
+  const size_t move_data = offset;
+  offset = AlignGameRecordSection(offset + move_count);
+  const size_t game_result = offset;
+  offset = AlignGameRecordSection(offset + game_count);
+  const size_t end_status = offset;
+  offset = AlignGameRecordSection(offset + game_count);
+  const size_t game_date = offset;
+  offset = AlignGameRecordSection(offset + 4 * game_count);
+  const size_t black_player = offset;
+  offset = AlignGameRecordSection(offset + 4 * game_count);
+  const size_t white_player = offset;
+  offset = AlignGameRecordSection(offset + 4 * game_count);
+  const size_t player_name_offset = offset;
+  offset = AlignGameRecordSection(offset + 4 * (player_count + 1));
+  const size_t player_name = offset;
+  offset += name_size;
+
+  if(offset != data_size){
+    return false;
+  }
+
+  // 参照時に範囲外を読まないよう、開始位置とIDの範囲を確認する
+  uint32_t prev_offset = 0;
+
+  for(size_t i=0; i<=game_count; i++){
+    const uint32_t move_offset = ReadFixed32(data + record_offset + 4 * i);
+
+    if(move_offset < prev_offset || (i == 0 && move_offset != 0)){
+      return false;
+    }
+
+    prev_offset = move_offset;
+  }
+
+  if(prev_offset != move_count){
+    return false;
+  }
+
+  prev_offset = 0;
+
+  for(size_t i=0; i<=player_count; i++){
+    const uint32_t name_offset = ReadFixed32(data + player_name_offset + 4 * i);
+
+    if(name_offset < prev_offset || (i == 0 && name_offset != 0)){
+      return false;
+    }
+
+    prev_offset = name_offset;
+  }
+
+  if(prev_offset != name_size){
+    return false;
+  }
+
+  for(size_t i=0; i<game_count; i++){
+    if(ReadFixed32(data + black_player + 4 * i) >= player_count || ReadFixed32(data + white_player + 4 * i) >= player_count){
+      return false;
+    }
+  }
+
+  // 不正な指し手がBoard::MakeMoveに渡らないよう、指し手は盤内の位置かパスのみとする
+  array<bool, 256> is_valid_move_table;
+
+  for(size_t i=0; i<is_valid_move_table.size(); i++){
+    is_valid_move_table[i] = IsValidMove(static_cast<MovePosition>(i));
+  }
+
+  const auto move_begin = reinterpret_cast<const uint8_t*>(data + move_data);
+
+  if(!all_of(move_begin, move_begin + move_count, [&is_valid_move_table](const uint8_t move){ return is_valid_move_table[move]; })){
+    return false;
+  }
+
+  game_count_ = game_count;
+  move_count_ = move_count;
+  player_count_ = player_count;
+  generation_++;
+
+  record_offset_ = data + record_offset;
+  move_data_ = reinterpret_cast<const MovePosition*>(data + move_data);
+  game_result_ = data + game_result;
+  end_status_ = data + end_status;
+  game_date_ = data + game_date;
+  black_player_ = data + black_player;
+  white_player_ = data + white_player;
+  player_name_offset_ = data + player_name_offset;
+  player_name_ = data + player_name;
+
+  return true;
+}
+
+const bool GameRecordDB::Open(const std::string &db_file)
+{
+  namespace bip = boost::interprocess;
+  Close();
+
+  try{
+    file_mapping_.reset(new bip::file_mapping(db_file.c_str(), bip::read_only));
+    mapped_region_.reset(new bip::mapped_region(*file_mapping_, bip::read_only));
+  }catch(bip::interprocess_exception &){
+    Close();
+    return false;
+  }
+
+  const auto data = static_cast<const char*>(mapped_region_->get_address());
+
+  if(!Attach(data, mapped_region_->get_size())){
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+const bool GameRecordDB::Load(const std::string &db_file)
+{
+  if(Open(db_file)){
+    return true;
+  }
+
+  GameRecordDBBuilder builder;
+  size_t skip_count = 0;
+
+  if(!builder.AddCSV(db_file, &skip_count)){
+    return false;
+  }
+
+  if(skip_count > 0){
+    cerr << "Skipped game records: " << skip_count << endl;
+  }
+
+  string binary;
+  builder.Serialize(&binary);
+  binary_.swap(binary);
+
+  return Attach(binary_.data(), binary_.size());
+}
+
+void GameRecordDB::Close()
+{
+  game_count_ = 0;
+  move_count_ = 0;
+  player_count_ = 0;
+  generation_++;
+
+  record_offset_ = nullptr;
+  move_data_ = nullptr;
+  game_result_ = nullptr;
+  end_status_ = nullptr;
+  game_date_ = nullptr;
+  black_player_ = nullptr;
+  white_player_ = nullptr;
+  player_name_offset_ = nullptr;
+  player_name_ = nullptr;
+
+  binary_.clear();
+  mapped_region_.reset();
+  file_mapping_.reset();
+}
+
+}   // namespace realcore
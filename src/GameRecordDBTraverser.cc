@@ -0,0 +1,134 @@
+#include <algorithm>
+
+#include "GameRecordDBTraverser.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+GameRecordDBTraverser::GameRecordDBTraverser(const GameRecordDB &game_record_db, const size_t thread_num, const UpdateOpenStateFlag &update_flag)
+: game_record_db_(game_record_db), thread_num_(thread_num), chunk_size_(kDefaultTraverseChunkSize), is_unique_position_(false),
+  is_end_position_(true), search_manager_(nullptr), is_first_game_list_built_(false), first_game_list_generation_(0),
+  processed_game_count_(0)
+{
+  assert(thread_num > 0);
+  board_list_.reserve(thread_num);
+
+  for(size_t i=0; i<thread_num; i++){
+    board_list_.emplace_back(new Board(update_flag));
+  }
+}
+
+void GameRecordDBTraverser::SetChunkSize(const size_t chunk_size)
+{
+  assert(chunk_size > 0);
+  chunk_size_ = chunk_size;
+}
+
+void GameRecordDBTraverser::SetUniquePosition(const bool is_unique_position)
+{
+  is_unique_position_ = is_unique_position;
+}
+
+void GameRecordDBTraverser::SetEndPosition(const bool is_end_position)
+{
+  if(is_end_position_ != is_end_position){
+    // 終局図を含めるかで局面が最初に現れる棋譜が変わるため求め直す
+    is_first_game_list_built_ = false;
+  }
+
+  is_end_position_ = is_end_position;
+}
+
+void GameRecordDBTraverser::SetSearchManager(SharedSearchManager * const search_manager)
+{
+  assert(search_manager == nullptr || search_manager->GetThreadNum() >= thread_num_);
+  search_manager_ = search_manager;
+}
+
+const bool GameRecordDBTraverser::BuildFirstGameList()
+{
+  if(IsFirstGameListBuilt()){
+    return true;
+  }
+
+  typedef vector<pair<HashValue, uint32_t>> FirstGameList;
+
+  // チャンクごとに(ハッシュ値, 棋譜index)を整列して局面ごとに最小の棋譜indexを残す
+  const auto chunk_function = [this](const size_t worker_index, const size_t game_begin, const size_t game_end, FirstGameList * const chunk_list){
+    for(size_t game_index=game_begin; game_index<game_end; game_index++){
+      if(IsTerminate(worker_index)){
+        return false;
+      }
+
+      const GameRecordView game_record = game_record_db_.GetGameRecord(game_index);
+      MoveList move_list;
+      HashValue hash_value = 0;
+
+      for(const auto move : game_record){
+        chunk_list->emplace_back(hash_value, game_index);
+
+        const bool is_black_turn = move_list.IsBlackTurn();
+        move_list += move;
+
+        hash_value = move != kNullMove ? CalcHashValue(is_black_turn, move, hash_value) : CalcHashValue(move_list);
+      }
+
+      if(is_end_position_){
+        chunk_list->emplace_back(hash_value, game_index);
+      }
+    }
+
+    sort(chunk_list->begin(), chunk_list->end());
+    chunk_list->erase(unique(chunk_list->begin(), chunk_list->end(), [](const pair<HashValue, uint32_t> &lhs, const pair<HashValue, uint32_t> &rhs){
+      return lhs.first == rhs.first;
+    }), chunk_list->end());
+
+    return true;
+  };
+
+  const auto reduce = [](FirstGameList * const first_game_list, const FirstGameList &chunk_list){
+    first_game_list->insert(first_game_list->end(), chunk_list.begin(), chunk_list.end());
+  };
+
+  FirstGameList first_game_list;
+
+  if(!RunChunk(chunk_function, reduce, &first_game_list)){
+    processed_game_count_ = 0;
+    return false;
+  }
+
+  sort(first_game_list.begin(), first_game_list.end());
+  first_game_list.erase(unique(first_game_list.begin(), first_game_list.end(), [](const pair<HashValue, uint32_t> &lhs, const pair<HashValue, uint32_t> &rhs){
+    return lhs.first == rhs.first;
+  }), first_game_list.end());
+
+  first_game_list.shrink_to_fit();
+  first_game_list_.swap(first_game_list);
+
+  is_first_game_list_built_ = true;
+  first_game_list_generation_ = game_record_db_.GetGeneration();
+
+  return true;
+}
+
+const bool GameRecordDBTraverser::IsFirstGameListBuilt() const
+{
+  if(!is_first_game_list_built_){
+    return false;
+  }
+
+  // 棋譜DBを開き直した場合は求め直す
+  return first_game_list_generation_ == game_record_db_.GetGeneration();
+}
+
+const size_t GameRecordDBTraverser::GetFirstGameIndex(const HashValue hash_value) const
+{
+  const auto find_it = lower_bound(first_game_list_.begin(), first_game_list_.end(), make_pair(hash_value, static_cast<uint32_t>(0)));
+
+  assert(find_it != first_game_list_.end() && find_it->first == hash_value);
+  return find_it->second;
+}
+
+}   // namespace realcore
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include "GameRecordDB.h"
+#include "WorkStealingScheduler.h"
+#include "POSFileBatch.h"
+#include "GameRecordImporter.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+//! @brief 1回の並列読込で扱うファイル数の既定値
+static constexpr size_t kDefaultImportBatchSize = 4096;
+
+GameRecordImporter::GameRecordImporter(const size_t thread_num, const SGFCheckBit &check_bit)
+: thread_num_(thread_num), check_bit_(check_bit), batch_size_(kDefaultImportBatchSize)
+{
+  assert(thread_num > 0);
+}
+
+void GameRecordImporter::EnumerateGameRecordFile(const std::string &path, std::vector<std::string> * const file_list)
+{
+  assert(file_list != nullptr);
+
+  const auto is_game_record_file = [](const boost::filesystem::path &file_path){
+    string extension = file_path.extension().string();
+    transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    return boost::filesystem::is_regular_file(file_path) && (extension == ".sgf" || extension == ".pos");
+  };
+
+  boost::system::error_code error_code;
+  vector<string> enumerated_list;
+
+  if(boost::filesystem::is_directory(path, error_code)){
+    for(boost::filesystem::recursive_directory_iterator it(path, error_code), it_end; it!=it_end; it.increment(error_code)){
+      if(error_code){
+        break;
+      }
+
+      if(is_game_record_file(it->path())){
+        enumerated_list.emplace_back(it->path().string());
+      }
+    }
+  }else if(is_game_record_file(path)){
+    enumerated_list.emplace_back(path);
+  }
+
+  // ディレクトリの走査順に依存せず同一の棋譜DBを生成するためパス順にする
+  sort(enumerated_list.begin(), enumerated_list.end());
+  file_list->insert(file_list->end(), enumerated_list.begin(), enumerated_list.end());
+}
+
+void GameRecordImporter::Import(const std::vector<std::string> &file_list, GameRecordDBBuilder * const builder)
+{
+  assert(builder != nullptr);
+
+  WorkStealingScheduler scheduler(thread_num_);
+  vector<ImportedGameRecord> batch_record_list;
+
+  for(size_t batch_begin=0, file_count=file_list.size(); batch_begin<file_count; batch_begin+=batch_size_){
+    const size_t batch_end = min(batch_begin + batch_size_, file_count);
+
+    // 並列に読み込む
+    batch_record_list.clear();
+    batch_record_list.resize(batch_end - batch_begin);
+
+    for(size_t i=batch_begin; i<batch_end; i++){
+      const size_t record_index = i - batch_begin;
+
+      scheduler.Push(record_index % thread_num_, [this, &file_list, &batch_record_list, i, record_index](const size_t worker_index){
+        ReadGameRecordFile(file_list[i], &batch_record_list[record_index]);
+      });
+    }
+
+    scheduler.Run();
+
+    // ファイルリスト順に追加する
+    for(auto &game_record : batch_record_list){
+      stats_.file_count++;
+      stats_.byte_count += game_record.byte_count;
+
+      if(!game_record.is_valid){
+        stats_.error_count++;
+        continue;
+      }
+
+      if(!hash_value_set_.insert(game_record.hash_value).second){
+        stats_.duplicate_count++;
+        continue;
+      }
+
+      builder->Add(game_record.game_record, game_record.game_result, game_record.end_status, game_record.game_date, game_record.black_player_name, game_record.white_player_name);
+      stats_.imported_count++;
+    }
+  }
+}
+
+void GameRecordImporter::ReadGameRecordFile(const std::string &file_path, ImportedGameRecord * const game_record) const
+{
+  assert(game_record != nullptr);
+
+  string extension = boost::filesystem::path(file_path).extension().string();
+  transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+  if(extension == ".pos"){
+    ReadPOSGameRecordFile(file_path, game_record);
+  }else{
+    ReadSGFFile(file_path, game_record);
+  }
+
+  if(game_record->is_valid){
+    game_record->hash_value = CalcSymmetricHashValue(game_record->game_record);
+  }
+}
+
+void GameRecordImporter::ReadSGFFile(const std::string &file_path, ImportedGameRecord * const game_record) const
+{
+  assert(game_record != nullptr);
+
+  ifstream sgf_file(file_path, ios::in | ios::binary);
+
+  if(!sgf_file){
+    return;
+  }
+
+  const string sgf_data((istreambuf_iterator<char>(sgf_file)), istreambuf_iterator<char>());
+  game_record->byte_count = sgf_data.size();
+
+  SGFParser sgf_parser(check_bit_);
+
+  try{
+    sgf_parser.ParseSGF(sgf_data);
+  }catch(logic_error &ex){
+    return;
+  }
+
+  if(!GetMoveList(sgf_parser.GetGameRecord(), &game_record->game_record)){
+    return;
+  }
+
+  game_record->game_result = sgf_parser.GetGameResult();
+  game_record->end_status = sgf_parser.GetEndStatus();
+  game_record->game_date = GetGameDate(sgf_parser.GetGameDate());
+  game_record->black_player_name = sgf_parser.GetBlackPlayerName();
+  game_record->white_player_name = sgf_parser.GetWhitePlayerName();
+  game_record->is_valid = true;
+}
+
+void GameRecordImporter::ReadPOSGameRecordFile(const std::string &file_path, ImportedGameRecord * const game_record) const
+{
+  assert(game_record != nullptr);
+
+  // 途中で切れたファイルや盤外の指し手を含むファイル、指し手のない棋譜はエラーとする
+  vector<MovePosition> move_list;
+
+  if(!POSFileBatch::DecodePOSFile(file_path, &move_list) || move_list.empty()){
+    return;
+  }
+
+  // 手数(1byte) + 指し手(1byte/手)
+  game_record->byte_count = move_list.size() + 1;
+  game_record->game_record.ReserveInitial(move_list.size());
+
+  for(const auto move : move_list){
+    game_record->game_record += move;
+  }
+
+  game_record->is_valid = true;
+}
+
+}   // namespace realcore
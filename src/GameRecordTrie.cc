@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include "GameRecordDB.h"
+#include "GameRecordTrie.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+GameRecordTrie::GameRecordTrie()
+: move_tree_(kNoChildIndex), replay_position_count_(0)
+{
+  game_count_list_.emplace_back(0);
+  end_count_list_.emplace_back(0);
+}
+
+void GameRecordTrie::Build(const GameRecordDB &game_record_db)
+{
+  const size_t game_count = game_record_db.size();
+
+  move_tree_.clear();
+  game_count_list_.assign(1, 0);
+  end_count_list_.assign(1, 0);
+  replay_position_count_ = 0;
+
+  // 指し手列の辞書順に並べると共通の手順を持つ棋譜が連続する
+  sorted_game_list_.resize(game_count);
+  iota(sorted_game_list_.begin(), sorted_game_list_.end(), 0);
+
+  sort(sorted_game_list_.begin(), sorted_game_list_.end(), [&game_record_db](const uint32_t lhs, const uint32_t rhs){
+    const GameRecordView lhs_record = game_record_db.GetGameRecord(lhs);
+    const GameRecordView rhs_record = game_record_db.GetGameRecord(rhs);
+    const size_t compare_size = min(lhs_record.size(), rhs_record.size());
+    const int compare_result = compare_size == 0 ? 0 : memcmp(lhs_record.begin(), rhs_record.begin(), compare_size);
+
+    if(compare_result != 0){
+      return compare_result < 0;
+    }
+
+    return lhs_record.size() != rhs_record.size() ? lhs_record.size() < rhs_record.size() : lhs < rhs;
+  });
+
+  // 直前の棋譜との共通の手順までノードを戻り、以降の指し手を子ノードとして追加する
+  // @note 辞書順に登録するため、追加する指し手は常に新しい子ノードとなり、兄弟ノードは指し手の昇順に並ぶ
+  vector<MoveNodeIndex> path_node_list(1, kRootNodeIndex);
+  GameRecordView previous_record;
+
+  for(const auto game_index : sorted_game_list_){
+    const GameRecordView game_record = game_record_db.GetGameRecord(game_index);
+    const size_t record_size = game_record.size();
+    const size_t compare_size = min(record_size, previous_record.size());
+    size_t common_size = 0;
+
+    while(common_size < compare_size && game_record[common_size] == previous_record[common_size]){
+      common_size++;
+    }
+
+    path_node_list.resize(common_size + 1);
+    move_tree_.MoveNode(path_node_list.back());
+
+    for(size_t i=common_size; i<record_size; i++){
+      move_tree_.AddChild(game_record[i]);
+
+      const auto child_node_index = static_cast<MoveNodeIndex>(move_tree_.size());
+      move_tree_.MoveNode(child_node_index);
+      path_node_list.emplace_back(child_node_index);
+
+      end_count_list_.emplace_back(0);
+    }
+
+    end_count_list_[path_node_list.back()]++;
+    replay_position_count_ += record_size + 1;
+    previous_record = game_record;
+  }
+
+  move_tree_.MoveRootNode();
+
+  // 子ノードは親ノードより後に追加しているため、逆順に親ノードへ棋譜数を加算する
+  const auto &node_list = move_tree_.GetMoveTreeNodeList();
+  game_count_list_ = end_count_list_;
+
+  for(size_t node_index=game_count_list_.size() - 1; node_index>0; node_index--){
+    game_count_list_[node_list[node_index].GetParentIndex()] += game_count_list_[node_index];
+  }
+}
+
+}   // namespace realcore
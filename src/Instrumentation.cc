@@ -0,0 +1,136 @@
+#include <cassert>
+#include <algorithm>
+#include <sstream>
+
+#include "Instrumentation.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+const char* GetInstrumentOperationName(const InstrumentOperation operation)
+{
+  switch(operation){
+  case kInstrumentMakeMove:
+    return "MakeMove";
+  case kInstrumentUndoMove:
+    return "UndoMove";
+  case kInstrumentBoardOpenState:
+    return "BoardOpenState";
+  case kInstrumentIsForbiddenMove:
+    return "IsForbiddenMove";
+  case kInstrumentHashTableProbe:
+    return "HashTableProbe";
+  case kInstrumentHashTableHit:
+    return "HashTableHit";
+  case kInstrumentEnumerateFourMoves:
+    return "EnumerateFourMoves";
+  default:
+    assert(false);
+    return "";
+  }
+}
+
+const char* GetCycleCounterUnit()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return "tsc";
+#else
+  return "ns";
+#endif
+}
+
+InstrumentationSnapshot::InstrumentationSnapshot()
+{
+}
+
+void InstrumentationSnapshot::Merge(const InstrumentationSnapshot &snapshot)
+{
+  for(size_t i=0; i<kInstrumentOperationNum; i++){
+    OperationStatistics &statistics = statistics_list_[i];
+    const OperationStatistics &merge_statistics = snapshot.statistics_list_[i];
+
+    statistics.count += merge_statistics.count;
+    statistics.total_cycle += merge_statistics.total_cycle;
+    statistics.max_cycle = max(statistics.max_cycle, merge_statistics.max_cycle);
+
+    for(size_t bin=0; bin<kCycleHistogramBinNum; bin++){
+      statistics.cycle_histogram[bin] += merge_statistics.cycle_histogram[bin];
+    }
+  }
+}
+
+void InstrumentationSnapshot::clear()
+{
+  statistics_list_.fill(OperationStatistics());
+}
+
+string InstrumentationSnapshot::GetJSON() const
+{
+  stringstream ss;
+
+  ss << "{\"enabled\":" << (kInstrumentationEnabled ? "true" : "false") << ",";
+  ss << "\"cycle_unit\":\"" << GetCycleCounterUnit() << "\",";
+  ss << "\"operations\":[";
+
+  for(size_t i=0; i<kInstrumentOperationNum; i++){
+    const auto operation = static_cast<InstrumentOperation>(i);
+    const OperationStatistics &statistics = statistics_list_[i];
+
+    if(i != 0){
+      ss << ",";
+    }
+
+    ss << "{\"name\":\"" << GetInstrumentOperationName(operation) << "\",";
+    ss << "\"count\":" << statistics.count << ",";
+    ss << "\"total_cycle\":" << statistics.total_cycle << ",";
+    ss << "\"max_cycle\":" << statistics.max_cycle << ",";
+    ss << "\"cycle_histogram\":[";
+
+    for(size_t bin=0; bin<kCycleHistogramBinNum; bin++){
+      if(bin != 0){
+        ss << ",";
+      }
+
+      ss << statistics.cycle_histogram[bin];
+    }
+
+    ss << "]}";
+  }
+
+  ss << "]}";
+
+  return ss.str();
+}
+
+string InstrumentationSnapshot::GetCSV() const
+{
+  stringstream ss;
+
+  ss << "operation,count,total_cycle,max_cycle";
+
+  for(size_t bin=0; bin<kCycleHistogramBinNum; bin++){
+    ss << ",bin_" << bin;
+  }
+
+  ss << endl;
+
+  for(size_t i=0; i<kInstrumentOperationNum; i++){
+    const auto operation = static_cast<InstrumentOperation>(i);
+    const OperationStatistics &statistics = statistics_list_[i];
+
+    ss << GetInstrumentOperationName(operation) << ",";
+    ss << statistics.count << "," << statistics.total_cycle << "," << statistics.max_cycle;
+
+    for(size_t bin=0; bin<kCycleHistogramBinNum; bin++){
+      ss << "," << statistics.cycle_histogram[bin];
+    }
+
+    ss << endl;
+  }
+
+  return ss.str();
+}
+
+}   // namespace realcore
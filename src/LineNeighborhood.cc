@@ -14,38 +14,31 @@ namespace realcore
 LineNeighborhood::LineNeighborhood(const MovePosition move, const size_t distance, const BitBoard &bit_board)
 : local_bit_board_{{0}}, move_(move), distance_(distance)
 {
-  std::array<StateBit, kBoardDirectionNum> line_neighborhood;
-
   switch(distance){
   case 1:
-    bit_board.GetLineNeighborhoodStateBit<1>(move, &line_neighborhood);
+    bit_board.GetLocalBitBoard<1>(move, &local_bit_board_);
     break;
   case 2:
-    bit_board.GetLineNeighborhoodStateBit<2>(move, &line_neighborhood);
+    bit_board.GetLocalBitBoard<2>(move, &local_bit_board_);
     break;
   case 3:
-    bit_board.GetLineNeighborhoodStateBit<3>(move, &line_neighborhood);
+    bit_board.GetLocalBitBoard<3>(move, &local_bit_board_);
     break;
   case 4:
-    bit_board.GetLineNeighborhoodStateBit<4>(move, &line_neighborhood);
+    bit_board.GetLocalBitBoard<4>(move, &local_bit_board_);
     break;
   case 5:
-    bit_board.GetLineNeighborhoodStateBit<5>(move, &line_neighborhood);
+    bit_board.GetLocalBitBoard<5>(move, &local_bit_board_);
     break;
   case 6:
-    bit_board.GetLineNeighborhoodStateBit<6>(move, &line_neighborhood);
+    bit_board.GetLocalBitBoard<6>(move, &local_bit_board_);
     break;
   case 7:
-    bit_board.GetLineNeighborhoodStateBit<7>(move, &line_neighborhood);
+    bit_board.GetLocalBitBoard<7>(move, &local_bit_board_);
     break;
   default:
     assert(false);
   }
-
-  local_bit_board_[0] |= line_neighborhood[kLateralDirection];
-  local_bit_board_[0] |= line_neighborhood[kVerticalDirection] << 32ULL;
-  local_bit_board_[1] |= line_neighborhood[kLeftDiagonalDirection];
-  local_bit_board_[1] |= line_neighborhood[kRightDiagonalDirection] << 32ULL;
 }
 
 const ForbiddenCheckState LineNeighborhood::ForbiddenCheck(std::vector<BoardPosition> * const next_open_four_list) const
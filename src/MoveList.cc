@@ -253,23 +253,36 @@ void ReadPOSFile(const std::string &pos_file_path, MoveList * const move_list)
     return;
   }
 
-  pos_file.seekg(0, ios::end);
-  const size_t size = pos_file.tellg();
-  pos_file.seekg(0, ios::beg);
+  // POSファイルは高々226byteのためスタック上のバッファで読み込み、ヒープ確保やシークは行わない
+  // 先頭1byteは手数のため読み飛ばす
+  static constexpr size_t kBufferSize = 256;
+  array<char, kBufferSize> buffer;
+  bool is_header = true;
 
-  char *buffer = new char[size];
-  pos_file.read(buffer, size);
+  move_list->ReserveInitial(kInBoardMoveNum);
 
-  for(size_t i=1; i<size; i++){
-    const unsigned char val = static_cast<unsigned char>(buffer[i]);
-    const Cordinate x = static_cast<Cordinate>(val % kBoardLineNum + 1);
-    const Cordinate y = static_cast<Cordinate>(val / kBoardLineNum + 1);
+  while(pos_file){
+    pos_file.read(buffer.data(), kBufferSize);
+    const size_t read_size = static_cast<size_t>(pos_file.gcount());
 
-    const auto move = GetMove(x, y);
-    *move_list += move;
+    for(size_t i=is_header ? 1 : 0; i<read_size; i++){
+      *move_list += GetPOSMove(static_cast<unsigned char>(buffer[i]));
+    }
+
+    is_header &= read_size == 0;
   }
+}
 
-  delete [] buffer;
+void MoveListView::GetMoveList(MoveList * const move_list) const
+{
+  assert(move_list != nullptr);
+
+  move_list->clear();
+  move_list->ReserveInitial(move_count_);
+
+  for(const auto move : *this){
+    *move_list += move;
+  }
 }
 
 }   // namespace realcore
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "MoveTreeSerializer.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+void WriteVarint(const uint64_t value, string * const binary)
+{
+  assert(binary != nullptr);
+
+  uint64_t rest = value;
+
+  while(rest >= 0x80){
+    binary->push_back(static_cast<char>((rest & 0x7F) | 0x80));
+    rest >>= 7;
+  }
+
+  binary->push_back(static_cast<char>(rest));
+}
+
+const bool ReadVarint(const char ** const data, const char * const data_end, uint64_t * const value)
+{
+  assert(data != nullptr);
+  assert(value != nullptr);
+
+  uint64_t read_value = 0;
+  const char *p = *data;
+
+  for(size_t shift=0; shift<64; shift+=7){
+    if(p >= data_end){
+      return false;
+    }
+
+    const uint64_t byte = static_cast<uint8_t>(*p++);
+    read_value |= (byte & 0x7F) << shift;
+
+    if((byte & 0x80) == 0){
+      *data = p;
+      *value = read_value;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void WriteFixed64(const uint64_t value, string * const binary)
+{
+  assert(binary != nullptr);
+
+  for(size_t i=0; i<8; i++){
+    binary->push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+const uint64_t ReadFixed64(const char * const data)
+{
+  uint64_t value = 0;
+
+  for(size_t i=0; i<8; i++){
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+  }
+
+  return value;
+}
+
+void MoveTreeDataCodec<EmptyAditionalData>::Encode(const EmptyAditionalData &additional_data, string * const binary)
+{
+}
+
+const bool MoveTreeDataCodec<EmptyAditionalData>::Decode(const char ** const data, const char * const data_end, EmptyAditionalData * const additional_data)
+{
+  return true;
+}
+
+void MoveTreeDataCodec<string>::Encode(const string &additional_data, string * const binary)
+{
+  assert(binary != nullptr);
+
+  WriteVarint(additional_data.size(), binary);
+  binary->append(additional_data);
+}
+
+const bool MoveTreeDataCodec<string>::Decode(const char ** const data, const char * const data_end, string * const additional_data)
+{
+  assert(data != nullptr);
+  assert(additional_data != nullptr);
+
+  uint64_t length = 0;
+
+  if(!ReadVarint(data, data_end, &length)){
+    return false;
+  }
+
+  if(length > static_cast<uint64_t>(data_end - *data)){
+    return false;
+  }
+
+  additional_data->assign(*data, length);
+  *data += length;
+
+  return true;
+}
+
+}   // namespace realcore
@@ -0,0 +1,446 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#include "GameRecordDB.h"
+#include "WorkStealingScheduler.h"
+#include "OpeningBook.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+//! @brief 1タスクで集計する棋譜数
+static constexpr size_t kOpeningBookTaskSize = 1024;
+
+//! @brief 集計時の分割数(SymmetricHash値の上位8bitで分割する)
+static constexpr size_t kOpeningBookPartitionNum = 256;
+
+//! @brief 局面データの局面ごとの語数
+static constexpr size_t kOpeningBookPositionWordNum = 5;
+
+//! @brief 局面データの次の一手ごとの語数
+static constexpr size_t kOpeningBookMoveWordNum = 5;
+
+//! @brief 棋譜の1局面分の集計単位
+struct OpeningBookItem
+{
+  HashValue hash_value;       //!< 局面のSymmetricHash値
+  MovePosition next_move;     //!< 正規形の局面での次の一手(終局面はkInvalidMove)
+  GameResult game_result;     //!< 対局結果
+};
+
+//! @brief 4byte little endianで追記する
+inline void WriteOpeningBookFixed32(const uint32_t value, string * const binary)
+{
+  for(size_t i=0; i<4; i++){
+    binary->push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+//! @brief 8byte little endianで追記する
+inline void WriteOpeningBookFixed64(const uint64_t value, string * const binary)
+{
+  for(size_t i=0; i<8; i++){
+    binary->push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+//! @brief 対局結果の集計を追記する
+inline void WriteOpeningBookStats(const OpeningBookStats &stats, string * const binary)
+{
+  WriteOpeningBookFixed32(stats.game_count, binary);
+  WriteOpeningBookFixed32(stats.black_win_count, binary);
+  WriteOpeningBookFixed32(stats.white_win_count, binary);
+  WriteOpeningBookFixed32(stats.draw_count, binary);
+}
+
+OpeningBookBuilder::OpeningBookBuilder()
+: max_depth_(numeric_limits<size_t>::max()), min_game_count_(1), game_count_(0)
+{
+}
+
+void OpeningBookBuilder::Build(const GameRecordDB &game_record_db, const size_t thread_num)
+{
+  assert(thread_num > 0);
+
+  const size_t game_count = game_record_db.size();
+  const size_t task_count = (game_count + kOpeningBookTaskSize - 1) / kOpeningBookTaskSize;
+
+  game_count_ = game_count;
+  position_list_.clear();
+  move_list_.clear();
+
+  // 棋譜ごとの全局面をワーカーごと・SymmetricHash値の上位8bitごとに振り分ける
+  vector<vector<vector<OpeningBookItem>>> item_list(thread_num, vector<vector<OpeningBookItem>>(kOpeningBookPartitionNum));
+  WorkStealingScheduler scheduler(thread_num);
+
+  for(size_t task_index=0; task_index<task_count; task_index++){
+    scheduler.Push(task_index % thread_num, [this, &game_record_db, &item_list, task_index, game_count](const size_t worker_index){
+      const size_t task_begin = task_index * kOpeningBookTaskSize;
+      const size_t task_end = min(task_begin + kOpeningBookTaskSize, game_count);
+      vector<vector<OpeningBookItem>> &partition_list = item_list[worker_index];
+
+      for(size_t i=task_begin; i<task_end; i++){
+        const GameRecordView game_record = game_record_db.GetGameRecord(i);
+        const GameResult game_result = game_record_db.GetGameResult(i);
+        SymmetricHashState hash_state;
+
+        for(size_t depth=0; ; depth++){
+          const bool has_next_move = depth < game_record.size();
+
+          OpeningBookItem item;
+          item.hash_value = hash_state.GetSymmetricHashValue();
+          item.next_move = has_next_move ? hash_state.GetCanonicalMove(game_record[depth]) : kInvalidMove;
+          item.game_result = game_result;
+
+          partition_list[item.hash_value >> 56].emplace_back(item);
+
+          if(!has_next_move || depth == max_depth_){
+            break;
+          }
+
+          hash_state.Play(game_record[depth]);
+        }
+      }
+    });
+  }
+
+  scheduler.Run();
+
+  // 分割ごとにSymmetricHash値, 次の一手の順に整列して集計する
+  vector<vector<PositionRecord>> partition_position_list(kOpeningBookPartitionNum);
+  vector<vector<OpeningBookMove>> partition_move_list(kOpeningBookPartitionNum);
+
+  for(size_t partition=0; partition<kOpeningBookPartitionNum; partition++){
+    scheduler.Push(partition % thread_num, [this, &item_list, &partition_position_list, &partition_move_list, partition, thread_num](const size_t worker_index){
+      vector<OpeningBookItem> partition_item_list;
+
+      for(size_t worker=0; worker<thread_num; worker++){
+        vector<OpeningBookItem> &worker_item_list = item_list[worker][partition];
+        partition_item_list.insert(partition_item_list.end(), worker_item_list.begin(), worker_item_list.end());
+        vector<OpeningBookItem>().swap(worker_item_list);
+      }
+
+      sort(partition_item_list.begin(), partition_item_list.end(), [](const OpeningBookItem &lhs, const OpeningBookItem &rhs){
+        return lhs.hash_value != rhs.hash_value ? lhs.hash_value < rhs.hash_value : lhs.next_move < rhs.next_move;
+      });
+
+      vector<PositionRecord> &position_list = partition_position_list[partition];
+      vector<OpeningBookMove> &move_list = partition_move_list[partition];
+
+      for(size_t position_begin=0, item_count=partition_item_list.size(); position_begin<item_count; ){
+        const HashValue hash_value = partition_item_list[position_begin].hash_value;
+
+        PositionRecord position_record;
+        position_record.hash_value = hash_value;
+        position_record.move_begin = move_list.size();
+
+        size_t i = position_begin;
+
+        while(i < item_count && partition_item_list[i].hash_value == hash_value){
+          const OpeningBookItem &item = partition_item_list[i];
+          position_record.stats.Add(item.game_result);
+
+          if(item.next_move != kInvalidMove){
+            if(move_list.size() == position_record.move_begin || move_list.back().move != item.next_move){
+              OpeningBookMove book_move;
+              book_move.move = item.next_move;
+              move_list.emplace_back(book_move);
+            }
+
+            move_list.back().stats.Add(item.game_result);
+          }
+
+          i++;
+        }
+
+        position_begin = i;
+
+        if(position_record.stats.game_count < min_game_count_){
+          move_list.resize(position_record.move_begin);
+          continue;
+        }
+
+        position_record.move_count = move_list.size() - position_record.move_begin;
+
+        // 次の一手は対局数の降順(同数は指し手の昇順)に並べる
+        stable_sort(move_list.begin() + position_record.move_begin, move_list.end(), [](const OpeningBookMove &lhs, const OpeningBookMove &rhs){
+          return lhs.stats.game_count > rhs.stats.game_count;
+        });
+
+        position_list.emplace_back(position_record);
+      }
+    });
+  }
+
+  scheduler.Run();
+
+  // 分割ごとの集計を連結する(上位8bitで分割しているため連結後もSymmetricHash値の昇順になる)
+  for(size_t partition=0; partition<kOpeningBookPartitionNum; partition++){
+    const size_t move_offset = move_list_.size();
+
+    for(auto position_record : partition_position_list[partition]){
+      position_record.move_begin += move_offset;
+      position_list_.emplace_back(position_record);
+    }
+
+    move_list_.insert(move_list_.end(), partition_move_list[partition].begin(), partition_move_list[partition].end());
+  }
+}
+
+void OpeningBookBuilder::Serialize(std::string * const binary) const
+{
+  assert(binary != nullptr);
+
+  const size_t position_count = position_list_.size();
+  const size_t record_word_count = kOpeningBookPositionWordNum * position_count + kOpeningBookMoveWordNum * move_list_.size();
+
+  assert(record_word_count < kOpeningBookEmptySlot);
+
+  // 充填率が1/2以下となる2のべき乗のスロット数
+  size_t slot_count = 1;
+
+  while(slot_count < 2 * position_count){
+    slot_count *= 2;
+  }
+
+  // オープンアドレス法(線形探索)で局面データの開始位置をスロットに割り当てる
+  vector<HashValue> slot_hash_list(slot_count, 0);
+  vector<uint32_t> slot_offset_list(slot_count, kOpeningBookEmptySlot);
+  uint32_t record_offset = 0;
+
+  for(const auto &position_record : position_list_){
+    size_t index = position_record.hash_value & (slot_count - 1);
+
+    while(slot_offset_list[index] != kOpeningBookEmptySlot){
+      index = (index + 1) & (slot_count - 1);
+    }
+
+    slot_hash_list[index] = position_record.hash_value;
+    slot_offset_list[index] = record_offset;
+
+    record_offset += static_cast<uint32_t>(kOpeningBookPositionWordNum + kOpeningBookMoveWordNum * position_record.move_count);
+  }
+
+  assert(record_offset == record_word_count);
+
+  binary->clear();
+  binary->reserve(kOpeningBookHeaderSize + kOpeningBookSlotSize * slot_count + 4 * record_word_count);
+
+  // ヘッダ
+  binary->append(kOpeningBookMagic, kOpeningBookMagicSize);
+  binary->push_back(static_cast<char>(kOpeningBookVersion));
+  binary->append(3, '\0');
+  WriteOpeningBookFixed64(position_count, binary);
+  WriteOpeningBookFixed64(slot_count, binary);
+  WriteOpeningBookFixed64(record_word_count, binary);
+  WriteOpeningBookFixed64(game_count_, binary);
+  assert(binary->size() == kOpeningBookHeaderSize);
+
+  // スロット
+  for(size_t i=0; i<slot_count; i++){
+    WriteOpeningBookFixed64(slot_hash_list[i], binary);
+    WriteOpeningBookFixed32(slot_offset_list[i], binary);
+    WriteOpeningBookFixed32(0, binary);
+  }
+
+  // 局面データ
+  for(const auto &position_record : position_list_){
+    WriteOpeningBookStats(position_record.stats, binary);
+    WriteOpeningBookFixed32(static_cast<uint32_t>(position_record.move_count), binary);
+
+    for(size_t i=0; i<position_record.move_count; i++){
+      const OpeningBookMove &book_move = move_list_[position_record.move_begin + i];
+
+      WriteOpeningBookFixed32(book_move.move, binary);
+      WriteOpeningBookStats(book_move.stats, binary);
+    }
+  }
+}
+
+const bool OpeningBookBuilder::WriteFile(const std::string &book_file) const
+{
+  string binary;
+  Serialize(&binary);
+
+  ofstream ofs(book_file, ios::binary);
+
+  if(!ofs){
+    cerr << "Failed to open the file: " << book_file << endl;
+    return false;
+  }
+
+  ofs.write(binary.data(), binary.size());
+  return static_cast<bool>(ofs);
+}
+
+OpeningBook::OpeningBook()
+: position_count_(0), slot_count_(0), record_word_count_(0), game_count_(0), slot_(nullptr), record_(nullptr)
+{
+}
+
+const bool OpeningBook::Attach(const char * const data, const size_t data_size)
+{
+  assert(data != nullptr || data_size == 0);
+
+  if(data_size < kOpeningBookHeaderSize){
+    return false;
+  }
+
+  if(memcmp(data, kOpeningBookMagic, kOpeningBookMagicSize) != 0 || static_cast<uint8_t>(data[kOpeningBookMagicSize]) != kOpeningBookVersion){
+    return false;
+  }
+
+  const uint64_t position_count = ReadFixed64(data + 8);
+  const uint64_t slot_count = ReadFixed64(data + 16);
+  const uint64_t record_word_count = ReadFixed64(data + 24);
+  const uint64_t game_count = ReadFixed64(data + 32);
+
+  // 不正な値によるoverflowを避けるため、各セクションはdata_sizeを上限として確認する
+  if(slot_count == 0 || (slot_count & (slot_count - 1)) != 0 || slot_count > data_size / kOpeningBookSlotSize || record_word_count > data_size / 4){
+    return false;
+  }
+
+  if(position_count > slot_count || kOpeningBookHeaderSize + kOpeningBookSlotSize * slot_count + 4 * record_word_count != data_size){
+    return false;
+  }
+
+  // 局面データの範囲はFindRecordで参照する局面ごとに確認し、Attachは局面数によらない時間で終える
+  position_count_ = position_count;
+  slot_count_ = slot_count;
+  record_word_count_ = record_word_count;
+  game_count_ = game_count;
+
+  slot_ = data + kOpeningBookHeaderSize;
+  record_ = slot_ + kOpeningBookSlotSize * slot_count;
+
+  return true;
+}
+
+const bool OpeningBook::Open(const std::string &book_file)
+{
+  namespace bip = boost::interprocess;
+  Close();
+
+  try{
+    file_mapping_.reset(new bip::file_mapping(book_file.c_str(), bip::read_only));
+    mapped_region_.reset(new bip::mapped_region(*file_mapping_, bip::read_only));
+  }catch(bip::interprocess_exception &){
+    Close();
+    return false;
+  }
+
+  const auto data = static_cast<const char*>(mapped_region_->get_address());
+
+  if(!Attach(data, mapped_region_->get_size())){
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+void OpeningBook::Close()
+{
+  position_count_ = 0;
+  slot_count_ = 0;
+  record_word_count_ = 0;
+  game_count_ = 0;
+
+  slot_ = nullptr;
+  record_ = nullptr;
+
+  mapped_region_.reset();
+  file_mapping_.reset();
+}
+
+const bool OpeningBook::Find(const MoveList &board_move_sequence, OpeningBookEntry * const entry) const
+{
+  assert(entry != nullptr);
+
+  SymmetricHashState hash_state;
+
+  for(const auto move : board_move_sequence){
+    hash_state.Play(move);
+  }
+
+  const char * const record = FindRecord(hash_state.GetSymmetricHashValue());
+
+  if(record == nullptr){
+    return false;
+  }
+
+  const auto read_stats = [](const char * const data){
+    OpeningBookStats stats;
+
+    stats.game_count = ReadFixed32(data);
+    stats.black_win_count = ReadFixed32(data + 4);
+    stats.white_win_count = ReadFixed32(data + 8);
+    stats.draw_count = ReadFixed32(data + 12);
+
+    return stats;
+  };
+
+  // 次の一手は正規形の局面での指し手のため、逆変換で指定局面の向きに戻す
+  const BoardSymmetry inverse_symmetry = GetInverseSymmetry(hash_state.GetCanonicalSymmetry());
+  const size_t move_count = ReadFixed32(record + 16);
+
+  entry->stats = read_stats(record);
+  entry->next_move_list.resize(move_count);
+
+  for(size_t i=0; i<move_count; i++){
+    const char * const move_data = record + 4 * (kOpeningBookPositionWordNum + kOpeningBookMoveWordNum * i);
+    const auto move = static_cast<MovePosition>(ReadFixed32(move_data));
+
+    entry->next_move_list[i].move = GetSymmetricMove(move, inverse_symmetry);
+    entry->next_move_list[i].stats = read_stats(move_data + 4);
+  }
+
+  return true;
+}
+
+const char* OpeningBook::FindRecord(const HashValue hash_value) const
+{
+  if(slot_count_ == 0){
+    return nullptr;
+  }
+
+  const size_t slot_mask = slot_count_ - 1;
+  size_t index = hash_value & slot_mask;
+
+  for(size_t i=0; i<slot_count_; i++){
+    const char * const slot = slot_ + kOpeningBookSlotSize * index;
+    const size_t record_offset = ReadFixed32(slot + 8);
+
+    if(record_offset == kOpeningBookEmptySlot){
+      return nullptr;
+    }
+
+    if(ReadFixed64(slot) == hash_value){
+      // 不正なバイナリ形式で範囲外を読まないよう、局面データの範囲を確認する
+      if(record_offset + kOpeningBookPositionWordNum > record_word_count_){
+        return nullptr;
+      }
+
+      const char * const record = record_ + 4 * record_offset;
+      const size_t move_count = ReadFixed32(record + 16);
+
+      if(move_count > (record_word_count_ - record_offset - kOpeningBookPositionWordNum) / kOpeningBookMoveWordNum){
+        return nullptr;
+      }
+
+      return record;
+    }
+
+    index = (index + 1) & slot_mask;
+  }
+
+  return nullptr;
+}
+
+}   // namespace realcore
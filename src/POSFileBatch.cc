@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+
+#include "WorkStealingScheduler.h"
+#include "POSFileBatch.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+//! @brief 1タスクで読み込むファイル数
+static constexpr size_t kPOSFileTaskSize = 256;
+
+POSFileBatch::POSFileBatch()
+{
+  move_offset_list_.emplace_back(0);
+}
+
+const bool POSFileBatch::Load(const std::vector<std::string> &pos_file_list, const size_t thread_num)
+{
+  assert(thread_num > 0);
+
+  const size_t file_count = pos_file_list.size();
+  const size_t task_count = (file_count + kPOSFileTaskSize - 1) / kPOSFileTaskSize;
+
+  move_arena_.clear();
+  move_offset_list_.assign(file_count + 1, 0);
+  loaded_list_.assign(file_count, 0);
+
+  // タスクごとに連続した領域へ読み込み、ファイルごとの指し手数を記録する
+  vector<vector<MovePosition>> task_move_list(task_count);
+  WorkStealingScheduler scheduler(thread_num);
+
+  for(size_t task_index=0; task_index<task_count; task_index++){
+    scheduler.Push(task_index % thread_num, [this, &pos_file_list, &task_move_list, task_index, file_count](const size_t worker_index){
+      const size_t task_begin = task_index * kPOSFileTaskSize;
+      const size_t task_end = min(task_begin + kPOSFileTaskSize, file_count);
+      vector<MovePosition> &move_list = task_move_list[task_index];
+
+      move_list.reserve((task_end - task_begin) * kInBoardMoveNum / 4);
+
+      for(size_t i=task_begin; i<task_end; i++){
+        const size_t move_begin = move_list.size();
+        loaded_list_[i] = DecodePOSFile(pos_file_list[i], &move_list);
+
+        if(loaded_list_[i] == 0){
+          move_list.resize(move_begin);
+        }
+
+        move_offset_list_[i + 1] = move_list.size() - move_begin;
+      }
+    });
+  }
+
+  scheduler.Run();
+
+  // タスクごとの領域を1つの領域に連結する
+  for(size_t i=0; i<file_count; i++){
+    move_offset_list_[i + 1] += move_offset_list_[i];
+  }
+
+  move_arena_.resize(move_offset_list_[file_count]);
+  MovePosition *arena_it = move_arena_.data();
+
+  for(const auto &move_list : task_move_list){
+    copy(move_list.begin(), move_list.end(), arena_it);
+    arena_it += move_list.size();
+  }
+
+  return all_of(loaded_list_.begin(), loaded_list_.end(), [](const uint8_t is_loaded){ return is_loaded != 0; });
+}
+
+const bool POSFileBatch::DecodePOSFile(const std::string &pos_file_path, std::vector<MovePosition> * const move_list)
+{
+  assert(move_list != nullptr);
+
+  FILE *pos_file = fopen(pos_file_path.c_str(), "rb");
+
+  if(pos_file == nullptr){
+    return false;
+  }
+
+  // 先頭1byteは手数
+  static constexpr size_t kBufferSize = 256;
+  array<unsigned char, kBufferSize> buffer;
+  bool is_header = true;
+  size_t header_move_count = 0, move_count = 0, read_size = 0;
+
+  while((read_size = fread(buffer.data(), 1, kBufferSize, pos_file)) > 0){
+    if(is_header){
+      header_move_count = buffer[0];
+    }
+
+    for(size_t i=is_header ? 1 : 0; i<read_size; i++){
+      // 盤外の値はGetPOSMoveで盤面の指し手に変換できない
+      if(buffer[i] >= kInBoardMoveNum){
+        fclose(pos_file);
+        return false;
+      }
+
+      move_list->emplace_back(GetPOSMove(buffer[i]));
+      move_count++;
+    }
+
+    is_header = false;
+  }
+
+  const bool is_read = ferror(pos_file) == 0;
+  fclose(pos_file);
+
+  return is_read && !is_header && move_count == header_move_count;
+}
+
+}   // namespace realcore
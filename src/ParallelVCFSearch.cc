@@ -0,0 +1,117 @@
+#include "ParallelVCFSearch.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+ParallelVCFSearch::ParallelVCFSearch(const Board &board, VCFTable * const vcf_table, SharedSearchManager * const search_manager)
+: search_manager_(search_manager), scheduler_(search_manager->GetThreadNum()), is_proven_(false), is_unknown_(false)
+{
+  assert(vcf_table != nullptr);
+
+  const size_t thread_num = search_manager->GetThreadNum();
+  vcf_search_list_.reserve(thread_num);
+
+  for(size_t i=0; i<thread_num; i++){
+    vcf_search_list_.emplace_back(new VCFSearch(board, vcf_table, search_manager, i));
+  }
+}
+
+const VCFResult ParallelVCFSearch::Solve(MoveList * const proof_sequence)
+{
+  assert(proof_sequence != nullptr);
+
+  is_proven_ = false;
+  proof_sequence_.clear();
+  is_unknown_ = false;
+
+  scheduler_.Push(0, [this](const size_t worker_index){
+    SearchTask(worker_index, vector<MovePair>());
+  });
+
+  scheduler_.Run();
+
+  if(is_proven_){
+    *proof_sequence = proof_sequence_;
+    return kVCFProven;
+  }
+
+  return is_unknown_ ? kVCFUnknown : kVCFDisproven;
+}
+
+SearchCounter ParallelVCFSearch::GetStealCount() const
+{
+  return scheduler_.GetStealCount();
+}
+
+void ParallelVCFSearch::SearchTask(const size_t worker_index, const vector<MovePair> &four_sequence)
+{
+  VCFSearch &vcf_search = *vcf_search_list_[worker_index];
+
+  for(const auto &four_pair : four_sequence){
+    vcf_search.MakeFourMove(four_pair);
+  }
+
+  MoveList proof_sequence;
+
+  for(const auto &four_pair : four_sequence){
+    proof_sequence += four_pair.first;
+    proof_sequence += four_pair.second;
+  }
+
+  if(four_sequence.size() < kVCFSplitDepth){
+    // 展開した子局面をタスクとして積み、他ワーカーが盗めるようにする
+    vector<MovePair> candidate_list;
+    MovePosition terminating_move = kNullMove;
+    const VCFResult result = vcf_search.Expand(&candidate_list, &terminating_move);
+
+    if(result == kVCFProven){
+      proof_sequence += terminating_move;
+      SetProof(proof_sequence);
+    }else if(result == kVCFUnknown && candidate_list.empty()){
+      is_unknown_ = true;
+    }
+
+    // 自ワーカーは末尾から取り出すため、先頭の候補から探索するよう逆順に積む
+    for(auto it=candidate_list.rbegin(); it!=candidate_list.rend(); ++it){
+      vector<MovePair> child_sequence(four_sequence);
+      child_sequence.emplace_back(*it);
+
+      scheduler_.Push(worker_index, [this, child_sequence](const size_t child_worker_index){
+        SearchTask(child_worker_index, child_sequence);
+      });
+    }
+  }else{
+    MoveList subtree_proof;
+    const VCFResult result = vcf_search.Solve(&subtree_proof);
+
+    if(result == kVCFProven){
+      proof_sequence += subtree_proof;
+      SetProof(proof_sequence);
+    }else if(result == kVCFUnknown){
+      is_unknown_ = true;
+    }
+  }
+
+  for(size_t i=0; i<four_sequence.size(); i++){
+    vcf_search.UndoFourMove();
+  }
+}
+
+void ParallelVCFSearch::SetProof(const MoveList &proof_sequence)
+{
+  {
+    boost::lock_guard<boost::mutex> lock(proof_mutex_);
+
+    if(!is_proven_){
+      is_proven_ = true;
+      proof_sequence_ = proof_sequence;
+    }
+  }
+
+  search_manager_->Stop();
+  scheduler_.Stop();
+}
+
+}   // namespace realcore
@@ -0,0 +1,77 @@
+#include "ParallelVCTSearch.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+ParallelVCTSearch::ParallelVCTSearch(const Board &board, VCTTable * const vct_table, SharedSearchManager * const search_manager)
+: board_(board), vct_table_(vct_table), search_manager_(search_manager), scheduler_(search_manager->GetThreadNum()),
+  max_depth_(kDefaultVCTDepth), result_(kVCTUnknown)
+{
+  assert(vct_table != nullptr);
+
+  const size_t thread_num = search_manager->GetThreadNum();
+  vct_search_list_.reserve(thread_num);
+
+  for(size_t i=0; i<thread_num; i++){
+    vct_search_list_.emplace_back(new VCTSearch(board, vct_table, search_manager, i));
+  }
+}
+
+void ParallelVCTSearch::SetMaxDepth(const size_t max_depth)
+{
+  max_depth_ = max_depth;
+
+  for(auto &vct_search : vct_search_list_){
+    vct_search->SetMaxDepth(max_depth);
+  }
+}
+
+const VCTResult ParallelVCTSearch::Solve(MoveTree * const proof_tree)
+{
+  assert(proof_tree != nullptr);
+
+  result_ = kVCTUnknown;
+
+  // 各ワーカーが探索開始局面から探索する
+  const size_t thread_num = search_manager_->GetThreadNum();
+
+  for(size_t i=0; i<thread_num; i++){
+    scheduler_.Push(i, [this](const size_t worker_index){
+      SearchTask(worker_index);
+    });
+  }
+
+  scheduler_.Run();
+
+  if(result_ != kVCTProven){
+    return result_;
+  }
+
+  // 探索の停止通知とは独立に証明木を生成する(置換表から消えた部分木は再探索する)
+  // 再探索は呼び出し元の探索ノード数/時間の上限の残りで打ち切る
+  SharedSearchManager proof_search_manager(1, kNoInterruptionPoint);
+  proof_search_manager.SetRemainingLimit(*search_manager_);
+  VCTSearch proof_search(board_, vct_table_, &proof_search_manager, 0);
+  proof_search.SetMaxDepth(max_depth_);
+
+  return proof_search.Solve(proof_tree);
+}
+
+void ParallelVCTSearch::SearchTask(const size_t worker_index)
+{
+  const VCTResult result = vct_search_list_[worker_index]->Search();
+
+  if(result == kVCTUnknown){
+    return;
+  }
+
+  VCTResult expected = kVCTUnknown;
+  result_.compare_exchange_strong(expected, result);
+
+  search_manager_->Stop();
+  scheduler_.Stop();
+}
+
+}   // namespace realcore
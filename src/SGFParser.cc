@@ -1,6 +1,9 @@
+#include <algorithm>
+#include <cassert>
 #include <iostream>
-#include <set>
-#include <regex>
+#include <stdexcept>
+
+#include <boost/optional.hpp>
 
 #include "MoveList.h"
 #include "SGFParser.h"
@@ -24,167 +27,205 @@ SGFParser::SGFParser(const SGFCheckBit &check_bit)
 
 void SGFParser::ParseSGF(const string &sgf_data)
 {
-  try{
-    game_date_ = ParseGameDate(sgf_data);
-    event_name_ = ParseEventName(sgf_data);
-    black_player_name_ = ParseBlackPlayerName(sgf_data);
-    black_player_rank_ = ParseBlackPlayerRank(sgf_data); 
-    white_player_name_ = ParseWhitePlayerName(sgf_data);
-    white_player_rank_ = ParseWhitePlayerRank(sgf_data);
-
-    game_rule_ = ParseGameRule(sgf_data);
-    game_end_status_ = ParseGameEndStatus(sgf_data);
-    game_result_ = ParseGameResult(sgf_data);
-    game_record_ = ParseGameRecord(sgf_data);
-    alternative_moves_ = ParseAlternativeMoves(sgf_data);
-  }catch(logic_error &ex){
-    throw ex;
-  }
-}
+  // SGFデータを1回だけ走査して各プロパティを取得する
+  // 単一の値をとるプロパティは最初に出現したものを採用する
+  // (未出現の値はdata()がnullptrとなる)
+  boost::string_view game_date, event_name;
+  boost::string_view black_player_name, black_player_rank, white_player_name, white_player_rank;
+  boost::optional<string> game_rule, alternative_moves;
+
+  const auto set_first_value = [](const boost::string_view &value, boost::string_view * const first_value){
+    if(first_value->data() == nullptr){
+      *first_value = value;
+    }
+  };
 
-const string SGFParser::ParseGameDate(const std::string &sgf_data) const
-{
-  static regex date_expr("DT\\[(.*?)\\]");
-  sregex_iterator it(sgf_data.begin(), sgf_data.end(), date_expr);
-  sregex_iterator it_end;
-
-  if(it != it_end){
-    return it->str(1);
-  }else if(check_bit_[kSGFDateCheck]){
-    logic_error error("Date(DT) is not found.");
-    throw error;
-  }else{
-    return "";
+  bool is_draw = false;
+  bool has_win_result = false;
+  GameResult game_result = kUnknownResult;
+  GameEndStatus game_end_status = kUnknownEndStatus;
+
+  bool has_black_stone = false, has_white_stone = false;
+  vector<boost::string_view> black_stone_list, white_stone_list;
+  bool is_black_turn_specified = false, is_white_turn_specified = false;
+
+  vector<pair<char, boost::string_view>> move_list;
+
+  ScanSGFProperty(sgf_data, [&](const SGFProperty &property){
+    const boost::string_view &id = property.id;
+    const boost::string_view &value = property.value_list.front();
+
+    if(id == "B" || id == "W"){
+      if(property.is_node_head && GetStoneValueCount(property) > 0){
+        move_list.emplace_back(id[0], value);
+      }
+    }else if(id == "DT"){
+      set_first_value(value, &game_date);
+    }else if(id == "EV"){
+      set_first_value(value, &event_name);
+    }else if(id == "PB"){
+      set_first_value(value, &black_player_name);
+    }else if(id == "BR"){
+      set_first_value(value, &black_player_rank);
+    }else if(id == "PW"){
+      set_first_value(value, &white_player_name);
+    }else if(id == "WR"){
+      set_first_value(value, &white_player_rank);
+    }else if(id == "GN" || id == "RU"){
+      string rule;
+
+      if(!game_rule && ParseGameRule(property, &rule)){
+        game_rule = rule;
+      }
+    }else if(id == "RE"){
+      // 満局の記録は勝敗の記録より優先する
+      if(IsDrawResult(value)){
+        is_draw = true;
+      }else if(!has_win_result){
+        has_win_result = ParseWinResult(value, &game_result, &game_end_status);
+      }
+    }else if(id == "AB" || id == "AW"){
+      const bool is_black = id == "AB";
+      bool &has_stone = is_black ? has_black_stone : has_white_stone;
+      const size_t stone_count = GetStoneValueCount(property);
+
+      if(!has_stone && stone_count > 0){
+        has_stone = true;
+        auto &stone_list = is_black ? black_stone_list : white_stone_list;
+        stone_list.assign(property.value_list.begin(), property.value_list.begin() + stone_count);
+      }
+    }else if(id == "PL"){
+      is_black_turn_specified |= value == "B";
+      is_white_turn_specified |= value == "W";
+    }else if(id == "5A" || id == "FA"){
+      string alternative;
+
+      if(!alternative_moves && ParseAlternativeMoves(property, &alternative)){
+        alternative_moves = alternative;
+      }
+    }
+  });
+
+  // 必須プロパティのチェック
+  if(game_date.data() == nullptr && check_bit_[kSGFDateCheck]){
+    throw logic_error("Date(DT) is not found.");
   }
-}
 
-const string SGFParser::ParseBlackPlayerName(const std::string &sgf_data) const
-{
-  static regex black_player_name_expr("PB\\[(.*?)\\]");
-  sregex_iterator it(sgf_data.begin(), sgf_data.end(), black_player_name_expr);
-  sregex_iterator it_end;
-
-  if(it != it_end){
-    return it->str(1);
-  }else if(check_bit_[kSGFBlackPlayerNameCheck]){
-    logic_error error("Black Player Name(PB) is not found.");
-    throw error;
-  }else{
-    return "";
+  if(black_player_name.data() == nullptr && check_bit_[kSGFBlackPlayerNameCheck]){
+    throw logic_error("Black Player Name(PB) is not found.");
   }
-}
 
-const string SGFParser::ParseBlackPlayerRank(const std::string &sgf_data) const
-{
-  static regex black_player_rank_expr("BR\\[(.*?)\\]");
-  sregex_iterator it(sgf_data.begin(), sgf_data.end(), black_player_rank_expr);
-  sregex_iterator it_end;
+  if(white_player_name.data() == nullptr && check_bit_[kSGFWhitePlayerNameCheck]){
+    throw logic_error("White Player Name(PW) is not found.");
+  }
 
-  if(it != it_end){
-    return it->str(1);
-  }else{
-    return "";
+  if(!is_draw && !has_win_result && check_bit_[kSGFGameResultCheck]){
+    throw logic_error("Game result(RE) is not found.");
   }
-}
 
-const string SGFParser::ParseWhitePlayerName(const std::string &sgf_data) const
-{
-  static regex white_player_name_expr("PW\\[(.*?)\\]");
-  sregex_iterator it(sgf_data.begin(), sgf_data.end(), white_player_name_expr);
-  sregex_iterator it_end;
-
-  if(it != it_end){
-    return it->str(1);
-  }else if(check_bit_[kSGFWhitePlayerNameCheck]){
-    logic_error error("White Player Name(PW) is not found.");
-    throw error;
+  game_date_ = game_date.to_string();
+  event_name_ = event_name.to_string();
+  black_player_name_ = black_player_name.to_string();
+  black_player_rank_ = black_player_rank.to_string();
+  white_player_name_ = white_player_name.to_string();
+  white_player_rank_ = white_player_rank.to_string();
+
+  game_rule_ = game_rule ? *game_rule : "Unknown";
+
+  if(is_draw){
+    game_end_status_ = kAgreedDraw;
+    game_result_ = kDraw;
   }else{
-    return "";
+    game_end_status_ = game_end_status;
+    game_result_ = game_result;
   }
+
+  const string init_board = ParseInitBoard(black_stone_list, white_stone_list, is_black_turn_specified, is_white_turn_specified);
+  game_record_ = ParseGameRecord(init_board, move_list);
+  alternative_moves_ = alternative_moves ? *alternative_moves : "";
 }
 
-const string SGFParser::ParseWhitePlayerRank(const std::string &sgf_data) const
+const bool SGFParser::ParseGameRule(const SGFProperty &property, std::string * const game_rule) const
 {
-  static regex white_player_rank_expr("WR\\[(.*?)\\]");
-  sregex_iterator it(sgf_data.begin(), sgf_data.end(), white_player_rank_expr);
-  sregex_iterator it_end;
+  assert(game_rule != nullptr);
 
-  if(it != it_end){
-    return it->str(1);
-  }else{
-    return "";
+  static const vector<string> kRuleList{"RIF", "Sakata", "Yamaguchi", "Tarannikov", "Jonsson", "Unknown"};
+
+  for(const auto &value : property.value_list){
+    // 値の中で最初に出現するルール名を採用する
+    size_t first_pos = boost::string_view::npos;
+
+    for(const auto &rule : kRuleList){
+      const size_t pos = value.find(rule);
+
+      if(pos < first_pos){
+        first_pos = pos;
+        *game_rule = rule;
+      }
+    }
+
+    if(first_pos != boost::string_view::npos){
+      return true;
+    }
   }
+
+  return false;
 }
 
-const string SGFParser::ParseGameRule(const std::string &sgf_data) const
+const bool SGFParser::IsDrawResult(const boost::string_view &value) const
 {
-  static regex game_rule_expr("(GN|RU)\\[.*?((RIF)|(Sakata)|(Yamaguchi)|(Tarannikov)|(Jonsson)|(Unknown)).*?\\]");
-  sregex_iterator it(sgf_data.begin(), sgf_data.end(), game_rule_expr);
-  sregex_iterator it_end;
+  boost::string_view result(value);
 
-  if(it != it_end){
-    return it->str(2);
-  }else{
-    return "Unknown";
+  for(const char c : {'B', 'W', '+'}){
+    if(!result.empty() && result.front() == c){
+      result.remove_prefix(1);
+    }
   }
+
+  return result == "Draw";
 }
 
-const GameEndStatus SGFParser::ParseGameEndStatus(const std::string &sgf_data) const
+const bool SGFParser::ParseWinResult(const boost::string_view &value, GameResult * const game_result, GameEndStatus * const game_end_status) const
 {
-  static regex draw_expr("RE\\[B?W?\\+?Draw\\]");
-  sregex_iterator it_draw(sgf_data.begin(), sgf_data.end(), draw_expr);
-  sregex_iterator it_end;
+  assert(game_result != nullptr);
+  assert(game_end_status != nullptr);
 
-  if(it_draw != it_end){
-    return kAgreedDraw;
+  if(value.size() < 3 || (value[0] != 'B' && value[0] != 'W') || value[1] != '+'){
+    return false;
   }
 
-  static regex result_expr("RE\\[(B|W)\\+(Resign|R|Time)\\]");
-  sregex_iterator it(sgf_data.begin(), sgf_data.end(), result_expr);
+  const boost::string_view end_status = value.substr(2);
 
-  if(it != it_end){
-    const string end_status = it->str(2);
-
-    if(end_status == "Resign" || end_status == "R"){
-      return kResign;
-    }else{
-      return kTimeup;
-    }
-  }else if(check_bit_[kSGFGameResultCheck]){
-    logic_error error("Game result(RE) is not found.");
-    throw error;
+  if(end_status == "Resign" || end_status == "R"){
+    *game_end_status = kResign;
+  }else if(end_status == "Time"){
+    *game_end_status = kTimeup;
   }else{
-    return kUnknownEndStatus;
+    return false;
   }
+
+  *game_result = value[0] == 'B' ? kBlackWin : kWhiteWin;
+  return true;
 }
 
-const GameResult SGFParser::ParseGameResult(const std::string &sgf_data) const
+const size_t SGFParser::GetStoneValueCount(const SGFProperty &property) const
 {
-  if(ParseGameEndStatus(sgf_data) == kAgreedDraw){
-    return kDraw;
-  }
-
-  static regex result_expr("RE\\[(B|W)\\+(Resign|R|Time)\\]");
-  sregex_iterator it(sgf_data.begin(), sgf_data.end(), result_expr);
-  sregex_iterator it_end;
+  size_t stone_count = 0;
 
-  if(it != it_end){
-    const string win_player = it->str(1);
+  for(const auto &value : property.value_list){
+    const bool is_stone = value.size() == 2 && 'a' <= value[0] && value[0] <= 'z' && 'a' <= value[1] && value[1] <= 'z';
 
-    if(win_player == "B"){
-      return kBlackWin;
-    }else{
-      return kWhiteWin;
+    if(!is_stone){
+      break;
     }
-  }else if(check_bit_[kSGFGameResultCheck]){
-    logic_error error("Game result(RE) is not found.");
-    throw error;
-  }else{
-    return kUnknownResult;
+
+    stone_count++;
   }
+
+  return stone_count;
 }
 
-const bool SGFParser::IsValidMove(const std::string &move) const
+const bool SGFParser::IsValidMove(const boost::string_view &move) const
 {
   if(move == "tt"){
     return true;
@@ -196,37 +237,10 @@ const bool SGFParser::IsValidMove(const std::string &move) const
   return is_valid_move;
 }
 
-const string SGFParser::ParseInitBoard(const std::string &sgf_data) const
+const string SGFParser::ParseInitBoard(const vector<boost::string_view> &black_stone_list, const vector<boost::string_view> &white_stone_list, const bool is_black_turn_specified, const bool is_white_turn_specified) const
 {
-  // 黒石位置、白石位置の取得
-  static regex stone_expr("[a-z][a-z]");
-  sregex_iterator it_end;
-
-  vector<string> black_stone_vec;
-  static regex black_stone_expr("AB(\\[[a-z][a-z]\\])+");
-  sregex_iterator black_stone_it(sgf_data.begin(), sgf_data.end(), black_stone_expr);
-
-  if(black_stone_it != it_end){
-    const auto init_board_str = black_stone_it->str();
-    sregex_iterator stone_it(init_board_str.begin(), init_board_str.end(), stone_expr);
-
-    for(; stone_it!=it_end; ++stone_it){
-      black_stone_vec.emplace_back(stone_it->str());
-    }
-  }
-
-  vector<string> white_stone_vec;
-  static regex white_stone_expr("AW(\\[[a-z][a-z]\\])+");
-  sregex_iterator white_stone_it(sgf_data.begin(), sgf_data.end(), white_stone_expr);
-
-  if(white_stone_it != it_end){
-    const auto init_board_str = white_stone_it->str();
-    sregex_iterator stone_it(init_board_str.begin(), init_board_str.end(), stone_expr);
-
-    for(; stone_it!=it_end; ++stone_it){
-      white_stone_vec.emplace_back(stone_it->str());
-    }
-  }
+  vector<string> black_stone_vec(black_stone_list.begin(), black_stone_list.end());
+  vector<string> white_stone_vec(white_stone_list.begin(), white_stone_list.end());
 
   // 黒番、白番の取得
   const size_t black_size = black_stone_vec.size();
@@ -242,17 +256,11 @@ const string SGFParser::ParseInitBoard(const std::string &sgf_data) const
     is_black_turn = false;
   }
 
-  static regex black_turn_expr("PL\\[B\\]");
-  sregex_iterator black_turn_it(sgf_data.begin(), sgf_data.end(), black_turn_expr);
-
-  if(black_turn_it != it_end){
+  if(is_black_turn_specified){
     is_black_turn = true;
   }
 
-  static regex white_turn_expr("PL\\[W\\]");
-  sregex_iterator white_turn_it(sgf_data.begin(), sgf_data.end(), white_turn_expr);
-
-  if(white_turn_it != it_end){
+  if(is_white_turn_specified){
     is_black_turn = false;
   }
 
@@ -303,24 +311,18 @@ const string SGFParser::ParseInitBoard(const std::string &sgf_data) const
   return init_board_string;
 }
 
-const string SGFParser::ParseGameRecord(const std::string &sgf_data) const
+const string SGFParser::ParseGameRecord(const std::string &init_board, const vector<pair<char, boost::string_view>> &move_list) const
 {
-  static regex move_expr(";(B|W)\\[([a-z][a-z])\\]");
-
-  sregex_iterator move_it(sgf_data.begin(), sgf_data.end(), move_expr);
-  sregex_iterator it_end;
-  
-  set<string> move_set;
   bool black_turn = true;
-  string record = ParseInitBoard(sgf_data);
+  string record = init_board;
 
-  while(move_it != it_end)
+  for(const auto &move : move_list)
   {
-    const string turn = move_it->str(1);
-    const string stone = move_it->str(2);
+    const char turn = move.first;
+    const boost::string_view stone = move.second;
     
     // 黒番、白番が交互に出現しているかチェックする
-    bool is_turn_consistent = (black_turn && turn == "B") || (!black_turn && turn == "W");
+    bool is_turn_consistent = (black_turn && turn == 'B') || (!black_turn && turn == 'W');
 
     if(!is_turn_consistent){
       throw logic_error("Turn is not consistent.");
@@ -332,58 +334,48 @@ const string SGFParser::ParseGameRecord(const std::string &sgf_data) const
     }
 
     if(!IsValidMove(stone)){
-      const string error_message = "Illegal move: " + stone;
-      logic_error error(error_message);
-      throw error;
-    }
-
-    // 同じ場所への着手がある場合が稀にあるのでチェック
-    set<string>::const_iterator find_it = move_set.find(stone);
-
-    if(find_it != move_set.end()){
-      const string error_message = "Conflict move: " + stone;
+      const string error_message = "Illegal move: " + stone.to_string();
       logic_error error(error_message);
       throw error;
     }
 
-    record += stone;
-
-    ++move_it;
+    record.append(stone.data(), stone.size());
     black_turn = !black_turn;
   }
 
   return record;
 }
 
-const string SGFParser::ParseAlternativeMoves(const std::string &sgf_data) const
+const bool SGFParser::ParseAlternativeMoves(const SGFProperty &property, std::string * const alternative_moves) const
 {
-  static regex alternative_expr("(5A|FA)\\[([a-o0-9\\s\\[\\]]*)\\]");
-  sregex_iterator it(sgf_data.begin(), sgf_data.end(), alternative_expr);
-  sregex_iterator it_end;
+  assert(alternative_moves != nullptr);
 
-  if(it != it_end){
-    string alternative_move = it->str(2);
+  // 先頭から連続する提示珠の形式([a-o0-9空白]*)の値を対象とする
+  size_t value_count = 0;
 
-    replace(alternative_move.begin(), alternative_move.end(), '[', ' ');
-    replace(alternative_move.begin(), alternative_move.end(), ']', ';');
+  for(const auto &value : property.value_list){
+    const bool is_alternative = all_of(value.begin(), value.end(), [](const char c){
+      return ('a' <= c && c <= 'o') || ('0' <= c && c <= '9') || isspace(static_cast<unsigned char>(c));
+    });
 
-    return alternative_move;
-  }else{
-    return "";
-  }
-}
+    if(!is_alternative){
+      break;
+    }
 
-const string SGFParser::ParseEventName(const std::string &sgf_data) const
-{
-  static regex event_expr("EV\\[(.*?)\\]");
-  sregex_iterator it(sgf_data.begin(), sgf_data.end(), event_expr);
-  sregex_iterator it_end;
+    value_count++;
+  }
 
-  if(it != it_end){
-    return it->str(1);
-  }else{
-    return "";
+  if(value_count == 0){
+    return false;
   }
-}
 
+  // 値の区切り"]["をSGFデータの表記のまま"; "に置換する
+  const boost::string_view &first_value = property.value_list.front();
+  const boost::string_view &last_value = property.value_list[value_count - 1];
+  alternative_moves->assign(first_value.data(), last_value.data() + last_value.size());
 
+  replace(alternative_moves->begin(), alternative_moves->end(), '[', ' ');
+  replace(alternative_moves->begin(), alternative_moves->end(), ']', ';');
+
+  return true;
+}
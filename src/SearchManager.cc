@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <boost/thread.hpp>
 
 #include "SearchManager.h"
@@ -5,24 +7,51 @@
 using namespace std;
 using namespace realcore;
 
+void TimeCheckCounter::Update(const SearchClock::time_point &check_time)
+{
+  const auto elapsed_time = check_time - last_check_time_;
+  const SearchCounter elapsed_time_us = chrono::duration_cast<chrono::microseconds>(elapsed_time).count();
+
+  // 直前の呼出頻度から間隔がkTimeCheckIntervalUSとなる呼出回数を求める
+  // 呼出頻度の一時的な変動で間隔が極端に伸びないよう増加は2倍までとする
+  SearchCounter next_interval = 2 * check_interval_;
+
+  if(elapsed_time_us != 0){
+    next_interval = min(next_interval, call_count_ * kTimeCheckIntervalUS / elapsed_time_us);
+  }
+
+  check_interval_ = max<SearchCounter>(1, min(next_interval, kMaxTimeCheckCallInterval));
+  call_count_ = 0;
+  last_check_time_ = check_time;
+}
+
 const bool SearchManager::IsTerminate()
 {
   if(node_limit_ != 0 && node_ > node_limit_){
     return true;
   }
 
+  if(time_over_ || interruption_){
+    return true;
+  }
+
+  if(!time_check_counter_.IsCheckTiming()){
+    return false;
+  }
+
+  const auto check_time = SearchClock::now();
+  time_check_counter_.Update(check_time);
+
   if(elapsed_time_limit_ != 0){
-    auto elapsed_time_ms = GetSearchTime();
+    auto elapsed_time = check_time - search_start_time_;
+    SearchCounter elapsed_time_ms = chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
 
     if(elapsed_time_ms > elapsed_time_limit_){
+      time_over_ = true;
       return true;
     }
   }
 
-  if(interruption_){
-    return true;
-  }
-
   try{
     if(catch_interrupt_exception_){
       boost::this_thread::interruption_point();
@@ -37,8 +66,8 @@ const bool SearchManager::IsTerminate()
 
 SearchCounter SearchManager::GetSearchTime() const
 {
-  auto elapsed_time = chrono::system_clock::now() - search_start_time_;
+  auto elapsed_time = SearchClock::now() - search_start_time_;
   auto elapsed_time_ms = chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
-  
+
   return elapsed_time_ms;
 }
@@ -0,0 +1,90 @@
+#include <boost/thread.hpp>
+
+#include "SharedSearchManager.h"
+
+using namespace std;
+using namespace realcore;
+
+SharedSearchManager::SharedSearchManager(const size_t thread_num, const bool catch_interrupt_exception)
+: thread_num_(thread_num), shard_list_(new SearchCounterShard[thread_num]), flushed_node_(0), node_limit_(0),
+  search_start_time_(SearchClock::now()), elapsed_time_limit_(0),
+  catch_interrupt_exception_(catch_interrupt_exception), stop_flag_(false)
+{
+  assert(thread_num > 0);
+  SearchStart();
+}
+
+SearchCounter SharedSearchManager::GetTotalCount(atomic<SearchCounter> SearchCounterShard::*counter) const
+{
+  SearchCounter total_count = 0;
+
+  for(size_t i=0; i<thread_num_; i++){
+    total_count += (shard_list_[i].*counter).load(memory_order_relaxed);
+  }
+
+  return total_count;
+}
+
+const bool SharedSearchManager::IsNodeLimitExceeded() const
+{
+  // 各スレッドの未反映分はkNodeFlushInterval未満のため、共有カウンタから上限を超えていないことが分かる場合は集計を省略する
+  const SearchCounter flushed_node = flushed_node_.load(memory_order_relaxed);
+
+  if(flushed_node + thread_num_ * kNodeFlushInterval <= node_limit_){
+    return false;
+  }
+
+  return GetNode() > node_limit_;
+}
+
+const bool SharedSearchManager::IsTerminate(const size_t thread_index)
+{
+  assert(thread_index < thread_num_);
+
+  if(IsStopped()){
+    return true;
+  }
+
+  if(node_limit_ != 0 && IsNodeLimitExceeded()){
+    Stop();
+    return true;
+  }
+
+  TimeCheckCounter &time_check_counter = GetShard(thread_index).time_check_counter;
+
+  if(!time_check_counter.IsCheckTiming()){
+    return false;
+  }
+
+  const auto check_time = SearchClock::now();
+  time_check_counter.Update(check_time);
+
+  if(elapsed_time_limit_ != 0){
+    auto elapsed_time = check_time - search_start_time_;
+    SearchCounter elapsed_time_ms = chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
+
+    if(elapsed_time_ms > elapsed_time_limit_){
+      Stop();
+      return true;
+    }
+  }
+
+  try{
+    if(catch_interrupt_exception_){
+      boost::this_thread::interruption_point();
+    }
+  }catch(boost::thread_interrupted){
+    Stop();
+    return true;
+  }
+
+  return false;
+}
+
+SearchCounter SharedSearchManager::GetSearchTime() const
+{
+  auto elapsed_time = SearchClock::now() - search_start_time_;
+  auto elapsed_time_ms = chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
+
+  return elapsed_time_ms;
+}
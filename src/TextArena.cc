@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+#include "TextArena.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+constexpr size_t kDefaultTextArenaChunkSize = 64 * 1024;
+
+ArenaText::ArenaText()
+: data_(nullptr), size_(0)
+{
+}
+
+ArenaText::ArenaText(const char * const data, const uint32_t size)
+: data_(data), size_(size)
+{
+}
+
+const bool ArenaText::operator==(const ArenaText &rhs) const
+{
+  if(size_ != rhs.size_){
+    return false;
+  }
+
+  return size_ == 0 || memcmp(data_, rhs.data_, size_) == 0;
+}
+
+const bool ArenaText::operator!=(const ArenaText &rhs) const
+{
+  return !(*this == rhs);
+}
+
+const char* ArenaText::data() const
+{
+  return data_;
+}
+
+const size_t ArenaText::size() const
+{
+  return size_;
+}
+
+const bool ArenaText::empty() const
+{
+  return size_ == 0;
+}
+
+string ArenaText::str() const
+{
+  return size_ == 0 ? string() : string(data_, size_);
+}
+
+TextArena::TextArena()
+: TextArena(kDefaultTextArenaChunkSize)
+{
+}
+
+TextArena::TextArena(const size_t chunk_size)
+: chunk_size_(chunk_size), current_chunk_size_(0), current_chunk_used_(0), used_size_(0), allocated_size_(0)
+{
+  assert(chunk_size > 0);
+}
+
+ArenaText TextArena::Store(const string &text)
+{
+  return Store(text.data(), text.size());
+}
+
+ArenaText TextArena::Store(const char * const text, const size_t size)
+{
+  assert(size <= numeric_limits<uint32_t>::max());
+
+  if(size == 0){
+    return ArenaText();
+  }
+
+  if(current_chunk_used_ + size > current_chunk_size_){
+    // チャンクサイズを超える文字列はその文字列専用のチャンクを確保する
+    const size_t new_chunk_size = max(chunk_size_, size);
+
+    chunk_list_.emplace_back(new char[new_chunk_size]);
+    current_chunk_size_ = new_chunk_size;
+    current_chunk_used_ = 0;
+    allocated_size_ += new_chunk_size;
+  }
+
+  char * const data = chunk_list_.back().get() + current_chunk_used_;
+  memcpy(data, text, size);
+
+  current_chunk_used_ += size;
+  used_size_ += size;
+
+  return ArenaText(data, static_cast<uint32_t>(size));
+}
+
+const size_t TextArena::GetUsedSize() const
+{
+  return used_size_;
+}
+
+const size_t TextArena::GetAllocatedSize() const
+{
+  return allocated_size_;
+}
+
+void TextArena::clear()
+{
+  chunk_list_.clear();
+  current_chunk_size_ = 0;
+  current_chunk_used_ = 0;
+  used_size_ = 0;
+  allocated_size_ = 0;
+}
+
+}   // namespace realcore
@@ -0,0 +1,174 @@
+#include "VCFSearch.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+VCFSearch::VCFSearch(const Board &board, VCFTable * const vcf_table, SharedSearchManager * const search_manager, const size_t thread_index)
+: Board(board), vcf_table_(vcf_table), search_manager_(search_manager), thread_index_(thread_index), solve_start_move_count_(0)
+{
+  assert(vcf_table != nullptr);
+  assert(search_manager != nullptr);
+  assert(thread_index < search_manager->GetThreadNum());
+}
+
+const VCFResult VCFSearch::Solve(MoveList * const proof_sequence)
+{
+  assert(proof_sequence != nullptr);
+
+  solve_start_move_count_ = board_move_sequence_.size();
+  proof_sequence_.clear();
+
+  const VCFResult result = SolveOR();
+
+  if(result == kVCFProven){
+    *proof_sequence = proof_sequence_;
+  }
+
+  return result;
+}
+
+const VCFResult VCFSearch::Solve(MoveTree * const proof_tree)
+{
+  assert(proof_tree != nullptr);
+
+  MoveList proof_sequence;
+  const VCFResult result = Solve(&proof_sequence);
+
+  if(result == kVCFProven){
+    proof_tree->clear();
+    proof_tree->AddChild(proof_sequence);
+    proof_tree->MoveRootNode();
+  }
+
+  return result;
+}
+
+const VCFResult VCFSearch::SolveOR()
+{
+  vector<MovePair> candidate_list;
+  MovePosition terminating_move = kNullMove;
+  const VCFResult expand_result = Expand(&candidate_list, &terminating_move);
+
+  if(expand_result == kVCFProven){
+    for(size_t i=solve_start_move_count_; i<board_move_sequence_.size(); i++){
+      proof_sequence_ += board_move_sequence_[i];
+    }
+
+    proof_sequence_ += terminating_move;
+    return kVCFProven;
+  }
+
+  if(candidate_list.empty()){
+    return expand_result;
+  }
+
+  for(const auto &four_pair : candidate_list){
+    MakeFourMove(four_pair);
+    const VCFResult result = SolveOR();
+    UndoFourMove();
+
+    // 探索打ち切りは全スレッドで共有されるため、以降の候補の探索は行わない
+    if(result != kVCFDisproven){
+      return result;
+    }
+  }
+
+  VCFTableData table_data;
+  table_data.hash_value = GetHashValue();
+  table_data.result = kVCFDisproven;
+
+  vcf_table_->Upsert(table_data.hash_value, table_data);
+
+  return kVCFDisproven;
+}
+
+const VCFResult VCFSearch::Expand(vector<MovePair> * const candidate_list, MovePosition * const terminating_move)
+{
+  assert(candidate_list != nullptr);
+  assert(candidate_list->empty());
+  assert(terminating_move != nullptr);
+
+  search_manager_->AddNode(thread_index_);
+
+  if(search_manager_->IsTerminate(thread_index_)){
+    return kVCFUnknown;
+  }
+
+  const HashValue hash_value = GetHashValue();
+  VCFTableData table_data;
+
+  if(vcf_table_->find(hash_value, &table_data) && table_data.result == kVCFDisproven){
+    return kVCFDisproven;
+  }
+
+  vector<MovePair> four_list;
+
+  if(GetFourCandidate(&four_list, terminating_move)){
+    return kVCFProven;
+  }
+
+  candidate_list->reserve(four_list.size());
+
+  for(const auto &four_pair : four_list){
+    // 防手が終端手になる場合は相手の勝ちが先行するため候補から除く
+    MakeMove(four_pair.first, kUpdateVCFOpenState);
+    const bool is_terminate_guard = IsTerminateMove(four_pair.second);
+    UndoMove();
+
+    if(!is_terminate_guard){
+      candidate_list->emplace_back(four_pair);
+    }
+  }
+
+  if(candidate_list->empty()){
+    table_data.hash_value = hash_value;
+    table_data.result = kVCFDisproven;
+
+    vcf_table_->Upsert(hash_value, table_data);
+    return kVCFDisproven;
+  }
+
+  return kVCFUnknown;
+}
+
+const bool VCFSearch::GetFourCandidate(vector<MovePair> * const candidate_list, MovePosition * const terminating_move) const
+{
+  assert(candidate_list != nullptr);
+  assert(terminating_move != nullptr);
+
+  const bool is_black_turn = board_move_sequence_.IsBlackTurn();
+
+  // 相手に四がある場合は防手のみが正規手となる
+  MovePosition opponent_four_guard = kNullMove;
+  const bool is_opponent_four = IsOpponentFour(&opponent_four_guard);
+
+  vector<MovePair> four_list;
+  EnumerateFourMoves(is_black_turn, &four_list);
+
+  candidate_list->reserve(four_list.size());
+
+  for(const auto &four_pair : four_list){
+    const auto four_move = four_pair.first;
+
+    if(is_opponent_four && four_move != opponent_four_guard){
+      continue;
+    }
+
+    if(is_black_turn && bit_board_.IsForbiddenMove<kBlackTurn>(four_move)){
+      continue;
+    }
+
+    if(IsTerminateMove(four_pair)){
+      *terminating_move = four_move;
+      return true;
+    }
+
+    candidate_list->emplace_back(four_pair);
+  }
+
+  return false;
+}
+
+}   // namespace realcore
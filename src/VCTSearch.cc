@@ -0,0 +1,514 @@
+#include <array>
+#include <limits>
+
+#include "VCTSearch.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+//! @brief 証明数/反証数の和を無限大で飽和させて求める
+inline const ProofNumber AddProofNumber(const ProofNumber proof_number_1, const ProofNumber proof_number_2)
+{
+  const ProofNumber sum = proof_number_1 + proof_number_2;
+  return sum < kInfinityProofNumber ? sum : kInfinityProofNumber;
+}
+
+//! @brief 最良の子局面の閾値を2番目の子局面の値から求める
+//! @note 最良と2番目の子局面を交互に探索し続ける現象を抑えるため、2番目の値の(1 + 1/4)倍を閾値とする(1 + ε trick)
+inline const ProofNumber GetSecondThreshold(const ProofNumber second_number)
+{
+  return AddProofNumber(second_number, second_number / 4 + 1);
+}
+
+//! @brief 探索量の和を上限で飽和させて求める
+inline const VCTWork AddWork(const VCTWork work, const SearchCounter node_count)
+{
+  constexpr VCTWork kMaxWork = numeric_limits<VCTWork>::max();
+  return node_count < kMaxWork - work ? static_cast<VCTWork>(work + node_count) : kMaxWork;
+}
+
+//! @brief 探索量をlog2で区分したindexを返す(探索量0は0)
+inline const size_t GetWorkBucket(const VCTWork work)
+{
+  size_t bucket = 0;
+
+  for(VCTWork value=work; value!=0; value>>=1){
+    ++bucket;
+  }
+
+  return bucket;
+}
+
+VCTTable::VCTTable(const size_t table_space, const bool lock_control)
+: HashTable<VCTTableData>(table_space, lock_control), used_count_(0), gc_count_(0),
+  search_thread_count_list_(new atomic<uint8_t>[kSearchThreadCountSize]())
+{
+}
+
+void VCTTable::Initialize()
+{
+  HashTable<VCTTableData>::Initialize();
+  used_count_ = 0;
+}
+
+void VCTTable::Store(const VCTTableData &table_data)
+{
+  VCTTableData conflict_data;
+
+  if(IsConflict(table_data.hash_value, &conflict_data)){
+    if(conflict_data.hash_value != table_data.hash_value && conflict_data.work > table_data.work){
+      return;
+    }
+  }else{
+    used_count_.fetch_add(1, memory_order_relaxed);
+  }
+
+  Upsert(table_data.hash_value, table_data);
+}
+
+const size_t VCTTable::CollectGarbage()
+{
+  boost::unique_lock<boost::mutex> lock(gc_mutex_, boost::try_to_lock);
+
+  if(!lock.owns_lock() || !IsGarbageCollectionRequired()){
+    return 0;
+  }
+
+  // 探索量をlog2で区分して要素数を集計し、探索量の小さい区分から削除対象とする
+  constexpr size_t kWorkBucketSize = 8 * sizeof(VCTWork) + 1;
+  array<size_t, kWorkBucketSize> bucket_count_list{{0}};
+  size_t used_count = 0;
+
+  ForEach([&bucket_count_list, &used_count](const VCTTableData &table_data){
+    ++bucket_count_list[GetWorkBucket(table_data.work)];
+    ++used_count;
+  });
+
+  const size_t target_count = size() * kVCTGCTargetPercent / 100;
+  size_t erase_bucket = 0, remain_count = used_count;
+
+  while(erase_bucket < kWorkBucketSize && remain_count > target_count){
+    remain_count -= bucket_count_list[erase_bucket];
+    ++erase_bucket;
+  }
+
+  const size_t erase_count = EraseIf([erase_bucket](const VCTTableData &table_data){
+    return GetWorkBucket(table_data.work) < erase_bucket;
+  });
+
+  used_count_ = used_count - erase_count;
+  gc_count_.fetch_add(1, memory_order_relaxed);
+
+  return erase_count;
+}
+
+VCTSearch::VCTSearch(const Board &board, VCTTable * const vct_table, SharedSearchManager * const search_manager, const size_t thread_index)
+: Board(board), vct_table_(vct_table), search_manager_(search_manager), thread_index_(thread_index),
+  is_attacker_black_(board_move_sequence_.IsBlackTurn()), solve_start_move_count_(0), max_depth_(kDefaultVCTDepth), node_count_(0)
+{
+  assert(vct_table != nullptr);
+  assert(search_manager != nullptr);
+  assert(thread_index < search_manager->GetThreadNum());
+}
+
+const VCTResult VCTSearch::Search()
+{
+  is_attacker_black_ = board_move_sequence_.IsBlackTurn();
+  solve_start_move_count_ = board_move_sequence_.size();
+
+  ProofNumber proof_number = 1, disproof_number = 1;
+  SearchMID(kInfinityProofNumber, kInfinityProofNumber, &proof_number, &disproof_number);
+
+  if(proof_number == 0){
+    return kVCTProven;
+  }
+
+  if(disproof_number == 0){
+    return kVCTDisproven;
+  }
+
+  return kVCTUnknown;
+}
+
+const VCTResult VCTSearch::Solve(MoveTree * const proof_tree)
+{
+  assert(proof_tree != nullptr);
+
+  const VCTResult result = Search();
+
+  if(result != kVCTProven){
+    return result;
+  }
+
+  proof_tree->clear();
+
+  if(!GetProofTree(proof_tree)){
+    // 証明木の再探索が打ち切られた
+    proof_tree->clear();
+    return kVCTUnknown;
+  }
+
+  proof_tree->MoveRootNode();
+  return kVCTProven;
+}
+
+void VCTSearch::SearchMID(const ProofNumber pn_threshold, const ProofNumber dn_threshold, ProofNumber * const proof_number, ProofNumber * const disproof_number)
+{
+  assert(proof_number != nullptr);
+  assert(disproof_number != nullptr);
+
+  search_manager_->AddNode(thread_index_);
+  const SearchCounter start_node_count = node_count_++;
+
+  const HashValue hash_value = GetHashValue();
+  const VCTDepth remaining_depth = GetRemainingDepth(board_move_sequence_.size());
+  VCTTableData table_data;
+
+  FindTableData(hash_value, remaining_depth, &table_data);
+
+  *proof_number = table_data.proof_number;
+  *disproof_number = table_data.disproof_number;
+
+  if(*proof_number == 0 || *disproof_number == 0){
+    return;
+  }
+
+  MoveList child_list;
+  MovePosition terminating_move = kNullMove;
+
+  if(Expand(&child_list, &terminating_move, proof_number, disproof_number)){
+    return;
+  }
+
+  const bool is_or_node = IsAttackerTurn();
+  const bool is_black_turn = board_move_sequence_.IsBlackTurn();
+  const size_t child_count = child_list.size();
+  const VCTDepth child_remaining_depth = GetRemainingDepth(board_move_sequence_.size() + 1);
+
+  vector<HashValue> child_hash_list;
+  child_hash_list.reserve(child_count);
+
+  for(const auto move : child_list){
+    child_hash_list.emplace_back(CalcHashValue(is_black_turn, move, hash_value));
+  }
+
+  // 置換表から消えた子局面は直前の値を用いることで、置換表の競合により同じ子局面を繰り返し探索し続けることを防ぐ
+  vector<ProofNumber> child_proof_number_list(child_count, 1), child_disproof_number_list(child_count, 1);
+
+  // 並列探索時は他スレッドが探索中の子局面の証明数/反証数を仮想的に増やし、探索する子局面を分散させる
+  const bool is_parallel = search_manager_->GetThreadNum() > 1;
+
+  if(is_parallel){
+    vct_table_->EnterNode(hash_value);
+  }
+
+  while(!search_manager_->IsTerminate(thread_index_)){
+    // OR nodeは証明数最小、AND nodeは反証数最小の子局面を選ぶ
+    *proof_number = is_or_node ? kInfinityProofNumber : 0;
+    *disproof_number = is_or_node ? 0 : kInfinityProofNumber;
+    ProofNumber best_number = kInfinityProofNumber, second_number = kInfinityProofNumber;
+    ProofNumber best_proof_number = 0, best_disproof_number = 0;
+    size_t best_index = child_count;
+
+    for(size_t i=0; i<child_count; i++){
+      VCTTableData child_data;
+
+      if(FindTableData(child_hash_list[i], child_remaining_depth, &child_data)){
+        child_proof_number_list[i] = child_data.proof_number;
+        child_disproof_number_list[i] = child_data.disproof_number;
+      }
+
+      const ProofNumber child_proof_number = child_proof_number_list[i];
+      const ProofNumber child_disproof_number = child_disproof_number_list[i];
+      ProofNumber select_number = is_or_node ? child_proof_number : child_disproof_number;
+
+      if(is_or_node){
+        *proof_number = min(*proof_number, child_proof_number);
+        *disproof_number = AddProofNumber(*disproof_number, child_disproof_number);
+      }else{
+        *proof_number = AddProofNumber(*proof_number, child_proof_number);
+        *disproof_number = min(*disproof_number, child_disproof_number);
+      }
+
+      if(is_parallel && select_number != 0){
+        select_number = AddProofNumber(select_number, vct_table_->GetSearchThreadCount(child_hash_list[i]));
+      }
+
+      if(select_number < best_number || best_index == child_count){
+        second_number = best_number;
+        best_number = select_number;
+        best_index = i;
+        best_proof_number = child_proof_number;
+        best_disproof_number = child_disproof_number;
+      }else if(select_number < second_number){
+        second_number = select_number;
+      }
+    }
+
+    if(*proof_number >= pn_threshold || *disproof_number >= dn_threshold){
+      SetProofNumber(*proof_number, *disproof_number, AddWork(table_data.work, node_count_ - start_node_count), remaining_depth);
+      break;
+    }
+
+    ProofNumber child_pn_threshold = 0, child_dn_threshold = 0;
+
+    // 他スレッドが探索中の子局面を避けた結果、閾値以上の値を持つ子局面を選んだ場合も探索が進むよう閾値は子局面の値より大きくする
+    if(is_or_node){
+      child_pn_threshold = max(min(pn_threshold, GetSecondThreshold(second_number)), AddProofNumber(best_proof_number, 1));
+      child_dn_threshold = dn_threshold - *disproof_number + best_disproof_number;
+    }else{
+      child_pn_threshold = pn_threshold - *proof_number + best_proof_number;
+      child_dn_threshold = max(min(dn_threshold, GetSecondThreshold(second_number)), AddProofNumber(best_disproof_number, 1));
+    }
+
+    // 子局面の登録が競合で見送られた場合も探索結果を反映できるよう、探索後の値を直接受け取る
+    MakeMove(child_list[best_index]);
+    SearchMID(child_pn_threshold, child_dn_threshold, &child_proof_number_list[best_index], &child_disproof_number_list[best_index]);
+    UndoMove();
+  }
+
+  if(is_parallel){
+    vct_table_->ExitNode(hash_value);
+  }
+}
+
+const bool VCTSearch::Expand(MoveList * const child_list, MovePosition * const terminating_move, ProofNumber * const proof_number, ProofNumber * const disproof_number)
+{
+  assert(child_list != nullptr);
+  assert(terminating_move != nullptr);
+  assert(proof_number != nullptr);
+  assert(disproof_number != nullptr);
+
+  bool is_proven = false, is_disproven = false;
+
+  // 手数上限による反証以外は残り手数によらず有効とする
+  VCTDepth remaining_depth = kUnlimitedVCTDepth;
+
+  if(IsAttackerTurn()){
+    if(ExpandOR(child_list, terminating_move)){
+      is_proven = true;
+    }else if(child_list->empty()){
+      is_disproven = true;
+    }else if(GetRemainingDepth(board_move_sequence_.size()) == 0){
+      is_disproven = true;
+      remaining_depth = 0;
+    }
+  }else{
+    if(ExpandAND(child_list)){
+      // 防御側の勝ち、または攻め方の脅威がない
+      is_disproven = true;
+    }else if(child_list->empty()){
+      // 防手がすべて禁手
+      is_proven = true;
+    }
+  }
+
+  if(!is_proven && !is_disproven){
+    return false;
+  }
+
+  // 末端局面の探索量は1とする
+  constexpr VCTWork kTerminalWork = 1;
+
+  *proof_number = is_proven ? 0 : kInfinityProofNumber;
+  *disproof_number = is_proven ? kInfinityProofNumber : 0;
+
+  SetProofNumber(*proof_number, *disproof_number, kTerminalWork, remaining_depth);
+  return true;
+}
+
+const bool VCTSearch::ExpandOR(MoveList * const child_list, MovePosition * const terminating_move) const
+{
+  assert(child_list != nullptr);
+  assert(terminating_move != nullptr);
+
+  if(TerminateCheck(terminating_move)){
+    return true;
+  }
+
+  *terminating_move = kNullMove;
+
+  MovePosition guard_move;
+
+  if(IsOpponentFour(&guard_move)){
+    // 相手の四ノビは防ぐしかない
+    if(IsNormalMove(guard_move)){
+      *child_list += guard_move;
+    }
+
+    return false;
+  }
+
+  const bool is_black_turn = board_move_sequence_.IsBlackTurn();
+  MoveBitSet candidate_move_set, semi_three_move_set, mise_move_set, multi_mise_move_set;
+
+  EnumerateFourMoves(is_black_turn, &candidate_move_set);
+  EnumerateSemiThreeMoves(is_black_turn, &semi_three_move_set);
+  EnumerateMiseMoves(is_black_turn, &mise_move_set, &multi_mise_move_set);
+
+  candidate_move_set |= semi_three_move_set;
+  candidate_move_set |= mise_move_set;
+  candidate_move_set |= multi_mise_move_set;
+
+  MoveList candidate_move_list;
+  GetMoveList(candidate_move_set, &candidate_move_list);
+
+  for(const auto move : candidate_move_list){
+    if(IsNormalMove(move) && !IsTerminateMove(move)){
+      *child_list += move;
+    }
+  }
+
+  return false;
+}
+
+const bool VCTSearch::ExpandAND(MoveList * const child_list) const
+{
+  assert(child_list != nullptr);
+
+  MovePosition terminating_move;
+
+  if(TerminateCheck(&terminating_move)){
+    return true;
+  }
+
+  MovePosition guard_move;
+
+  if(IsOpponentFour(&guard_move)){
+    if(IsNormalMove(guard_move)){
+      *child_list += guard_move;
+    }
+
+    return false;
+  }
+
+  MoveBitSet guard_move_set;
+
+  if(!GetTerminateGuard(&guard_move_set)){
+    return true;
+  }
+
+  MoveList guard_move_list;
+  GetMoveList(guard_move_set, &guard_move_list);
+
+  for(const auto move : guard_move_list){
+    if(IsNormalMove(move) && !IsTerminateMove(move)){
+      *child_list += move;
+    }
+  }
+
+  return false;
+}
+
+const bool VCTSearch::GetProofTree(MoveTree * const proof_tree)
+{
+  assert(proof_tree != nullptr);
+
+  // 置換表の登録結果によらず子局面を生成するため、直接候補手を生成する
+  MoveList child_list;
+  MovePosition terminating_move = kNullMove;
+  const bool is_or_node = IsAttackerTurn();
+
+  if(is_or_node){
+    if(ExpandOR(&child_list, &terminating_move)){
+      proof_tree->AddChild(terminating_move);
+      return true;
+    }
+  }else{
+    if(ExpandAND(&child_list)){
+      return false;
+    }
+  }
+
+  if(!is_or_node){
+    // 防手がすべて禁手の場合は子局面なしで証明済となる
+    for(const auto move : child_list){
+      if(!GetChildProofTree(move, proof_tree)){
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // 置換表で証明済の子局面を優先し、生成できない場合は反証済でない子局面を再探索する
+  MoveBitSet tried_move_set;
+
+  for(const auto move : child_list){
+    ProofNumber proof_number = 1, disproof_number = 1;
+    GetChildProofNumber(move, &proof_number, &disproof_number);
+
+    if(proof_number != 0){
+      continue;
+    }
+
+    if(GetChildProofTree(move, proof_tree)){
+      return true;
+    }
+
+    if(search_manager_->IsTerminate(thread_index_)){
+      return false;
+    }
+
+    tried_move_set.set(move);
+  }
+
+  for(const auto move : child_list){
+    if(tried_move_set[move]){
+      continue;
+    }
+
+    ProofNumber proof_number = 1, disproof_number = 1;
+    GetChildProofNumber(move, &proof_number, &disproof_number);
+
+    if(disproof_number == 0){
+      continue;
+    }
+
+    if(GetChildProofTree(move, proof_tree)){
+      return true;
+    }
+
+    if(search_manager_->IsTerminate(thread_index_)){
+      return false;
+    }
+  }
+
+  return false;
+}
+
+const bool VCTSearch::GetChildProofTree(const MovePosition move, MoveTree * const proof_tree)
+{
+  MakeMove(move);
+
+  ProofNumber proof_number = 0, disproof_number = 0;
+  GetProofNumber(&proof_number, &disproof_number);
+
+  if(proof_number != 0){
+    // 置換表から消えた子局面を再探索する
+    SearchMID(kInfinityProofNumber, kInfinityProofNumber, &proof_number, &disproof_number);
+  }
+
+  bool is_generated = false;
+
+  if(proof_number == 0){
+    // 生成に失敗した子局面のノードが残らないよう、別の木で生成してから追加する
+    MoveTree child_proof_tree;
+    child_proof_tree.AddChild(move);
+    child_proof_tree.MoveChildNode(move);
+
+    is_generated = GetProofTree(&child_proof_tree);
+
+    if(is_generated){
+      child_proof_tree.MoveRootNode();
+      proof_tree->AddSubtree(child_proof_tree);
+    }
+  }
+
+  UndoMove();
+  return is_generated;
+}
+
+}   // namespace realcore
@@ -0,0 +1,125 @@
+#include "WorkStealingScheduler.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+WorkStealingScheduler::WorkStealingScheduler(const size_t thread_num)
+: thread_num_(thread_num), pending_task_count_(0), stop_flag_(false), steal_count_(0)
+{
+  assert(thread_num > 0);
+  queue_list_.reserve(thread_num);
+
+  for(size_t i=0; i<thread_num; i++){
+    queue_list_.emplace_back(new WorkerTaskQueue);
+  }
+}
+
+void WorkStealingScheduler::Push(const size_t worker_index, const SchedulerTask &task)
+{
+  assert(worker_index < thread_num_);
+
+  // 積んだタスクが取り出される前に未完了数を加算しておき、実行中に未完了数が0にならないようにする
+  pending_task_count_.fetch_add(1, memory_order_relaxed);
+
+  WorkerTaskQueue &queue = *queue_list_[worker_index];
+  boost::lock_guard<boost::mutex> lock(queue.mutex);
+  queue.task_deque.emplace_back(task);
+}
+
+const bool WorkStealingScheduler::PopTask(const size_t worker_index, SchedulerTask * const task)
+{
+  assert(task != nullptr);
+  WorkerTaskQueue &queue = *queue_list_[worker_index];
+  boost::lock_guard<boost::mutex> lock(queue.mutex);
+
+  if(queue.task_deque.empty()){
+    return false;
+  }
+
+  *task = std::move(queue.task_deque.back());
+  queue.task_deque.pop_back();
+
+  return true;
+}
+
+const bool WorkStealingScheduler::StealTask(const size_t worker_index, SchedulerTask * const task)
+{
+  assert(task != nullptr);
+
+  for(size_t i=1; i<thread_num_; i++){
+    WorkerTaskQueue &queue = *queue_list_[(worker_index + i) % thread_num_];
+    boost::lock_guard<boost::mutex> lock(queue.mutex);
+
+    if(queue.task_deque.empty()){
+      continue;
+    }
+
+    // 先頭のタスクは探索木の根に近く、大きな仕事を盗める
+    *task = std::move(queue.task_deque.front());
+    queue.task_deque.pop_front();
+
+    steal_count_.fetch_add(1, memory_order_relaxed);
+    return true;
+  }
+
+  return false;
+}
+
+void WorkStealingScheduler::WorkerLoop(const size_t worker_index)
+{
+  SchedulerTask task;
+
+  while(!IsStopped() && pending_task_count_.load(memory_order_acquire) != 0){
+    if(!PopTask(worker_index, &task) && !StealTask(worker_index, &task)){
+      boost::this_thread::yield();
+      continue;
+    }
+
+    task(worker_index);
+    task = nullptr;
+
+    pending_task_count_.fetch_sub(1, memory_order_acq_rel);
+  }
+}
+
+void WorkStealingScheduler::Run()
+{
+  vector<boost::thread> worker_list;
+  worker_list.reserve(thread_num_ - 1);
+
+  for(size_t i=1; i<thread_num_; i++){
+    worker_list.emplace_back(&WorkStealingScheduler::WorkerLoop, this, i);
+  }
+
+  WorkerLoop(0);
+
+  for(auto &worker : worker_list){
+    worker.join();
+  }
+
+  ClearQueue();
+}
+
+void WorkStealingScheduler::Stop()
+{
+  stop_flag_.store(true, memory_order_relaxed);
+}
+
+void WorkStealingScheduler::Reset()
+{
+  stop_flag_.store(false, memory_order_relaxed);
+}
+
+void WorkStealingScheduler::ClearQueue()
+{
+  for(auto &queue : queue_list_){
+    boost::lock_guard<boost::mutex> lock(queue->mutex);
+    queue->task_deque.clear();
+  }
+
+  pending_task_count_.store(0, memory_order_relaxed);
+}
+
+}   // namespace realcore
@@ -0,0 +1,63 @@
+#ifndef BENCHMARK_INL_H
+#define BENCHMARK_INL_H
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+#include "Instrumentation.h"
+#include "Benchmark.h"
+
+namespace realcore
+{
+
+template<class Function>
+const BenchmarkResult& Benchmark::Run(const std::string &label, const std::uint64_t operation_count, const Function &function)
+{
+  return Run(label, operation_count, []{}, function);
+}
+
+template<class Setup, class Function>
+const BenchmarkResult& Benchmark::Run(const std::string &label, const std::uint64_t operation_count, const Setup &setup, const Function &function)
+{
+  for(size_t i=0; i<warmup_count_; i++){
+    setup();
+    function();
+  }
+
+  BenchmarkResult result;
+  result.label = label;
+  result.operation_count = operation_count;
+  result.time_list.reserve(trial_count_);
+  result.cycle_list.reserve(trial_count_);
+
+  for(size_t i=0; i<trial_count_; i++){
+    setup();
+
+    const auto start_time = std::chrono::steady_clock::now();
+    const std::uint64_t start_cycle = ReadCycleCounter();
+
+    function();
+
+    const std::uint64_t end_cycle = ReadCycleCounter();
+    const auto elapsed_time = std::chrono::steady_clock::now() - start_time;
+
+    result.time_list.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed_time).count());
+    result.cycle_list.emplace_back(end_cycle - start_cycle);
+  }
+
+  std::sort(result.time_list.begin(), result.time_list.end());
+  std::sort(result.cycle_list.begin(), result.cycle_list.end());
+
+  result_list_.emplace_back(result);
+  return result_list_.back();
+}
+
+inline const std::vector<BenchmarkResult>& Benchmark::GetResultList() const
+{
+  return result_list_;
+}
+
+}   // namespace realcore
+
+#endif    // BENCHMARK_INL_H
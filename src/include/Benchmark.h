@@ -0,0 +1,164 @@
+//! @file
+//! @brief 性能測定プログラム(performance/)の共通計測ハーネス
+//! @author Koichi NABETANI
+//! @date 2017/07/29
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+namespace realcore
+{
+
+//! @brief ウォームアップの試行回数のデフォルト値
+constexpr size_t kDefaultBenchmarkWarmupCount = 1;
+
+//! @brief 計測の試行回数のデフォルト値
+constexpr size_t kDefaultBenchmarkTrialCount = 5;
+
+//! @brief 回帰と判定する所要時間の増加率のデフォルト値
+constexpr double kDefaultRegressionThreshold = 0.05;
+
+//! @brief JSONの文字列値をエスケープする
+std::string EscapeJSONString(const std::string &value);
+
+//! @brief ソート済みの値リストのパーセンタイル値を線形補間で返す
+//! @param sorted_list 昇順にソートした値リスト
+//! @param percentile パーセンタイル(0-100)
+const double GetPercentile(const std::vector<std::uint64_t> &sorted_list, const double percentile);
+
+//! @brief 1項目の計測結果
+struct BenchmarkResult
+{
+  BenchmarkResult();
+
+  //! @brief 所要時間(ns)のパーセンタイル値を返す
+  const double GetTimePercentile(const double percentile) const;
+
+  //! @brief 所要サイクル数のパーセンタイル値を返す
+  const double GetCyclePercentile(const double percentile) const;
+
+  //! @brief 1操作あたりの所要時間(ns, 中央値)を返す
+  const double GetTimePerOperation() const;
+
+  //! @brief 1操作あたりの所要サイクル数(中央値)を返す
+  const double GetCyclePerOperation() const;
+
+  std::string label;                  //!< 計測項目名
+  std::uint64_t operation_count;      //!< 1試行あたりの操作数
+  std::vector<std::uint64_t> time_list;     //!< 試行ごとの所要時間(ns, 昇順)
+  std::vector<std::uint64_t> cycle_list;    //!< 試行ごとの所要サイクル数(昇順)
+};
+
+//! @brief ベースラインとの比較結果
+struct BenchmarkComparison
+{
+  BenchmarkComparison();
+
+  std::string label;          //!< 計測項目名
+  double baseline_time;       //!< ベースラインの1操作あたりの所要時間(ns)
+  double current_time;        //!< 今回の1操作あたりの所要時間(ns)
+  bool is_regression;         //!< 回帰と判定したか
+};
+
+// 前方宣言
+class BenchmarkTest;
+
+//! @brief ウォームアップ後に試行を繰り返し、所要時間とサイクル数の分布を集計するクラス
+//! @note 計測結果はJSON形式で出力でき、保存したJSONをベースラインとして1操作あたりの所要時間(中央値)の回帰を判定する
+class Benchmark
+{
+  friend class BenchmarkTest;
+
+public:
+  //! @param name ベンチマーク名
+  Benchmark(const std::string &name);
+
+  //! @brief 計測ハーネスのオプションを追加する
+  //! @param option 追加先
+  //! @param warmup_count ウォームアップの試行回数のデフォルト値
+  //! @param trial_count 計測の試行回数のデフォルト値
+  static void AddOption(boost::program_options::options_description * const option, const size_t warmup_count, const size_t trial_count);
+
+  //! @brief AddOptionで追加したオプションの値を設定する
+  //! @retval false CPUの固定に失敗した
+  const bool SetOption(const boost::program_options::variables_map &arg_map);
+
+  //! @brief ウォームアップの試行回数を設定する
+  void SetWarmupCount(const size_t warmup_count);
+
+  //! @brief 計測の試行回数を設定する
+  void SetTrialCount(const size_t trial_count);
+
+  //! @brief 回帰と判定する所要時間の増加率を設定する
+  void SetRegressionThreshold(const double regression_threshold);
+
+  //! @brief 実行中のスレッドを指定したCPUに固定する
+  //! @retval false 固定に失敗した(Linux以外では常にfalse)
+  //! @note 固定後に生成したスレッドも同じCPUに固定される
+  const bool PinCPU(const int cpu);
+
+  //! @brief ウォームアップ後に関数を試行回数だけ呼び出して計測する
+  //! @param label 計測項目名
+  //! @param operation_count 1回の呼び出しで行う操作数
+  //! @param function 計測する関数
+  //! @note 返す参照は次にRunを呼び出すまで有効
+  template<class Function>
+  const BenchmarkResult& Run(const std::string &label, const std::uint64_t operation_count, const Function &function);
+
+  //! @brief 試行ごとに準備用の関数を呼び出してから計測する
+  //! @param setup 試行ごとに計測前に呼び出す関数(所要時間は計測しない)
+  template<class Setup, class Function>
+  const BenchmarkResult& Run(const std::string &label, const std::uint64_t operation_count, const Setup &setup, const Function &function);
+
+  //! @brief 計測結果のリストを返す
+  const std::vector<BenchmarkResult>& GetResultList() const;
+
+  //! @brief 計測結果の一覧を返す
+  std::string GetSummary() const;
+
+  //! @brief 計測結果をJSON形式で返す
+  std::string GetJSON() const;
+
+  //! @brief JSON形式の計測結果から項目ごとの1操作あたりの所要時間を読み込む
+  //! @retval false 読込に失敗した
+  static const bool LoadBaseline(const std::string &json_file, std::map<std::string, double> * const baseline_map);
+
+  //! @brief JSON文字列から項目ごとの1操作あたりの所要時間を読み込む
+  //! @retval false JSONの解析に失敗した
+  static const bool ParseBaseline(const std::string &json, std::map<std::string, double> * const baseline_map);
+
+  //! @brief ベースラインと比較する
+  //! @note ベースラインに存在しない項目は比較しない
+  void CompareBaseline(const std::map<std::string, double> &baseline_map, std::vector<BenchmarkComparison> * const comparison_list) const;
+
+  //! @brief 計測結果の一覧を出力し、オプションの指定に応じてJSON出力とベースラインとの比較を行う
+  //! @param os 出力先
+  //! @retval false 回帰を検出した、またはファイルの入出力に失敗した
+  const bool Report(std::ostream &os = std::cout) const;
+
+private:
+  std::string name_;          //!< ベンチマーク名
+  size_t warmup_count_;       //!< ウォームアップの試行回数
+  size_t trial_count_;        //!< 計測の試行回数
+  double regression_threshold_;   //!< 回帰と判定する所要時間の増加率
+  int cpu_;                   //!< 固定したCPU(-1: 固定なし)
+
+  std::string json_file_;         //!< 計測結果の出力先
+  std::string baseline_file_;     //!< ベースラインのJSONファイル
+
+  std::vector<BenchmarkResult> result_list_;    //!< 計測結果
+};
+
+}   // namespace realcore
+
+#include "Benchmark-inl.h"
+
+#endif    // BENCHMARK_H
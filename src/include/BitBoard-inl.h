@@ -9,6 +9,11 @@
 
 namespace realcore{
 
+inline const StateBitPosition* GetStateBitPositionList(const MovePosition move)
+{
+  return kStateBitPositionTable.position_list[move];
+}
+
 inline const PositionState BitBoard::GetState(const MovePosition move) const
 {
   // BoardPositionの横方向とMovePositionは同じ値になる
@@ -37,79 +42,38 @@ inline void BitBoard::SetState<kOverBoard>(const MovePosition move)
 template<>
 inline void BitBoard::SetState<kBlackStone>(const MovePosition move)
 {
-  Cordinate x, y;
-  GetMoveCordinate(move, &x, &y);
-
-  if(!IsInBoard(x, y)){
-    return;
-  }
-
-  std::array<size_t, kBoardDirectionNum> index_list;   // StateBit配列のindex
-  GetBitBoardIndexList(x, y, &index_list);
-
-  std::array<size_t, kBoardDirectionNum> shift_list;   // StateBit配列のshift量
-  GetBitBoardShiftList(x, y, &shift_list);
-
-  constexpr StateBit black_stone_xor_mask = 0b10ULL;    // kOpenPosition(0b11) XOR 0b10(mask) = 0b01(kBlackStone)
-
-  for(size_t i=0; i<kBoardDirectionNum; i++){
-    const size_t index = index_list[i];
-    const size_t shift = shift_list[i];
-
-    bit_board_[index] ^= (black_stone_xor_mask << shift);    
-  }
+  // 盤外の指し手はmaskが0のため分岐せずに更新しても盤面は変化しない
+  constexpr StateBit black_stone_xor_mask = 0xAAAAAAAAAAAAAAAAULL;    // kOpenPosition(0b11) XOR 0b10(mask) = 0b01(kBlackStone)
+  const StateBitPosition * const position_list = GetStateBitPositionList(move);
+
+  bit_board_[position_list[kLateralDirection].index] ^= (position_list[kLateralDirection].mask & black_stone_xor_mask);
+  bit_board_[position_list[kVerticalDirection].index] ^= (position_list[kVerticalDirection].mask & black_stone_xor_mask);
+  bit_board_[position_list[kLeftDiagonalDirection].index] ^= (position_list[kLeftDiagonalDirection].mask & black_stone_xor_mask);
+  bit_board_[position_list[kRightDiagonalDirection].index] ^= (position_list[kRightDiagonalDirection].mask & black_stone_xor_mask);
 }
 
 template<>
 inline void BitBoard::SetState<kWhiteStone>(const MovePosition move)
 {
-  Cordinate x, y;
-  GetMoveCordinate(move, &x, &y);
-
-  if(!IsInBoard(x, y)){
-    return;
-  }
-
-  std::array<size_t, kBoardDirectionNum> index_list;   // StateBit配列のindex
-  GetBitBoardIndexList(x, y, &index_list);
-
-  std::array<size_t, kBoardDirectionNum> shift_list;   // StateBit配列のshift量
-  GetBitBoardShiftList(x, y, &shift_list);
-  
-  constexpr StateBit white_stone_xor_mask = 0b01ULL;    // kOpenPosition(0b11) XOR 0b01(mask) = 0b10(kWhiteStone)
-
-  for(size_t i=0; i<kBoardDirectionNum; i++){
-    const size_t index = index_list[i];
-    const size_t shift = shift_list[i];
+  constexpr StateBit white_stone_xor_mask = 0x5555555555555555ULL;    // kOpenPosition(0b11) XOR 0b01(mask) = 0b10(kWhiteStone)
+  const StateBitPosition * const position_list = GetStateBitPositionList(move);
 
-    bit_board_[index] ^= (white_stone_xor_mask << shift);    
-  }
+  bit_board_[position_list[kLateralDirection].index] ^= (position_list[kLateralDirection].mask & white_stone_xor_mask);
+  bit_board_[position_list[kVerticalDirection].index] ^= (position_list[kVerticalDirection].mask & white_stone_xor_mask);
+  bit_board_[position_list[kLeftDiagonalDirection].index] ^= (position_list[kLeftDiagonalDirection].mask & white_stone_xor_mask);
+  bit_board_[position_list[kRightDiagonalDirection].index] ^= (position_list[kRightDiagonalDirection].mask & white_stone_xor_mask);
 }
 
 template<>
 inline void BitBoard::SetState<kOpenPosition>(const MovePosition move)
 {
-  Cordinate x, y;
-  GetMoveCordinate(move, &x, &y);
-
-  if(!IsInBoard(x, y)){
-    return;
-  }
-
-  std::array<size_t, kBoardDirectionNum> index_list;   // StateBit配列のindex
-  GetBitBoardIndexList(x, y, &index_list);
+  // Any(0b**) OR 0b11(mask) = 0b11(kOpenPosition)
+  const StateBitPosition * const position_list = GetStateBitPositionList(move);
 
-  std::array<size_t, kBoardDirectionNum> shift_list;   // StateBit配列のshift量
-  GetBitBoardShiftList(x, y, &shift_list);
-  
-  constexpr StateBit open_position_or_mask = 0b11ULL;    // Any(0b**) OR 0b11(mask) = 0b11(kOpenPosition)
-
-  for(size_t i=0; i<kBoardDirectionNum; i++){
-    const size_t index = index_list[i];
-    const size_t shift = shift_list[i];
-
-    bit_board_[index] |= (open_position_or_mask << shift);
-  }
+  bit_board_[position_list[kLateralDirection].index] |= position_list[kLateralDirection].mask;
+  bit_board_[position_list[kVerticalDirection].index] |= position_list[kVerticalDirection].mask;
+  bit_board_[position_list[kLeftDiagonalDirection].index] |= position_list[kLeftDiagonalDirection].mask;
+  bit_board_[position_list[kRightDiagonalDirection].index] |= position_list[kRightDiagonalDirection].mask;
 }
 
 inline void BitBoard::SetState(const MovePosition move, const PositionState state)
@@ -144,6 +108,40 @@ void BitBoard::SetState(const MoveBitSet &move_bit_set)
   }
 }
 
+template<>
+inline void BitBoard::RemoveStone<kBlackStone>(const MovePosition move)
+{
+  assert(!IsInBoardMove(move) || GetState(move) == kBlackStone);
+
+  // kBlackStone(0b01) XOR 0b10(mask) = 0b11(kOpenPosition)
+  SetState<kBlackStone>(move);
+}
+
+template<>
+inline void BitBoard::RemoveStone<kWhiteStone>(const MovePosition move)
+{
+  assert(!IsInBoardMove(move) || GetState(move) == kWhiteStone);
+
+  // kWhiteStone(0b10) XOR 0b01(mask) = 0b11(kOpenPosition)
+  SetState<kWhiteStone>(move);
+}
+
+template<PositionState State>
+inline ScopedStone<State>::ScopedStone(const MovePosition move, BitBoard * const bit_board)
+: move_(move), bit_board_(bit_board)
+{
+  assert(bit_board != nullptr);
+  assert(!IsInBoardMove(move) || bit_board->GetState(move) == kOpenPosition);
+
+  bit_board_->template SetState<State>(move_);
+}
+
+template<PositionState State>
+inline ScopedStone<State>::~ScopedStone()
+{
+  bit_board_->template RemoveStone<State>(move_);
+}
+
 template<size_t N>
 void BitBoard::GetLineNeighborhoodStateBit(const MovePosition move, std::array<StateBit, kBoardDirectionNum> * const line_neighborhood_list) const
 {
@@ -152,23 +150,19 @@ void BitBoard::GetLineNeighborhoodStateBit(const MovePosition move, std::array<S
 
   std::fill(line_neighborhood_list->begin(), line_neighborhood_list->end(), 0);
 
-  Cordinate x = 0, y = 0;
-  GetMoveCordinate(move, &x, &y);
+  const StateBitPosition * const position_list = GetStateBitPositionList(move);
 
-  if(!IsInBoard(x, y)){
+  if(position_list[kLateralDirection].mask == 0){
+    // 盤外
     return;
   }
 
-  std::array<size_t, kBoardDirectionNum> index_list, shift_list;
-  GetBitBoardIndexList(x, y, &index_list);
-  GetBitBoardShiftList(x, y, &shift_list);
-
   constexpr size_t kBitNumber = 2 * (2 * N + 1);  // (2 * N + 1)地点（指定の地点 + 左右にN路ずつ） * 2bit/地点
   constexpr uint64_t kLineNeighborhoodMask = GetConsectiveBit<kBitNumber>();  // (2*N+1)地点の状態を取り出すマスク
 
   for(auto direction : GetBoardDirection()){
-    const size_t index = index_list[direction];
-    const size_t shift = shift_list[direction];
+    const size_t index = position_list[direction].index;
+    const size_t shift = position_list[direction].shift;
 
     constexpr size_t kMaskShift = 2 * N;    // moveを中心とした左右対称なマスクを生成するためN個の状態(2 * N bit)分を右シフト
 
@@ -194,6 +188,50 @@ void BitBoard::GetLineNeighborhoodStateBit(const MovePosition move, std::array<S
   }
 }
 
+inline const StateBit BitBoard::GetCenterAlignedStateBit(const StateBitPosition &state_bit_position) const
+{
+  constexpr size_t kCenterAlignment = 14;
+  const StateBit state_bit = bit_board_[state_bit_position.index];
+  const size_t shift = state_bit_position.shift;
+
+  return shift >= kCenterAlignment ? (state_bit >> (shift - kCenterAlignment)) : (state_bit << (kCenterAlignment - shift));
+}
+
+template<size_t N>
+inline void BitBoard::GetLocalBitBoard(const MovePosition move, LocalBitBoard * const local_bit_board) const
+{
+  static_assert(1 <= N && N <= 7, "N must be in [1, 7]");
+  assert(local_bit_board != nullptr);
+
+  // 14-15bit目を中心とした(2 * N + 1)地点の状態を取り出すマスク
+  constexpr size_t kBitNumber = 2 * (2 * N + 1);
+  constexpr size_t kCenterAlignment = 14;
+  constexpr std::uint64_t kNeighborhoodMask = GetConsectiveBit<kBitNumber>() << (kCenterAlignment - 2 * N);
+
+  const StateBitPosition * const position_list = GetStateBitPositionList(move);
+
+  // 盤外の指し手はすべて盤外の状態(0)にする
+  const std::uint64_t in_board_mask = position_list[kLateralDirection].mask != 0 ? ~0ULL : 0ULL;
+  const std::uint64_t neighborhood_mask = kNeighborhoodMask & in_board_mask;
+
+  const StateBit lateral_bit = GetCenterAlignedStateBit(position_list[kLateralDirection]) & neighborhood_mask;
+  const StateBit vertical_bit = GetCenterAlignedStateBit(position_list[kVerticalDirection]) & neighborhood_mask;
+  const StateBit left_diagonal_bit = GetCenterAlignedStateBit(position_list[kLeftDiagonalDirection]) & neighborhood_mask;
+  const StateBit right_diagonal_bit = GetCenterAlignedStateBit(position_list[kRightDiagonalDirection]) & neighborhood_mask;
+
+  (*local_bit_board)[0] = lateral_bit | (vertical_bit << 32);
+  (*local_bit_board)[1] = left_diagonal_bit | (right_diagonal_bit << 32);
+}
+
+template<size_t N>
+inline LineNeighborhood LineNeighborhood::Create(const MovePosition move, const BitBoard &bit_board)
+{
+  LocalBitBoard local_bit_board;
+  bit_board.GetLocalBitBoard<N>(move, &local_bit_board);
+
+  return LineNeighborhood(move, N, local_bit_board);
+}
+
 template<PlayerTurn P>
 const bool BitBoard::IsOpenFourMove(const MovePosition move) const
 {
@@ -205,7 +243,7 @@ const bool BitBoard::IsOpenFourMove(const MovePosition move) const
 
   // 黒の達四(XOBBBBOX)には長さ5, 白の達四(OWWWWO)には長さ4の直線近傍を見れば良い
   constexpr size_t kFourCheck = (P == kBlackTurn) ? 5 : 4;
-  LineNeighborhood line_neighbor(move, kFourCheck, *this);
+  LineNeighborhood line_neighbor = LineNeighborhood::Create<kFourCheck>(move, *this);
 
   constexpr PositionState S = GetPlayerStone(P);
   line_neighbor.template SetCenterState<S>();
@@ -233,7 +271,7 @@ const bool BitBoard::IsFourMove(const MovePosition move, MovePosition * const gu
 
   // 黒の四(X[B4O1]X)には長さ5, 白の四([W4O1])には長さ4の直線近傍を見れば良い
   constexpr size_t kFourCheck = (P == kBlackTurn) ? 5 : 4;
-  LineNeighborhood line_neighbor(move, kFourCheck, *this);
+  LineNeighborhood line_neighbor = LineNeighborhood::Create<kFourCheck>(move, *this);
 
   constexpr PositionState S = GetPlayerStone(P);
   line_neighbor.template SetCenterState<S>();
@@ -252,7 +290,7 @@ const bool BitBoard::IsFourMoveOnBoard(const MovePosition move, MovePosition * c
 
   // 黒の四(X[B4O1]X)には長さ5, 白の四([W4O1])には長さ4の直線近傍を見れば良い
   constexpr size_t kFourCheck = (P == kBlackTurn) ? 5 : 4;
-  LineNeighborhood line_neighbor(move, kFourCheck, *this);
+  LineNeighborhood line_neighbor = LineNeighborhood::Create<kFourCheck>(move, *this);
 
   return line_neighbor.IsFour<P>(guard_move);
 }
@@ -277,7 +315,7 @@ const bool BitBoard::IsDoubleFourMove(const MovePosition move, MoveBitSet * cons
 
   // 四々のチェックは長さ5の直線近傍を見れば良い
   static constexpr size_t kDoubleFourCheck = 5;
-  LineNeighborhood line_neighbor(move, kDoubleFourCheck, *this);
+  LineNeighborhood line_neighbor = LineNeighborhood::Create<kDoubleFourCheck>(move, *this);
 
   static constexpr PositionState S = GetPlayerStone(P);
   line_neighbor.SetCenterState<S>();
@@ -302,7 +340,7 @@ const bool BitBoard::IsDoubleSemiThreeMove(const MovePosition move) const
 
   // 見かけの三のチェックは長さ5の直線近傍を見れば良い
   static constexpr size_t kSemiThreeCheck = 5;
-  LineNeighborhood line_neighbor(move, kSemiThreeCheck, *this);
+  LineNeighborhood line_neighbor = LineNeighborhood::Create<kSemiThreeCheck>(move, *this);
 
   static constexpr PositionState S = GetPlayerStone(P);
   line_neighbor.SetCenterState<S>();
@@ -360,6 +398,14 @@ inline void BitBoard::EnumerateForbiddenMoves(MoveBitSet * const forbidden_move_
   EnumerateForbiddenMoves(board_open_state, forbidden_move_set);
 }
 
+inline void BitBoard::EnumerateForbiddenMoves(MoveBitSet * const forbidden_move_set)
+{
+  BoardOpenState board_open_state;
+  GetBoardOpenState(kUpdateForbiddenCheck, &board_open_state);
+  
+  EnumerateForbiddenMoves(board_open_state, forbidden_move_set);
+}
+
 template<PlayerTurn P>
 void BitBoard::EnumerateDoubleFourMoves(const BoardOpenState &board_open_state, MoveBitSet * const double_four_move_set) const
 {
@@ -644,7 +690,7 @@ template<PlayerTurn P>
 inline const bool BitBoard::IsFiveStones(const MovePosition move) const
 {
   static constexpr PositionState S = GetPlayerStone(P);
-  LineNeighborhood line_neighbor(move, kOpenStateNeighborhoodSize, *this);
+  LineNeighborhood line_neighbor = LineNeighborhood::Create<kOpenStateNeighborhoodSize>(move, *this);
   line_neighbor.SetCenterState<S>();
 
   return line_neighbor.IsFive<P>();
@@ -671,7 +717,7 @@ template<PlayerTurn P>
 inline const bool BitBoard::IsOverline(const MovePosition move) const
 {
   static constexpr PositionState S = GetPlayerStone(P);
-  LineNeighborhood line_neighbor(move, kOpenStateNeighborhoodSize, *this);
+  LineNeighborhood line_neighbor = LineNeighborhood::Create<kOpenStateNeighborhoodSize>(move, *this);
   line_neighbor.SetCenterState<S>();
 
   return line_neighbor.IsOverline<P>();
@@ -8,8 +8,10 @@
 
 #include <cstdint>
 #include <array>
+#include <vector>
 
 #include "BitSearch.h"
+#include "LineNeighborhood.h"
 #include "BoardOpenState.h"
 
 namespace realcore
@@ -25,10 +27,35 @@ enum MovePosition : std::uint8_t;
 class BoardOpenState;
 class BitBoard;
 class BitBoardTest;
+class BitPlaneBoard;
 class MoveList;
 
 typedef std::bitset<kMoveNum> MoveBitSet;
 
+//! @brief 指し手位置の1方向分のBitBoard配列上の位置
+struct StateBitPosition
+{
+  StateBit mask;          //!< 指し手位置の2bitを取り出すマスク(盤外の指し手は0)
+  std::uint32_t index;    //!< StateBit配列のindex
+  std::uint32_t shift;    //!< StateBit配列のshift量
+};
+
+//! @brief 全指し手位置の各方向のBitBoard配列上の位置テーブル
+struct StateBitPositionTable
+{
+  StateBitPosition position_list[kMoveNum][kBoardDirectionNum];
+};
+
+//! @brief 指し手位置の各方向のBitBoard配列上の位置テーブル(BitBoard.ccでconstexprとして定義)
+//! @note コンパイル時に生成するため、他の翻訳単位の静的初期化から参照してもよい
+extern const StateBitPositionTable kStateBitPositionTable;
+
+//! @brief 指し手位置の各方向のBitBoard配列上の位置を取得する
+//! @param move 指し手位置
+//! @retval 各方向(BoardDirection順)の(mask, index, shift)
+//! @note 盤外の指し手はmaskが0になるため、maskを用いた更新は何もしない
+inline const StateBitPosition* GetStateBitPositionList(const MovePosition move);
+
 //! @brief 2つのBitBoardを比較する
 //! @param bit_board_1, 2: 比較対象
 //! @retval true 2つのBoardが同一の内容を保持
@@ -39,9 +66,17 @@ bool IsEqual(const BitBoard &bit_board_1, const BitBoard &bit_board_2);
 //! @param bit_board_to コピー先
 void Copy(const BitBoard &bit_board_from, BitBoard * const bit_board_to);
 
+//! @brief 現在のスレッドでBitBoardをコピーした回数を取得する
+//! @note REALCORE_COUNT_BIT_BOARD_COPYを定義してビルドした場合のみ計測し、未定義の場合は常に0を返す
+const std::uint64_t GetBitBoardCopyCount();
+
+//! @brief 現在のスレッドのBitBoardのコピー回数を0にする
+void ResetBitBoardCopyCount();
+
 class BitBoard
 {
   friend class BitBoardTest;
+  friend class BitPlaneBoard;
   friend bool IsEqual(const BitBoard &bit_board_1, const BitBoard &bit_board_2);
   friend void Copy(const BitBoard &bit_board_from, BitBoard * const bit_board_to);
 
@@ -86,6 +121,14 @@ public:
   template<PositionState State>
   void SetState(const MoveBitSet &move_bit_set);
 
+  //! @brief SetState<State>で置いた石を取り除く
+  //! @param State 取り除く石(kBlackStone or kWhiteStone)
+  //! @param move 指し手位置
+  //! @pre moveにStateの石が置かれていること
+  //! @note SetStateと同じXORマスクを再度適用して元の空点に戻す
+  template<PositionState State>
+  void RemoveStone(const MovePosition move);
+
   //! @brief 指定位置を中心としたN路の直線近傍の盤面状態(各方向2N+1個の状態)を取得する
   //! @param N 直線近傍の長さ
   //! @param move 指し手位置
@@ -96,6 +139,16 @@ public:
   template<size_t N>
   void GetLineNeighborhoodStateBit(const MovePosition move, std::array<StateBit, kBoardDirectionNum> * const line_neighborhood_list) const;
 
+  //! @brief 指定位置を中心としたN路の直線近傍の盤面状態をLocalBitBoardの形式で取得する
+  //! @param N 直線近傍の長さ
+  //! @param move 指し手位置
+  //! @param local_bit_board 直線近傍の盤面状態の格納先
+  //! @pre N in [1, 7]
+  //! @note 横/縦方向をlocal_bit_board[0], 左斜め/右斜め方向をlocal_bit_board[1]の下位/上位32bitに設定する
+  //! @note 方向ごとの取り出しと格納を分岐せずに行う
+  template<size_t N>
+  void GetLocalBitBoard(const MovePosition move, LocalBitBoard * const local_bit_board) const;
+
   //! @brief 盤面状態を文字列出力する
   //! @retval 盤面をテキスト表現した文字列
   const std::string str() const;
@@ -174,9 +227,16 @@ public:
 
   //! @brief 禁点を列挙する
   //! @param 禁点の格納先
+  //! @note const版は見かけの三々点が存在する場合に盤面を1度だけコピーし、コピーした盤面で三々をチェックする
   void EnumerateForbiddenMoves(const BoardOpenState &board_open_state, MoveBitSet * const forbidden_move_set) const;
   void EnumerateForbiddenMoves(MoveBitSet * const forbidden_move_set) const;
 
+  //! @brief 禁点を列挙する(盤面直接更新版)
+  //! @note 盤面をコピーせず、盤面への着手/取り消しで三々をチェックする(終了時には元の盤面に戻る)
+  //! @note チェック中は盤面を変更するため、他スレッドと共有している盤面には使用できない
+  void EnumerateForbiddenMoves(const BoardOpenState &board_open_state, MoveBitSet * const forbidden_move_set);
+  void EnumerateForbiddenMoves(MoveBitSet * const forbidden_move_set);
+
   //! @brief 達四点を列挙する
   template<PlayerTurn P>
   void EnumerateOpenFourMoves(const BoardOpenState &board_open_state, MoveBitSet * const open_four_move_set) const;
@@ -228,6 +288,30 @@ public:
   void EnumerateDoubleSemiThreeMoves(const BoardOpenState &board_open_state, MoveBitSet * const double_semi_three_move_set) const;
 
 private:
+  //! @brief 指定位置が14-15bit目になるようにシフトしたStateBitを返す
+  const StateBit GetCenterAlignedStateBit(const StateBitPosition &state_bit_position) const;
+
+  //! @brief 直線近傍の禁手チェックを行う
+  //! @param next_open_four_list 見かけの三々の場合、達四を作る位置の格納先
+  //! @note 影響領域はIsForbiddenMoveと同様に設定する
+  const ForbiddenCheckState CheckLineNeighborhoodForbidden(const MovePosition move, std::vector<BoardPosition> * const next_open_four_list, MoveBitSet * const downward_influence_area, MoveBitSet * const black_upward_influence_area) const;
+
+  //! @brief 黒番の指し手が禁手かチェックする(盤面直接更新版)
+  //! @note 再帰チェックで置いた石はチェック後に取り除くため、盤面をコピーせずに済む
+  //! @note チェック中は盤面を変更するため、他スレッドと共有している盤面には使用できない
+  const bool IsForbiddenMoveInPlace(const MovePosition move, MoveBitSet * const downward_influence_area, MoveBitSet * const black_upward_influence_area, MoveBitSet * const white_upward_influence_area);
+
+  //! @brief 長連点・四々点を禁点に設定し、見かけの三々点を列挙する
+  //! @param double_semi_three_move_set 見かけの三々点の格納先
+  void EnumerateForbiddenCandidates(const BoardOpenState &board_open_state, MoveBitSet * const forbidden_move_set, MoveBitSet * const double_semi_three_move_set) const;
+
+  //! @brief 見かけの三々点のうち三々点であるものを禁点に設定する(盤面直接更新版)
+  void EnumerateDoubleThreeMovesInPlace(const BoardOpenState &board_open_state, const MoveBitSet &double_semi_three_move_set, MoveBitSet * const forbidden_move_set);
+
+  //! @brief 見かけの三々が三々かどうかを達四を作る位置の禁手チェックにより判定する
+  //! @param next_open_four_list 達四を作る位置
+  const bool IsDoubleThreeInPlace(const MovePosition move, const std::vector<BoardPosition> &next_open_four_list, MoveBitSet * const downward_influence_area, MoveBitSet * const black_upward_influence_area, MoveBitSet * const white_upward_influence_area);
+
   //! 指し手パターンの空点状態を取得する
   template<OpenStatePattern Pattern>
   void GetOpenState(const size_t index, const std::uint64_t combined_stone_bit, const std::uint64_t combined_open_bit, BoardOpenState * const board_open_state) const;
@@ -261,6 +345,26 @@ private:
   Bitboard bit_board_;    //!< 盤面状態を保持するBit board
 };    // class BitBoard
 
+//! @brief 石を置き、スコープを抜ける際に取り除く
+//! @param State 置く石(kBlackStone or kWhiteStone)
+//! @pre 石を置く位置は空点であること
+template<PositionState State>
+class ScopedStone
+{
+  static_assert(State == kBlackStone || State == kWhiteStone, "State must be kBlackStone or kWhiteStone");
+
+public:
+  ScopedStone(const MovePosition move, BitBoard * const bit_board);
+  ~ScopedStone();
+
+  ScopedStone(const ScopedStone &) = delete;
+  ScopedStone& operator=(const ScopedStone &) = delete;
+
+private:
+  const MovePosition move_;       //!< 石を置いた位置
+  BitBoard * const bit_board_;    //!< 石を置いた盤面
+};
+
 }   // namespace realcore
 
 #include "BitBoard-inl.h"
@@ -0,0 +1,169 @@
+#ifndef BIT_PLANE_BOARD_INL_H
+#define BIT_PLANE_BOARD_INL_H
+
+#include <cassert>
+
+#include "Conversion.h"
+#include "MovePatternSearch.h"
+#include "BitPlaneBoard.h"
+
+namespace realcore{
+
+inline const size_t GetBitPlaneIndex(const StateBitPosition &state_bit_position)
+{
+  return state_bit_position.index / 2;
+}
+
+inline const std::uint64_t GetBitPlaneBit(const StateBitPosition &state_bit_position)
+{
+  // BitBoard配列の奇数indexは石フラグを1bit左シフトして結合する(GetCombinedBitと同じ配置)
+  return (state_bit_position.mask & kUpperBitMask) << (state_bit_position.index % 2);
+}
+
+inline const PositionState BitPlaneBoard::GetState(const MovePosition move) const
+{
+  const StateBitPosition &position = GetStateBitPositionList(move)[kLateralDirection];
+  const std::uint64_t plane_bit = GetBitPlaneBit(position);
+
+  if(plane_bit == 0){
+    return kOverBoard;
+  }
+
+  const size_t plane_index = GetBitPlaneIndex(position);
+
+  if(black_plane_[plane_index] & plane_bit){
+    return kBlackStone;
+  }
+
+  if(white_plane_[plane_index] & plane_bit){
+    return kWhiteStone;
+  }
+
+  return kOpenPosition;
+}
+
+template<>
+inline void BitPlaneBoard::SetState<kOverBoard>(const MovePosition move)
+{
+  assert(false);
+}
+
+template<>
+inline void BitPlaneBoard::SetState<kBlackStone>(const MovePosition move)
+{
+  // 盤外の指し手はフラグが0のため分岐せずに更新しても盤面は変化しない
+  const StateBitPosition * const position_list = GetStateBitPositionList(move);
+
+  for(const auto direction : GetBoardDirection()){
+    black_plane_[GetBitPlaneIndex(position_list[direction])] ^= GetBitPlaneBit(position_list[direction]);
+  }
+}
+
+template<>
+inline void BitPlaneBoard::SetState<kWhiteStone>(const MovePosition move)
+{
+  const StateBitPosition * const position_list = GetStateBitPositionList(move);
+
+  for(const auto direction : GetBoardDirection()){
+    white_plane_[GetBitPlaneIndex(position_list[direction])] ^= GetBitPlaneBit(position_list[direction]);
+  }
+}
+
+template<>
+inline void BitPlaneBoard::SetState<kOpenPosition>(const MovePosition move)
+{
+  const StateBitPosition * const position_list = GetStateBitPositionList(move);
+
+  for(const auto direction : GetBoardDirection()){
+    const size_t plane_index = GetBitPlaneIndex(position_list[direction]);
+    const std::uint64_t plane_bit = GetBitPlaneBit(position_list[direction]);
+
+    black_plane_[plane_index] &= ~plane_bit;
+    white_plane_[plane_index] &= ~plane_bit;
+  }
+}
+
+inline void BitPlaneBoard::SetState(const MovePosition move, const PositionState state)
+{
+  switch(state){
+  case kOverBoard:
+    SetState<kOverBoard>(move);
+    break;
+
+  case kBlackStone:
+    SetState<kBlackStone>(move);
+    break;
+
+  case kWhiteStone:
+    SetState<kWhiteStone>(move);
+    break;
+
+  case kOpenPosition:
+    SetState<kOpenPosition>(move);
+    break;
+  }
+}
+
+inline const BitPlane& BitPlaneBoard::GetBlackStonePlane() const
+{
+  return black_plane_;
+}
+
+inline const BitPlane& BitPlaneBoard::GetWhiteStonePlane() const
+{
+  return white_plane_;
+}
+
+template<OpenStatePattern Pattern>
+void BitPlaneBoard::GetOpenState(const size_t plane_index, const std::uint64_t stone_bit, const std::uint64_t open_bit, BoardOpenState * const board_open_state) const
+{
+  constexpr bool is_multiple_stone_pattern = (Pattern == kNextOverline) || (Pattern == kNextOpenFourBlack) || (Pattern == kNextOpenFourWhite) ||
+    (Pattern == kNextFourBlack) || (Pattern == kNextFourWhite) || (Pattern == kNextSemiThreeBlack) || (Pattern == kNextSemiThreeWhite) || (Pattern == kNextPointOfSwordBlack) || (Pattern == kNextPointOfSwordWhite);
+
+  if(is_multiple_stone_pattern && (stone_bit == 0 || IsSingleBit(stone_bit))){
+    return;
+  }
+
+  constexpr size_t kPatternNum = GetOpenStatePatternNum(Pattern);
+  std::array<std::uint64_t, kPatternNum> pattern_search{{0}};
+  SearchOpenStatePattern<Pattern>(stone_bit, open_bit, &pattern_search);
+
+  for(size_t pattern_index=0; pattern_index<kPatternNum; pattern_index++){
+    std::uint64_t search_bit = pattern_search[pattern_index];
+
+    while(search_bit != 0){
+      const std::uint64_t rightmost_bit = GetRightmostBit(search_bit);
+      const size_t combined_shift = GetNumberOfTrailingZeros(search_bit, rightmost_bit);
+      search_bit ^= rightmost_bit;
+
+      // 結合bitの偶数位置はBitBoard配列の偶数index, 奇数位置は奇数indexに対応する
+      const size_t bit_board_index = 2 * plane_index + combined_shift % 2;
+      const size_t bit_board_shift = combined_shift - combined_shift % 2;
+
+      const BoardPosition pattern_position = GetBoardPosition(bit_board_index, bit_board_shift);
+      board_open_state->AddOpenState<Pattern>(pattern_index, pattern_position);
+    }
+  }
+}
+
+template<PlayerTurn P>
+void BitPlaneBoard::EnumerateFourMoves(MoveBitSet * const four_move_set) const
+{
+  assert(four_move_set != nullptr);
+  assert(four_move_set->none());
+
+  constexpr OpenStatePattern kPattern = (P == kBlackTurn) ? kNextFourBlack : kNextFourWhite;
+  const UpdateOpenStateFlag update_flag(P == kBlackTurn ? kUpdateFlagFourBlack : kUpdateFlagFourWhite);
+
+  BoardOpenState board_open_state(update_flag);
+  GetBoardOpenState(update_flag, &board_open_state);
+
+  for(const auto &open_state : board_open_state.GetList(kPattern)){
+    const auto open_position = open_state.GetOpenPosition();
+    four_move_set->set(GetBoardMove(open_position));
+  }
+}
+
+}   // namespace realcore
+
+#endif    // BIT_PLANE_BOARD_INL_H
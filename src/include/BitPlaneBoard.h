@@ -0,0 +1,112 @@
+//! @file
+//! @brief 黒石/白石のbitplaneで盤面を保持するBitPlaneBoardの定義
+//! @author Koichi NABETANI
+//! @date 2017/06/10
+
+#ifndef BIT_PLANE_BOARD_H
+#define BIT_PLANE_BOARD_H
+
+#include <cstdint>
+#include <array>
+
+#include "BitBoard.h"
+
+namespace realcore
+{
+//! @brief BitPlane(=uint64_t配列)の要素数
+//! @note 横/縦/左斜め/右斜め方向の各256bitを4要素ずつ保持する
+constexpr size_t kBitPlaneElementNum = kBitBoardElementNum / 2;
+
+//! @brief BitPlane型
+//! @note 各要素はBitBoard配列の2要素(index: 2i, 2i+1)を結合した石フラグ(GetCombinedBitと同じ配置)
+typedef std::array<std::uint64_t, kBitPlaneElementNum> BitPlane;
+
+// 前方宣言
+class BitPlaneBoardTest;
+
+//! @brief 盤内の位置に1を立てたBitPlaneを返す
+const BitPlane& GetInBoardBitPlane();
+
+//! @brief BitBoard配列上の位置に対応するBitPlaneのindexを返す
+inline const size_t GetBitPlaneIndex(const StateBitPosition &state_bit_position);
+
+//! @brief BitBoard配列上の位置に対応するBitPlaneのフラグを返す
+//! @note 盤外の位置(maskが0)は0を返す
+inline const std::uint64_t GetBitPlaneBit(const StateBitPosition &state_bit_position);
+
+//! @brief 黒石/白石のbitplaneで盤面を保持するクラス
+//! @note 石フラグを直接保持するため、パターン検索時にStateBitから石/空点フラグを抽出する必要がない
+//! @note 三々の判定はLineNeighborhoodを用いるため、BitBoardに変換して行う
+class BitPlaneBoard
+{
+  friend class BitPlaneBoardTest;
+
+public:
+  BitPlaneBoard();
+  BitPlaneBoard(const MoveList &move_list);
+  explicit BitPlaneBoard(const BitBoard &bit_board);
+
+  //! @brief 比較演算子
+  const bool operator==(const BitPlaneBoard &bit_plane_board) const;
+  const bool operator!=(const BitPlaneBoard &bit_plane_board) const;
+
+  //! @brief 盤面状態を取得する
+  //! @param move 指し手位置
+  //! @retval 指定位置の盤面状態
+  //! @note moveが盤内以外の場合、kOverBoardを返す
+  const PositionState GetState(const MovePosition move) const;
+
+  //! @brief 盤面状態を設定する(template版)
+  //! @param State 設定する盤面状態
+  //! @param move 指し手位置
+  //! @note 石の設定はBitBoard::SetStateと同様にXORで行うため、同じ石を再度設定すると空点に戻る
+  template<PositionState State>
+  void SetState(const MovePosition move);
+
+  //! @brief 盤面状態を設定する(non-template版)
+  void SetState(const MovePosition move, const PositionState state);
+
+  //! @brief 黒石のbitplaneを返す
+  const BitPlane& GetBlackStonePlane() const;
+
+  //! @brief 白石のbitplaneを返す
+  const BitPlane& GetWhiteStonePlane() const;
+
+  //! @brief 空点のbitplaneを生成する
+  void GetOpenPositionPlane(BitPlane * const open_position_plane) const;
+
+  //! @brief 空点状態を取得する
+  //! @param update_flag 取得する指し手パターンのフラグ
+  //! @param board_open_state 空点状態の格納先
+  //! @note BitBoard::GetBoardOpenStateと同じ空点状態を生成する
+  void GetBoardOpenState(const UpdateOpenStateFlag &update_flag, BoardOpenState * const board_open_state) const;
+
+  //! @brief 四ノビ点を列挙する
+  //! @param P 手番
+  //! @param four_move_set 四ノビ点の格納先
+  template<PlayerTurn P>
+  void EnumerateFourMoves(MoveBitSet * const four_move_set) const;
+
+  //! @brief 禁点を列挙する
+  //! @param forbidden_move_set 禁点の格納先
+  void EnumerateForbiddenMoves(MoveBitSet * const forbidden_move_set) const;
+
+  //! @brief BitBoardに変換する
+  //! @param bit_board 変換結果の格納先
+  void GetBitBoard(BitBoard * const bit_board) const;
+
+private:
+  //! @brief 指し手パターンの空点状態を取得する
+  //! @param plane_index BitPlaneのindex
+  template<OpenStatePattern Pattern>
+  void GetOpenState(const size_t plane_index, const std::uint64_t stone_bit, const std::uint64_t open_bit, BoardOpenState * const board_open_state) const;
+
+  BitPlane black_plane_;    //!< 黒石のbitplane
+  BitPlane white_plane_;    //!< 白石のbitplane
+};    // class BitPlaneBoard
+
+}   // namespace realcore
+
+#include "BitPlaneBoard-inl.h"
+
+#endif    // BIT_PLANE_BOARD_H
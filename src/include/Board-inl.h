@@ -10,6 +10,17 @@
 
 namespace realcore
 {
+inline const HashValue Board::GetHashValue() const
+{
+  assert(!board_hash_value_list_.empty());
+  return board_hash_value_list_.back();
+}
+
+inline void Board::SetForbiddenMoveTable(ForbiddenMoveTable * const forbidden_move_table)
+{
+  forbidden_move_table_ = forbidden_move_table;
+}
+
 template<PlayerTurn P>
 inline void Board::EnumerateOpenFourMoves(MoveBitSet * const open_four_move_set) const
 {
@@ -14,6 +14,7 @@
 #include "RealCore.h"
 #include "BitBoard.h"
 #include "MoveList.h"
+#include "HashTable.h"
 #include "BoardOpenState.h"
 
 namespace realcore
@@ -22,6 +23,7 @@ namespace realcore
 enum MovePosition : std::uint8_t;
 class BoardTest;
 class Board;
+class ForbiddenMoveTable;
 
 //! @brief 2つのBoardを比較する
 //! @param board_1, 2: 比較対象
@@ -119,7 +121,20 @@ public:
 
   //! @brief 禁点を列挙する
   //! @param 禁点の格納先
+  //! @note 禁手点キャッシュを設定している場合はキャッシュを参照し、未登録の局面は列挙結果を登録する
+  //! @note const版は三々のチェックに盤面を1度だけコピーし、非const版はコピーせずに盤面への着手/取り消しでチェックする
+  //! @note 非const版はチェック中に盤面を変更するため(終了時には元の盤面に戻る)、他スレッドと共有している盤面には使用できない
   void EnumerateForbiddenMoves(MoveBitSet * const forbidden_move_set) const;
+  void EnumerateForbiddenMoves(MoveBitSet * const forbidden_move_set);
+
+  //! @brief 局面のHash値を返す
+  //! @note MakeMove/UndoMoveで差分計算した値を返し、CalcHashValue(指し手リスト)と一致する
+  const HashValue GetHashValue() const;
+
+  //! @brief EnumerateForbiddenMovesで参照する禁手点キャッシュを設定する
+  //! @param forbidden_move_table 禁手点キャッシュ(nullptrの場合はキャッシュを参照しない)
+  //! @note キャッシュは複数のBoardで共有でき、Boardはキャッシュを所有しない
+  void SetForbiddenMoveTable(ForbiddenMoveTable * const forbidden_move_table);
 
   //! @brief 達四点を列挙する
   template<PlayerTurn P>
@@ -168,6 +183,11 @@ protected:
   const bool TerminateCheckBlack(MovePosition * const terminating_move) const;
   const bool TerminateCheckWhite(MovePosition * const terminating_move) const;
 
+  //! @brief 禁手点キャッシュを参照し、未登録の局面はbit_boardで禁点を列挙する
+  //! @param bit_board 禁点を列挙するBitBoard(constの場合は盤面をコピーしてチェックする)
+  template<class BitBoardType>
+  void EnumerateForbiddenMoves(BitBoardType * const bit_board, MoveBitSet * const forbidden_move_set) const;
+
   //! @brief 盤面が対称形か返す
   //! @param symmetry 対称性
   bool IsBoardSymmetric(const BoardSymmetry symmetry) const;
@@ -180,6 +200,12 @@ protected:
 
   //! @brief 盤面空点状態リスト
   std::vector<BoardOpenState> board_open_state_list_;
+
+  //! @brief 局面のHash値リスト(初期局面から現局面まで)
+  std::vector<HashValue> board_hash_value_list_;
+
+  //! @brief 禁手点キャッシュ
+  ForbiddenMoveTable *forbidden_move_table_;
 };
 
 }   // namespace realcore
@@ -0,0 +1,77 @@
+#ifndef CSV_READER_INL_H
+#define CSV_READER_INL_H
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+#include "CSVReader.h"
+
+namespace realcore
+{
+
+inline const StringVector& MappedCSVReader::GetHeader() const
+{
+  return header_;
+}
+
+inline const size_t MappedCSVReader::GetProjectionSize() const
+{
+  return projection_size_;
+}
+
+inline const CSVChunk MappedCSVReader::GetChunk() const
+{
+  return CSVChunk{data_, data_end_};
+}
+
+template<class Function>
+const bool MappedCSVReader::ForEachRow(const Function &function) const
+{
+  return ForEachRow(GetChunk(), function);
+}
+
+template<class Function>
+const bool MappedCSVReader::ForEachRow(const CSVChunk &chunk, const Function &function) const
+{
+  assert(chunk.begin <= chunk.end);
+
+  CSVRow row(projection_size_);
+  const char *line_begin = chunk.begin;
+
+  while(line_begin < chunk.end){
+    const char *line_end = static_cast<const char*>(std::memchr(line_begin, '\n', chunk.end - line_begin));
+    const char *next_line = line_end == nullptr ? chunk.end : line_end + 1;
+
+    if(line_end == nullptr){
+      line_end = chunk.end;
+    }
+
+    if(line_end != line_begin && *(line_end - 1) == '\r'){
+      --line_end;
+    }
+
+    if(line_end == line_begin){
+      // 空行はスキップする
+      line_begin = next_line;
+      continue;
+    }
+
+    if(!SplitRow(line_begin, line_end, &row)){
+      // ヘッダとデータ行の列数が異なる
+      std::cerr << "Column numbers are not same." << std::endl;
+      std::cerr << "\theader num: " << header_.size() << std::endl;
+      std::cerr << "\tline data: " << std::string(line_begin, line_end) << std::endl;
+      return false;
+    }
+
+    function(static_cast<const CSVRow&>(row));
+    line_begin = next_line;
+  }
+
+  return true;
+}
+
+}   // namespace realcore
+
+#endif    // CSV_READER_INL_H
@@ -6,15 +6,23 @@
 #ifndef CSV_READER_H
 #define CSV_READER_H
 
+#include <memory>
 #include <vector>
 #include <map>
 #include <string>
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/utility/string_view.hpp>
+
 namespace realcore{
 
 //! @brief 文字列リスト
 typedef std::vector<std::string> StringVector;
 
+//! @brief CSVの1行の値(参照先はMappedCSVReaderがマップした領域)
+typedef std::vector<boost::string_view> CSVRow;
+
 //! @brief Header付きのCSVを読み込む関数
 //! @param csv_file CSVファイルパス
 //! @param *csv_data 読み込んだCSVデータ(headerをkeyとするStringVector)
@@ -24,6 +32,93 @@ bool ReadCSV(const std::string &csv_file, std::map<std::string, StringVector> *
 //! 1行のテキストデータをカンマで区切る関数
 void CSVSplitter(const std::string &line, StringVector * const line_data);
 
+//! @brief CSVのデータ行の範囲
+//! @note 行の先頭から始まり、行の終端(改行の直後 or ファイル終端)で終わる
+struct CSVChunk
+{
+  const char *begin;    //!< 範囲の先頭
+  const char *end;      //!< 範囲の終端
+};
+
+// 前方宣言
+class MappedCSVReaderTest;
+
+//! @brief Header付きのCSVをmmapして1パスで読み込むクラス
+//! @note 値は文字列を複製せずマップした領域へのstring_viewで返すため、Close後は参照できない
+//! @note 空行は読み飛ばし、行末の"\r"は取り除く
+//! @note 読込関数はconstのため、チャンクに分割して複数スレッドから並列に読み込める
+class MappedCSVReader
+{
+  friend class MappedCSVReaderTest;
+
+public:
+  MappedCSVReader();
+
+  //! @brief CSVファイルをmmapしてheaderを読み込む
+  //! @retval true: 読込成功, false: ファイルが存在しない or 空ファイル
+  const bool Open(const std::string &csv_file);
+
+  //! @brief メモリ上のCSVを参照してheaderを読み込む
+  //! @note dataは参照中に解放しないこと
+  //! @retval true: 読込成功, false: 空データ
+  const bool Attach(const char * const data, const size_t data_size);
+
+  //! @brief 参照を解除する
+  void Close();
+
+  //! @brief headerを返す
+  const StringVector& GetHeader() const;
+
+  //! @brief 読み込むカラムを設定する
+  //! @param column_list 読み込むカラム名のリスト(CSVRowはこの順で値を格納する)
+  //! @retval true: 設定成功, false: headerに存在しないカラムがある
+  //! @note 初期状態はheaderの全カラムを読み込む
+  const bool SetProjection(const StringVector &column_list);
+
+  //! @brief 読み込むカラム数を返す
+  const size_t GetProjectionSize() const;
+
+  //! @brief データ行の全範囲を返す
+  const CSVChunk GetChunk() const;
+
+  //! @brief データ行を行の境界でおおよそ等しいサイズのチャンクに分割する
+  //! @param chunk_count 分割数
+  //! @param chunk_list チャンクの格納先(データ量が少ない場合はchunk_count未満になる)
+  void SplitChunk(const size_t chunk_count, std::vector<CSVChunk> * const chunk_list) const;
+
+  //! @brief データ行の改行数を数える
+  //! @note 空行を含むため、データ行数の上限値として用いる
+  const size_t CountLine(const CSVChunk &chunk) const;
+
+  //! @brief 全データ行を読み込み、行ごとに関数を呼び出す
+  //! @param function void(const CSVRow &row)の関数
+  //! @retval true: 読込成功, false: headerとカラム数が異なる行がある
+  template<class Function>
+  const bool ForEachRow(const Function &function) const;
+
+  //! @brief チャンク内のデータ行を読み込み、行ごとに関数を呼び出す
+  template<class Function>
+  const bool ForEachRow(const CSVChunk &chunk, const Function &function) const;
+
+private:
+  //! @brief 1行をカンマで区切り、読み込むカラムの値をrowに格納する
+  //! @retval true: 分割成功, false: headerとカラム数が異なる
+  const bool SplitRow(const char * const line_begin, const char * const line_end, CSVRow * const row) const;
+
+  const char *data_;          //!< データ行の先頭
+  const char *data_end_;      //!< データの終端
+  StringVector header_;       //!< header
+
+  //! @brief headerのカラムindexごとの読込先index(読み込まないカラムはkNoProjection)
+  std::vector<size_t> projection_index_list_;
+  size_t projection_size_;    //!< 読み込むカラム数
+
+  std::unique_ptr<boost::interprocess::file_mapping> file_mapping_;    //!< mmapしたファイル
+  std::unique_ptr<boost::interprocess::mapped_region> mapped_region_;  //!< mmapした領域
+};
+
 }   // realcore
 
-#endif    // CSV_READER_H
\ No newline at end of file
+#include "CSVReader-inl.h"
+
+#endif    // CSV_READER_H
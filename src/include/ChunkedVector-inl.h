@@ -0,0 +1,194 @@
+#ifndef CHUNKED_VECTOR_INL_H
+#define CHUNKED_VECTOR_INL_H
+
+#include <cassert>
+#include <new>
+#include <utility>
+
+#include "ChunkedVector.h"
+
+namespace realcore
+{
+
+template<class T, size_t kChunkBits>
+constexpr size_t ChunkedVector<T, kChunkBits>::kChunkSize;
+
+template<class T, size_t kChunkBits>
+constexpr size_t ChunkedVector<T, kChunkBits>::kChunkMask;
+
+template<class T, size_t kChunkBits>
+inline ChunkedVector<T, kChunkBits>::ChunkedVector()
+: size_(0)
+{
+}
+
+template<class T, size_t kChunkBits>
+ChunkedVector<T, kChunkBits>::ChunkedVector(const ChunkedVector<T, kChunkBits> &rhs)
+: size_(0)
+{
+  *this = rhs;
+}
+
+template<class T, size_t kChunkBits>
+inline ChunkedVector<T, kChunkBits>::ChunkedVector(ChunkedVector<T, kChunkBits> &&rhs)
+: size_(0)
+{
+  swap(rhs);
+}
+
+template<class T, size_t kChunkBits>
+inline ChunkedVector<T, kChunkBits>::~ChunkedVector()
+{
+  clear();
+}
+
+template<class T, size_t kChunkBits>
+ChunkedVector<T, kChunkBits>& ChunkedVector<T, kChunkBits>::operator=(const ChunkedVector<T, kChunkBits> &rhs)
+{
+  if(this != &rhs){
+    clear();
+    reserve(rhs.size());
+
+    for(size_t i=0, size=rhs.size(); i<size; i++){
+      emplace_back(rhs[i]);
+    }
+  }
+
+  return *this;
+}
+
+template<class T, size_t kChunkBits>
+inline ChunkedVector<T, kChunkBits>& ChunkedVector<T, kChunkBits>::operator=(ChunkedVector<T, kChunkBits> &&rhs)
+{
+  if(this != &rhs){
+    clear();
+    swap(rhs);
+  }
+
+  return *this;
+}
+
+template<class T, size_t kChunkBits>
+const bool ChunkedVector<T, kChunkBits>::operator==(const ChunkedVector<T, kChunkBits> &rhs) const
+{
+  if(size() != rhs.size()){
+    return false;
+  }
+
+  for(size_t i=0, size=size_; i<size; i++){
+    if((*this)[i] != rhs[i]){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template<class T, size_t kChunkBits>
+inline const bool ChunkedVector<T, kChunkBits>::operator!=(const ChunkedVector<T, kChunkBits> &rhs) const
+{
+  return !(*this == rhs);
+}
+
+template<class T, size_t kChunkBits>
+inline T& ChunkedVector<T, kChunkBits>::operator[](const size_t index)
+{
+  assert(index < size_);
+  return *GetElementPointer(index);
+}
+
+template<class T, size_t kChunkBits>
+inline const T& ChunkedVector<T, kChunkBits>::operator[](const size_t index) const
+{
+  assert(index < size_);
+  return *GetElementPointer(index);
+}
+
+template<class T, size_t kChunkBits>
+inline T& ChunkedVector<T, kChunkBits>::back()
+{
+  assert(!empty());
+  return (*this)[size_ - 1];
+}
+
+template<class T, size_t kChunkBits>
+inline const T& ChunkedVector<T, kChunkBits>::back() const
+{
+  assert(!empty());
+  return (*this)[size_ - 1];
+}
+
+template<class T, size_t kChunkBits>
+template<class... Args>
+inline void ChunkedVector<T, kChunkBits>::emplace_back(Args&&... args)
+{
+  if(size_ == capacity()){
+    chunk_list_.emplace_back(new ElementStorage[kChunkSize]);
+  }
+
+  new(GetElementPointer(size_)) T(std::forward<Args>(args)...);
+  size_++;
+}
+
+template<class T, size_t kChunkBits>
+inline void ChunkedVector<T, kChunkBits>::push_back(const T &element)
+{
+  emplace_back(element);
+}
+
+template<class T, size_t kChunkBits>
+inline const size_t ChunkedVector<T, kChunkBits>::size() const
+{
+  return size_;
+}
+
+template<class T, size_t kChunkBits>
+inline const bool ChunkedVector<T, kChunkBits>::empty() const
+{
+  return size_ == 0;
+}
+
+template<class T, size_t kChunkBits>
+inline const size_t ChunkedVector<T, kChunkBits>::capacity() const
+{
+  return chunk_list_.size() * kChunkSize;
+}
+
+template<class T, size_t kChunkBits>
+void ChunkedVector<T, kChunkBits>::reserve(const size_t element_count)
+{
+  const size_t chunk_count = (element_count + kChunkSize - 1) / kChunkSize;
+  chunk_list_.reserve(chunk_count);
+
+  while(chunk_list_.size() < chunk_count){
+    chunk_list_.emplace_back(new ElementStorage[kChunkSize]);
+  }
+}
+
+template<class T, size_t kChunkBits>
+void ChunkedVector<T, kChunkBits>::clear()
+{
+  for(size_t i=0; i<size_; i++){
+    GetElementPointer(i)->~T();
+  }
+
+  size_ = 0;
+}
+
+template<class T, size_t kChunkBits>
+inline void ChunkedVector<T, kChunkBits>::swap(ChunkedVector<T, kChunkBits> &rhs)
+{
+  chunk_list_.swap(rhs.chunk_list_);
+  std::swap(size_, rhs.size_);
+}
+
+template<class T, size_t kChunkBits>
+inline T* ChunkedVector<T, kChunkBits>::GetElementPointer(const size_t index) const
+{
+  ElementStorage * const chunk = chunk_list_[index >> kChunkBits].get();
+  return reinterpret_cast<T*>(&chunk[index & kChunkMask]);
+}
+
+}   // namespace realcore
+
+#endif    // CHUNKED_VECTOR_INL_H
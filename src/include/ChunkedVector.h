@@ -0,0 +1,96 @@
+//! @file
+//! @brief 要素を再配置しない可変長配列の定義
+//! @author Koichi NABETANI
+//! @date 2017/06/03
+#ifndef CHUNKED_VECTOR_H
+#define CHUNKED_VECTOR_H
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace realcore
+{
+
+// 前方宣言
+class ChunkedVectorTest;
+
+//! @brief 固定長のチャンク単位で領域を確保する可変長配列
+//! @param kChunkBits 1チャンクの要素数(2^kChunkBits)
+//! @note 追加時に既存要素を移動/コピーしないため、要素への参照・ポインタは要素を削除するまで有効
+//! @note 要素の追加はO(1)(チャンク追加時もチャンクのポインタ配列の伸長のみ)
+template<class T, size_t kChunkBits = 10>
+class ChunkedVector
+{
+  friend class ChunkedVectorTest;
+
+public:
+  typedef T value_type;
+
+  ChunkedVector();
+  ChunkedVector(const ChunkedVector<T, kChunkBits> &rhs);
+  ChunkedVector(ChunkedVector<T, kChunkBits> &&rhs);
+
+  ~ChunkedVector();
+
+  //! @brief 代入演算子
+  ChunkedVector<T, kChunkBits>& operator=(const ChunkedVector<T, kChunkBits> &rhs);
+  ChunkedVector<T, kChunkBits>& operator=(ChunkedVector<T, kChunkBits> &&rhs);
+
+  //! @brief 比較演算子
+  const bool operator==(const ChunkedVector<T, kChunkBits> &rhs) const;
+  const bool operator!=(const ChunkedVector<T, kChunkBits> &rhs) const;
+
+  //! @brief 要素を参照する
+  T& operator[](const size_t index);
+  const T& operator[](const size_t index) const;
+
+  //! @brief 末尾の要素を参照する
+  //! @pre 要素が存在すること
+  T& back();
+  const T& back() const;
+
+  //! @brief 末尾に要素を構築する
+  template<class... Args>
+  void emplace_back(Args&&... args);
+
+  void push_back(const T &element);
+
+  //! @brief 要素数を返す
+  const size_t size() const;
+
+  //! @brief 要素が空かどうかを返す
+  const bool empty() const;
+
+  //! @brief 確保済の要素数を返す
+  const size_t capacity() const;
+
+  //! @brief 指定の要素数分のチャンクを確保する
+  void reserve(const size_t element_count);
+
+  //! @brief 全要素を削除する
+  //! @note 確保済のチャンクは解放しない
+  void clear();
+
+  //! @brief 内容を交換する
+  void swap(ChunkedVector<T, kChunkBits> &rhs);
+
+private:
+  static constexpr size_t kChunkSize = static_cast<size_t>(1) << kChunkBits;    //!< 1チャンクの要素数
+  static constexpr size_t kChunkMask = kChunkSize - 1;
+
+  typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type ElementStorage;
+
+  //! @brief 指定indexの要素の領域を返す
+  T* GetElementPointer(const size_t index) const;
+
+  std::vector< std::unique_ptr<ElementStorage[]> > chunk_list_;   //!< チャンクのリスト
+  size_t size_;     //!< 要素数
+};
+
+}   // namespace realcore
+
+#include "ChunkedVector-inl.h"
+
+#endif    // CHUNKED_VECTOR_H
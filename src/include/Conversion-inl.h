@@ -17,7 +17,7 @@ inline const size_t GetBitBoardIndex(const BoardPosition board_position)
 }
 
 template<BoardDirection kDirection>
-inline const size_t GetBitBoardIndex(const Cordinate x, const Cordinate y)
+constexpr inline size_t GetBitBoardIndex(const Cordinate x, const Cordinate y)
 {
   assert(IsInBoard(x, y));
 
@@ -62,7 +62,7 @@ inline const size_t GetBitBoardShift(const BoardPosition board_position)
 }
 
 template<BoardDirection kDirection>
-inline const size_t GetBitBoardShift(const Cordinate x, const Cordinate y)
+constexpr inline size_t GetBitBoardShift(const Cordinate x, const Cordinate y)
 {
   assert(IsInBoard(x, y));
 
@@ -26,7 +26,7 @@ inline const size_t GetBitBoardIndex(const BoardPosition board_position);
 //! @param y y座標
 //! @retval BitBoard配列のindex
 template<BoardDirection kDirection>
-inline const size_t GetBitBoardIndex(const Cordinate x, const Cordinate y);
+constexpr inline size_t GetBitBoardIndex(const Cordinate x, const Cordinate y);
 
 //! @brief (x, y)座標, BoardDirectionに対応するBitBoard配列のindexを取得する(non-template版)
 inline const size_t GetBitBoardIndex(const Cordinate x, const Cordinate y, const BoardDirection direction);
@@ -36,7 +36,7 @@ inline const size_t GetBitBoardShift(const BoardPosition board_position);
 
 //! @brief (x, y)座標, BoardDirectionに対応するBitBoard配列のシフト量を取得する(template版)
 template<BoardDirection kDirection>
-inline const size_t GetBitBoardShift(const Cordinate x, const Cordinate y);
+constexpr inline size_t GetBitBoardShift(const Cordinate x, const Cordinate y);
 
 //! @brief (x, y)座標, BoardDirectionに対応するBitBoard配列のシフト量を取得する(non-template版)
 inline const size_t GetBitBoardShift(const Cordinate x, const Cordinate y, const BoardDirection direction);
@@ -0,0 +1,80 @@
+#ifndef FORBIDDEN_MOVE_TABLE_INL_H
+#define FORBIDDEN_MOVE_TABLE_INL_H
+
+#include <cassert>
+
+#include "ForbiddenMoveTable.h"
+
+namespace realcore
+{
+
+inline ForbiddenMoveTableData::ForbiddenMoveTableData()
+: hash_value(0), logic_counter(0)
+{
+}
+
+inline ForbiddenMoveTable::ForbiddenMoveTable(const size_t table_space, const bool lock_control)
+: HashTable<ForbiddenMoveTableData>(table_space, lock_control), lookup_count_(0), hit_count_(0)
+{
+}
+
+inline void ForbiddenMoveTable::Initialize()
+{
+  HashTable<ForbiddenMoveTableData>::Initialize();
+
+  lookup_count_ = 0;
+  hit_count_ = 0;
+}
+
+inline const bool ForbiddenMoveTable::Find(const HashValue hash_value, MoveBitSet * const forbidden_move_set) const
+{
+  assert(forbidden_move_set != nullptr);
+
+  // 統計値のため、カウンタの更新はrelaxedで行う
+  lookup_count_.fetch_add(1, std::memory_order_relaxed);
+  ForbiddenMoveTableData table_data;
+
+  if(!find(hash_value, &table_data)){
+    return false;
+  }
+
+  hit_count_.fetch_add(1, std::memory_order_relaxed);
+  *forbidden_move_set = table_data.forbidden_move_set;
+
+  return true;
+}
+
+inline void ForbiddenMoveTable::Store(const HashValue hash_value, const MoveBitSet &forbidden_move_set)
+{
+  ForbiddenMoveTableData table_data;
+
+  table_data.hash_value = hash_value;
+  table_data.forbidden_move_set = forbidden_move_set;
+
+  Upsert(hash_value, table_data);
+}
+
+inline const size_t ForbiddenMoveTable::GetLookupCount() const
+{
+  return lookup_count_.load(std::memory_order_relaxed);
+}
+
+inline const size_t ForbiddenMoveTable::GetHitCount() const
+{
+  return hit_count_.load(std::memory_order_relaxed);
+}
+
+inline const double ForbiddenMoveTable::GetHitRate() const
+{
+  const size_t lookup_count = GetLookupCount();
+
+  if(lookup_count == 0){
+    return 0;
+  }
+
+  return 1.0 * GetHitCount() / lookup_count;
+}
+
+}   // namespace realcore
+
+#endif    // FORBIDDEN_MOVE_TABLE_INL_H
@@ -0,0 +1,71 @@
+//! @file
+//! @brief 局面ごとの禁手点を保持するキャッシュ
+//! @author Koichi NABETANI
+//! @date 2017/07/26
+
+#ifndef FORBIDDEN_MOVE_TABLE_H
+#define FORBIDDEN_MOVE_TABLE_H
+
+#include <atomic>
+
+#include "Move.h"
+#include "HashTable.h"
+
+namespace realcore
+{
+
+//! @brief 禁手点キャッシュの要素
+struct ForbiddenMoveTableData
+{
+  ForbiddenMoveTableData();
+
+  HashValue hash_value;               //!< 局面のHash値
+  TableLogicCounter logic_counter;    //!< 論理カウンタ
+  MoveBitSet forbidden_move_set;      //!< 禁手点
+};
+
+// 前方宣言
+class ForbiddenMoveTableTest;
+
+//! @brief 局面のHash値から禁手点を引くキャッシュ
+//! @note 棋譜DBの集計など、共通の手順を持つ多数の棋譜で同一局面の禁手を繰り返し列挙する場合に用いる
+//! @note 複数スレッドで共有する場合はkLockTableで確保する
+class ForbiddenMoveTable
+: public HashTable<ForbiddenMoveTableData>
+{
+  friend class ForbiddenMoveTableTest;
+
+public:
+  //! @param table_space キャッシュのサイズ(MB)
+  //! @param lock_control キャッシュのlockフラグ
+  ForbiddenMoveTable(const size_t table_space, const bool lock_control);
+
+  //! @brief 論理初期化を行い、参照回数をリセットする
+  void Initialize();
+
+  //! @brief 局面の禁手点を検索する
+  //! @retval true 登録済の局面
+  const bool Find(const HashValue hash_value, MoveBitSet * const forbidden_move_set) const;
+
+  //! @brief 局面の禁手点を登録する
+  void Store(const HashValue hash_value, const MoveBitSet &forbidden_move_set);
+
+  //! @brief 検索回数を返す
+  const size_t GetLookupCount() const;
+
+  //! @brief 検索のヒット回数を返す
+  const size_t GetHitCount() const;
+
+  //! @brief ヒット率を返す(検索していない場合は0)
+  const double GetHitRate() const;
+
+private:
+  mutable std::atomic<size_t> lookup_count_;    //!< 検索回数
+  mutable std::atomic<size_t> hit_count_;       //!< ヒット回数
+};
+
+}   // namespace realcore
+
+#include "ForbiddenMoveTable-inl.h"
+
+#endif    // FORBIDDEN_MOVE_TABLE_H
@@ -0,0 +1,99 @@
+#ifndef GAME_RECORD_DB_INL_H
+#define GAME_RECORD_DB_INL_H
+
+#include <cassert>
+
+#include "GameRecordDB.h"
+
+namespace realcore
+{
+
+inline const size_t GameRecordDBBuilder::size() const
+{
+  return game_result_list_.size();
+}
+
+inline const std::uint32_t GameRecordDB::ReadFixed32(const char * const data)
+{
+  const auto byte = reinterpret_cast<const unsigned char*>(data);
+  return static_cast<std::uint32_t>(byte[0]) | (static_cast<std::uint32_t>(byte[1]) << 8) | (static_cast<std::uint32_t>(byte[2]) << 16) | (static_cast<std::uint32_t>(byte[3]) << 24);
+}
+
+inline const size_t GameRecordDB::size() const
+{
+  return game_count_;
+}
+
+inline const size_t GameRecordDB::GetMoveCount() const
+{
+  return move_count_;
+}
+
+inline const size_t GameRecordDB::GetPlayerCount() const
+{
+  return player_count_;
+}
+
+inline const std::uint64_t GameRecordDB::GetGeneration() const
+{
+  return generation_;
+}
+
+inline const GameRecordView GameRecordDB::GetGameRecord(const size_t index) const
+{
+  assert(index < game_count_);
+
+  const std::uint32_t begin = ReadFixed32(record_offset_ + 4 * index);
+  const std::uint32_t end = ReadFixed32(record_offset_ + 4 * (index + 1));
+
+  return GameRecordView(move_data_ + begin, end - begin);
+}
+
+inline void GameRecordDB::GetMoveList(const size_t index, MoveList * const move_list) const
+{
+  GetGameRecord(index).GetMoveList(move_list);
+}
+
+inline const GameResult GameRecordDB::GetGameResult(const size_t index) const
+{
+  assert(index < game_count_);
+  return static_cast<GameResult>(game_result_[index]);
+}
+
+inline const GameEndStatus GameRecordDB::GetEndStatus(const size_t index) const
+{
+  assert(index < game_count_);
+  return static_cast<GameEndStatus>(end_status_[index]);
+}
+
+inline const std::uint32_t GameRecordDB::GetGameDate(const size_t index) const
+{
+  assert(index < game_count_);
+  return ReadFixed32(game_date_ + 4 * index);
+}
+
+inline const boost::string_view GameRecordDB::GetBlackPlayerName(const size_t index) const
+{
+  assert(index < game_count_);
+  return GetPlayerName(ReadFixed32(black_player_ + 4 * index));
+}
+
+inline const boost::string_view GameRecordDB::GetWhitePlayerName(const size_t index) const
+{
+  assert(index < game_count_);
+  return GetPlayerName(ReadFixed32(white_player_ + 4 * index));
+}
+
+inline const boost::string_view GameRecordDB::GetPlayerName(const std::uint32_t player_id) const
+{
+  assert(player_id < player_count_);
+
+  const std::uint32_t begin = ReadFixed32(player_name_offset_ + 4 * player_id);
+  const std::uint32_t end = ReadFixed32(player_name_offset_ + 4 * (player_id + 1));
+
+  return boost::string_view(player_name_ + begin, end - begin);
+}
+
+}   // namespace realcore
+
+#endif    // GAME_RECORD_DB_INL_H
@@ -0,0 +1,190 @@
+//! @file
+//! @brief 棋譜データベースのバイナリ形式(列指向)
+//! @author Koichi NABETANI
+//! @date 2017/07/20
+//! @note バイナリ形式(little endian, 各セクションは8byte境界から開始する)
+//! @note [magic "RCGD"(4byte)][version(1byte)][予約(3byte)][棋譜数N(8byte)][指し手数M(8byte)][対局者数P(8byte)][対局者名の文字数C(8byte)]
+//! @note [棋譜ごとの指し手の開始位置(4byte x (N + 1))][指し手(1byte x M)][対局結果(1byte x N)][終局状態(1byte x N)]
+//! @note [対局日(yyyymmdd, 不明は0)(4byte x N)][黒番の対局者ID(4byte x N)][白番の対局者ID(4byte x N)]
+//! @note [対局者名の開始位置(4byte x (P + 1))][対局者名(1byte x C)]
+#ifndef GAME_RECORD_DB_H
+#define GAME_RECORD_DB_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/utility/string_view.hpp>
+
+#include "Move.h"
+#include "MoveList.h"
+#include "SGFParser.h"
+
+namespace realcore
+{
+
+static constexpr char kGameRecordDBMagic[] = "RCGD";       //!< バイナリ形式の識別子
+static constexpr size_t kGameRecordDBMagicSize = 4;         //!< 識別子のサイズ
+static constexpr std::uint8_t kGameRecordDBVersion = 1;     //!< バイナリ形式のバージョン
+static constexpr size_t kGameRecordDBHeaderSize = 40;       //!< ヘッダのサイズ
+
+//! @brief 対局結果の文字列(BlackWin, WhiteWin, Draw)を変換する
+//! @note 該当しない場合はkUnknownResultを返す
+const GameResult GetGameResult(const boost::string_view &result_string);
+
+//! @brief 終局状態の文字列(Resign, Timeup, AgreedDraw)を変換する
+//! @note 該当しない場合はkUnknownEndStatusを返す
+const GameEndStatus GetGameEndStatus(const boost::string_view &end_status_string);
+
+//! @brief 対局日の文字列(2017-02-27, 2017/02/27など)をyyyymmdd形式の整数に変換する
+//! @note 先頭から8桁の数字が得られない場合は0を返す
+const std::uint32_t GetGameDate(const boost::string_view &date_string);
+
+//! @brief 棋譜DB内の1棋譜の指し手列への参照
+//! @note 参照先のGameRecordDBをCloseするまで有効
+typedef MoveListView GameRecordView;
+
+//! @brief 棋譜DBのバイナリ形式を生成するクラス
+class GameRecordDBBuilder
+{
+public:
+  GameRecordDBBuilder();
+
+  //! @brief 棋譜を追加する
+  //! @param game_date yyyymmdd形式の対局日(不明は0)
+  void Add(const MoveList &game_record, const GameResult game_result, const GameEndStatus end_status, const std::uint32_t game_date, const std::string &black_player_name, const std::string &white_player_name);
+
+  //! @brief 追加した棋譜数を返す
+  const size_t size() const;
+
+  //! @brief バイナリ形式に変換する
+  void Serialize(std::string * const binary) const;
+
+  //! @brief バイナリ形式でファイルに出力する
+  //! @retval true 出力成功
+  const bool WriteFile(const std::string &db_file) const;
+
+  //! @brief CSVの棋譜DBを読み込み棋譜を追加する
+  //! @note game_recordカラムは必須、game_result, game_end_status, game_date, black_player_name, white_player_nameは存在する場合のみ読み込む
+  //! @note [a-o]形式に変換できない棋譜は読み飛ばす
+  //! @param skip_count 読み飛ばした棋譜数の格納先(nullptrの場合は格納しない)
+  //! @retval true 読込成功
+  const bool AddCSV(const std::string &csv_file, size_t * const skip_count);
+
+private:
+  //! @brief 対局者IDを返す(未登録の対局者は登録する)
+  const std::uint32_t GetPlayerID(const std::string &player_name);
+
+  std::vector<std::uint32_t> record_offset_list_;     //!< 棋譜ごとの指し手の開始位置
+  std::vector<MovePosition> move_list_;               //!< 全棋譜の指し手
+  std::vector<std::uint8_t> game_result_list_;        //!< 対局結果
+  std::vector<std::uint8_t> end_status_list_;         //!< 終局状態
+  std::vector<std::uint32_t> game_date_list_;         //!< 対局日
+  std::vector<std::uint32_t> black_player_list_;      //!< 黒番の対局者ID
+  std::vector<std::uint32_t> white_player_list_;      //!< 白番の対局者ID
+
+  std::vector<std::string> player_name_list_;                         //!< 対局者IDごとの対局者名
+  std::unordered_map<std::string, std::uint32_t> player_id_map_;      //!< 対局者名 -> 対局者ID
+};
+
+// 前方宣言
+class GameRecordDBTest;
+
+//! @brief バイナリ形式の棋譜DBを展開せずに参照するクラス
+//! @note ファイルはmmapでマップし、指し手はGameRecordViewとして文字列の解析なしに参照する
+//! @note 参照関数はconstのため、複数スレッドから並列に参照できる
+class GameRecordDB
+{
+  friend class GameRecordDBTest;
+
+public:
+  GameRecordDB();
+
+  //! @brief メモリ上のバイナリ形式を参照する
+  //! @note dataは参照中に解放しないこと
+  //! @retval true: 参照成功, false: 不正なバイナリ形式
+  const bool Attach(const char * const data, const size_t data_size);
+
+  //! @brief バイナリ形式のファイルをmmapして参照する
+  //! @retval true: 参照成功, false: ファイルが存在しない or 不正なバイナリ形式
+  const bool Open(const std::string &db_file);
+
+  //! @brief バイナリ形式またはCSVの棋譜DBを読み込む
+  //! @note バイナリ形式でない場合はCSVとして読み込み、メモリ上でバイナリ形式に変換して参照する
+  //! @retval true 読込成功
+  const bool Load(const std::string &db_file);
+
+  //! @brief 参照を解除する
+  void Close();
+
+  //! @brief 棋譜数を返す
+  const size_t size() const;
+
+  //! @brief 全棋譜の指し手数を返す
+  const size_t GetMoveCount() const;
+
+  //! @brief 棋譜を返す
+  const GameRecordView GetGameRecord(const size_t index) const;
+
+  //! @brief 棋譜を指し手リストに変換する
+  void GetMoveList(const size_t index, MoveList * const move_list) const;
+
+  //! @brief 対局結果を返す
+  const GameResult GetGameResult(const size_t index) const;
+
+  //! @brief 終局状態を返す
+  const GameEndStatus GetEndStatus(const size_t index) const;
+
+  //! @brief yyyymmdd形式の対局日を返す(不明は0)
+  const std::uint32_t GetGameDate(const size_t index) const;
+
+  //! @brief 黒番の対局者名を返す
+  const boost::string_view GetBlackPlayerName(const size_t index) const;
+
+  //! @brief 白番の対局者名を返す
+  const boost::string_view GetWhitePlayerName(const size_t index) const;
+
+  //! @brief 対局者数を返す
+  const size_t GetPlayerCount() const;
+
+  //! @brief 参照する棋譜DBの世代を返す
+  //! @note Attach(Open, Loadを含む)とCloseのたびに増えるため、棋譜DBから求めた結果のキャッシュの無効化に用いる
+  const std::uint64_t GetGeneration() const;
+
+private:
+  //! @brief 4byte little endianの符号なし整数を読み込む
+  static const std::uint32_t ReadFixed32(const char * const data);
+
+  //! @brief 対局者名を返す
+  const boost::string_view GetPlayerName(const std::uint32_t player_id) const;
+
+  size_t game_count_;                 //!< 棋譜数
+  size_t move_count_;                 //!< 全棋譜の指し手数
+  size_t player_count_;               //!< 対局者数
+  std::uint64_t generation_;          //!< 参照する棋譜DBの世代
+
+  const char *record_offset_;         //!< 棋譜ごとの指し手の開始位置
+  const MovePosition *move_data_;     //!< 指し手
+  const char *game_result_;           //!< 対局結果
+  const char *end_status_;            //!< 終局状態
+  const char *game_date_;             //!< 対局日
+  const char *black_player_;          //!< 黒番の対局者ID
+  const char *white_player_;          //!< 白番の対局者ID
+  const char *player_name_offset_;    //!< 対局者名の開始位置
+  const char *player_name_;           //!< 対局者名
+
+  std::string binary_;    //!< CSVから変換したバイナリ形式(Loadで変換した場合のみ使用)
+
+  std::unique_ptr<boost::interprocess::file_mapping> file_mapping_;    //!< mmapしたファイル
+  std::unique_ptr<boost::interprocess::mapped_region> mapped_region_;  //!< mmapした領域
+};
+
+}   // namespace realcore
+
+#include "GameRecordDB-inl.h"
+
+#endif    // GAME_RECORD_DB_H
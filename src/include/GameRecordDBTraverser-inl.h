@@ -0,0 +1,176 @@
+#ifndef GAME_RECORD_DB_TRAVERSER_INL_H
+#define GAME_RECORD_DB_TRAVERSER_INL_H
+
+#include <algorithm>
+#include <cassert>
+
+#include "WorkStealingScheduler.h"
+#include "GameRecordDBTraverser.h"
+
+namespace realcore
+{
+
+inline const size_t GameRecordDBTraverser::GetThreadNum() const
+{
+  return thread_num_;
+}
+
+inline Board* GameRecordDBTraverser::GetBoard(const size_t worker_index)
+{
+  assert(worker_index < thread_num_);
+  return board_list_[worker_index].get();
+}
+
+inline const size_t GameRecordDBTraverser::GetProcessedGameCount() const
+{
+  return processed_game_count_;
+}
+
+inline const bool GameRecordDBTraverser::IsTerminate(const size_t worker_index) const
+{
+  return search_manager_ != nullptr && search_manager_->IsTerminate(worker_index);
+}
+
+inline void GameRecordDBTraverser::AddNode(const size_t worker_index) const
+{
+  if(search_manager_ != nullptr){
+    search_manager_->AddNode(worker_index);
+  }
+}
+
+template<class Result, class Function, class Reduce>
+const bool GameRecordDBTraverser::ForEachGame(const Function &function, const Reduce &reduce, Result * const result)
+{
+  const auto chunk_function = [this, &function](const size_t worker_index, const size_t game_begin, const size_t game_end, Result * const chunk_result){
+    Board * const board = board_list_[worker_index].get();
+
+    for(size_t game_index=game_begin; game_index<game_end; game_index++){
+      if(IsTerminate(worker_index)){
+        return false;
+      }
+
+      const GameRecordView game_record = game_record_db_.GetGameRecord(game_index);
+      function(board, game_index, game_record, chunk_result);
+
+      AddNode(worker_index);
+    }
+
+    return true;
+  };
+
+  return RunChunk(chunk_function, reduce, result);
+}
+
+template<class Result, class Function, class Reduce>
+const bool GameRecordDBTraverser::ForEachPosition(const Function &function, const Reduce &reduce, Result * const result)
+{
+  if(is_unique_position_ && !BuildFirstGameList()){
+    return false;
+  }
+
+  const auto chunk_function = [this, &function](const size_t worker_index, const size_t game_begin, const size_t game_end, Result * const chunk_result){
+    Board * const board = board_list_[worker_index].get();
+    MoveList move_list;
+
+    for(size_t game_index=game_begin; game_index<game_end; game_index++){
+      if(IsTerminate(worker_index)){
+        return false;
+      }
+
+      const GameRecordView game_record = game_record_db_.GetGameRecord(game_index);
+      const size_t record_size = game_record.size();
+
+      GameRecordDBPosition position;
+      position.game_index = game_index;
+      position.game_record = &game_record;
+      position.move_list = &move_list;
+      position.hash_value = 0;
+
+      for(size_t depth=0; ; depth++){
+        position.depth = depth;
+
+        if(depth == record_size && !is_end_position_){
+          break;
+        }
+
+        if(!is_unique_position_ || GetFirstGameIndex(position.hash_value) == game_index){
+          function(static_cast<const Board&>(*board), position, chunk_result);
+          AddNode(worker_index);
+        }
+
+        if(depth == record_size){
+          break;
+        }
+
+        const MovePosition move = game_record[depth];
+        const bool is_black_turn = move_list.IsBlackTurn();
+
+        board->MakeMove(move);
+        move_list += move;
+
+        // パスは手番ごとのパス回数でハッシュ値が変わるため指し手列から計算する
+        position.hash_value = move != kNullMove ? CalcHashValue(is_black_turn, move, position.hash_value) : CalcHashValue(move_list);
+      }
+
+      for(size_t i=0; i<record_size; i++){
+        board->UndoMove();
+        --move_list;
+      }
+    }
+
+    return true;
+  };
+
+  return RunChunk(chunk_function, reduce, result);
+}
+
+template<class Result, class ChunkFunction, class Reduce>
+const bool GameRecordDBTraverser::RunChunk(const ChunkFunction &chunk_function, const Reduce &reduce, Result * const result)
+{
+  assert(result != nullptr);
+
+  const size_t game_count = game_record_db_.size();
+  const size_t chunk_count = (game_count + chunk_size_ - 1) / chunk_size_;
+
+  // 各チャンクは1つのタスクのみが書き込み、Runから戻った後に読み出す
+  std::vector<Result> chunk_result_list(chunk_count);
+  std::vector<std::uint8_t> is_completed_list(chunk_count, 0);
+  WorkStealingScheduler scheduler(thread_num_);
+
+  for(size_t chunk_index=0; chunk_index<chunk_count; chunk_index++){
+    scheduler.Push(chunk_index % thread_num_, [this, &chunk_function, &chunk_result_list, &is_completed_list, &scheduler, chunk_index, game_count](const size_t worker_index){
+      const size_t game_begin = chunk_index * chunk_size_;
+      const size_t game_end = std::min(game_begin + chunk_size_, game_count);
+
+      if(chunk_function(worker_index, game_begin, game_end, &chunk_result_list[chunk_index])){
+        is_completed_list[chunk_index] = 1;
+      }else{
+        scheduler.Stop();
+      }
+    });
+  }
+
+  scheduler.Run();
+
+  // 完了したタイミングによらず、チャンクの順に統合する
+  bool is_all_completed = true;
+  processed_game_count_ = 0;
+
+  for(size_t chunk_index=0; chunk_index<chunk_count; chunk_index++){
+    if(is_completed_list[chunk_index] == 0){
+      is_all_completed = false;
+      continue;
+    }
+
+    reduce(result, chunk_result_list[chunk_index]);
+
+    const size_t game_begin = chunk_index * chunk_size_;
+    processed_game_count_ += std::min(game_begin + chunk_size_, game_count) - game_begin;
+  }
+
+  return is_all_completed;
+}
+
+}   // namespace realcore
+
+#endif    // GAME_RECORD_DB_TRAVERSER_INL_H
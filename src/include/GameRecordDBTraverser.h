@@ -0,0 +1,142 @@
+//! @file
+//! @brief 棋譜DBの棋譜・局面を並列に走査するクラス
+//! @author Koichi NABETANI
+//! @date 2017/07/28
+
+#ifndef GAME_RECORD_DB_TRAVERSER_H
+#define GAME_RECORD_DB_TRAVERSER_H
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "HashTable.h"
+#include "Board.h"
+#include "GameRecordDB.h"
+#include "SharedSearchManager.h"
+
+namespace realcore
+{
+
+//! @brief 1タスクで走査する棋譜数のデフォルト値
+constexpr size_t kDefaultTraverseChunkSize = 256;
+
+//! @brief 並列走査で訪問した局面の情報
+struct GameRecordDBPosition
+{
+  size_t game_index;            //!< 棋譜DBでのindex
+  size_t depth;                 //!< 初期局面からの手数
+  const GameRecordView *game_record;  //!< 棋譜
+  const MoveList *move_list;    //!< 初期局面からの指し手列
+  HashValue hash_value;         //!< 局面のハッシュ値
+};
+
+// 前方宣言
+class GameRecordDBTraverserTest;
+
+//! @brief 棋譜DBを一定の棋譜数ごとのチャンクに分割し、ワーカーごとのBoardで並列に走査するクラス
+//! @note チャンクごとに結果を集計し、チャンクの順に統合するため、結果はスレッド数によらず同一となる
+//! @note SharedSearchManagerを設定すると、棋譜ごとに終了条件をチェックし、訪問した棋譜(ForEachGame)または局面(ForEachPosition)ごとに探索ノード数を加算する
+class GameRecordDBTraverser
+{
+  friend class GameRecordDBTraverserTest;
+
+public:
+  //! @param game_record_db 走査する棋譜DB
+  //! @param thread_num ワーカースレッド数
+  //! @param update_flag ワーカーごとのBoardの空点情報の更新フラグ
+  GameRecordDBTraverser(const GameRecordDB &game_record_db, const size_t thread_num, const UpdateOpenStateFlag &update_flag);
+
+  //! @brief 1タスクで走査する棋譜数を設定する
+  //! @note 結果の統合順はチャンク分割のみで決まるため、同一の結果を得るにはチャンクサイズを揃える
+  void SetChunkSize(const size_t chunk_size);
+
+  //! @brief 同一局面を棋譜DBで最初に現れる1度だけ訪問するかを設定する(ForEachPositionのみ)
+  //! @note 局面の同一性はハッシュ値で判定する
+  //! @note 局面が最初に現れる棋譜は初回の走査で求めて保持し、終局図の設定または棋譜DBが変わるまで再利用する
+  void SetUniquePosition(const bool is_unique_position);
+
+  //! @brief 終局図を訪問するかを設定する(ForEachPositionのみ)
+  //! @note 訪問しない場合は指し手を着手する前の局面のみを訪問し、同一局面の判定も着手前の局面で行う
+  void SetEndPosition(const bool is_end_position);
+
+  //! @brief 走査の中断に用いるSharedSearchManagerを設定する(nullptrで中断しない)
+  //! @pre search_managerのスレッド数はワーカースレッド数以上
+  void SetSearchManager(SharedSearchManager * const search_manager);
+
+  //! @brief ワーカースレッド数を返す
+  const size_t GetThreadNum() const;
+
+  //! @brief ワーカーのBoardを返す
+  //! @note 禁手キャッシュの設定など、走査前にBoardを設定する場合に用いる
+  Board* GetBoard(const size_t worker_index);
+
+  //! @brief 直前の走査で結果を統合した棋譜数を返す
+  const size_t GetProcessedGameCount() const;
+
+  //! @brief 棋譜ごとに関数を呼び出す
+  //! @param function (Board * const, const size_t game_index, const GameRecordView&, Result * const)で呼び出す関数
+  //! @param reduce チャンクの結果を(Result * const, const Result&)で統合する関数
+  //! @param result 統合結果
+  //! @retval true 全棋譜を走査した
+  //! @retval false 走査が中断された(完了したチャンクの結果のみをチャンクの順に統合する)
+  //! @note 関数に渡すBoardは初期局面であり、関数から戻る際は初期局面に戻す
+  template<class Result, class Function, class Reduce>
+  const bool ForEachGame(const Function &function, const Reduce &reduce, Result * const result);
+
+  //! @brief 初期局面から終局図までの局面ごとに関数を呼び出す
+  //! @param function (const Board&, const GameRecordDBPosition&, Result * const)で呼び出す関数
+  //! @param reduce チャンクの結果を(Result * const, const Result&)で統合する関数
+  //! @param result 統合結果
+  //! @retval true 全棋譜を走査した
+  //! @retval false 走査が中断された
+  template<class Result, class Function, class Reduce>
+  const bool ForEachPosition(const Function &function, const Reduce &reduce, Result * const result);
+
+private:
+  //! @brief 各チャンクをワーカーに割り当てて実行し、完了したチャンクの結果をチャンクの順に統合する
+  //! @param chunk_function (const size_t worker_index, const size_t game_begin, const size_t game_end, Result * const)で呼び出す関数
+  template<class Result, class ChunkFunction, class Reduce>
+  const bool RunChunk(const ChunkFunction &chunk_function, const Reduce &reduce, Result * const result);
+
+  //! @brief 走査を中断するか返す
+  const bool IsTerminate(const size_t worker_index) const;
+
+  //! @brief 棋譜・局面を訪問したことを通知する
+  void AddNode(const size_t worker_index) const;
+
+  //! @brief 局面ごとに最初に現れる棋譜のindexを求める
+  //! @retval false 中断された
+  //! @note 現在の棋譜DB・設定で求め済の場合は再計算しない
+  const bool BuildFirstGameList();
+
+  //! @brief first_game_list_が現在の棋譜DB・設定で求めたものか返す
+  const bool IsFirstGameListBuilt() const;
+
+  //! @brief 局面が最初に現れる棋譜のindexを返す
+  const size_t GetFirstGameIndex(const HashValue hash_value) const;
+
+  const GameRecordDB &game_record_db_;    //!< 走査する棋譜DB
+  const size_t thread_num_;               //!< ワーカースレッド数
+  size_t chunk_size_;                     //!< 1タスクで走査する棋譜数
+  bool is_unique_position_;               //!< 同一局面を1度だけ訪問するか
+  bool is_end_position_;                  //!< 終局図を訪問するか
+  SharedSearchManager *search_manager_;   //!< 走査の中断に用いるSharedSearchManager
+
+  std::vector<std::unique_ptr<Board>> board_list_;    //!< ワーカーごとのBoard
+
+  //! @brief (局面のハッシュ値, 最初に現れる棋譜のindex)のハッシュ値順のリスト
+  std::vector<std::pair<HashValue, std::uint32_t>> first_game_list_;
+
+  bool is_first_game_list_built_;               //!< first_game_list_を求め済か
+  std::uint64_t first_game_list_generation_;    //!< first_game_list_を求めた棋譜DBの世代
+
+  size_t processed_game_count_;     //!< 直前の走査で結果を統合した棋譜数
+};
+
+}   // namespace realcore
+
+#include "GameRecordDBTraverser-inl.h"
+
+#endif    // GAME_RECORD_DB_TRAVERSER_H
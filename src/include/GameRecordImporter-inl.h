@@ -0,0 +1,34 @@
+#ifndef GAME_RECORD_IMPORTER_INL_H
+#define GAME_RECORD_IMPORTER_INL_H
+
+#include <cassert>
+
+#include "GameRecordImporter.h"
+
+namespace realcore
+{
+
+inline GameRecordImportStats::GameRecordImportStats()
+: file_count(0), byte_count(0), imported_count(0), duplicate_count(0), error_count(0)
+{
+}
+
+inline ImportedGameRecord::ImportedGameRecord()
+: is_valid(false), byte_count(0), hash_value(0), game_result(kUnknownResult), end_status(kUnknownEndStatus), game_date(0)
+{
+}
+
+inline void GameRecordImporter::SetBatchSize(const size_t batch_size)
+{
+  assert(batch_size > 0);
+  batch_size_ = batch_size;
+}
+
+inline const GameRecordImportStats& GameRecordImporter::GetStats() const
+{
+  return stats_;
+}
+
+}   // namespace realcore
+
+#endif    // GAME_RECORD_IMPORTER_INL_H
@@ -0,0 +1,101 @@
+//! @file
+//! @brief SGF, POSファイルを並列に読み込み棋譜DBを生成するクラス
+//! @author Koichi NABETANI
+//! @date 2017/07/22
+#ifndef GAME_RECORD_IMPORTER_H
+#define GAME_RECORD_IMPORTER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "HashTable.h"
+#include "MoveList.h"
+#include "SGFParser.h"
+
+namespace realcore
+{
+
+class GameRecordDBBuilder;
+
+//! @brief 棋譜読込の集計
+struct GameRecordImportStats
+{
+  GameRecordImportStats();
+
+  size_t file_count;        //!< 読み込んだファイル数
+  size_t byte_count;        //!< 読み込んだバイト数
+  size_t imported_count;    //!< 棋譜DBに追加した棋譜数
+  size_t duplicate_count;   //!< 対称形を含めて既出の局面のため読み飛ばした棋譜数
+  size_t error_count;       //!< 読込に失敗したファイル数
+};
+
+//! @brief 1ファイル分の読込結果
+struct ImportedGameRecord
+{
+  ImportedGameRecord();
+
+  bool is_valid;                //!< 読込に成功したか
+  size_t byte_count;            //!< ファイルサイズ
+  MoveList game_record;         //!< 棋譜
+  HashValue hash_value;         //!< 棋譜の終局図のSymmetricHash値
+  GameResult game_result;       //!< 対局結果
+  GameEndStatus end_status;     //!< 終局状態
+  std::uint32_t game_date;      //!< yyyymmdd形式の対局日(不明は0)
+  std::string black_player_name;    //!< 黒番の対局者名
+  std::string white_player_name;    //!< 白番の対局者名
+};
+
+// 前方宣言
+class GameRecordImporterTest;
+
+//! @brief SGF(.sgf), POS(.pos)ファイルをスレッドプールで並列に読み込み棋譜DBに追加するクラス
+//! @note ファイルは一定数ごとに並列に読み込み、ファイルリスト順に棋譜DBへ追加してから次の読込を行う
+//! @note 読込済のファイルの内容は保持しないため、使用メモリは棋譜DBのバイナリ形式とバッチ1回分に抑えられる
+class GameRecordImporter
+{
+  friend class GameRecordImporterTest;
+
+public:
+  //! @param thread_num 読込スレッド数
+  //! @param check_bit SGFプロパティ有無チェックのフラグ
+  GameRecordImporter(const size_t thread_num, const SGFCheckBit &check_bit);
+
+  //! @brief ディレクトリ(またはファイル)以下のSGF, POSファイルをパス順に列挙する
+  //! @note 拡張子(.sgf, .pos)の大文字・小文字は区別しない
+  static void EnumerateGameRecordFile(const std::string &path, std::vector<std::string> * const file_list);
+
+  //! @brief ファイルを並列に読み込み棋譜DBに追加する
+  //! @note 対称形を含めて既出の局面の棋譜は追加しない(Importを複数回呼んだ場合も以前の棋譜と重複を判定する)
+  void Import(const std::vector<std::string> &file_list, GameRecordDBBuilder * const builder);
+
+  //! @brief 1回の並列読込で扱うファイル数を設定する
+  void SetBatchSize(const size_t batch_size);
+
+  //! @brief 集計を返す
+  const GameRecordImportStats& GetStats() const;
+
+private:
+  //! @brief 1ファイルを読み込む
+  void ReadGameRecordFile(const std::string &file_path, ImportedGameRecord * const game_record) const;
+
+  //! @brief SGFファイルを読み込む
+  void ReadSGFFile(const std::string &file_path, ImportedGameRecord * const game_record) const;
+
+  //! @brief POSファイルを読み込む
+  void ReadPOSGameRecordFile(const std::string &file_path, ImportedGameRecord * const game_record) const;
+
+  const size_t thread_num_;     //!< 読込スレッド数
+  const SGFCheckBit check_bit_;   //!< SGFプロパティ有無チェックのフラグ
+  size_t batch_size_;           //!< 1回の並列読込で扱うファイル数
+
+  std::unordered_set<HashValue> hash_value_set_;    //!< 追加済の棋譜のSymmetricHash値
+  GameRecordImportStats stats_;   //!< 集計
+};
+
+}   // namespace realcore
+
+#include "GameRecordImporter-inl.h"
+
+#endif    // GAME_RECORD_IMPORTER_H
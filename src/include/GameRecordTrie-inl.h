@@ -0,0 +1,107 @@
+#ifndef GAME_RECORD_TRIE_INL_H
+#define GAME_RECORD_TRIE_INL_H
+
+#include <cassert>
+
+#include "GameRecordTrie.h"
+
+namespace realcore
+{
+
+inline const size_t GameRecordTrie::GetGameCount() const
+{
+  return sorted_game_list_.size();
+}
+
+inline const size_t GameRecordTrie::GetPrefixCount() const
+{
+  return move_tree_.size() + 1;
+}
+
+inline const size_t GameRecordTrie::GetReplayPositionCount() const
+{
+  return replay_position_count_;
+}
+
+inline const GameRecordMoveTree& GameRecordTrie::GetMoveTree() const
+{
+  return move_tree_;
+}
+
+template<class Function>
+void GameRecordTrie::Traverse(Board * const board, const Function &function) const
+{
+  assert(board != nullptr);
+
+  const auto &node_list = move_tree_.GetMoveTreeNodeList();
+
+  // 指し手列の辞書順に兄弟ノードを登録しているため、深さ優先の訪問順に終わる棋譜が並ぶ
+  size_t end_game_offset = 0;
+  MoveList move_list;
+
+  const auto visit = [this, board, &function, &end_game_offset, &move_list](const MoveNodeIndex node_index, const size_t depth){
+    GameRecordTriePosition position;
+
+    position.node_index = node_index;
+    position.depth = depth;
+    position.move_list = &move_list;
+    position.game_count = game_count_list_[node_index];
+    position.end_game_index = sorted_game_list_.data() + end_game_offset;
+    position.end_game_count = end_count_list_[node_index];
+
+    end_game_offset += position.end_game_count;
+    function(static_cast<const Board&>(*board), position);
+  };
+
+  MoveNodeIndex node_index = kRootNodeIndex;
+  size_t depth = 0;
+
+  visit(node_index, depth);
+
+  while(true){
+    // 子ノードがあれば最初の子ノードに進む
+    const MoveNodeIndex first_child_index = node_list[node_index].GetFirstChildIndex();
+
+    if(first_child_index != kNullNodeIndex){
+      node_index = first_child_index;
+      board->MakeMove(node_list[node_index].GetMove());
+      move_list += node_list[node_index].GetMove();
+      visit(node_index, ++depth);
+
+      continue;
+    }
+
+    // 次の兄弟ノードがあるノードまで戻る
+    bool is_found = false;
+
+    while(node_index != kRootNodeIndex){
+      const MoveNodeIndex next_sibling_index = node_list[node_index].GetNextSiblingIndex();
+
+      board->UndoMove();
+      --move_list;
+      depth--;
+
+      if(next_sibling_index != kNullNodeIndex){
+        node_index = next_sibling_index;
+        board->MakeMove(node_list[node_index].GetMove());
+        move_list += node_list[node_index].GetMove();
+        visit(node_index, ++depth);
+
+        is_found = true;
+        break;
+      }
+
+      node_index = node_list[node_index].GetParentIndex();
+    }
+
+    if(!is_found){
+      break;
+    }
+  }
+
+  assert(end_game_offset == sorted_game_list_.size());
+}
+
+}   // namespace realcore
+
+#endif    // GAME_RECORD_TRIE_INL_H
@@ -0,0 +1,86 @@
+//! @file
+//! @brief 棋譜DBの共通の手順を共有するトライ木
+//! @author Koichi NABETANI
+//! @date 2017/07/27
+
+#ifndef GAME_RECORD_TRIE_H
+#define GAME_RECORD_TRIE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ChunkedVector.h"
+#include "MoveTree.h"
+#include "Board.h"
+
+namespace realcore
+{
+
+class GameRecordDB;
+
+//! @brief トライ木の走査で訪問した局面の情報
+struct GameRecordTriePosition
+{
+  MoveNodeIndex node_index;       //!< 局面のnode index
+  size_t depth;                   //!< 走査開始局面からの手数
+  const MoveList *move_list;      //!< 走査開始局面からの指し手列
+  size_t game_count;              //!< 局面を経由する棋譜数
+  const std::uint32_t *end_game_index;  //!< 局面で終わる棋譜の棋譜DBでのindex
+  size_t end_game_count;          //!< 局面で終わる棋譜数
+};
+
+//! @brief トライ木の探索木
+//! @note ノードを再配置しないChunkedVectorに格納し、構築時のノード配列の再確保を避ける
+typedef MoveTreeBase< EmptyAditionalData, ChunkedVector< MoveTreeNode<EmptyAditionalData> > > GameRecordMoveTree;
+
+// 前方宣言
+class GameRecordTrieTest;
+
+//! @brief 棋譜DBの棋譜を指し手列の辞書順に並べてトライ木に登録し、異なる手順(指し手列の接頭辞)ごとに1度だけ走査するクラス
+//! @note 棋譜ごとに盤面を初期局面から再生する代わりに、MakeMove/UndoMoveで共通の手順を再利用する
+//! @note 手順前後で同一局面となる手順は合流しないため、同一局面を複数回訪問することがある
+class GameRecordTrie
+{
+  friend class GameRecordTrieTest;
+
+public:
+  GameRecordTrie();
+
+  //! @brief 棋譜DBの全棋譜をトライ木に登録する
+  //! @note 以前に登録した内容は破棄する
+  void Build(const GameRecordDB &game_record_db);
+
+  //! @brief 登録した棋譜数を返す
+  const size_t GetGameCount() const;
+
+  //! @brief 異なる手順(指し手列の接頭辞)の数(トライ木のノード数)を返す
+  //! @note 手順前後による同一局面は別に数えるため、異なる局面の数以上となる
+  const size_t GetPrefixCount() const;
+
+  //! @brief 棋譜ごとに初期局面から再生した場合の局面数を返す
+  const size_t GetReplayPositionCount() const;
+
+  //! @brief トライ木を深さ優先で走査し、局面ごとに関数を呼び出す
+  //! @param board 走査に用いる盤面(現局面をトライ木のroot nodeとし、走査後は元の局面に戻す)
+  //! @param function 局面ごとに(const Board&, const GameRecordTriePosition&)で呼び出す関数
+  //! @note 兄弟ノードは指し手の昇順に走査し、root nodeを含めて手順ごとに1度だけ呼び出す
+  template<class Function>
+  void Traverse(Board * const board, const Function &function) const;
+
+  //! @brief トライ木を返す
+  const GameRecordMoveTree& GetMoveTree() const;
+
+private:
+  GameRecordMoveTree move_tree_;    //!< トライ木
+
+  std::vector<std::uint32_t> sorted_game_list_;   //!< 指し手列の辞書順に並べた棋譜のindex
+  std::vector<std::uint32_t> game_count_list_;    //!< ノードごとの経由する棋譜数
+  std::vector<std::uint32_t> end_count_list_;     //!< ノードごとの終わる棋譜数
+  size_t replay_position_count_;    //!< 棋譜ごとに再生した場合の局面数
+};
+
+}   // namespace realcore
+
+#include "GameRecordTrie-inl.h"
+
+#endif    // GAME_RECORD_TRIE_H
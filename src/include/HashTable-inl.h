@@ -2,6 +2,7 @@
 #define HASH_TABLE_INL_H
 
 #include "MoveList.h"
+#include "Instrumentation.h"
 #include "HashTable.h"
 
 namespace realcore{
@@ -47,6 +48,7 @@ inline const size_t HashTable<T>::GetTableIndex(const HashValue hash_value) cons
 template<class T>
 const bool HashTable<T>::find(const HashValue hash_value, T * const element) const
 {
+  CountOperation<kInstrumentHashTableProbe>();
   const auto index = GetTableIndex(hash_value);
 
   {
@@ -63,6 +65,7 @@ const bool HashTable<T>::find(const HashValue hash_value, T * const element) con
     *element = hash_data;
   }  
 
+  CountOperation<kInstrumentHashTableHit>();
   return true;
 }
 
@@ -133,6 +136,44 @@ void HashTable<T>::clear()
   logic_counter_ = 1;
 }
 
+template<class T>
+template<class Function>
+void HashTable<T>::ForEach(const Function &function) const
+{
+  const size_t table_size = hash_table_.size();
+
+  for(size_t i=0; i<table_size; i++){
+    Lock lock(mutex_list_[i], lock_control_);
+    const T& hash_data = hash_table_[i];
+
+    if(hash_data.logic_counter == logic_counter_){
+      function(hash_data);
+    }
+  }
+}
+
+template<class T>
+template<class Predicate>
+const size_t HashTable<T>::EraseIf(const Predicate &predicate)
+{
+  // 論理カウンタは1から開始するため0の要素は未登録となる
+  constexpr TableLogicCounter kErasedCounter = 0;
+  const size_t table_size = hash_table_.size();
+  size_t erase_count = 0;
+
+  for(size_t i=0; i<table_size; i++){
+    Lock lock(mutex_list_[i], lock_control_);
+    T& hash_data = hash_table_[i];
+
+    if(hash_data.logic_counter == logic_counter_ && predicate(hash_data)){
+      hash_data.logic_counter = kErasedCounter;
+      ++erase_count;
+    }
+  }
+
+  return erase_count;
+}
+
 template<class T>
 inline const size_t HashTable<T>::size() const
 {
@@ -230,6 +271,22 @@ inline const HashValue CalcHashValue(const MoveList &board_move_sequence)
   return hash_value;
 }
 
+inline const HashValue GetSymmetricHashValue(const std::array<HashValue, kBoardSymmetryNum> &hash_value_list)
+{
+  std::array<HashValue, kBoardSymmetryNum> sorted_list(hash_value_list);
+
+  // 対称形のhash値をsortすることで対称形は同一のhash_value_listを持つ
+  std::sort(sorted_list.begin(), sorted_list.end());
+
+  // CalcSymmetricHashValueが一様に分布するようにする
+  //  index = 中央値(3番目に小さい値) % kBoardSymmetryNum
+  // としてhash_value_list[index]をCalcSymmetricHashValueとする
+  static constexpr size_t kMedianIndex = 3;
+  const auto index = sorted_list[kMedianIndex] % kBoardSymmetryNum;
+
+  return sorted_list[index];
+}
+
 inline const HashValue CalcSymmetricHashValue(const MoveList &board_move_sequence)
 {
   std::array<HashValue, kBoardSymmetryNum> hash_value_list{{0ULL}};
@@ -241,16 +298,7 @@ inline const HashValue CalcSymmetricHashValue(const MoveList &board_move_sequenc
     hash_value_list[symmetry] = CalcHashValue(symmetric_list);
   }
 
-  // 対称形のhash値をsortすることで対称形は同一のhash_value_listを持つ
-  std::sort(hash_value_list.begin(), hash_value_list.end());
-
-  // CalcSymmetricHashValueが一様に分布するようにする
-  //  index = 中央値(3番目に小さい値) % kBoardSymmetryNum
-  // としてhash_value_list[index]をCalcSymmetricHashValueとする
-  static constexpr size_t kMedianIndex = 3;
-  const auto index = hash_value_list[kMedianIndex] % kBoardSymmetryNum;
-
-  return hash_value_list[index];
+  return GetSymmetricHashValue(hash_value_list);
 }
 }
 
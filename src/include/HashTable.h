@@ -6,6 +6,7 @@
 #define HASH_TABLE_H
 
 #include <cstdint>
+#include <array>
 #include <vector>
 
 #include "Move.h"
@@ -31,6 +32,11 @@ const HashValue CalcHashValue(const MoveList &board_move_sequence);
 //! @note 対称変換で同一になる局面は同一のHash値になる
 const HashValue CalcSymmetricHashValue(const MoveList &board_move_sequence);
 
+//! @brief 対称性ごとの局面のHash値からSymmetricHash値を求める
+//! @param hash_value_list hash_value_list[symmetry]が対称変換した局面のHash値
+//! @note 差分計算した対称形のHash値からCalcSymmetricHashValueと同じ値を求める
+const HashValue GetSymmetricHashValue(const std::array<HashValue, kBoardSymmetryNum> &hash_value_list);
+
 //! @brief Hash値を求める(差分計算用)
 const HashValue CalcHashValue(const bool is_black_turn, const MovePosition move, const HashValue current_value);
 
@@ -60,6 +66,18 @@ public:
   //! @param element 競合するデータを格納する
   const bool IsConflict(const HashValue hash_value, T * const element) const;
 
+  //! @brief 登録済の要素ごとに関数を呼び出す
+  //! @param function 要素を引数にとる関数
+  template<class Function>
+  void ForEach(const Function &function) const;
+
+  //! @brief 条件を満たす登録済の要素を削除する
+  //! @param predicate 削除する要素に対してtrueを返す関数
+  //! @return 削除した要素数
+  //! @note 削除した要素は論理カウンタを無効値にすることで未登録の扱いとする
+  template<class Predicate>
+  const size_t EraseIf(const Predicate &predicate);
+
   //! @brief Hash tableの要素数を返す
   const size_t size() const;
 
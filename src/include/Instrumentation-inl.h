@@ -0,0 +1,107 @@
+#ifndef INSTRUMENTATION_INL_H
+#define INSTRUMENTATION_INL_H
+
+#include <cassert>
+#include <chrono>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Instrumentation.h"
+
+namespace realcore
+{
+
+inline const size_t GetCycleHistogramBin(const std::uint64_t cycle)
+{
+  if(cycle == 0){
+    return 0;
+  }
+
+  const size_t bin = 63 - __builtin_clzll(cycle);
+  return bin < kCycleHistogramBinNum ? bin : kCycleHistogramBinNum - 1;
+}
+
+inline const std::uint64_t ReadCycleCounter()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+#endif
+}
+
+inline OperationStatistics::OperationStatistics()
+: count(0), total_cycle(0), max_cycle(0), cycle_histogram{{0}}
+{
+}
+
+inline void InstrumentationSnapshot::AddCount(const InstrumentOperation operation)
+{
+  assert(operation < kInstrumentOperationNum);
+  ++statistics_list_[operation].count;
+}
+
+inline void InstrumentationSnapshot::AddCycle(const InstrumentOperation operation, const std::uint64_t cycle)
+{
+  assert(operation < kInstrumentOperationNum);
+  OperationStatistics &statistics = statistics_list_[operation];
+
+  ++statistics.count;
+  statistics.total_cycle += cycle;
+  statistics.max_cycle = statistics.max_cycle < cycle ? cycle : statistics.max_cycle;
+  ++statistics.cycle_histogram[GetCycleHistogramBin(cycle)];
+}
+
+inline const OperationStatistics& InstrumentationSnapshot::GetStatistics(const InstrumentOperation operation) const
+{
+  assert(operation < kInstrumentOperationNum);
+  return statistics_list_[operation];
+}
+
+inline InstrumentationSnapshot& GetThreadInstrumentation()
+{
+  static thread_local InstrumentationSnapshot thread_snapshot;
+  return thread_snapshot;
+}
+
+template<InstrumentOperation Operation>
+inline void CountOperation()
+{
+#ifdef REALCORE_INSTRUMENTATION
+  GetThreadInstrumentation().AddCount(Operation);
+#endif
+}
+
+#ifdef REALCORE_INSTRUMENTATION
+template<InstrumentOperation Operation>
+inline ScopedOperationTimer<Operation>::ScopedOperationTimer()
+: start_cycle_(ReadCycleCounter())
+{
+}
+
+template<InstrumentOperation Operation>
+inline ScopedOperationTimer<Operation>::~ScopedOperationTimer()
+{
+  GetThreadInstrumentation().AddCycle(Operation, ReadCycleCounter() - start_cycle_);
+}
+#else
+template<InstrumentOperation Operation>
+inline ScopedOperationTimer<Operation>::ScopedOperationTimer()
+{
+}
+
+template<InstrumentOperation Operation>
+inline ScopedOperationTimer<Operation>::~ScopedOperationTimer()
+{
+}
+
+static_assert(std::is_empty<ScopedOperationTimer<kInstrumentMakeMove>>::value, "ScopedOperationTimer must be empty when instrumentation is disabled");
+#endif
+
+}   // namespace realcore
+
+#endif    // INSTRUMENTATION_INL_H
@@ -0,0 +1,131 @@
+//! @file
+//! @brief 探索の主要処理の実行回数と所要サイクル数を計測する
+//! @author Koichi NABETANI
+//! @date 2017/06/24
+//! @note REALCORE_INSTRUMENTATIONを定義してビルドした場合のみ計測し、未定義の場合の計測処理は空の関数となる
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <cstdint>
+#include <array>
+#include <string>
+
+namespace realcore
+{
+
+#ifdef REALCORE_INSTRUMENTATION
+constexpr bool kInstrumentationEnabled = true;    //!< 計測を行う
+#else
+constexpr bool kInstrumentationEnabled = false;   //!< 計測を行わない
+#endif
+
+//! @brief 計測対象の処理
+enum InstrumentOperation : std::uint8_t
+{
+  kInstrumentMakeMove,              //!< Board::MakeMove
+  kInstrumentUndoMove,              //!< Board::UndoMove
+  kInstrumentBoardOpenState,        //!< 差分更新によるBoardOpenStateの生成
+  kInstrumentIsForbiddenMove,       //!< BitBoard::IsForbiddenMove(黒番)
+  kInstrumentHashTableProbe,        //!< HashTable::findの参照(回数のみ)
+  kInstrumentHashTableHit,          //!< HashTable::findのヒット(回数のみ)
+  kInstrumentEnumerateFourMoves,    //!< BitBoard::EnumerateFourMoves
+  kInstrumentOperationNum
+};
+
+//! @brief 計測対象の処理名を返す
+const char* GetInstrumentOperationName(const InstrumentOperation operation);
+
+//! @brief サイクル数ヒストグラムの階級数
+//! @note 階級kは[2^k, 2^(k+1))サイクル(階級0は0サイクルを含む)、最終階級はそれ以上すべてを数える
+constexpr size_t kCycleHistogramBinNum = 32;
+
+//! @brief サイクル数の属する階級を返す
+inline const size_t GetCycleHistogramBin(const std::uint64_t cycle);
+
+//! @brief サイクルカウンタを読み出す
+//! @note x86ではTSC、それ以外ではsteady_clockのns値を返す
+inline const std::uint64_t ReadCycleCounter();
+
+//! @brief サイクルカウンタの単位を返す("tsc" or "ns")
+const char* GetCycleCounterUnit();
+
+//! @brief 1つの処理の計測結果
+struct OperationStatistics
+{
+  OperationStatistics();
+
+  std::uint64_t count;          //!< 実行回数
+  std::uint64_t total_cycle;    //!< 所要サイクル数の合計
+  std::uint64_t max_cycle;      //!< 所要サイクル数の最大値
+  std::array<std::uint64_t, kCycleHistogramBinNum> cycle_histogram;   //!< 所要サイクル数のヒストグラム
+};
+
+// 前方宣言
+class InstrumentationTest;
+
+//! @brief 全計測対象の計測結果
+class InstrumentationSnapshot
+{
+  friend class InstrumentationTest;
+
+public:
+  InstrumentationSnapshot();
+
+  //! @brief 実行回数を加算する
+  void AddCount(const InstrumentOperation operation);
+
+  //! @brief 実行回数と所要サイクル数を加算する
+  void AddCycle(const InstrumentOperation operation, const std::uint64_t cycle);
+
+  //! @brief 計測結果を返す
+  const OperationStatistics& GetStatistics(const InstrumentOperation operation) const;
+
+  //! @brief 他の計測結果を合算する
+  //! @note 各スレッドの計測結果を集計する場合に用いる
+  void Merge(const InstrumentationSnapshot &snapshot);
+
+  //! @brief 計測結果を初期化する
+  void clear();
+
+  //! @brief 計測結果をJSON形式で返す
+  std::string GetJSON() const;
+
+  //! @brief 計測結果をCSV形式で返す
+  //! @note 形式: operation,count,total_cycle,max_cycle,bin_0,...,bin_31 (1行目はヘッダ)
+  std::string GetCSV() const;
+
+private:
+  std::array<OperationStatistics, kInstrumentOperationNum> statistics_list_;    //!< 計測対象ごとの計測結果
+};
+
+//! @brief 現在のスレッドの計測結果を返す
+inline InstrumentationSnapshot& GetThreadInstrumentation();
+
+//! @brief 処理の実行回数を計測する
+template<InstrumentOperation Operation>
+void CountOperation();
+
+//! @brief スコープ内の処理の実行回数と所要サイクル数を計測する
+//! @note REALCORE_INSTRUMENTATIONが未定義の場合はメンバを持たない空のクラスとなる
+template<InstrumentOperation Operation>
+class ScopedOperationTimer
+{
+public:
+  ScopedOperationTimer();
+  ~ScopedOperationTimer();
+
+  ScopedOperationTimer(const ScopedOperationTimer&) = delete;
+  ScopedOperationTimer& operator=(const ScopedOperationTimer&) = delete;
+
+private:
+#ifdef REALCORE_INSTRUMENTATION
+  const std::uint64_t start_cycle_;   //!< 計測開始時のサイクルカウンタ
+#endif
+};
+
+}   // namespace realcore
+
+#include "Instrumentation-inl.h"
+
+#endif    // INSTRUMENTATION_H
@@ -8,6 +8,12 @@
 
 namespace realcore
 {
+inline LineNeighborhood::LineNeighborhood(const MovePosition move, const size_t distance, const LocalBitBoard &local_bit_board)
+: local_bit_board_(local_bit_board), move_(move), distance_(distance)
+{
+  assert(1 <= distance && distance <= 7);
+}
+
 template<PositionState S>
 inline void LineNeighborhood::SetCenterState()
 {
@@ -36,6 +36,16 @@ class LineNeighborhood{
 public:
   LineNeighborhood(const MovePosition move, const size_t distance, const BitBoard &board);
 
+  //! @param local_bit_board 直線近傍の状態(BitBoard::GetLocalBitBoardで取得した値)
+  LineNeighborhood(const MovePosition move, const size_t distance, const LocalBitBoard &local_bit_board);
+
+  //! @brief 直線近傍の長さをコンパイル時に指定して生成する
+  //! @param N 直線近傍の長さ
+  //! @note 長さによる分岐を行わず、直線近傍の取り出しとLocalBitBoardへの格納をまとめて行う
+  //! @note BitBoardの定義が必要なためBitBoard-inl.hで定義する
+  template<size_t N>
+  static LineNeighborhood Create(const MovePosition move, const BitBoard &bit_board);
+
   //! @brief 中心に状態を設定する
   //! @param S 黒石 or 白石
   //! @pre SはkBlackStoneもしくはkWhiteStoneであること
@@ -153,6 +153,18 @@ inline const MovePosition GetSymmetricMove(const MovePosition move, const BoardS
   return GetMove(symmetric_x + kCordinateCenter, symmetric_y + kCordinateCenter);
 }
 
+inline const BoardSymmetry GetInverseSymmetry(const BoardSymmetry symmetry)
+{
+  // 90度回転(kDiagonalSymmetry2, kDiagonalSymmetry3)以外は2回の変換で元に戻る
+  if(symmetry == kDiagonalSymmetry2){
+    return kDiagonalSymmetry3;
+  }else if(symmetry == kDiagonalSymmetry3){
+    return kDiagonalSymmetry2;
+  }
+
+  return symmetry;
+}
+
 inline std::string MoveString(const MovePosition move)
 {
   static const std::array<std::string, kBoardLineNum + 1> kCordinateStr{{
@@ -99,6 +99,9 @@ const MovePosition GetMove(const Cordinate x, const Cordinate y);
 //! @retval 対称変換した位置
 const MovePosition GetSymmetricMove(const MovePosition move, const BoardSymmetry symmetry);
 
+//! @brief 対称変換の逆変換を返す
+const BoardSymmetry GetInverseSymmetry(const BoardSymmetry symmetry);
+
 static constexpr size_t kMaxBoardDistance = 225;    // BoardDistanceの最大値
 static constexpr size_t kMaxInBoardDistance = 119;  // 盤内の手間の最大値
 
@@ -0,0 +1,326 @@
+#ifndef MOVE_DAG_INL_H
+#define MOVE_DAG_INL_H
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+#include "MoveDAG.h"
+
+namespace realcore
+{
+
+template<class T>
+inline MoveDAGBase<T>::MoveDAGBase()
+: MoveDAGBase(MoveList())
+{
+}
+
+template<class T>
+inline MoveDAGBase<T>::MoveDAGBase(const MoveList &root_move_sequence)
+: root_move_sequence_(root_move_sequence)
+{
+  clear();
+}
+
+template<class T>
+void MoveDAGBase<T>::clear()
+{
+  node_list_.clear();
+  edge_list_.clear();
+  node_index_map_.clear();
+
+  // root nodeを設定
+  size_t black_pass_count = 0, white_pass_count = 0;
+  bool is_black_turn = true;
+
+  for(const auto move : root_move_sequence_){
+    if(move == kNullMove){
+      auto &pass_count = is_black_turn ? black_pass_count : white_pass_count;
+      pass_count++;
+    }
+
+    is_black_turn = !is_black_turn;
+  }
+
+  DAGNode root_node{};
+  root_node.hash_value = CalcHashValue(root_move_sequence_);
+  root_node.first_edge_index = kNullDAGEdgeIndex;
+  root_node.last_edge_index = kNullDAGEdgeIndex;
+  root_node.black_pass_count = static_cast<std::uint8_t>(black_pass_count);
+  root_node.white_pass_count = static_cast<std::uint8_t>(white_pass_count);
+  root_node.is_black_turn = is_black_turn;
+
+  node_list_.emplace_back(root_node);
+  node_index_map_[root_node.hash_value] = kRootDAGNodeIndex;
+}
+
+template<class T>
+inline void MoveDAGBase<T>::AddTree(const MoveTreeBase<T> &move_tree)
+{
+  AddSubtree(MoveList(), move_tree);
+}
+
+template<class T>
+void MoveDAGBase<T>::AddSubtree(const MoveList &move_list, const MoveTreeBase<T> &move_tree)
+{
+  DAGNodeIndex start_node_index = kRootDAGNodeIndex;
+
+  for(const auto move : move_list){
+    start_node_index = GetChildNode(start_node_index, move, nullptr);
+  }
+
+  // 探索木を深さ優先でたどり、到達局面のノードに対応付ける
+  const auto &tree_node_list = move_tree.GetMoveTreeNodeList();
+  std::vector< std::pair<MoveNodeIndex, DAGNodeIndex> > node_stack;
+
+  node_stack.emplace_back(kRootNodeIndex, start_node_index);
+
+  while(!node_stack.empty()){
+    MoveNodeIndex tree_node_index = kNullNodeIndex;
+    DAGNodeIndex dag_node_index = kNullDAGNodeIndex;
+
+    std::tie(tree_node_index, dag_node_index) = node_stack.back();
+    node_stack.pop_back();
+
+    MoveNodeIndex child_index = tree_node_list[tree_node_index].GetFirstChildIndex();
+    const size_t stack_size = node_stack.size();
+
+    while(child_index != kNullNodeIndex){
+      const auto &child_node = tree_node_list[child_index];
+      bool is_added_node = false;
+
+      const auto child_dag_index = GetChildNode(dag_node_index, child_node.GetMove(), &is_added_node);
+
+      if(is_added_node){
+        node_list_[child_dag_index].additional_data = child_node.GetAdditionalData();
+      }
+
+      node_stack.emplace_back(child_index, child_dag_index);
+      child_index = child_node.GetNextSiblingIndex();
+    }
+
+    // 合流する局面の子ノードの順序が探索木の行きがけ順になるよう兄弟順にたどる
+    std::reverse(node_stack.begin() + stack_size, node_stack.end());
+  }
+}
+
+template<class T>
+void MoveDAGBase<T>::ExpandTree(MoveTreeBase<T> * const move_tree) const
+{
+  assert(move_tree != nullptr);
+  assert(move_tree->empty());
+
+  move_tree->MoveRootNode();
+  move_tree->SetAdditionalData(node_list_[kRootDAGNodeIndex].additional_data);
+
+  // 合流するノードは参照された回数だけ部分木を複製する
+  std::vector< std::pair<DAGNodeIndex, MoveNodeIndex> > node_stack;
+  node_stack.emplace_back(kRootDAGNodeIndex, kRootNodeIndex);
+
+  while(!node_stack.empty()){
+    DAGNodeIndex dag_node_index = kNullDAGNodeIndex;
+    MoveNodeIndex tree_node_index = kNullNodeIndex;
+
+    std::tie(dag_node_index, tree_node_index) = node_stack.back();
+    node_stack.pop_back();
+
+    for(auto edge_index=node_list_[dag_node_index].first_edge_index; edge_index!=kNullDAGEdgeIndex; edge_index=edge_list_[edge_index].next_edge_index){
+      const auto &edge = edge_list_[edge_index];
+
+      move_tree->MoveNode(tree_node_index);
+      move_tree->AddChild(edge.move);
+      move_tree->MoveChildNode(edge.move);
+      move_tree->SetAdditionalData(node_list_[edge.child_node_index].additional_data);
+
+      const auto child_tree_index = static_cast<MoveNodeIndex>(move_tree->GetMoveTreeNodeList().size() - 1);
+      node_stack.emplace_back(edge.child_node_index, child_tree_index);
+    }
+  }
+
+  move_tree->MoveRootNode();
+}
+
+template<class T>
+const std::uint64_t MoveDAGBase<T>::GetExpandedTreeSize() const
+{
+  // 帰りがけ順に子ノードの部分木サイズを確定させる
+  constexpr std::uint64_t kUnknownSize = std::numeric_limits<std::uint64_t>::max();
+  std::vector<std::uint64_t> subtree_size_list(node_list_.size(), kUnknownSize);
+  std::vector<DAGNodeIndex> node_stack{kRootDAGNodeIndex};
+
+  while(!node_stack.empty()){
+    const auto node_index = node_stack.back();
+
+    if(subtree_size_list[node_index] != kUnknownSize){
+      node_stack.pop_back();
+      continue;
+    }
+
+    bool is_determined = true;
+    std::uint64_t subtree_size = 0;
+
+    for(auto edge_index=node_list_[node_index].first_edge_index; edge_index!=kNullDAGEdgeIndex; edge_index=edge_list_[edge_index].next_edge_index){
+      const auto child_node_index = edge_list_[edge_index].child_node_index;
+      const auto child_subtree_size = subtree_size_list[child_node_index];
+
+      if(child_subtree_size == kUnknownSize){
+        is_determined = false;
+        node_stack.emplace_back(child_node_index);
+      }else{
+        subtree_size += 1 + child_subtree_size;
+      }
+    }
+
+    if(is_determined){
+      subtree_size_list[node_index] = subtree_size;
+      node_stack.pop_back();
+    }
+  }
+
+  return subtree_size_list[kRootDAGNodeIndex];
+}
+
+template<class T>
+inline const size_t MoveDAGBase<T>::size() const
+{
+  return node_list_.size() - 1;
+}
+
+template<class T>
+inline const size_t MoveDAGBase<T>::GetEdgeCount() const
+{
+  return edge_list_.size();
+}
+
+template<class T>
+inline const bool MoveDAGBase<T>::empty() const
+{
+  return size() == 0;
+}
+
+template<class T>
+const DAGNodeIndex MoveDAGBase<T>::GetNodeIndex(const MoveList &move_list) const
+{
+  DAGNodeIndex node_index = kRootDAGNodeIndex;
+
+  for(const auto move : move_list){
+    node_index = FindChildNode(node_index, move);
+
+    if(node_index == kNullDAGNodeIndex){
+      return kNullDAGNodeIndex;
+    }
+  }
+
+  return node_index;
+}
+
+template<class T>
+inline const DAGNodeIndex MoveDAGBase<T>::FindNodeIndex(const HashValue hash_value) const
+{
+  const auto find_it = node_index_map_.find(hash_value);
+  return find_it == node_index_map_.end() ? kNullDAGNodeIndex : find_it->second;
+}
+
+template<class T>
+std::string MoveDAGBase<T>::str() const
+{
+  MoveTreeBase<T> move_tree;
+  ExpandTree(&move_tree);
+
+  return move_tree.str();
+}
+
+template<class T>
+std::string MoveDAGBase<T>::GetSGFLabeledText(const bool is_black_turn) const
+{
+  MoveTreeBase<T> move_tree;
+  ExpandTree(&move_tree);
+
+  return move_tree.GetSGFLabeledText(is_black_turn);
+}
+
+template<class T>
+const DAGNodeIndex MoveDAGBase<T>::GetChildNode(const DAGNodeIndex node_index, const MovePosition move, bool * const is_added_node)
+{
+  if(is_added_node != nullptr){
+    *is_added_node = false;
+  }
+
+  const auto registered_child_index = FindChildNode(node_index, move);
+
+  if(registered_child_index != kNullDAGNodeIndex){
+    return registered_child_index;
+  }
+
+  // 子ノードの局面のHash値を求める
+  const DAGNode &node = node_list_[node_index];
+
+  DAGNode child_node{};
+  child_node.first_edge_index = kNullDAGEdgeIndex;
+  child_node.last_edge_index = kNullDAGEdgeIndex;
+  child_node.black_pass_count = node.black_pass_count;
+  child_node.white_pass_count = node.white_pass_count;
+  child_node.is_black_turn = !node.is_black_turn;
+
+  if(move != kNullMove){
+    child_node.hash_value = CalcHashValue(node.is_black_turn, move, node.hash_value);
+  }else{
+    // パスは手番ごとの回数に応じて異なるHash値とする(CalcHashValue(const MoveList&)と同一)
+    auto &pass_count = node.is_black_turn ? child_node.black_pass_count : child_node.white_pass_count;
+    const auto pass_move = static_cast<MovePosition>(move + 16 * pass_count);
+
+    child_node.hash_value = CalcHashValue(node.is_black_turn, pass_move, node.hash_value);
+    pass_count++;
+  }
+
+  // 同一局面のノードがなければ追加する
+  DAGNodeIndex child_node_index = FindNodeIndex(child_node.hash_value);
+
+  if(child_node_index == kNullDAGNodeIndex){
+    assert(node_list_.size() < kNullDAGNodeIndex);
+    child_node_index = static_cast<DAGNodeIndex>(node_list_.size());
+
+    node_list_.emplace_back(child_node);
+    node_index_map_[child_node.hash_value] = child_node_index;
+
+    if(is_added_node != nullptr){
+      *is_added_node = true;
+    }
+  }
+
+  // 辺を追加する
+  assert(edge_list_.size() < kNullDAGEdgeIndex);
+  const auto edge_index = static_cast<DAGEdgeIndex>(edge_list_.size());
+  edge_list_.push_back(DAGEdge{child_node_index, kNullDAGEdgeIndex, move});
+
+  DAGNode &parent_node = node_list_[node_index];
+
+  if(parent_node.first_edge_index == kNullDAGEdgeIndex){
+    parent_node.first_edge_index = edge_index;
+  }else{
+    edge_list_[parent_node.last_edge_index].next_edge_index = edge_index;
+  }
+
+  parent_node.last_edge_index = edge_index;
+
+  return child_node_index;
+}
+
+template<class T>
+const DAGNodeIndex MoveDAGBase<T>::FindChildNode(const DAGNodeIndex node_index, const MovePosition move) const
+{
+  for(auto edge_index=node_list_[node_index].first_edge_index; edge_index!=kNullDAGEdgeIndex; edge_index=edge_list_[edge_index].next_edge_index){
+    const auto &edge = edge_list_[edge_index];
+
+    if(edge.move == move){
+      return edge.child_node_index;
+    }
+  }
+
+  return kNullDAGNodeIndex;
+}
+
+}   // namespace realcore
+
+#endif    // MOVE_DAG_INL_H
@@ -0,0 +1,125 @@
+//! @file
+//! @brief 同一局面の部分木を共有する探索DAGの定義
+//! @author Koichi NABETANI
+//! @date 2017/05/27
+#ifndef MOVE_DAG_H
+#define MOVE_DAG_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "HashTable.h"
+#include "MoveList.h"
+#include "MoveTree.h"
+
+namespace realcore
+{
+
+typedef std::uint32_t DAGNodeIndex;     //!< MoveDAGクラスのノード配列のindex
+typedef std::uint32_t DAGEdgeIndex;     //!< MoveDAGクラスの辺配列のindex
+
+constexpr DAGNodeIndex kNullDAGNodeIndex = std::numeric_limits<DAGNodeIndex>::max();
+constexpr DAGEdgeIndex kNullDAGEdgeIndex = std::numeric_limits<DAGEdgeIndex>::max();
+constexpr DAGNodeIndex kRootDAGNodeIndex = 0;   //!< root nodeのDAGNodeIndex
+
+// 前方宣言
+class MoveDAGBaseTest;
+
+//! @brief 探索DAG
+//! @note 到達局面のHash値(CalcHashValue)が同一のノードを共有することで、手順前後で同一局面となる部分木を1つにまとめる
+//! @note 同一局面のノードに追加された子ノードはすべて共有される(合流した局面の子ノードは和集合となる)
+template<class T>
+class MoveDAGBase
+{
+  friend class MoveDAGBaseTest;
+
+public:
+  MoveDAGBase();
+
+  //! @param root_move_sequence root nodeまでの局面の手順
+  explicit MoveDAGBase(const MoveList &root_move_sequence);
+
+  //! @brief root nodeに探索木を追加する
+  void AddTree(const MoveTreeBase<T> &move_tree);
+
+  //! @brief root nodeから指定の手順で到達するノードに探索木を追加する
+  //! @note 手順上のノードが存在しない場合は追加する
+  void AddSubtree(const MoveList &move_list, const MoveTreeBase<T> &move_tree);
+
+  //! @brief 探索DAGを探索木に展開する
+  //! @pre move_treeは空であること
+  void ExpandTree(MoveTreeBase<T> * const move_tree) const;
+
+  //! @brief 探索木に展開した場合のサイズ（root node以外のノード数）を返す
+  const std::uint64_t GetExpandedTreeSize() const;
+
+  //! @brief ノード数（root node以外）を返す
+  const size_t size() const;
+
+  //! @brief 辺の数を返す
+  const size_t GetEdgeCount() const;
+
+  //! @brief 探索DAGが空かどうかを返す
+  const bool empty() const;
+
+  //! @brief 探索DAGを初期化する
+  void clear();
+
+  //! @brief 指定の手順で到達するノードのnode indexを返す
+  //! @note ノードが存在しない場合はkNullDAGNodeIndexを返す
+  const DAGNodeIndex GetNodeIndex(const MoveList &move_list) const;
+
+  //! @brief 指定のHash値の局面のノードのnode indexを返す
+  //! @note ノードが存在しない場合はkNullDAGNodeIndexを返す
+  const DAGNodeIndex FindNodeIndex(const HashValue hash_value) const;
+
+  //! @brief MoveDAG全体を探索木に展開した[a-o]形式の文字列を出力する
+  std::string str() const;
+
+  //! @brief MoveDAG全体を探索木に展開したSGF形式で出力する
+  std::string GetSGFLabeledText(const bool is_black_turn) const;
+
+private:
+  //! @brief 局面のノード
+  struct DAGNode{
+    HashValue hash_value;                 //!< 局面のHash値
+    DAGEdgeIndex first_edge_index;        //!< 最初の子ノードへの辺のindex
+    DAGEdgeIndex last_edge_index;         //!< 最後の子ノードへの辺のindex
+    std::uint8_t black_pass_count;        //!< 局面までの黒のパス回数
+    std::uint8_t white_pass_count;        //!< 局面までの白のパス回数
+    bool is_black_turn;                   //!< 局面の手番
+    T additional_data;                    //!< 付加情報
+  };
+
+  //! @brief 子ノードへの辺
+  struct DAGEdge{
+    DAGNodeIndex child_node_index;        //!< 子ノードのindex
+    DAGEdgeIndex next_edge_index;         //!< 次の兄弟への辺のindex
+    MovePosition move;                    //!< 子ノードへの指し手
+  };
+
+  //! @brief 指定ノードの指定の指し手の子ノードを返す
+  //! @note 子ノードが存在しない場合は局面のノードを取得(なければ追加)し辺を追加する
+  //! @param is_added_node 局面のノードを新規に追加したかを返す(nullptrの場合は返さない)
+  const DAGNodeIndex GetChildNode(const DAGNodeIndex node_index, const MovePosition move, bool * const is_added_node);
+
+  //! @brief 指定ノードの指定の指し手の子ノードのnode indexを返す
+  //! @note 子ノードが存在しない場合はkNullDAGNodeIndexを返す
+  const DAGNodeIndex FindChildNode(const DAGNodeIndex node_index, const MovePosition move) const;
+
+  std::vector<DAGNode> node_list_;        //!< ノード配列
+  std::vector<DAGEdge> edge_list_;        //!< 辺配列
+  std::unordered_map<HashValue, DAGNodeIndex> node_index_map_;    //!< 局面のHash値 -> node index
+  MoveList root_move_sequence_;           //!< root nodeまでの局面の手順
+};
+
+typedef MoveDAGBase<EmptyAditionalData> MoveDAG;
+typedef MoveDAGBase<std::string> MoveTextDAG;
+
+}   // namespace realcore
+
+#include "MoveDAG-inl.h"
+
+#endif    // MOVE_DAG_H
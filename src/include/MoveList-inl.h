@@ -193,6 +193,50 @@ inline void SelectMove(const MoveBitSet &select_bit, MoveBitSet * const move_bit
   GetMoveList(select_move_bit, move_list);
 }
 
+inline const MovePosition GetPOSMove(const unsigned char pos_value)
+{
+  const Cordinate x = static_cast<Cordinate>(pos_value % kBoardLineNum + 1);
+  const Cordinate y = static_cast<Cordinate>(pos_value / kBoardLineNum + 1);
+
+  return GetMove(x, y);
+}
+
+inline MoveListView::MoveListView()
+: move_data_(nullptr), move_count_(0)
+{
+}
+
+inline MoveListView::MoveListView(const MovePosition * const move_data, const size_t move_count)
+: move_data_(move_data), move_count_(move_count)
+{
+}
+
+inline const size_t MoveListView::size() const
+{
+  return move_count_;
+}
+
+inline const bool MoveListView::empty() const
+{
+  return move_count_ == 0;
+}
+
+inline const MovePosition MoveListView::operator[](const size_t index) const
+{
+  assert(index < move_count_);
+  return move_data_[index];
+}
+
+inline const MovePosition* MoveListView::begin() const
+{
+  return move_data_;
+}
+
+inline const MovePosition* MoveListView::end() const
+{
+  return move_data_ + move_count_;
+}
+
 }
 
 #endif  // MOVE_LIST_INL_H
@@ -32,6 +32,9 @@ void GetMoveList(const MoveBitSet &move_bit_set, MoveList * const move_list);
 //! POS形式ファイルを読み込む
 void ReadPOSFile(const std::string &pos_file_path, MoveList * const move_list);
 
+//! @brief POS形式の1byte((y - 1) * 15 + (x - 1))を指し手に変換する
+const MovePosition GetPOSMove(const unsigned char pos_value);
+
 //! @brief 対称変換した指し手リストを生成する
 //! @param move_list 変換対称の指し手リスト
 //! @param symmetry 対称性
@@ -156,6 +159,38 @@ private:
   //! @brief 指し手リスト
   std::vector<MovePosition> move_list_;
 };
+
+//! @brief 連続した領域に格納された指し手列への参照
+//! @note 参照先の領域を解放するまで有効
+class MoveListView
+{
+public:
+  MoveListView();
+  MoveListView(const MovePosition * const move_data, const size_t move_count);
+
+  //! @brief 手数を返す
+  const size_t size() const;
+
+  //! @brief 指し手がないかを返す
+  const bool empty() const;
+
+  //! @brief 添字演算子
+  const MovePosition operator[](const size_t index) const;
+
+  //! @breif 範囲の開始イテレータを返す
+  const MovePosition* begin() const;
+
+  //! @breif 範囲の終端イテレータを返す
+  const MovePosition* end() const;
+
+  //! @brief 指し手リストに変換する
+  //! @note move_listの内容は置き換える
+  void GetMoveList(MoveList * const move_list) const;
+
+private:
+  const MovePosition *move_data_;   //!< 指し手列の先頭
+  size_t move_count_;               //!< 手数
+};
 }   // namespace realcore
 
 #include "MoveList-inl.h"
@@ -1,22 +1,56 @@
 #ifndef MOVE_TREE_INL_H
 #define MOVE_TREE_INL_H
 
-#include <sstream>
+#include <algorithm>
+#include <cerrno>
 #include <map>
+#include <string>
+
+#include <unistd.h>
+
+#include <boost/thread.hpp>
 
 #include "MoveTree.h"
 
 namespace realcore
 {
 
-template<class T>
-inline MoveTreeBase<T>::MoveTreeBase()
+inline const bool WriteFileDescriptor(const int file_descriptor, const std::string &text)
+{
+  size_t write_size = 0;
+
+  while(write_size < text.size()){
+    const auto result = write(file_descriptor, text.data() + write_size, text.size() - write_size);
+
+    if(result < 0){
+      if(errno == EINTR){
+        continue;
+      }
+
+      return false;
+    }
+
+    write_size += static_cast<size_t>(result);
+  }
+
+  return true;
+}
+
+template<class T, class NodeStore>
+inline MoveTreeBase<T, NodeStore>::MoveTreeBase()
+: MoveTreeBase(kNoChildIndex)
+{
+}
+
+template<class T, class NodeStore>
+inline MoveTreeBase<T, NodeStore>::MoveTreeBase(const bool use_child_index)
+: use_child_index_(use_child_index)
 {
   clear();
 }
 
-template<class T>
-void MoveTreeBase<T>::AddChild(const MovePosition move)
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::AddChild(const MovePosition move)
 {
   assert(tree_.size() < kMaxMoveNodeIndex);
 
@@ -28,6 +62,7 @@ void MoveTreeBase<T>::AddChild(const MovePosition move)
   const MoveNodeIndex child_node_index = static_cast<MoveNodeIndex>(tree_.size());
 
   tree_.emplace_back(current_node_index_, move);
+  youngest_child_index_list_.emplace_back(kNullNodeIndex);
   auto& current_node = tree_[current_node_index_];
 
   if(!current_node.HasChild()){
@@ -38,10 +73,13 @@ void MoveTreeBase<T>::AddChild(const MovePosition move)
 
     youngest_child_node.SetNextSiblingIndex(child_node_index);
   }
+
+  youngest_child_index_list_[current_node_index_] = child_node_index;
+  RegisterChildIndex(child_node_index);
 }
 
-template<class T>
-void MoveTreeBase<T>::AddChild(const MoveList &move_list)
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::AddChild(const MoveList &move_list)
 {
   const MoveNodeIndex current_node_index = current_node_index_;
 
@@ -53,8 +91,8 @@ void MoveTreeBase<T>::AddChild(const MoveList &move_list)
   current_node_index_ = current_node_index;
 }
 
-template<class T>
-void MoveTreeBase<T>::AddSubtree(const MoveTreeBase<T> &move_tree)
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::AddSubtree(const MoveTreeBase<T, NodeStore> &move_tree)
 {
   const MoveNodeIndex start_node_index = static_cast<MoveNodeIndex>(tree_.size() - 1);
   const auto& subtree_node_list = move_tree.GetMoveTreeNodeList();
@@ -66,6 +104,7 @@ void MoveTreeBase<T>::AddSubtree(const MoveTreeBase<T> &move_tree)
 
   assert(tree_.size() + subtree_node_count < kMaxMoveNodeIndex);
   tree_.reserve(tree_.size() + subtree_node_count);
+  youngest_child_index_list_.resize(tree_.size() + subtree_node_count, kNullNodeIndex);
 
   // subtreeを追加する
   std::vector<MoveNodeIndex> subtree_top_node;   // sub treeのroot node直下のノード一覧
@@ -95,6 +134,10 @@ void MoveTreeBase<T>::AddSubtree(const MoveTreeBase<T> &move_tree)
     if(first_child_index != kNullNodeIndex){
       added_node.SetFirstChildIndex(first_child_index + start_node_index);
     }
+
+    if(added_node.GetParentIndex() != kRootNodeIndex && added_node.GetNextSiblingIndex() == kNullNodeIndex){
+      youngest_child_index_list_[added_node.GetParentIndex()] = node_index;
+    }
   }
 
   // カレントノードとsub treeのroot node直下のノードの親子関係を更新する
@@ -113,18 +156,26 @@ void MoveTreeBase<T>::AddSubtree(const MoveTreeBase<T> &move_tree)
 
       youngest_child_node.SetNextSiblingIndex(node_index);
     }
+
+    youngest_child_index_list_[current_node_index_] = node_index;
+  }
+
+  if(use_child_index_){
+    for(size_t node_index=start_node_index + 1, size=tree_.size(); node_index<size; node_index++){
+      RegisterChildIndex(node_index);
+    }
   }
 }
 
-template<class T>
-inline void MoveTreeBase<T>::MoveNode(const MoveNodeIndex node_index)
+template<class T, class NodeStore>
+inline void MoveTreeBase<T, NodeStore>::MoveNode(const MoveNodeIndex node_index)
 {
   assert(node_index < tree_.size());
   current_node_index_ = node_index;
 }
 
-template<class T>
-const bool MoveTreeBase<T>::MoveChildNode(const MovePosition move)
+template<class T, class NodeStore>
+const bool MoveTreeBase<T, NodeStore>::MoveChildNode(const MovePosition move)
 {
   const auto child_node_index = GetChildNodeIndex(move);
 
@@ -136,8 +187,8 @@ const bool MoveTreeBase<T>::MoveChildNode(const MovePosition move)
   return true;
 }
 
-template<class T>
-const bool MoveTreeBase<T>::MoveChildNode(const MoveList &move_list)
+template<class T, class NodeStore>
+const bool MoveTreeBase<T, NodeStore>::MoveChildNode(const MoveList &move_list)
 {
   const auto current_node_index = current_node_index_;
 
@@ -152,8 +203,8 @@ const bool MoveTreeBase<T>::MoveChildNode(const MoveList &move_list)
   return true;
 }
 
-template<class T>
-inline void MoveTreeBase<T>::MoveParent()
+template<class T, class NodeStore>
+inline void MoveTreeBase<T, NodeStore>::MoveParent()
 {
   if(IsRootNode()){
     return;
@@ -163,8 +214,20 @@ inline void MoveTreeBase<T>::MoveParent()
   current_node_index_ = current_node.GetParentIndex();
 }
 
-template<class T>
-void MoveTreeBase<T>::GetChildMoveList(MoveList * const move_list) const
+template<class T, class NodeStore>
+inline const T& MoveTreeBase<T, NodeStore>::GetAdditionalData() const
+{
+  return tree_[current_node_index_].GetAdditionalData();
+}
+
+template<class T, class NodeStore>
+inline void MoveTreeBase<T, NodeStore>::SetAdditionalData(const T &additional_data)
+{
+  tree_[current_node_index_].SetAdditionalData(additional_data);
+}
+
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::GetChildMoveList(MoveList * const move_list) const
 {
   assert(move_list != nullptr);
   assert(move_list->empty());
@@ -181,14 +244,14 @@ void MoveTreeBase<T>::GetChildMoveList(MoveList * const move_list) const
   }
 }
 
-template<class T>
-inline const size_t MoveTreeBase<T>::size() const
+template<class T, class NodeStore>
+inline const size_t MoveTreeBase<T, NodeStore>::size() const
 {
   return tree_.size() - 1;
 }
 
-template<class T>
-inline const size_t MoveTreeBase<T>::depth() const
+template<class T, class NodeStore>
+inline const size_t MoveTreeBase<T, NodeStore>::depth() const
 {
   std::vector<size_t> depth_list(tree_.size(), 0);   //!< ノード別深さリスト
   size_t tree_depth = 0;
@@ -206,15 +269,20 @@ inline const size_t MoveTreeBase<T>::depth() const
   return tree_depth;
 }
 
-template<class T>
-inline const bool MoveTreeBase<T>::IsRootNode() const
+template<class T, class NodeStore>
+inline const bool MoveTreeBase<T, NodeStore>::IsRootNode() const
 {
   return (current_node_index_ == kRootNodeIndex);
 }
 
-template<class T>
-const MoveNodeIndex MoveTreeBase<T>::GetChildNodeIndex(const MovePosition move) const
+template<class T, class NodeStore>
+const MoveNodeIndex MoveTreeBase<T, NodeStore>::GetChildNodeIndex(const MovePosition move) const
 {
+  if(use_child_index_){
+    const auto find_it = child_index_.find(GetChildIndexKey(current_node_index_, move));
+    return find_it == child_index_.end() ? kNullNodeIndex : find_it->second;
+  }
+
   MoveNodeIndex child_node_index = tree_[current_node_index_].GetFirstChildIndex();
 
   while(child_node_index != kNullNodeIndex){
@@ -231,137 +299,385 @@ const MoveNodeIndex MoveTreeBase<T>::GetChildNodeIndex(const MovePosition move)
   return kNullNodeIndex;
 }
 
-template<class T>
-const MoveNodeIndex MoveTreeBase<T>::GetYoungestChildNodeIndex() const
+template<class T, class NodeStore>
+inline const MoveNodeIndex MoveTreeBase<T, NodeStore>::GetYoungestChildNodeIndex() const
 {
-  MoveNodeIndex child_node_index = tree_[current_node_index_].GetFirstChildIndex();
-  assert(child_node_index != kNullNodeIndex);
+  assert(tree_[current_node_index_].HasChild());
+  return youngest_child_index_list_[current_node_index_];
+}
 
-  while(child_node_index != kNullNodeIndex){
-    const auto& child_node = tree_[child_node_index];
-    const auto next_sibling_index = child_node.GetNextSiblingIndex();
+template<class T, class NodeStore>
+std::string MoveTreeBase<T, NodeStore>::str() const
+{
+  std::string tree_str;
+  WriteStr(kRootNodeIndex, false, &tree_str, TextFlusher());
 
-    if(next_sibling_index == kNullNodeIndex){
-      return child_node_index;
-    }
+  return tree_str;
+}
 
-    child_node_index = next_sibling_index;
-  }
-  
-  return kNullNodeIndex;
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::WriteStr(std::ostream &os) const
+{
+  std::string buffer;
+  buffer.reserve(kMoveTreeTextFlushSize);
+
+  const auto flusher = [&os](std::string * const buffer){
+    os.write(buffer->data(), buffer->size());
+    buffer->clear();
+  };
+
+  WriteStr(kRootNodeIndex, false, &buffer, flusher);
+  flusher(&buffer);
 }
 
-template<class T>
-std::string MoveTreeBase<T>::str() const
+template<class T, class NodeStore>
+const bool MoveTreeBase<T, NodeStore>::WriteStr(const int file_descriptor) const
 {
-  return str(kRootNodeIndex);
+  std::string buffer;
+  buffer.reserve(kMoveTreeTextFlushSize);
+
+  bool is_success = true;
+
+  const auto flusher = [file_descriptor, &is_success](std::string * const buffer){
+    is_success &= WriteFileDescriptor(file_descriptor, *buffer);
+    buffer->clear();
+  };
+
+  WriteStr(kRootNodeIndex, false, &buffer, flusher);
+  flusher(&buffer);
+
+  return is_success;
 }
 
-template<class T>
-std::string MoveTreeBase<T>::str(MoveNodeIndex move_node_index) const
+template<class T, class NodeStore>
+std::string MoveTreeBase<T, NodeStore>::GetStrParallel(const size_t thread_num) const
 {
-  std::string subtree_str = "";
-  MoveNodeIndex child_node_index = tree_[move_node_index].GetFirstChildIndex();
-  
-  if(child_node_index == kNullNodeIndex){
-    // leaf node
-    return subtree_str;
+  // 分岐のない手順はそのまま出力する
+  std::string tree_str;
+  MoveNodeIndex branch_node_index = kRootNodeIndex;
+  std::vector<MoveNodeIndex> child_index_list;
+
+  GetChildNodeIndexList(branch_node_index, &child_index_list);
+
+  while(child_index_list.size() == 1){
+    branch_node_index = child_index_list[0];
+    tree_str += MoveString(tree_[branch_node_index].GetMove());
+
+    child_index_list.clear();
+    GetChildNodeIndexList(branch_node_index, &child_index_list);
   }
 
-  const auto &child_node = tree_[child_node_index];
-  const bool is_multiple_brothers = child_node.GetNextSiblingIndex() != kNullNodeIndex;
+  // 分岐ノードの子ノード以下を並列に出力する
+  std::vector<std::string> subtree_str_list(child_index_list.size());
+  boost::thread_group thread_group;
 
-  if(is_multiple_brothers){
-    while(child_node_index != kNullNodeIndex){
-      auto &child_node = tree_[child_node_index];
+  const size_t worker_num = std::max<size_t>(1, std::min(thread_num, child_index_list.size()));
 
-      subtree_str += "(";
-      subtree_str += MoveString(child_node.GetMove());
-      subtree_str += str(child_node_index);
-      subtree_str += ")";
-      
-      child_node_index = child_node.GetNextSiblingIndex();
-    }
+  for(size_t worker_index=0; worker_index<worker_num; worker_index++){
+    thread_group.create_thread([this, worker_index, worker_num, &child_index_list, &subtree_str_list](){
+      for(size_t i=worker_index, size=child_index_list.size(); i<size; i+=worker_num){
+        WriteStr(child_index_list[i], true, &subtree_str_list[i], TextFlusher());
+      }
+    });
+  }
+
+  thread_group.join_all();
+
+  for(const auto &subtree_str : subtree_str_list){
+    tree_str += subtree_str;
+  }
+
+  return tree_str;
+}
+
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::WriteStr(const MoveNodeIndex move_node_index, const bool is_branch, std::string * const buffer, const TextFlusher &flusher) const
+{
+  assert(buffer != nullptr);
+
+  enum class WriteAction{
+    kExpand,      // ノードの子ノードを出力する
+    kOpen,        // "("と指し手を出力し、子ノードを展開する
+    kClose,       // ")"を出力する
+  };
+
+  std::vector< std::pair<WriteAction, MoveNodeIndex> > action_stack;
+
+  if(is_branch){
+    action_stack.emplace_back(WriteAction::kClose, move_node_index);
+    action_stack.emplace_back(WriteAction::kOpen, move_node_index);
   }else{
-    subtree_str = MoveString(child_node.GetMove());
-    subtree_str += str(child_node_index);
+    action_stack.emplace_back(WriteAction::kExpand, move_node_index);
+  }
+
+  while(!action_stack.empty()){
+    if(flusher && buffer->size() >= kMoveTreeTextFlushSize){
+      flusher(buffer);
+    }
+
+    const auto action = action_stack.back();
+    action_stack.pop_back();
+
+    if(action.first == WriteAction::kClose){
+      *buffer += ")";
+      continue;
+    }
+
+    if(action.first == WriteAction::kOpen){
+      *buffer += "(";
+      *buffer += MoveString(tree_[action.second].GetMove());
+      action_stack.emplace_back(WriteAction::kExpand, action.second);
+      continue;
+    }
+
+    const MoveNodeIndex child_node_index = tree_[action.second].GetFirstChildIndex();
+    
+    if(child_node_index == kNullNodeIndex){
+      // leaf node
+      continue;
+    }
+
+    const auto &child_node = tree_[child_node_index];
+    const bool is_multiple_brothers = child_node.GetNextSiblingIndex() != kNullNodeIndex;
+
+    if(!is_multiple_brothers){
+      *buffer += MoveString(child_node.GetMove());
+      action_stack.emplace_back(WriteAction::kExpand, child_node_index);
+      continue;
+    }
+
+    // 兄弟順に出力するため逆順にスタックに積む
+    const size_t stack_size = action_stack.size();
+
+    for(MoveNodeIndex node_index=child_node_index; node_index!=kNullNodeIndex; node_index=tree_[node_index].GetNextSiblingIndex()){
+      action_stack.emplace_back(WriteAction::kOpen, node_index);
+      action_stack.emplace_back(WriteAction::kClose, node_index);
+    }
+
+    std::reverse(action_stack.begin() + stack_size, action_stack.end());
   }
+}
+
+template<class T, class NodeStore>
+std::string MoveTreeBase<T, NodeStore>::GetSGFLabeledText(const bool is_black_turn) const
+{
+  static constexpr size_t kRootDepth = 1;
+
+  std::string sgf_text, label_string;
+  WriteSGFLabeledText(kRootNodeIndex, false, is_black_turn, kRootDepth, &label_string, &sgf_text, TextFlusher());
 
-  return subtree_str;
+  return sgf_text;
 }
 
-template<class T>
-std::string MoveTreeBase<T>::GetSGFLabeledText(const bool is_black_turn) const
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::WriteSGFLabeledText(const bool is_black_turn, std::ostream &os) const
 {
   static constexpr size_t kRootDepth = 1;
-  return GetSGFLabeledText(kRootNodeIndex, is_black_turn, "", kRootDepth);
+
+  std::string buffer, label_string;
+  buffer.reserve(kMoveTreeTextFlushSize);
+
+  const auto flusher = [&os](std::string * const buffer){
+    os.write(buffer->data(), buffer->size());
+    buffer->clear();
+  };
+
+  WriteSGFLabeledText(kRootNodeIndex, false, is_black_turn, kRootDepth, &label_string, &buffer, flusher);
+  flusher(&buffer);
 }
 
-template<class T>
-std::string MoveTreeBase<T>::GetSGFLabeledText(MoveNodeIndex move_node_index, const bool is_black_turn, const std::string &label_string, const size_t depth) const
+template<class T, class NodeStore>
+const bool MoveTreeBase<T, NodeStore>::WriteSGFLabeledText(const bool is_black_turn, const int file_descriptor) const
 {
-  std::string subtree_str = "";
-  MoveNodeIndex child_node_index = tree_[move_node_index].GetFirstChildIndex();
-  
-  if(child_node_index == kNullNodeIndex){
-    // leaf node
-    return subtree_str;
+  static constexpr size_t kRootDepth = 1;
+
+  std::string buffer, label_string;
+  buffer.reserve(kMoveTreeTextFlushSize);
+
+  bool is_success = true;
+
+  const auto flusher = [file_descriptor, &is_success](std::string * const buffer){
+    is_success &= WriteFileDescriptor(file_descriptor, *buffer);
+    buffer->clear();
+  };
+
+  WriteSGFLabeledText(kRootNodeIndex, false, is_black_turn, kRootDepth, &label_string, &buffer, flusher);
+  flusher(&buffer);
+
+  return is_success;
+}
+
+template<class T, class NodeStore>
+std::string MoveTreeBase<T, NodeStore>::GetSGFLabeledTextParallel(const bool is_black_turn, const size_t thread_num) const
+{
+  static constexpr size_t kRootDepth = 1;
+
+  // 分岐のない手順はそのまま出力する
+  std::string sgf_text, label_string;
+  MoveNodeIndex branch_node_index = kRootNodeIndex;
+  bool branch_turn = is_black_turn;
+  size_t branch_depth = kRootDepth;
+  std::vector<MoveNodeIndex> child_index_list;
+
+  GetChildNodeIndexList(branch_node_index, &child_index_list);
+
+  while(child_index_list.size() == 1){
+    branch_node_index = child_index_list[0];
+    WriteSGFNode(branch_node_index, branch_turn, branch_depth, label_string.size(), &label_string, &sgf_text);
+
+    branch_turn = !branch_turn;
+    branch_depth++;
+
+    child_index_list.clear();
+    GetChildNodeIndexList(branch_node_index, &child_index_list);
   }
 
-  const auto &child_node = tree_[child_node_index];
-  const bool is_multiple_brothers = child_node.GetNextSiblingIndex() != kNullNodeIndex;
+  // 分岐ノードの子ノード以下を並列に出力する
+  std::vector<std::string> subtree_text_list(child_index_list.size());
+  boost::thread_group thread_group;
 
-  std::stringstream label_string_stream;
-  label_string_stream << depth;
-  const std::string label = label_string_stream.str();
+  const size_t worker_num = std::max<size_t>(1, std::min(thread_num, child_index_list.size()));
 
-  if(is_multiple_brothers){
-    while(child_node_index != kNullNodeIndex){
-      auto &child_node = tree_[child_node_index];
-      const auto move = child_node.GetMove();
-      const auto move_string = move == kNullMove ? "tt" : MoveString(move);
-      const auto child_label_string = label_string + "[" + move_string + ":" + label + "]";
+  for(size_t worker_index=0; worker_index<worker_num; worker_index++){
+    thread_group.create_thread([this, worker_index, worker_num, branch_turn, branch_depth, &label_string, &child_index_list, &subtree_text_list](){
+      std::string worker_label_string;
 
-      subtree_str += "(";
-      
-      subtree_str += ";LB";
-      subtree_str += child_label_string;
+      for(size_t i=worker_index, size=child_index_list.size(); i<size; i+=worker_num){
+        worker_label_string = label_string;
+        WriteSGFLabeledText(child_index_list[i], true, branch_turn, branch_depth, &worker_label_string, &subtree_text_list[i], TextFlusher());
+      }
+    });
+  }
 
-      subtree_str += (is_black_turn ? "B[" : "W[");
-      subtree_str += move_string;
-      subtree_str += "]";
+  thread_group.join_all();
 
-      subtree_str += GetSGFLabeledText(child_node_index, !is_black_turn, child_label_string, depth + 1);
-      subtree_str += ")";
-      
-      child_node_index = child_node.GetNextSiblingIndex();
-    }
+  for(const auto &subtree_text : subtree_text_list){
+    sgf_text += subtree_text;
+  }
+
+  return sgf_text;
+}
+
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::WriteSGFLabeledText(const MoveNodeIndex move_node_index, const bool is_branch, const bool is_black_turn, const size_t depth, std::string * const label_string, std::string * const buffer, const TextFlusher &flusher) const
+{
+  assert(label_string != nullptr);
+  assert(buffer != nullptr);
+
+  enum class WriteAction{
+    kExpand,      // ノードの子ノードを出力する
+    kOpen,        // "("とノードを出力し、子ノードを展開する
+    kClose,       // ")"を出力する
+  };
+
+  //! 出力処理, 手番/深さ/ラベル長はkExpandではnodeの子ノード、kOpenではnodeのもの
+  struct WriteTask{
+    WriteAction action;
+    MoveNodeIndex node_index;
+    bool is_black_turn;
+    size_t depth;
+    size_t label_length;
+  };
+
+  std::vector<WriteTask> task_stack;
+  const size_t label_length = label_string->size();
+
+  if(is_branch){
+    task_stack.push_back(WriteTask{WriteAction::kClose, move_node_index, is_black_turn, depth, label_length});
+    task_stack.push_back(WriteTask{WriteAction::kOpen, move_node_index, is_black_turn, depth, label_length});
   }else{
-    const auto move = child_node.GetMove();
-    const auto move_string = move == kNullMove ? "tt" : MoveString(move);
-      const auto child_label_string = label_string + "[" + move_string + ":" + label + "]";
+    task_stack.push_back(WriteTask{WriteAction::kExpand, move_node_index, is_black_turn, depth, label_length});
+  }
+
+  while(!task_stack.empty()){
+    if(flusher && buffer->size() >= kMoveTreeTextFlushSize){
+      flusher(buffer);
+    }
+
+    const auto task = task_stack.back();
+    task_stack.pop_back();
+
+    if(task.action == WriteAction::kClose){
+      *buffer += ")";
+      continue;
+    }
 
-      subtree_str += ";LB";
-      subtree_str += child_label_string;
+    if(task.action == WriteAction::kOpen){
+      *buffer += "(";
+      WriteSGFNode(task.node_index, task.is_black_turn, task.depth, task.label_length, label_string, buffer);
+      task_stack.push_back(WriteTask{WriteAction::kExpand, task.node_index, !task.is_black_turn, task.depth + 1, label_string->size()});
+      continue;
+    }
+
+    const MoveNodeIndex child_node_index = tree_[task.node_index].GetFirstChildIndex();
+    
+    if(child_node_index == kNullNodeIndex){
+      // leaf node
+      continue;
+    }
 
-    subtree_str += (is_black_turn ? "B[" : "W[");
-    subtree_str += move_string;
-    subtree_str += "]";
+    const auto &child_node = tree_[child_node_index];
+    const bool is_multiple_brothers = child_node.GetNextSiblingIndex() != kNullNodeIndex;
 
-    subtree_str += GetSGFLabeledText(child_node_index, !is_black_turn, child_label_string, depth + 1);
+    if(!is_multiple_brothers){
+      WriteSGFNode(child_node_index, task.is_black_turn, task.depth, task.label_length, label_string, buffer);
+      task_stack.push_back(WriteTask{WriteAction::kExpand, child_node_index, !task.is_black_turn, task.depth + 1, label_string->size()});
+      continue;
+    }
+
+    // 兄弟順に出力するため逆順にスタックに積む
+    const size_t stack_size = task_stack.size();
+
+    for(MoveNodeIndex node_index=child_node_index; node_index!=kNullNodeIndex; node_index=tree_[node_index].GetNextSiblingIndex()){
+      task_stack.push_back(WriteTask{WriteAction::kOpen, node_index, task.is_black_turn, task.depth, task.label_length});
+      task_stack.push_back(WriteTask{WriteAction::kClose, node_index, task.is_black_turn, task.depth, task.label_length});
+    }
+
+    std::reverse(task_stack.begin() + stack_size, task_stack.end());
   }
+}
+
+template<class T, class NodeStore>
+inline void MoveTreeBase<T, NodeStore>::WriteSGFNode(const MoveNodeIndex move_node_index, const bool is_black_turn, const size_t depth, const size_t label_length, std::string * const label_string, std::string * const buffer) const
+{
+  const auto move = tree_[move_node_index].GetMove();
+  const auto move_string = move == kNullMove ? "tt" : MoveString(move);
+
+  // 親ノードまでのラベルに当該ノードのラベルを追加する
+  label_string->resize(label_length);
+  *label_string += "[";
+  *label_string += move_string;
+  *label_string += ":";
+  *label_string += std::to_string(depth);
+  *label_string += "]";
+
+  *buffer += ";LB";
+  *buffer += *label_string;
+
+  *buffer += (is_black_turn ? "B[" : "W[");
+  *buffer += move_string;
+  *buffer += "]";
+}
+
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::GetChildNodeIndexList(const MoveNodeIndex move_node_index, std::vector<MoveNodeIndex> * const child_index_list) const
+{
+  assert(child_index_list != nullptr);
+  assert(child_index_list->empty());
 
-  return subtree_str;
+  for(MoveNodeIndex node_index=tree_[move_node_index].GetFirstChildIndex(); node_index!=kNullNodeIndex; node_index=tree_[node_index].GetNextSiblingIndex()){
+    child_index_list->emplace_back(node_index);
+  }
 }
 
-template<class T>
-inline const std::vector< MoveTreeNode<T> >& MoveTreeBase<T>::GetMoveTreeNodeList() const
+template<class T, class NodeStore>
+inline const NodeStore& MoveTreeBase<T, NodeStore>::GetMoveTreeNodeList() const
 {
   return tree_;
 }
 
-template<class T>
-void MoveTreeBase<T>::GetLeafNodeList(std::vector<MoveNodeIndex> * const leaf_index_list) const
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::GetLeafNodeList(std::vector<MoveNodeIndex> * const leaf_index_list) const
 {
   assert(leaf_index_list != nullptr);
   assert(leaf_index_list->empty());
@@ -377,8 +693,8 @@ void MoveTreeBase<T>::GetLeafNodeList(std::vector<MoveNodeIndex> * const leaf_in
   }
 }
 
-template<class T>
-inline const MovePosition MoveTreeBase<T>::GetTopNodeMove() const
+template<class T, class NodeStore>
+inline const MovePosition MoveTreeBase<T, NodeStore>::GetTopNodeMove() const
 {
   const auto& root_node = tree_[kRootNodeIndex];
 
@@ -389,24 +705,27 @@ inline const MovePosition MoveTreeBase<T>::GetTopNodeMove() const
   return top_node.GetMove();
 }
 
-template<class T>
-inline const bool MoveTreeBase<T>::empty() const
+template<class T, class NodeStore>
+inline const bool MoveTreeBase<T, NodeStore>::empty() const
 {
   return size() == 0;
 }
 
-template<class T>
-inline const void MoveTreeBase<T>::clear()
+template<class T, class NodeStore>
+inline const void MoveTreeBase<T, NodeStore>::clear()
 {
   tree_.clear();
+  youngest_child_index_list_.clear();
+  child_index_.clear();
   
   // root nodeを設定
   tree_.emplace_back(kNullNodeIndex, kInvalidMove);
+  youngest_child_index_list_.emplace_back(kNullNodeIndex);
   current_node_index_ = kRootNodeIndex;
 }
 
-template<class T>
-const bool MoveTreeBase<T>::IsConflictORNode(const MovePosition move) const
+template<class T, class NodeStore>
+const bool MoveTreeBase<T, NodeStore>::IsConflictORNode(const MovePosition move) const
 {
   constexpr bool kNodeOR = true;
 
@@ -443,14 +762,14 @@ const bool MoveTreeBase<T>::IsConflictORNode(const MovePosition move) const
   return false;
 }
 
-template<class T>
-void MoveTreeBase<T>::MoveRootNode()
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::MoveRootNode()
 {
   current_node_index_ = kRootNodeIndex;
 }
 
-template<class T>
-void MoveTreeBase<T>::GetMoveList(MoveList * const move_list) const
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::GetMoveList(MoveList * const move_list) const
 {
   assert(move_list != nullptr);
   assert(move_list->empty());
@@ -473,6 +792,136 @@ void MoveTreeBase<T>::GetMoveList(MoveList * const move_list) const
   }
 }
 
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::CompactNodeLayout()
+{
+  // 幅優先で探索し、各ノードの子ノードが連続するように新しいnode indexを割り当てる
+  std::vector<MoveNodeIndex> new_order_list;    // 新しい並び順でのold node index
+  std::vector<MoveNodeIndex> new_index_list(tree_.size(), kNullNodeIndex);    // old node index -> new node index
+
+  new_order_list.reserve(tree_.size());
+  new_order_list.emplace_back(kRootNodeIndex);
+  new_index_list[kRootNodeIndex] = kRootNodeIndex;
+
+  for(size_t i=0; i<new_order_list.size(); i++){
+    MoveNodeIndex child_node_index = tree_[new_order_list[i]].GetFirstChildIndex();
+
+    while(child_node_index != kNullNodeIndex){
+      new_index_list[child_node_index] = static_cast<MoveNodeIndex>(new_order_list.size());
+      new_order_list.emplace_back(child_node_index);
+
+      child_node_index = tree_[child_node_index].GetNextSiblingIndex();
+    }
+  }
+
+  assert(new_order_list.size() == tree_.size());
+  
+  const auto GetNewIndex = [&new_index_list](const MoveNodeIndex old_index){
+    return old_index == kNullNodeIndex ? kNullNodeIndex : new_index_list[old_index];
+  };
+
+  NodeStore compact_tree;
+  std::vector<MoveNodeIndex> youngest_child_index_list;
+
+  compact_tree.reserve(tree_.size());
+  youngest_child_index_list.reserve(tree_.size());
+
+  for(const auto old_index : new_order_list){
+    const auto& node = tree_[old_index];
+    compact_tree.emplace_back(node);
+
+    auto& compact_node = compact_tree.back();
+    compact_node.SetParentIndex(GetNewIndex(node.GetParentIndex()));
+    compact_node.SetNextSiblingIndex(GetNewIndex(node.GetNextSiblingIndex()));
+    compact_node.SetFirstChildIndex(GetNewIndex(node.GetFirstChildIndex()));
+
+    youngest_child_index_list.emplace_back(GetNewIndex(youngest_child_index_list_[old_index]));
+  }
+
+  tree_.swap(compact_tree);
+  youngest_child_index_list_.swap(youngest_child_index_list);
+  current_node_index_ = new_index_list[current_node_index_];
+
+  RebuildChildIndex();
+}
+
+template<class T, class NodeStore>
+inline const bool MoveTreeBase<T, NodeStore>::UseChildIndex() const
+{
+  return use_child_index_;
+}
+
+template<class T, class NodeStore>
+inline const std::uint64_t MoveTreeBase<T, NodeStore>::GetChildIndexKey(const MoveNodeIndex parent_index, const MovePosition move)
+{
+  return (static_cast<std::uint64_t>(parent_index) << 8) | static_cast<std::uint64_t>(move);
+}
+
+template<class T, class NodeStore>
+inline void MoveTreeBase<T, NodeStore>::RegisterChildIndex(const MoveNodeIndex node_index)
+{
+  if(!use_child_index_){
+    return;
+  }
+
+  const auto& node = tree_[node_index];
+  child_index_.emplace(GetChildIndexKey(node.GetParentIndex(), node.GetMove()), node_index);
+}
+
+template<class T, class NodeStore>
+void MoveTreeBase<T, NodeStore>::RebuildChildIndex()
+{
+  child_index_.clear();
+
+  if(!use_child_index_){
+    return;
+  }
+
+  child_index_.reserve(tree_.size());
+
+  // 兄弟の中で先に登録されたノードを優先するため兄弟順に登録する
+  for(size_t node_index=0, size=tree_.size(); node_index<size; node_index++){
+    MoveNodeIndex child_node_index = tree_[node_index].GetFirstChildIndex();
+
+    while(child_node_index != kNullNodeIndex){
+      RegisterChildIndex(child_node_index);
+      child_node_index = tree_[child_node_index].GetNextSiblingIndex();
+    }
+  }
+}
+
+inline MoveArenaTextTree::MoveArenaTextTree()
+: MoveArenaTextTree(std::make_shared<TextArena>())
+{
+}
+
+inline MoveArenaTextTree::MoveArenaTextTree(const std::shared_ptr<TextArena> &text_arena)
+: text_arena_list_{text_arena}
+{
+  assert(text_arena != nullptr);
+}
+
+inline void MoveArenaTextTree::AddSubtree(const MoveArenaTextTree &move_tree)
+{
+  BaseTree::AddSubtree(move_tree);
+
+  for(const auto &text_arena : move_tree.text_arena_list_){
+    if(std::find(text_arena_list_.begin(), text_arena_list_.end(), text_arena) == text_arena_list_.end()){
+      text_arena_list_.emplace_back(text_arena);
+    }
+  }
+}
+
+inline void MoveArenaTextTree::SetAdditionalData(const std::string &additional_data)
+{
+  BaseTree::SetAdditionalData(text_arena_list_.front()->Store(additional_data));
+}
+
+inline const std::shared_ptr<TextArena>& MoveArenaTextTree::GetTextArena() const
+{
+  return text_arena_list_.front();
+}
+
 }   // namespace realcore
 
 #endif    // MOVE_TREE_INL_H
\ No newline at end of file
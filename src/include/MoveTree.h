@@ -6,10 +6,17 @@
 #ifndef MOVE_TREE_H
 #define MOVE_TREE_H
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <unordered_map>
 #include <vector>
 
+#include "ChunkedVector.h"
 #include "MoveList.h"
 #include "MoveTreeNode.h"
+#include "TextArena.h"
 
 namespace realcore
 {
@@ -17,15 +24,36 @@ namespace realcore
 // 前方宣言
 class MoveTreeBaseTest;
 
+template<class T, class Codec>
+class MoveTreeSerializer;
+
+static constexpr bool kUseChildIndex = true;    //!< 子ノードのハッシュインデックスを使用する
+static constexpr bool kNoChildIndex = false;    //!< 子ノードのハッシュインデックスを使用しない
+
+static constexpr size_t kMoveTreeTextFlushSize = 64 * 1024;   //!< 文字列出力時にバッファを書き出すサイズ
+
+//! @brief 文字列をファイルディスクリプタに書き出す
+//! @retval true: 書込成功, false: 書込エラー
+const bool WriteFileDescriptor(const int file_descriptor, const std::string &text);
+
 //! @brief 探索木
-template<class T>
+//! @param NodeStore ノード配列のコンテナ
+//! @note NodeStoreにChunkedVectorを指定するとノードを再配置しないため、ノードへの参照は探索木の初期化まで有効
+template<class T, class NodeStore = std::vector< MoveTreeNode<T> > >
 class MoveTreeBase
 {
   friend class MoveTreeBaseTest;
 
+  template<class U, class Codec>
+  friend class MoveTreeSerializer;
+
 public:
   MoveTreeBase();
 
+  //! @param use_child_index 子ノードのハッシュインデックスを使用するかのフラグ
+  //! @note 子ノードの多い大きな証明木では(親ノード, 指し手)をキーとするハッシュで子ノード探索をO(1)で行う
+  explicit MoveTreeBase(const bool use_child_index);
+
   //! @brief 子ノードを追加する
   //! @param move 子ノードへの指し手
   //! @note カレントノードは変更しない
@@ -35,7 +63,7 @@ public:
   //! @brief 探索木をカレントノードに追加する
   //! @param move_tree 探索木
   //! @note カレントノードは変更しない
-  void AddSubtree(const MoveTreeBase<T> &move_tree);
+  void AddSubtree(const MoveTreeBase<T, NodeStore> &move_tree);
 
   //! @brief カレントノードから子ノードへ移動する
   //! @param move 子ノードへの指し手
@@ -54,6 +82,12 @@ public:
   //! @brief Rootノードへ移動する
   void MoveRootNode();
 
+  //! @brief カレントノードの付加情報を取得する
+  const T& GetAdditionalData() const;
+
+  //! @brief カレントノードの付加情報を設定する
+  void SetAdditionalData(const T &additional_data);
+
   //! @brief すべての子ノードの指し手を取得する
   void GetChildMoveList(MoveList * const move_list) const;
 
@@ -69,11 +103,35 @@ public:
   //! @brief MoveTree全体を[a-o]形式の文字列を出力する
   std::string str() const;
 
+  //! @brief MoveTree全体を[a-o]形式でストリームに出力する
+  void WriteStr(std::ostream &os) const;
+
+  //! @brief MoveTree全体を[a-o]形式でファイルディスクリプタに出力する
+  //! @retval true: 出力成功, false: 書込エラー
+  const bool WriteStr(const int file_descriptor) const;
+
+  //! @brief MoveTree全体を[a-o]形式の文字列を出力する
+  //! @param thread_num 並列数
+  //! @note 最初に分岐するノードの子ノード以下のsubtreeを並列に生成して連結する
+  std::string GetStrParallel(const size_t thread_num) const;
+
   //! @brief MoveTree全体をSGF形式で出力する
   std::string GetSGFLabeledText(const bool is_black_turn) const;
 
+  //! @brief MoveTree全体をSGF形式でストリームに出力する
+  void WriteSGFLabeledText(const bool is_black_turn, std::ostream &os) const;
+
+  //! @brief MoveTree全体をSGF形式でファイルディスクリプタに出力する
+  //! @retval true: 出力成功, false: 書込エラー
+  const bool WriteSGFLabeledText(const bool is_black_turn, const int file_descriptor) const;
+
+  //! @brief MoveTree全体をSGF形式で出力する
+  //! @param thread_num 並列数
+  //! @note 最初に分岐するノードの子ノード以下のsubtreeを並列に生成して連結する
+  std::string GetSGFLabeledTextParallel(const bool is_black_turn, const size_t thread_num) const;
+
   //! @brief 木構造のノードリストを返す
-  const std::vector< MoveTreeNode<T> >& GetMoveTreeNodeList() const;
+  const NodeStore& GetMoveTreeNodeList() const;
 
   //! @brief Leaf nodeのリストを返す
   void GetLeafNodeList(std::vector<MoveNodeIndex> * const leaf_index_list) const;
@@ -95,6 +153,14 @@ public:
   //! @brief カレントノードがroot nodeかどうか判定する
   const bool IsRootNode() const;
 
+  //! @brief 兄弟ノードが連続領域に並ぶ(幅優先順)ようにノード配列を再配置する
+  //! @note 再配置後はnode indexが変わるため、保持しているnode indexは無効になる
+  //! @note カレントノードは再配置後の同一ノードを指す
+  void CompactNodeLayout();
+
+  //! @brief 子ノードのハッシュインデックスを使用しているか返す
+  const bool UseChildIndex() const;
+
 private:
   //! @brief 指定の指し手の子ノードのnode indexを取得する
   //! @note 指定の指し手の子ノードが存在しなかった場合はkNullNodeIndexを返す
@@ -104,14 +170,45 @@ private:
   //! @pre 子ノードが存在すること
   const MoveNodeIndex GetYoungestChildNodeIndex() const;
 
-  //! @brief node以下のsubtreeを[a-o]形式の文字列を出力する
-  std::string str(MoveNodeIndex move_node_index) const;
+  //! @brief 出力バッファを書き出す関数
+  //! @note 書き出し後にバッファを空にする
+  typedef std::function<void(std::string * const)> TextFlusher;
+
+  //! @brief node以下のsubtreeを[a-o]形式でバッファに出力する
+  //! @param is_branch true: nodeを分岐として"(指し手 subtree)"形式で出力する, false: nodeの子ノード以下を出力する
+  //! @param flusher バッファが一定サイズを超えた場合に呼び出す関数(空の場合は呼び出さない)
+  //! @note 再帰を使わず明示的なスタックで深さ優先に出力する
+  void WriteStr(const MoveNodeIndex move_node_index, const bool is_branch, std::string * const buffer, const TextFlusher &flusher) const;
 
-  //! @brief node以下のsubtreeをSGF形式(数字ラベル付き)で出力する
-  std::string GetSGFLabeledText(MoveNodeIndex move_node_index, const bool is_black_turn, const std::string &label_string, const size_t depth) const;
+  //! @brief node以下のsubtreeをSGF形式(数字ラベル付き)でバッファに出力する
+  //! @param is_black_turn move_node_indexの子ノード(is_branchの場合はmove_node_index)の手番
+  //! @param depth move_node_indexの子ノード(is_branchの場合はmove_node_index)の深さ
+  //! @param label_string move_node_indexの親までのラベル文字列(作業領域として使用する)
+  void WriteSGFLabeledText(const MoveNodeIndex move_node_index, const bool is_branch, const bool is_black_turn, const size_t depth, std::string * const label_string, std::string * const buffer, const TextFlusher &flusher) const;
 
-  std::vector< MoveTreeNode<T> > tree_;   //!< 木構造
+  //! @brief 1ノード分のSGF形式の文字列をバッファに出力する
+  //! @param label_length 親ノードまでのラベル文字列の長さ
+  void WriteSGFNode(const MoveNodeIndex move_node_index, const bool is_black_turn, const size_t depth, const size_t label_length, std::string * const label_string, std::string * const buffer) const;
+
+  //! @brief 子ノードのnode indexリストを取得する
+  void GetChildNodeIndexList(const MoveNodeIndex move_node_index, std::vector<MoveNodeIndex> * const child_index_list) const;
+
+  //! @brief 子ノードのハッシュインデックスのキーを返す
+  static const std::uint64_t GetChildIndexKey(const MoveNodeIndex parent_index, const MovePosition move);
+
+  //! @brief 子ノードのハッシュインデックスに登録する
+  //! @note 同一キーが登録済の場合は先に登録したノードを優先する
+  void RegisterChildIndex(const MoveNodeIndex node_index);
+
+  //! @brief 子ノードのハッシュインデックスを再構築する
+  void RebuildChildIndex();
+
+  NodeStore tree_;                        //!< 木構造
   MoveNodeIndex current_node_index_;      // カレントノードのnode index
+
+  std::vector<MoveNodeIndex> youngest_child_index_list_;    //!< ノード別の最も若い子ノードのnode index
+  bool use_child_index_;                  //!< 子ノードのハッシュインデックスを使用するかのフラグ
+  std::unordered_map<std::uint64_t, MoveNodeIndex> child_index_;    //!< (親ノード, 指し手) -> 子ノードのnode index
 };
 
 typedef struct structEmptyAditionalData
@@ -121,6 +218,36 @@ typedef struct structEmptyAditionalData
 typedef MoveTreeBase<EmptyAditionalData> MoveTree;
 typedef MoveTreeBase<std::string> MoveTextTree;
 
+//! @brief ノードを再配置せず、付加情報の文字列をTextArenaに格納する探索木
+//! @note 付加情報のArenaTextが参照するTextArenaはshared_ptrで保持するため、探索木をコピー/移動しても参照は無効にならない
+//! @note コピーした探索木は同一のTextArenaを共有する
+class MoveArenaTextTree
+: public MoveTreeBase< ArenaText, ChunkedVector< MoveTreeNode<ArenaText> > >
+{
+public:
+  typedef MoveTreeBase< ArenaText, ChunkedVector< MoveTreeNode<ArenaText> > > BaseTree;
+
+  MoveArenaTextTree();
+
+  //! @param text_arena 付加情報の文字列を格納するTextArena(複数の探索木で共有できる)
+  explicit MoveArenaTextTree(const std::shared_ptr<TextArena> &text_arena);
+
+  //! @brief 探索木をカレントノードに追加する
+  //! @note move_treeの付加情報が参照するTextArenaも保持する
+  void AddSubtree(const MoveArenaTextTree &move_tree);
+
+  //! @brief カレントノードの付加情報を設定する
+  //! @note 文字列は探索木のTextArenaに格納する
+  void SetAdditionalData(const std::string &additional_data);
+
+  //! @brief 付加情報の文字列を格納するTextArenaを返す
+  const std::shared_ptr<TextArena>& GetTextArena() const;
+
+private:
+  //! @brief 付加情報が参照するTextArenaのリスト(先頭は文字列を格納するTextArena)
+  std::vector< std::shared_ptr<TextArena> > text_arena_list_;
+};
+
 }   // realcore
 
 #include "MoveTree-inl.h"
@@ -0,0 +1,419 @@
+#ifndef MOVE_TREE_SERIALIZER_INL_H
+#define MOVE_TREE_SERIALIZER_INL_H
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "MoveTreeSerializer.h"
+
+namespace realcore
+{
+
+template<class T, class Codec>
+template<class NodeStore>
+void MoveTreeSerializer<T, Codec>::Serialize(const MoveTreeBase<T, NodeStore> &move_tree, std::string * const binary)
+{
+  assert(binary != nullptr);
+  assert(binary->empty());
+
+  const auto& node_list = move_tree.GetMoveTreeNodeList();
+  const size_t node_count = node_list.size();
+
+  binary->append(kMoveTreeBinaryMagic, kMoveTreeBinaryMagicSize);
+  binary->push_back(static_cast<char>(kMoveTreeBinaryVersion));
+  WriteVarint(node_count, binary);
+
+  const size_t node_data_begin = binary->size();
+  std::vector<std::uint64_t> block_offset_list;
+  block_offset_list.reserve(node_count / kMoveTreeBinaryBlockSize + 1);
+
+  for(size_t node_index=0; node_index<node_count; node_index++){
+    if(node_index % kMoveTreeBinaryBlockSize == 0){
+      block_offset_list.emplace_back(binary->size() - node_data_begin);
+    }
+
+    const auto& node = node_list[node_index];
+    const auto index = static_cast<MoveNodeIndex>(node_index);
+
+    binary->push_back(static_cast<char>(node.GetMove()));
+
+    // 親ノードは必ず前方にあるため符号なしの差分で表す
+    WriteVarint(node_index == kRootNodeIndex ? 0 : index - node.GetParentIndex(), binary);
+    WriteVarint(EncodeRelativeIndex(index, node.GetFirstChildIndex()), binary);
+    WriteVarint(EncodeRelativeIndex(index, node.GetNextSiblingIndex()), binary);
+
+    Codec::Encode(node.GetAdditionalData(), binary);
+  }
+
+  const std::uint64_t block_table_offset = binary->size();
+
+  for(const auto block_offset : block_offset_list){
+    WriteFixed64(block_offset, binary);
+  }
+
+  WriteFixed64(block_table_offset, binary);
+}
+
+template<class T, class Codec>
+template<class NodeStore>
+const bool MoveTreeSerializer<T, Codec>::Deserialize(const char * const data, const size_t data_size, MoveTreeBase<T, NodeStore> * const move_tree)
+{
+  assert(move_tree != nullptr);
+
+  MoveTreeBinaryView<T, Codec> binary_view;
+
+  if(!binary_view.Attach(data, data_size)){
+    return false;
+  }
+
+  NodeStore tree;
+  tree.reserve(binary_view.node_count_);
+
+  const char *node_data = binary_view.node_data_;
+
+  for(size_t node_index=0; node_index<binary_view.node_count_; node_index++){
+    tree.emplace_back(kNullNodeIndex, kInvalidMove);
+
+    if(!binary_view.DecodeNode(static_cast<MoveNodeIndex>(node_index), &node_data, &(tree.back()))){
+      return false;
+    }
+  }
+
+  // 最も若い子ノードを復元する
+  std::vector<MoveNodeIndex> youngest_child_index_list(tree.size(), kNullNodeIndex);
+
+  for(size_t node_index=1, size=tree.size(); node_index<size; node_index++){
+    const auto& node = tree[node_index];
+
+    if(node.GetNextSiblingIndex() == kNullNodeIndex){
+      youngest_child_index_list[node.GetParentIndex()] = static_cast<MoveNodeIndex>(node_index);
+    }
+  }
+
+  move_tree->tree_.swap(tree);
+  move_tree->youngest_child_index_list_.swap(youngest_child_index_list);
+  move_tree->current_node_index_ = kRootNodeIndex;
+  move_tree->RebuildChildIndex();
+
+  return true;
+}
+
+template<class T, class Codec>
+template<class NodeStore>
+const bool MoveTreeSerializer<T, Codec>::WriteFile(const MoveTreeBase<T, NodeStore> &move_tree, const std::string &file_path)
+{
+  std::ofstream ofs(file_path, std::ios::binary);
+
+  if(!ofs){
+    return false;
+  }
+
+  std::string binary;
+  Serialize(move_tree, &binary);
+
+  ofs.write(binary.data(), binary.size());
+  return static_cast<bool>(ofs);
+}
+
+template<class T, class Codec>
+template<class NodeStore>
+const bool MoveTreeSerializer<T, Codec>::ReadFile(const std::string &file_path, MoveTreeBase<T, NodeStore> * const move_tree)
+{
+  assert(move_tree != nullptr);
+
+  MoveTreeBinaryView<T, Codec> binary_view;
+
+  if(!binary_view.Open(file_path)){
+    return false;
+  }
+
+  const auto data = static_cast<const char*>(binary_view.mapped_region_->get_address());
+  return Deserialize(data, binary_view.mapped_region_->get_size(), move_tree);
+}
+
+template<class T, class Codec>
+inline const std::uint64_t MoveTreeSerializer<T, Codec>::EncodeRelativeIndex(const MoveNodeIndex node_index, const MoveNodeIndex target_index)
+{
+  if(target_index == kNullNodeIndex){
+    return 0;
+  }
+
+  // zigzag符号化
+  const std::int64_t difference = static_cast<std::int64_t>(target_index) - static_cast<std::int64_t>(node_index);
+  const std::uint64_t zigzag = (static_cast<std::uint64_t>(difference) << 1) ^ static_cast<std::uint64_t>(difference >> 63);
+
+  return zigzag + 1;
+}
+
+template<class T, class Codec>
+inline const MoveNodeIndex MoveTreeSerializer<T, Codec>::DecodeRelativeIndex(const MoveNodeIndex node_index, const std::uint64_t relative_index)
+{
+  if(relative_index == 0){
+    return kNullNodeIndex;
+  }
+
+  const std::uint64_t zigzag = relative_index - 1;
+  const std::int64_t difference = static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+
+  return static_cast<MoveNodeIndex>(static_cast<std::int64_t>(node_index) + difference);
+}
+
+template<class T, class Codec>
+MoveTreeBinaryView<T, Codec>::MoveTreeBinaryView()
+: node_data_(nullptr), node_data_end_(nullptr), block_table_(nullptr), node_count_(0)
+{
+}
+
+template<class T, class Codec>
+const bool MoveTreeBinaryView<T, Codec>::Attach(const char * const data, const size_t data_size)
+{
+  node_data_ = nullptr;
+  node_data_end_ = nullptr;
+  block_table_ = nullptr;
+  node_count_ = 0;
+
+  constexpr size_t kMinDataSize = kMoveTreeBinaryMagicSize + 1 + 1 + 8;
+
+  if(data == nullptr || data_size < kMinDataSize){
+    return false;
+  }
+
+  if(std::memcmp(data, kMoveTreeBinaryMagic, kMoveTreeBinaryMagicSize) != 0){
+    return false;
+  }
+
+  if(static_cast<std::uint8_t>(data[kMoveTreeBinaryMagicSize]) != kMoveTreeBinaryVersion){
+    return false;
+  }
+
+  const char * const data_end = data + data_size;
+  const char *p = data + kMoveTreeBinaryMagicSize + 1;
+  std::uint64_t node_count = 0;
+
+  if(!ReadVarint(&p, data_end, &node_count) || node_count == 0 || node_count > kMaxMoveNodeIndex){
+    return false;
+  }
+
+  const std::uint64_t block_table_offset = ReadFixed64(data_end - 8);
+  const std::uint64_t block_count = (node_count + kMoveTreeBinaryBlockSize - 1) / kMoveTreeBinaryBlockSize;
+  const std::uint64_t node_data_offset = p - data;
+
+  // block_table_offsetは任意の値を取り得るため、加算によるoverflowを避けて残りのサイズと比較する
+  if(block_table_offset < node_data_offset || block_table_offset > data_size - 8 || data_size - 8 - block_table_offset != 8 * block_count){
+    return false;
+  }
+
+  // ブロックの開始位置はノードデータ内で狭義単調増加であること
+  const std::uint64_t node_data_size = block_table_offset - node_data_offset;
+  const char * const block_table = data + block_table_offset;
+
+  for(std::uint64_t block_index=0; block_index<block_count; block_index++){
+    const std::uint64_t block_offset = ReadFixed64(block_table + 8 * block_index);
+
+    if(block_offset >= node_data_size){
+      return false;
+    }
+
+    if(block_index == 0 ? block_offset != 0 : block_offset <= ReadFixed64(block_table + 8 * (block_index - 1))){
+      return false;
+    }
+  }
+
+  node_data_ = p;
+  node_data_end_ = data + block_table_offset;
+  block_table_ = node_data_end_;
+  node_count_ = node_count;
+
+  return true;
+}
+
+template<class T, class Codec>
+const bool MoveTreeBinaryView<T, Codec>::Open(const std::string &file_path)
+{
+  namespace bip = boost::interprocess;
+  Close();
+
+  try{
+    file_mapping_.reset(new bip::file_mapping(file_path.c_str(), bip::read_only));
+    mapped_region_.reset(new bip::mapped_region(*file_mapping_, bip::read_only));
+  }catch(bip::interprocess_exception &){
+    Close();
+    return false;
+  }
+
+  const auto data = static_cast<const char*>(mapped_region_->get_address());
+
+  if(!Attach(data, mapped_region_->get_size())){
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+template<class T, class Codec>
+void MoveTreeBinaryView<T, Codec>::Close()
+{
+  node_data_ = nullptr;
+  node_data_end_ = nullptr;
+  block_table_ = nullptr;
+  node_count_ = 0;
+
+  mapped_region_.reset();
+  file_mapping_.reset();
+}
+
+template<class T, class Codec>
+inline const size_t MoveTreeBinaryView<T, Codec>::size() const
+{
+  return node_count_ == 0 ? 0 : node_count_ - 1;
+}
+
+template<class T, class Codec>
+MoveTreeNode<T> MoveTreeBinaryView<T, Codec>::GetNode(const MoveNodeIndex node_index) const
+{
+  assert(node_index < node_count_);
+
+  const size_t block_index = node_index / kMoveTreeBinaryBlockSize;
+  const char *node_data = node_data_ + ReadFixed64(block_table_ + 8 * block_index);
+
+  MoveTreeNode<T> node(kNullNodeIndex, kInvalidMove);
+
+  for(size_t index=block_index * kMoveTreeBinaryBlockSize; index<=node_index; index++){
+    if(!DecodeNode(static_cast<MoveNodeIndex>(index), &node_data, &node)){
+      return MoveTreeNode<T>(kNullNodeIndex, kInvalidMove);
+    }
+  }
+
+  return node;
+}
+
+template<class T, class Codec>
+const MoveNodeIndex MoveTreeBinaryView<T, Codec>::GetChildNodeIndex(const MoveNodeIndex node_index, const MovePosition move) const
+{
+  MoveNodeIndex child_node_index = GetNode(node_index).GetFirstChildIndex();
+
+  while(child_node_index != kNullNodeIndex){
+    const auto child_node = GetNode(child_node_index);
+
+    if(child_node.GetMove() == move){
+      return child_node_index;
+    }
+
+    child_node_index = child_node.GetNextSiblingIndex();
+  }
+
+  return kNullNodeIndex;
+}
+
+template<class T, class Codec>
+std::string MoveTreeBinaryView<T, Codec>::str() const
+{
+  std::string tree_str;
+
+  if(node_count_ == 0){
+    return tree_str;
+  }
+
+  // 再帰を使わず、出力処理をスタックに積んで処理する
+  enum class WriteAction{
+    kExpand,      // ノードの子ノードを展開する
+    kOpen,        // "("と指し手を出力する
+    kClose,       // ")"を出力する
+  };
+
+  std::vector< std::pair<WriteAction, MoveNodeIndex> > action_stack;
+  action_stack.emplace_back(WriteAction::kExpand, kRootNodeIndex);
+
+  std::vector<MoveNodeIndex> child_index_list;
+
+  while(!action_stack.empty()){
+    const auto action = action_stack.back();
+    action_stack.pop_back();
+
+    if(action.first == WriteAction::kOpen){
+      tree_str += "(";
+      tree_str += MoveString(GetNode(action.second).GetMove());
+      continue;
+    }
+
+    if(action.first == WriteAction::kClose){
+      tree_str += ")";
+      continue;
+    }
+
+    child_index_list.clear();
+    MoveNodeIndex child_node_index = GetNode(action.second).GetFirstChildIndex();
+
+    while(child_node_index != kNullNodeIndex){
+      child_index_list.emplace_back(child_node_index);
+      child_node_index = GetNode(child_node_index).GetNextSiblingIndex();
+    }
+
+    if(child_index_list.size() == 1){
+      tree_str += MoveString(GetNode(child_index_list[0]).GetMove());
+      action_stack.emplace_back(WriteAction::kExpand, child_index_list[0]);
+      continue;
+    }
+
+    for(auto it=child_index_list.rbegin(), it_end=child_index_list.rend(); it!=it_end; ++it){
+      action_stack.emplace_back(WriteAction::kClose, *it);
+      action_stack.emplace_back(WriteAction::kExpand, *it);
+      action_stack.emplace_back(WriteAction::kOpen, *it);
+    }
+  }
+
+  return tree_str;
+}
+
+template<class T, class Codec>
+const bool MoveTreeBinaryView<T, Codec>::DecodeNode(const MoveNodeIndex node_index, const char ** const data, MoveTreeNode<T> * const node) const
+{
+  assert(data != nullptr);
+  assert(node != nullptr);
+
+  if(*data >= node_data_end_){
+    return false;
+  }
+
+  const auto move = static_cast<MovePosition>(static_cast<std::uint8_t>(**data));
+  (*data)++;
+
+  std::uint64_t parent_difference = 0, first_child_index = 0, next_sibling_index = 0;
+
+  if(!ReadVarint(data, node_data_end_, &parent_difference) || !ReadVarint(data, node_data_end_, &first_child_index) || !ReadVarint(data, node_data_end_, &next_sibling_index)){
+    return false;
+  }
+
+  if(parent_difference > node_index || (node_index != kRootNodeIndex && parent_difference == 0)){
+    return false;
+  }
+
+  typedef MoveTreeSerializer<T, Codec> Serializer;
+  const MoveNodeIndex parent_index = node_index == kRootNodeIndex ? kNullNodeIndex : static_cast<MoveNodeIndex>(node_index - parent_difference);
+  const MoveNodeIndex first_child = Serializer::DecodeRelativeIndex(node_index, first_child_index);
+  const MoveNodeIndex next_sibling = Serializer::DecodeRelativeIndex(node_index, next_sibling_index);
+
+  // 子/兄弟ノードは常に後方にあるため、前方を指す(循環し得る)ノードは不正とする
+  if((first_child != kNullNodeIndex && (first_child <= node_index || first_child >= node_count_)) || (next_sibling != kNullNodeIndex && (next_sibling <= node_index || next_sibling >= node_count_))){
+    return false;
+  }
+
+  T additional_data;
+
+  if(!Codec::Decode(data, node_data_end_, &additional_data)){
+    return false;
+  }
+
+  *node = MoveTreeNode<T>(parent_index, move);
+  node->SetFirstChildIndex(first_child);
+  node->SetNextSiblingIndex(next_sibling);
+  node->SetAdditionalData(additional_data);
+
+  return true;
+}
+
+}   // namespace realcore
+
+#endif    // MOVE_TREE_SERIALIZER_INL_H
@@ -0,0 +1,165 @@
+//! @file
+//! @brief 探索木のバイナリ形式でのシリアライズ
+//! @author Koichi NABETANI
+//! @date 2017/05/20
+//! @note バイナリ形式(little endian)
+//! @note [magic "RCMT"(4byte)][version(1byte)][ノード数(varint)][ノード列][ブロック表][ブロック表の開始位置(8byte)]
+//! @note ノード: [指し手(1byte)][親との差分(varint)][最初の子との差分(varint)][次の兄弟との差分(varint)][付加情報(codec)]
+//! @note 子/兄弟の差分はzigzag符号化した値+1で、0は対象ノードなしを表す
+//! @note 親は前方、子/兄弟は後方のノードであること(MoveTreeBaseのノード追加順・CompactNodeLayoutの幅優先順はいずれも満たす)
+//! @note ブロック表: kMoveTreeBinaryBlockSizeノードごとの先頭ノードのノード列内offset(8byte)
+#ifndef MOVE_TREE_SERIALIZER_H
+#define MOVE_TREE_SERIALIZER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "MoveTree.h"
+
+namespace realcore
+{
+
+static constexpr char kMoveTreeBinaryMagic[] = "RCMT";       //!< バイナリ形式の識別子
+static constexpr size_t kMoveTreeBinaryMagicSize = 4;         //!< 識別子のサイズ
+static constexpr std::uint8_t kMoveTreeBinaryVersion = 1;     //!< バイナリ形式のバージョン
+static constexpr size_t kMoveTreeBinaryBlockSize = 16;        //!< ブロック表に登録するノード間隔
+
+//! @brief 符号なし整数をvarint(LEB128)形式で追記する
+void WriteVarint(const std::uint64_t value, std::string * const binary);
+
+//! @brief varint(LEB128)形式の符号なし整数を読み込む
+//! @param data 読込位置, 読込後は次のデータの先頭を指す
+//! @retval true: 読込成功, false: データ終端に達した
+const bool ReadVarint(const char ** const data, const char * const data_end, std::uint64_t * const value);
+
+//! @brief 符号なし整数を8byte little endianで追記する
+void WriteFixed64(const std::uint64_t value, std::string * const binary);
+
+//! @brief 8byte little endianの符号なし整数を読み込む
+const std::uint64_t ReadFixed64(const char * const data);
+
+//! @brief 探索木の付加情報のcodec
+//! @note 付加情報の型ごとに特殊化する
+//! @note Encode: 付加情報をbinaryに追記する
+//! @note Decode: dataから付加情報を読み込み、dataを次のデータの先頭に進める
+template<class T>
+class MoveTreeDataCodec;
+
+//! @brief 付加情報なし
+template<>
+class MoveTreeDataCodec<EmptyAditionalData>
+{
+public:
+  static void Encode(const EmptyAditionalData &additional_data, std::string * const binary);
+  static const bool Decode(const char ** const data, const char * const data_end, EmptyAditionalData * const additional_data);
+};
+
+//! @brief 文字列の付加情報: [長さ(varint)][文字列]
+template<>
+class MoveTreeDataCodec<std::string>
+{
+public:
+  static void Encode(const std::string &additional_data, std::string * const binary);
+  static const bool Decode(const char ** const data, const char * const data_end, std::string * const additional_data);
+};
+
+// 前方宣言
+template<class T, class Codec>
+class MoveTreeBinaryView;
+
+//! @brief 探索木のバイナリ形式への変換
+//! @param Codec 付加情報のcodec
+template<class T, class Codec = MoveTreeDataCodec<T>>
+class MoveTreeSerializer
+{
+  friend class MoveTreeBinaryView<T, Codec>;
+
+public:
+  //! @brief 探索木をバイナリ形式に変換する
+  template<class NodeStore>
+  static void Serialize(const MoveTreeBase<T, NodeStore> &move_tree, std::string * const binary);
+
+  //! @brief バイナリ形式から探索木を復元する
+  //! @retval true: 復元成功, false: 不正なバイナリ形式
+  //! @note 復元後のカレントノードはroot node
+  template<class NodeStore>
+  static const bool Deserialize(const char * const data, const size_t data_size, MoveTreeBase<T, NodeStore> * const move_tree);
+
+  //! @brief 探索木をバイナリ形式でファイルに出力する
+  template<class NodeStore>
+  static const bool WriteFile(const MoveTreeBase<T, NodeStore> &move_tree, const std::string &file_path);
+
+  //! @brief バイナリ形式のファイルから探索木を復元する
+  template<class NodeStore>
+  static const bool ReadFile(const std::string &file_path, MoveTreeBase<T, NodeStore> * const move_tree);
+
+private:
+  //! @brief 子/兄弟ノードのnode indexを差分形式に変換する
+  static const std::uint64_t EncodeRelativeIndex(const MoveNodeIndex node_index, const MoveNodeIndex target_index);
+
+  //! @brief 差分形式から子/兄弟ノードのnode indexを復元する
+  static const MoveNodeIndex DecodeRelativeIndex(const MoveNodeIndex node_index, const std::uint64_t relative_index);
+};
+
+//! @brief バイナリ形式の探索木を木構造に展開せずに参照する
+//! @note ファイルはmmapでマップし、ノードはブロック表を用いて必要な都度デコードする
+template<class T, class Codec = MoveTreeDataCodec<T>>
+class MoveTreeBinaryView
+{
+  friend class MoveTreeSerializer<T, Codec>;
+
+public:
+  MoveTreeBinaryView();
+
+  //! @brief メモリ上のバイナリ形式を参照する
+  //! @note dataは参照中に解放しないこと
+  //! @retval true: 参照成功, false: 不正なバイナリ形式
+  //! @note ブロック表の各開始位置がノード列内で狭義単調増加であることを検証する
+  const bool Attach(const char * const data, const size_t data_size);
+
+  //! @brief バイナリ形式のファイルをmmapして参照する
+  //! @retval true: 参照成功, false: ファイルが存在しない or 不正なバイナリ形式
+  const bool Open(const std::string &file_path);
+
+  //! @brief 参照を解除する
+  void Close();
+
+  //! @brief 探索木のサイズ（root node以外のノード数）を返す
+  const size_t size() const;
+
+  //! @brief 指定のノードをデコードする
+  //! @pre node_indexがノード数未満であること
+  //! @note デコードできない場合は親・子・兄弟を持たないkInvalidMoveのノードを返す
+  MoveTreeNode<T> GetNode(const MoveNodeIndex node_index) const;
+
+  //! @brief 指定ノードの指定の指し手の子ノードのnode indexを取得する
+  //! @note 指定の指し手の子ノードが存在しなかった場合はkNullNodeIndexを返す
+  const MoveNodeIndex GetChildNodeIndex(const MoveNodeIndex node_index, const MovePosition move) const;
+
+  //! @brief 探索木全体を[a-o]形式の文字列を出力する
+  //! @note MoveTreeBase::str()と同一の文字列を出力する
+  std::string str() const;
+
+private:
+  //! @brief ノード列からノードを1つデコードする
+  //! @param data 読込位置, 読込後は次のノードの先頭を指す
+  const bool DecodeNode(const MoveNodeIndex node_index, const char ** const data, MoveTreeNode<T> * const node) const;
+
+  const char *node_data_;             //!< ノード列の先頭
+  const char *node_data_end_;         //!< ノード列の終端
+  const char *block_table_;           //!< ブロック表の先頭
+  size_t node_count_;                 //!< root nodeを含むノード数
+
+  std::unique_ptr<boost::interprocess::file_mapping> file_mapping_;    //!< mmapしたファイル
+  std::unique_ptr<boost::interprocess::mapped_region> mapped_region_;  //!< mmapした領域
+};
+
+}   // namespace realcore
+
+#include "MoveTreeSerializer-inl.h"
+
+#endif    // MOVE_TREE_SERIALIZER_H
@@ -0,0 +1,144 @@
+#ifndef OPENING_BOOK_INL_H
+#define OPENING_BOOK_INL_H
+
+#include <cassert>
+#include <algorithm>
+
+#include "OpeningBook.h"
+
+namespace realcore
+{
+
+inline OpeningBookStats::OpeningBookStats()
+: game_count(0), black_win_count(0), white_win_count(0), draw_count(0)
+{
+}
+
+inline void OpeningBookStats::Add(const GameResult game_result)
+{
+  game_count++;
+
+  if(game_result == kBlackWin){
+    black_win_count++;
+  }else if(game_result == kWhiteWin){
+    white_win_count++;
+  }else if(game_result == kDraw){
+    draw_count++;
+  }
+}
+
+inline void OpeningBookStats::Add(const OpeningBookStats &stats)
+{
+  game_count += stats.game_count;
+  black_win_count += stats.black_win_count;
+  white_win_count += stats.white_win_count;
+  draw_count += stats.draw_count;
+}
+
+inline SymmetricHashState::SymmetricHashState()
+: hash_value_list_{{0ULL}}, is_black_turn_(true), black_pass_count_(0), white_pass_count_(0)
+{
+}
+
+inline void SymmetricHashState::Play(const MovePosition move)
+{
+  // CalcHashValue(const MoveList&)と同じくPassは手番ごとのPass数で区別する
+  if(move != kNullMove){
+    for(const auto symmetry : GetBoardSymmetry()){
+      hash_value_list_[symmetry] = CalcHashValue(is_black_turn_, GetSymmetricMove(move, symmetry), hash_value_list_[symmetry]);
+    }
+  }else{
+    size_t &pass_count = is_black_turn_ ? black_pass_count_ : white_pass_count_;
+    const auto pass_move = static_cast<MovePosition>(move + 16 * pass_count);
+
+    for(const auto symmetry : GetBoardSymmetry()){
+      hash_value_list_[symmetry] = CalcHashValue(is_black_turn_, pass_move, hash_value_list_[symmetry]);
+    }
+
+    pass_count++;
+  }
+
+  is_black_turn_ = !is_black_turn_;
+}
+
+inline const HashValue SymmetricHashState::GetSymmetricHashValue() const
+{
+  return realcore::GetSymmetricHashValue(hash_value_list_);
+}
+
+inline const BoardSymmetry SymmetricHashState::GetCanonicalSymmetry() const
+{
+  const HashValue symmetric_hash_value = GetSymmetricHashValue();
+
+  for(const auto symmetry : GetBoardSymmetry()){
+    if(hash_value_list_[symmetry] == symmetric_hash_value){
+      return symmetry;
+    }
+  }
+
+  assert(false);
+  return kIdenticalSymmetry;
+}
+
+inline const MovePosition SymmetricHashState::GetCanonicalMove(const MovePosition move) const
+{
+  const HashValue symmetric_hash_value = GetSymmetricHashValue();
+  MovePosition canonical_move = kInvalidMove;
+  bool is_found = false;
+
+  for(const auto symmetry : GetBoardSymmetry()){
+    if(hash_value_list_[symmetry] != symmetric_hash_value){
+      continue;
+    }
+
+    const MovePosition symmetric_move = GetSymmetricMove(move, symmetry);
+
+    if(!is_found || symmetric_move < canonical_move){
+      canonical_move = symmetric_move;
+      is_found = true;
+    }
+  }
+
+  return canonical_move;
+}
+
+inline void OpeningBookBuilder::SetMaxDepth(const size_t max_depth)
+{
+  max_depth_ = max_depth;
+}
+
+inline void OpeningBookBuilder::SetMinGameCount(const size_t min_game_count)
+{
+  assert(min_game_count > 0);
+  min_game_count_ = min_game_count;
+}
+
+inline const size_t OpeningBookBuilder::GetPositionCount() const
+{
+  return position_list_.size();
+}
+
+inline const std::uint32_t OpeningBook::ReadFixed32(const char * const data)
+{
+  const auto byte = reinterpret_cast<const unsigned char*>(data);
+  return static_cast<std::uint32_t>(byte[0]) | (static_cast<std::uint32_t>(byte[1]) << 8) | (static_cast<std::uint32_t>(byte[2]) << 16) | (static_cast<std::uint32_t>(byte[3]) << 24);
+}
+
+inline const std::uint64_t OpeningBook::ReadFixed64(const char * const data)
+{
+  return static_cast<std::uint64_t>(ReadFixed32(data)) | (static_cast<std::uint64_t>(ReadFixed32(data + 4)) << 32);
+}
+
+inline const size_t OpeningBook::size() const
+{
+  return position_count_;
+}
+
+inline const size_t OpeningBook::GetGameCount() const
+{
+  return game_count_;
+}
+
+}   // namespace realcore
+
+#endif    // OPENING_BOOK_INL_H
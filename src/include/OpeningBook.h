@@ -0,0 +1,207 @@
+//! @file
+//! @brief 局面ごとの対局統計と次の一手の頻度を格納した定跡DB
+//! @author Koichi NABETANI
+//! @date 2017/07/25
+//! @note 局面は対称形を同一視するSymmetricHash値で識別し、次の一手は正規形の局面(SymmetricHash値を与える対称変換をした局面)での指し手として格納する
+//! @note バイナリ形式(little endian)
+//! @note [magic "RCOB"(4byte)][version(1byte)][予約(3byte)][局面数N(8byte)][スロット数S(8byte, 2のべき乗)][局面データの語数R(8byte)][棋譜数G(8byte)]
+//! @note [スロット(16byte x S): SymmetricHash値(8byte), 局面データの開始位置(4byte単位, 空きスロットは0xFFFFFFFF)(4byte), 予約(4byte)]
+//! @note [局面データ(4byte x R): 局面ごとに対局数, 黒勝数, 白勝数, 満局数, 次の一手の数M, (指し手, 対局数, 黒勝数, 白勝数, 満局数) x M]
+#ifndef OPENING_BOOK_H
+#define OPENING_BOOK_H
+
+#include <cstdint>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "Move.h"
+#include "MoveList.h"
+#include "HashTable.h"
+#include "SGFParser.h"
+
+namespace realcore
+{
+
+static constexpr char kOpeningBookMagic[] = "RCOB";     //!< バイナリ形式の識別子
+static constexpr size_t kOpeningBookMagicSize = 4;        //!< 識別子のサイズ
+static constexpr std::uint8_t kOpeningBookVersion = 1;    //!< バイナリ形式のバージョン
+static constexpr size_t kOpeningBookHeaderSize = 40;      //!< ヘッダのサイズ
+static constexpr size_t kOpeningBookSlotSize = 16;        //!< スロットのサイズ
+static constexpr std::uint32_t kOpeningBookEmptySlot = 0xFFFFFFFF;    //!< 空きスロットの局面データの開始位置
+
+class GameRecordDB;
+
+//! @brief 対局結果の集計
+struct OpeningBookStats
+{
+  OpeningBookStats();
+
+  //! @brief 対局結果を加算する
+  void Add(const GameResult game_result);
+
+  //! @brief 集計を加算する
+  void Add(const OpeningBookStats &stats);
+
+  std::uint32_t game_count;         //!< 対局数
+  std::uint32_t black_win_count;    //!< 黒勝数
+  std::uint32_t white_win_count;    //!< 白勝数
+  std::uint32_t draw_count;         //!< 満局数
+};
+
+//! @brief 次の一手の集計
+struct OpeningBookMove
+{
+  MovePosition move;          //!< 次の一手
+  OpeningBookStats stats;     //!< 次の一手を打った対局の集計
+};
+
+//! @brief 局面の集計
+struct OpeningBookEntry
+{
+  OpeningBookStats stats;     //!< 局面に到達した対局の集計
+  std::vector<OpeningBookMove> next_move_list;    //!< 次の一手ごとの集計(対局数の降順)
+};
+
+//! @brief 指し手を追加しながら対称形ごとの局面のHash値を差分計算するクラス
+class SymmetricHashState
+{
+public:
+  SymmetricHashState();
+
+  //! @brief 指し手を追加する
+  void Play(const MovePosition move);
+
+  //! @brief 局面のSymmetricHash値を返す
+  //! @note CalcSymmetricHashValueと同じ値を返す
+  const HashValue GetSymmetricHashValue() const;
+
+  //! @brief 局面を正規形の局面に変換する対称変換を返す
+  //! @note 局面自体が対称形の場合は該当する対称変換のうち最小のものを返す
+  const BoardSymmetry GetCanonicalSymmetry() const;
+
+  //! @brief 指し手を正規形の局面での指し手に変換する
+  //! @note 局面自体が対称形の場合は対称な指し手のうち最小のものを返し、対称な指し手を同一視する
+  const MovePosition GetCanonicalMove(const MovePosition move) const;
+
+private:
+  std::array<HashValue, kBoardSymmetryNum> hash_value_list_;    //!< 対称性ごとの局面のHash値
+  bool is_black_turn_;          //!< 黒番か
+  size_t black_pass_count_;     //!< 黒番のPass数
+  size_t white_pass_count_;     //!< 白番のPass数
+};
+
+//! @brief 棋譜DBから定跡DBのバイナリ形式を生成するクラス
+class OpeningBookBuilder
+{
+public:
+  OpeningBookBuilder();
+
+  //! @brief 登録する局面の最大手数を設定する(既定値は制限なし)
+  void SetMaxDepth(const size_t max_depth);
+
+  //! @brief 登録する局面の最小対局数を設定する(既定値は1)
+  void SetMinGameCount(const size_t min_game_count);
+
+  //! @brief 棋譜DBの全棋譜の全局面を並列に集計する
+  //! @param thread_num 集計スレッド数
+  //! @note 以前に集計した内容は破棄する
+  void Build(const GameRecordDB &game_record_db, const size_t thread_num);
+
+  //! @brief 登録した局面数を返す
+  const size_t GetPositionCount() const;
+
+  //! @brief バイナリ形式に変換する
+  void Serialize(std::string * const binary) const;
+
+  //! @brief バイナリ形式でファイルに出力する
+  //! @retval true 出力成功
+  const bool WriteFile(const std::string &book_file) const;
+
+private:
+  //! @brief 局面の集計
+  struct PositionRecord
+  {
+    HashValue hash_value;       //!< SymmetricHash値
+    OpeningBookStats stats;     //!< 局面に到達した対局の集計
+    size_t move_begin;          //!< 次の一手の開始位置
+    size_t move_count;          //!< 次の一手の数
+  };
+
+  size_t max_depth_;          //!< 登録する局面の最大手数
+  size_t min_game_count_;     //!< 登録する局面の最小対局数
+  size_t game_count_;         //!< 集計した棋譜数
+
+  std::vector<PositionRecord> position_list_;   //!< SymmetricHash値の昇順の局面の集計
+  std::vector<OpeningBookMove> move_list_;      //!< 全局面の次の一手の集計
+};
+
+// 前方宣言
+class OpeningBookTest;
+
+//! @brief 定跡DBのバイナリ形式を展開せずに参照するクラス
+//! @note ファイルはmmapでマップし、局面はSymmetricHash値のオープンアドレス法のテーブルからO(1)で検索する
+//! @note 参照関数はconstのため、複数スレッドから並列に参照できる
+class OpeningBook
+{
+  friend class OpeningBookTest;
+
+public:
+  OpeningBook();
+
+  //! @brief メモリ上のバイナリ形式を参照する
+  //! @note dataは参照中に解放しないこと
+  //! @retval true: 参照成功, false: 不正なバイナリ形式
+  const bool Attach(const char * const data, const size_t data_size);
+
+  //! @brief バイナリ形式のファイルをmmapして参照する
+  //! @retval true: 参照成功, false: ファイルが存在しない or 不正なバイナリ形式
+  const bool Open(const std::string &book_file);
+
+  //! @brief 参照を解除する
+  void Close();
+
+  //! @brief 局面数を返す
+  const size_t size() const;
+
+  //! @brief 集計した棋譜数を返す
+  const size_t GetGameCount() const;
+
+  //! @brief 局面の集計を検索する
+  //! @param board_move_sequence 局面の指し手列
+  //! @param entry 局面の集計の格納先(次の一手はboard_move_sequenceの向きでの指し手)
+  //! @retval true 局面が登録されている
+  const bool Find(const MoveList &board_move_sequence, OpeningBookEntry * const entry) const;
+
+private:
+  //! @brief 4byte little endianの符号なし整数を読み込む
+  static const std::uint32_t ReadFixed32(const char * const data);
+
+  //! @brief 8byte little endianの符号なし整数を読み込む
+  static const std::uint64_t ReadFixed64(const char * const data);
+
+  //! @brief SymmetricHash値の局面データの開始位置を返す
+  //! @retval nullptr 局面が登録されていない
+  const char* FindRecord(const HashValue hash_value) const;
+
+  size_t position_count_;     //!< 局面数
+  size_t slot_count_;         //!< スロット数
+  size_t record_word_count_;  //!< 局面データの語数
+  size_t game_count_;         //!< 棋譜数
+
+  const char *slot_;          //!< スロット
+  const char *record_;        //!< 局面データ
+
+  std::unique_ptr<boost::interprocess::file_mapping> file_mapping_;    //!< mmapしたファイル
+  std::unique_ptr<boost::interprocess::mapped_region> mapped_region_;  //!< mmapした領域
+};
+
+}   // namespace realcore
+
+#include "OpeningBook-inl.h"
+
+#endif    // OPENING_BOOK_H
@@ -0,0 +1,48 @@
+#ifndef POS_FILE_BATCH_INL_H
+#define POS_FILE_BATCH_INL_H
+
+#include <cassert>
+
+#include "POSFileBatch.h"
+
+namespace realcore
+{
+
+inline const size_t POSFileBatch::size() const
+{
+  return loaded_list_.size();
+}
+
+inline const size_t POSFileBatch::GetMoveCount() const
+{
+  return move_arena_.size();
+}
+
+inline const bool POSFileBatch::IsLoaded(const size_t index) const
+{
+  assert(index < size());
+  return loaded_list_[index] != 0;
+}
+
+inline const MoveListView POSFileBatch::GetMoveList(const size_t index) const
+{
+  assert(index < size());
+
+  if(!IsLoaded(index)){
+    return MoveListView();
+  }
+
+  const size_t begin = move_offset_list_[index];
+  const size_t end = move_offset_list_[index + 1];
+
+  return MoveListView(move_arena_.data() + begin, end - begin);
+}
+
+inline void POSFileBatch::GetMoveList(const size_t index, MoveList * const move_list) const
+{
+  GetMoveList(index).GetMoveList(move_list);
+}
+
+}   // namespace realcore
+
+#endif    // POS_FILE_BATCH_INL_H
@@ -0,0 +1,71 @@
+//! @file
+//! @brief 複数のPOSファイルを一括して読み込むクラス
+//! @author Koichi NABETANI
+//! @date 2017/07/23
+#ifndef POS_FILE_BATCH_H
+#define POS_FILE_BATCH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Move.h"
+#include "MoveList.h"
+
+namespace realcore
+{
+
+// 前方宣言
+class POSFileBatchTest;
+
+//! @brief 複数のPOSファイルを並列に読み込み、全ファイルの指し手を連続した1つの領域に格納するクラス
+//! @note ファイルごとの指し手はMoveListViewとして参照し、ファイルごとのMoveListの確保は行わない
+//! @note POSファイルは高々226byteのため、mmapせずにスタック上のバッファへ1回で読み込む(mmapはファイルごとの生成コストが読込より大きい)
+//! @note 参照関数はconstのため、読込後は複数スレッドから並列に参照できる
+class POSFileBatch
+{
+  friend class POSFileBatchTest;
+
+public:
+  POSFileBatch();
+
+  //! @brief POSファイル群を読み込む
+  //! @param thread_num 読込スレッド数
+  //! @note 以前に読み込んだ内容は破棄する
+  //! @note 読込に失敗したファイル(DecodePOSFileを参照)はIsLoadedがfalseになり、手数0の指し手列を返す
+  //! @retval true 全ファイルの読込に成功
+  const bool Load(const std::vector<std::string> &pos_file_list, const size_t thread_num);
+
+  //! @brief 読み込んだファイル数を返す
+  const size_t size() const;
+
+  //! @brief 全ファイルの指し手数を返す
+  const size_t GetMoveCount() const;
+
+  //! @brief ファイルの読込に成功したかを返す
+  const bool IsLoaded(const size_t index) const;
+
+  //! @brief ファイルの指し手列を返す
+  //! @note 次にLoadを呼ぶまで有効
+  const MoveListView GetMoveList(const size_t index) const;
+
+  //! @brief ファイルの指し手列を指し手リストに変換する
+  void GetMoveList(const size_t index, MoveList * const move_list) const;
+
+  //! @brief POSファイルを読み込み指し手をmove_listの末尾に追加する
+  //! @retval true 読込に成功
+  //! @note 先頭1byteの手数と指し手のbyte数が一致しない場合(0byte, 途中で切れたファイル等)と盤外の指し手を含む場合は失敗する
+  //! @note 失敗した場合もmove_listに追加した指し手は取り除かない
+  static const bool DecodePOSFile(const std::string &pos_file_path, std::vector<MovePosition> * const move_list);
+
+private:
+  std::vector<MovePosition> move_arena_;      //!< 全ファイルの指し手
+  std::vector<size_t> move_offset_list_;      //!< ファイルごとの指し手の開始位置(ファイル数 + 1)
+  std::vector<std::uint8_t> loaded_list_;     //!< ファイルごとの読込成否(各スレッドが別要素に書き込むためvector<bool>は使わない)
+};
+
+}   // namespace realcore
+
+#include "POSFileBatch-inl.h"
+
+#endif    // POS_FILE_BATCH_H
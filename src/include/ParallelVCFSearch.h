@@ -0,0 +1,70 @@
+//! @file
+//! @brief Work stealingによる並列VCF探索
+//! @author Koichi NABETANI
+//! @date 2017/06/25
+
+#ifndef PARALLEL_VCF_SEARCH_H
+#define PARALLEL_VCF_SEARCH_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+#include "VCFSearch.h"
+#include "WorkStealingScheduler.h"
+
+namespace realcore
+{
+
+//! @brief タスクに分割する攻め方の手数
+//! @note 分割した局面は展開して子局面をタスクとして積み、それより深い局面は各ワーカーが逐次探索する
+constexpr size_t kVCFSplitDepth = 2;
+
+// 前方宣言
+class ParallelVCFSearchTest;
+
+//! @brief 並列VCF探索クラス
+//! @note 各ワーカーは探索開始局面を複製したVCFSearchを持ち、置換表と探索情報を共有する
+//! @note VCFの防手は一意なので、いずれかのタスクでVCFが見つかればその手順が探索開始局面からのVCFとなる
+class ParallelVCFSearch
+{
+  friend class ParallelVCFSearchTest;
+
+public:
+  //! @param board 探索開始局面
+  //! @param vcf_table 置換表(kLockTableで確保すること)
+  //! @param search_manager 探索情報(スレッド数がワーカー数となる)
+  ParallelVCFSearch(const Board &board, VCFTable * const vcf_table, SharedSearchManager * const search_manager);
+
+  //! @brief 手番側のVCFを探索する
+  //! @param proof_sequence VCFありの場合に探索開始局面から終端手までの手順を格納する
+  //! @note 探索の停止はSharedSearchManagerとスケジューラで共有するため、1インスタンスにつき1回のみ呼び出す
+  const VCFResult Solve(MoveList * const proof_sequence);
+
+  //! @brief タスクを盗んだ回数を返す
+  SearchCounter GetStealCount() const;
+
+private:
+  //! @brief 探索開始局面から四ノビと防手のペアを進めた局面を探索するタスク
+  //! @param worker_index 実行するワーカーのindex
+  //! @param four_sequence 探索開始局面からの四ノビと防手のペア
+  void SearchTask(const size_t worker_index, const std::vector<MovePair> &four_sequence);
+
+  //! @brief VCFの手順を登録し、全ワーカーに探索の停止を通知する
+  void SetProof(const MoveList &proof_sequence);
+
+  SharedSearchManager *search_manager_;   //!< 探索情報
+  WorkStealingScheduler scheduler_;       //!< タスクスケジューラ
+  std::vector<std::unique_ptr<VCFSearch>> vcf_search_list_;   //!< ワーカーごとの盤面
+
+  boost::mutex proof_mutex_;    //!< VCFの手順のmutex
+  bool is_proven_;              //!< VCFが見つかったかどうかのフラグ
+  MoveList proof_sequence_;     //!< VCFの手順
+  std::atomic<bool> is_unknown_;    //!< 探索打ち切りとなったタスクがあるかどうかのフラグ
+};
+
+}   // namespace realcore
+
+#endif    // PARALLEL_VCF_SEARCH_H
@@ -0,0 +1,61 @@
+//! @file
+//! @brief 仮想証明数による並列df-pn VCT探索
+//! @author Koichi NABETANI
+//! @date 2017/06/27
+
+#ifndef PARALLEL_VCT_SEARCH_H
+#define PARALLEL_VCT_SEARCH_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "VCTSearch.h"
+#include "WorkStealingScheduler.h"
+
+namespace realcore
+{
+
+// 前方宣言
+class ParallelVCTSearchTest;
+
+//! @brief 並列VCT探索クラス
+//! @note 各ワーカーは探索開始局面からdf-pnを行い、置換表を共有する
+//! @note 他ワーカーが探索中の局面は仮想的に証明数/反証数を増やして選択を避けるため、ワーカーごとに異なる部分木を探索する
+//! @note いずれかのワーカーで勝敗が確定すると全ワーカーの探索を停止し、置換表から証明木を生成する
+class ParallelVCTSearch
+{
+  friend class ParallelVCTSearchTest;
+
+public:
+  //! @param board 探索開始局面
+  //! @param vct_table 置換表(kLockTableで確保すること)
+  //! @param search_manager 探索情報(スレッド数がワーカー数となる)
+  ParallelVCTSearch(const Board &board, VCTTable * const vct_table, SharedSearchManager * const search_manager);
+
+  //! @brief 攻め方の手数上限を設定する
+  void SetMaxDepth(const size_t max_depth);
+
+  //! @brief 手番側のVCTを探索する
+  //! @param proof_tree VCTありの場合に探索開始局面をroot nodeとする証明木を格納する
+  //! @note 探索の停止はSharedSearchManagerで共有するため、1インスタンスにつき1回のみ呼び出す
+  const VCTResult Solve(MoveTree * const proof_tree);
+
+private:
+  //! @brief 探索開始局面からdf-pnを行うタスク
+  //! @param worker_index 実行するワーカーのindex
+  void SearchTask(const size_t worker_index);
+
+  Board board_;                           //!< 探索開始局面
+  VCTTable *vct_table_;                   //!< 置換表
+  SharedSearchManager *search_manager_;   //!< 探索情報
+  WorkStealingScheduler scheduler_;       //!< タスクスケジューラ
+  std::vector<std::unique_ptr<VCTSearch>> vct_search_list_;   //!< ワーカーごとの盤面
+
+  size_t max_depth_;                      //!< 攻め方の手数上限
+  std::atomic<VCTResult> result_;         //!< 最初に確定した探索結果
+};
+
+}   // namespace realcore
+
+#endif    // PARALLEL_VCT_SEARCH_H
@@ -1,6 +1,9 @@
 #ifndef SGF_PARSER_INL_H
 #define SGF_PARSER_INL_H
 
+#include <cctype>
+#include <cstring>
+
 #include "SGFParser.h"
 
 namespace realcore{
@@ -48,6 +51,95 @@ inline const std::string SGFParser::GetAlternativeMoves() const{
 inline const std::string SGFParser::GetEventName() const{
   return event_name_;
 }
+
+inline const bool IsSGFIdentifierChar(const char c)
+{
+  return ('A' <= c && c <= 'Z') || ('a' <= c && c <= 'z') || ('0' <= c && c <= '9');
+}
+
+template<class Function>
+void ScanSGFProperty(const boost::string_view &sgf_data, const Function &function)
+{
+  SGFProperty property;
+  bool is_node_head = false;
+
+  const char * const data_end = sgf_data.data() + sgf_data.size();
+  const char *it = sgf_data.data();
+
+  while(it < data_end){
+    if(*it == ';'){
+      is_node_head = true;
+      ++it;
+      continue;
+    }
+
+    if(!IsSGFIdentifierChar(*it)){
+      ++it;
+      continue;
+    }
+
+    // プロパティ識別子
+    const char * const id_begin = it;
+
+    while(it < data_end && IsSGFIdentifierChar(*it)){
+      ++it;
+    }
+
+    property.id = boost::string_view(id_begin, it - id_begin);
+    property.value_list.clear();
+
+    // プロパティ値
+    while(true){
+      const char *value_begin = it;
+
+      while(value_begin < data_end && std::isspace(static_cast<unsigned char>(*value_begin))){
+        ++value_begin;
+      }
+
+      if(value_begin == data_end || *value_begin != '['){
+        break;
+      }
+
+      ++value_begin;
+      const char *value_end = value_begin;
+
+      while(true){
+        value_end = static_cast<const char*>(std::memchr(value_end, ']', data_end - value_end));
+
+        if(value_end == nullptr){
+          // 閉じられていないプロパティ値
+          return;
+        }
+
+        // 直前のバックスラッシュが奇数個の場合はエスケープされた']'
+        size_t backslash_count = 0;
+
+        for(const char *escape_it=value_end; escape_it>value_begin && *(escape_it - 1) == '\\'; --escape_it){
+          backslash_count++;
+        }
+
+        if(backslash_count % 2 == 0){
+          break;
+        }
+
+        ++value_end;
+      }
+
+      property.value_list.emplace_back(value_begin, value_end - value_begin);
+      it = value_end + 1;
+    }
+
+    if(property.value_list.empty()){
+      continue;
+    }
+
+    property.is_node_head = is_node_head;
+    is_node_head = false;
+
+    function(static_cast<const SGFProperty&>(property));
+  }
+}
+
 }
 
 
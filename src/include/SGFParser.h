@@ -7,6 +7,9 @@
 
 #include <string>
 #include <bitset>
+#include <vector>
+
+#include <boost/utility/string_view.hpp>
 
 namespace realcore
 {
@@ -42,6 +45,24 @@ static constexpr SGFCheckBit kSGFCheckNone;
 
 class MoveList;
 
+//! @brief SGFのプロパティ
+struct SGFProperty
+{
+  boost::string_view id;                          //!< プロパティ識別子(B, W, ABなど)
+  std::vector<boost::string_view> value_list;     //!< プロパティ値のリスト(エスケープ文字は展開せずに保持する)
+  bool is_node_head;                              //!< ノード(;)の先頭のプロパティか
+};
+
+//! @brief SGFのプロパティ識別子に使われる文字かを返す
+//! @note 5A, FAなど数字を含む独自プロパティも扱うため英数字を識別子とみなす
+const bool IsSGFIdentifierChar(const char c);
+
+//! @brief SGFデータを先頭から1回だけ走査し、プロパティごとにfunction(const SGFProperty&)を呼び出す
+//! @note プロパティ値の外側の識別子以外の文字(ゲーム木の外側の文字列など)は読み飛ばす
+//! @note 値を持たない識別子は無視し、閉じられていないプロパティ値に達した時点で走査を終了する
+template<class Function>
+void ScanSGFProperty(const boost::string_view &sgf_data, const Function &function);
+
 //! @brief SGFデータの指し手リストを生成する
 void GetMoveListFromSGFData(const SGFCheckBit &check_bit, const std::string &sgf_data, MoveList * move_list);
 
@@ -76,47 +97,38 @@ public:
   const std::string GetEventName() const;
 
 private:
-  //! @brief 対局日を取得する
-  const std::string ParseGameDate(const std::string &sgf_data) const;
-
-  //! @brief 黒番の対局者名を取得する
-  const std::string ParseBlackPlayerName(const std::string &sgf_data) const;
-
-  //! @brief 黒番のランク(1dなど)を取得する
-  const std::string ParseBlackPlayerRank(const std::string &sgf_data) const;
-
-  //! @brief 白番の対局者名を取得する
-  const std::string ParseWhitePlayerName(const std::string &sgf_data) const;
-
-  //! @brief 白番のランク(1dなど)を取得する
-  const std::string ParseWhitePlayerRank(const std::string &sgf_data) const;
-
-  //! @brief 対局ルールを取得する
-  const std::string ParseGameRule(const std::string &sgf_data) const;
+  //! @brief 対局ルール(RIF, Sakata, Yamaguchi, Tarannikov, Jonsson, Unknown)をGN, RUプロパティの値から取得する
+  //! @retval true 対局ルールが含まれる
+  const bool ParseGameRule(const SGFProperty &property, std::string * const game_rule) const;
 
-  //! @brief 終局状態を取得する
-  const GameEndStatus ParseGameEndStatus(const std::string &sgf_data) const;
+  //! @brief REプロパティの値が満局(B?W?+?Draw)かを返す
+  const bool IsDrawResult(const boost::string_view &value) const;
 
-  //! @brief 対局結果を取得する
-  const GameResult ParseGameResult(const std::string &sgf_data) const;
+  //! @brief REプロパティの値((B|W)+(Resign|R|Time))から対局結果と終局状態を取得する
+  //! @retval true 勝敗が記録されている
+  const bool ParseWinResult(const boost::string_view &value, GameResult * const game_result, GameEndStatus * const game_end_status) const;
 
-  //! @brief 初期局面の棋譜([a-o]形式)を取得する
-  const std::string ParseInitBoard(const std::string &sgf_data) const;
+  //! @brief プロパティ値のうち先頭から連続する石の位置([a-z][a-z])の数を返す
+  const size_t GetStoneValueCount(const SGFProperty &property) const;
 
-  //! @brief 棋譜([a-o]形式)を取得する
-  const std::string ParseGameRecord(const std::string &sgf_data) const;
+  //! @brief 初期局面の棋譜([a-o]形式)を生成する
+  //! @param is_black_turn_specified PL[B]の有無
+  //! @param is_white_turn_specified PL[W]の有無
+  const std::string ParseInitBoard(const std::vector<boost::string_view> &black_stone_list, const std::vector<boost::string_view> &white_stone_list, const bool is_black_turn_specified, const bool is_white_turn_specified) const;
 
-  //! @brief 5手目の取り除かれた提示珠を取得する
-  const std::string ParseAlternativeMoves(const std::string &sgf_data) const;
+  //! @brief 棋譜([a-o]形式)を生成する
+  //! @param move_list ノード先頭の(B|W)[[a-z][a-z]]の手番と指し手
+  const std::string ParseGameRecord(const std::string &init_board, const std::vector<std::pair<char, boost::string_view>> &move_list) const;
 
-  //! @brief 大会名を取得する
-  const std::string ParseEventName(const std::string &sgf_data) const;
+  //! @brief 5手目の取り除かれた提示珠を5A, FAプロパティの値から取得する
+  //! @retval true 提示珠の形式の値が含まれる
+  const bool ParseAlternativeMoves(const SGFProperty &property, std::string * const alternative_moves) const;
 
   //! @brief CSVフィールドにカンマが入らないようにカンマをスペースに置換する
   const std::string ReplaceComma(const std::string &str) const;
 
   //! @brief 有効な指し手位置かをチェックする
-  const bool IsValidMove(const std::string &move) const;
+  const bool IsValidMove(const boost::string_view &move) const;
 
   std::string game_date_;     //!< 対局日
 
@@ -5,11 +5,29 @@
 
 namespace realcore{
 
+inline TimeCheckCounter::TimeCheckCounter()
+: call_count_(0), check_interval_(1), last_check_time_(SearchClock::now())
+{
+}
+
+inline const bool TimeCheckCounter::IsCheckTiming()
+{
+  return ++call_count_ >= check_interval_;
+}
+
+inline void TimeCheckCounter::Reset(const SearchClock::time_point &check_time)
+{
+  call_count_ = 0;
+  check_interval_ = 1;
+  last_check_time_ = check_time;
+}
+
 inline SearchManager::SearchManager(const bool catch_interrupt_exception)
-: node_(0), node_limit_(0), search_start_time_(std::chrono::system_clock::now()), elapsed_time_limit_(0), 
+: node_(0), node_limit_(0), search_start_time_(SearchClock::now()), elapsed_time_limit_(0), time_over_(false),
   get_proof_tree_(0), get_proof_tree_success_(0), simulation_(0), simulation_success_(0),
   catch_interrupt_exception_(catch_interrupt_exception), interruption_(false)
 {
+  time_check_counter_.Reset(search_start_time_);
 }
 
 inline void SearchManager::AddNode()
@@ -72,7 +90,9 @@ inline void SearchManager::SetSearchTimeLimit(const SearchCounter elapsed_time_l
 
 inline void SearchManager::SearchStart()
 {
-  search_start_time_ = std::chrono::system_clock::now();
+  search_start_time_ = SearchClock::now();
+  time_check_counter_.Reset(search_start_time_);
+  time_over_ = false;
 }
 
 }   // namespace realcore
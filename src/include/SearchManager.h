@@ -13,12 +13,48 @@ namespace realcore{
 
 typedef std::uint64_t SearchCounter;
 
+//! @brief 探索時間の計測に用いる時計
+//! @note system_clockは時刻補正で巻き戻る可能性があるため単調増加するsteady_clockを用いる
+typedef std::chrono::steady_clock SearchClock;
+
+//! @brief 探索時間をチェックする時間間隔(us)の目安
+constexpr SearchCounter kTimeCheckIntervalUS = 1000;
+
+//! @brief 探索時間をチェックする呼出回数間隔の上限
+constexpr SearchCounter kMaxTimeCheckCallInterval = 1ULL << 16;
+
 static constexpr bool kCatchInterruptException = true;    //!< interrupt exceptionをcatchする
 static constexpr bool kNoInterruptionPoint = false;       //!< interrupt exceptionをcatchしない
 
 // 前方宣言
 class SearchManagerTest;
 
+//! @brief 時計を参照する間隔を制御するクラス
+//! @note 呼出回数がcheck_interval_に達した時のみ時計を参照し、直前の呼出頻度から次の間隔がkTimeCheckIntervalUS程度となるよう調整する
+class TimeCheckCounter
+{
+  friend class SearchManagerTest;
+
+public:
+  TimeCheckCounter();
+
+  //! @brief 呼出回数を数え、時計を参照するタイミングか返す
+  const bool IsCheckTiming();
+
+  //! @brief 時計の参照結果から次に時計を参照するまでの呼出回数間隔を更新する
+  //! @param check_time 時計の参照結果
+  void Update(const SearchClock::time_point &check_time);
+
+  //! @brief 呼出回数間隔を初期化する
+  //! @param check_time 計測開始時間
+  void Reset(const SearchClock::time_point &check_time);
+
+private:
+  SearchCounter call_count_;       //!< 前回時計を参照してからの呼出回数
+  SearchCounter check_interval_;   //!< 時計を参照する呼出回数間隔
+  SearchClock::time_point last_check_time_;   //!< 前回時計を参照した時間
+};
+
 class SearchManager
 {
   friend class SearchManagerTest;
@@ -65,14 +101,17 @@ public:
   SearchCounter GetSearchTime() const;
 
   //! @brief 探索終了条件が成立しているか返す
+  //! @note 探索時間とinterruptionのチェックはTimeCheckCounterで間引いて行う
   const bool IsTerminate();
 
 private:
   SearchCounter node_;        //!< 探索ノード数
   SearchCounter node_limit_;  //!< 探索ノード数の上限(0: 無制限)
 
-  std::chrono::system_clock::time_point search_start_time_;   //!< 探索開始時間
+  SearchClock::time_point search_start_time_;   //!< 探索開始時間
   SearchCounter elapsed_time_limit_;  //!< 探索時間の上限
+  TimeCheckCounter time_check_counter_;   //!< 探索時間のチェック間隔
+  bool time_over_;    //!< 探索時間の上限を超えたかどうかのフラグ
 
   SearchCounter get_proof_tree_;            //! 証明木の取得回数
   SearchCounter get_proof_tree_success_;    //! 証明木の取得成功回数
@@ -0,0 +1,149 @@
+#ifndef SHARED_SEARCH_MANAGER_INL_H
+#define SHARED_SEARCH_MANAGER_INL_H
+
+#include <cassert>
+
+#include "SharedSearchManager.h"
+
+namespace realcore{
+
+inline SearchCounterShard::SearchCounterShard()
+: node(0), get_proof_tree(0), get_proof_tree_success(0), simulation(0), simulation_success(0)
+{
+}
+
+inline const size_t SharedSearchManager::GetThreadNum() const
+{
+  return thread_num_;
+}
+
+inline SearchCounterShard& SharedSearchManager::GetShard(const size_t thread_index)
+{
+  assert(thread_index < thread_num_);
+  return shard_list_[thread_index];
+}
+
+inline const SearchCounter SharedSearchManager::IncrementCounter(std::atomic<SearchCounter> * const counter)
+{
+  assert(counter != nullptr);
+
+  const SearchCounter value = counter->load(std::memory_order_relaxed) + 1;
+  counter->store(value, std::memory_order_relaxed);
+
+  return value;
+}
+
+inline void SharedSearchManager::AddNode(const size_t thread_index)
+{
+  const SearchCounter node = IncrementCounter(&GetShard(thread_index).node);
+  static_assert((kNodeFlushInterval & (kNodeFlushInterval - 1)) == 0, "kNodeFlushInterval must be a power of 2");
+
+  if((node & (kNodeFlushInterval - 1)) == 0){
+    flushed_node_.fetch_add(kNodeFlushInterval, std::memory_order_relaxed);
+  }
+}
+
+inline SearchCounter SharedSearchManager::GetNode() const
+{
+  return GetTotalCount(&SearchCounterShard::node);
+}
+
+inline void SharedSearchManager::AddGetProofTreeResult(const size_t thread_index, const bool is_generated)
+{
+  SearchCounterShard &shard = GetShard(thread_index);
+  IncrementCounter(&shard.get_proof_tree);
+
+  if(is_generated){
+    IncrementCounter(&shard.get_proof_tree_success);
+  }
+}
+
+inline SearchCounter SharedSearchManager::GetProofTreeCount() const
+{
+  return GetTotalCount(&SearchCounterShard::get_proof_tree);
+}
+
+inline SearchCounter SharedSearchManager::GetProofTreeSuccessCount() const
+{
+  return GetTotalCount(&SearchCounterShard::get_proof_tree_success);
+}
+
+inline void SharedSearchManager::AddSimulationResult(const size_t thread_index, const bool is_simulation_success)
+{
+  SearchCounterShard &shard = GetShard(thread_index);
+  IncrementCounter(&shard.simulation);
+
+  if(is_simulation_success){
+    IncrementCounter(&shard.simulation_success);
+  }
+}
+
+inline SearchCounter SharedSearchManager::GetSimulationCount() const
+{
+  return GetTotalCount(&SearchCounterShard::simulation);
+}
+
+inline SearchCounter SharedSearchManager::GetSimulationSuccessCount() const
+{
+  return GetTotalCount(&SearchCounterShard::simulation_success);
+}
+
+inline void SharedSearchManager::SetNodeLimit(const SearchCounter node_limit)
+{
+  node_limit_ = node_limit;
+}
+
+inline void SharedSearchManager::SetSearchTimeLimit(const SearchCounter elapsed_time_limit)
+{
+  elapsed_time_limit_ = elapsed_time_limit;
+}
+
+inline SearchCounter SharedSearchManager::GetNodeLimit() const
+{
+  return node_limit_;
+}
+
+inline SearchCounter SharedSearchManager::GetSearchTimeLimit() const
+{
+  return elapsed_time_limit_;
+}
+
+inline void SharedSearchManager::SetRemainingLimit(const SharedSearchManager &search_manager)
+{
+  const SearchCounter node_limit = search_manager.GetNodeLimit();
+
+  if(node_limit != 0){
+    const SearchCounter node = search_manager.GetNode();
+    SetNodeLimit(node < node_limit ? node_limit - node : 1);
+  }
+
+  const SearchCounter elapsed_time_limit = search_manager.GetSearchTimeLimit();
+
+  if(elapsed_time_limit != 0){
+    const SearchCounter search_time = search_manager.GetSearchTime();
+    SetSearchTimeLimit(search_time < elapsed_time_limit ? elapsed_time_limit - search_time : 1);
+  }
+}
+
+inline void SharedSearchManager::SearchStart()
+{
+  search_start_time_ = SearchClock::now();
+
+  for(size_t i=0; i<thread_num_; i++){
+    shard_list_[i].time_check_counter.Reset(search_start_time_);
+  }
+}
+
+inline void SharedSearchManager::Stop()
+{
+  stop_flag_.store(true, std::memory_order_release);
+}
+
+inline const bool SharedSearchManager::IsStopped() const
+{
+  return stop_flag_.load(std::memory_order_acquire);
+}
+
+}   // namespace realcore
+
+#endif    // SHARED_SEARCH_MANAGER_INL_H
@@ -0,0 +1,157 @@
+//! @file
+//! @brief 複数スレッドで共有する探索情報を管理する
+//! @author Koichi NABETANI
+//! @date 2017/06/17
+
+#ifndef SHARED_SEARCH_MANAGER_H
+#define SHARED_SEARCH_MANAGER_H
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+
+#include "SearchManager.h"
+
+namespace realcore{
+
+//! @brief 探索ノード数を全スレッド共有のカウンタに反映する間隔(2のべき乗)
+constexpr SearchCounter kNodeFlushInterval = 1024;
+
+//! @brief スレッドごとのカウンタ領域のサイズ(false sharingを避けるため2キャッシュライン分確保する)
+constexpr size_t kSearchCounterShardSize = 128;
+
+//! @brief スレッドごとの探索カウンタ
+//! @note 各カウンタは担当スレッドのみが更新し、他スレッドからは集計時に読み出すのみ
+struct SearchCounterShard
+{
+  SearchCounterShard();
+
+  std::atomic<SearchCounter> node;                  //!< 探索ノード数
+  std::atomic<SearchCounter> get_proof_tree;        //!< 証明木の取得回数
+  std::atomic<SearchCounter> get_proof_tree_success;  //!< 証明木の取得成功回数
+  std::atomic<SearchCounter> simulation;            //!< Simulationの実行回数
+  std::atomic<SearchCounter> simulation_success;    //!< Simulationの成功回数
+
+  TimeCheckCounter time_check_counter;    //!< 探索時間のチェック間隔
+
+  char padding[kSearchCounterShardSize - 5 * sizeof(std::atomic<SearchCounter>) - sizeof(TimeCheckCounter)];
+};
+
+static_assert(sizeof(SearchCounterShard) == kSearchCounterShardSize, "SearchCounterShard must fill kSearchCounterShardSize bytes");
+
+// 前方宣言
+class SharedSearchManagerTest;
+
+//! @brief 複数スレッドで共有する探索情報の管理クラス
+//! @note 探索カウンタはスレッドごとに分割して保持し、取得時に集計する
+//! @note 探索の停止フラグは全スレッドで共有し、いずれかのスレッドが終了条件を検出すると全スレッドのIsTerminateがtrueを返す
+//! @note 探索ノード上限、探索時間上限は探索開始前(スレッド起動前)に設定する
+class SharedSearchManager
+{
+  friend class SharedSearchManagerTest;
+
+public:
+  //! @param thread_num 探索スレッド数
+  //! @param catch_interrupt_exception interrupt exceptionをcatchするかどうかのフラグ
+  SharedSearchManager(const size_t thread_num, const bool catch_interrupt_exception);
+
+  //! @brief 探索スレッド数を返す
+  const size_t GetThreadNum() const;
+
+  //! @brief 探索ノードを増やす
+  //! @param thread_index 探索スレッドのindex
+  void AddNode(const size_t thread_index);
+
+  //! @brief 全スレッドの探索ノード数を集計して返す
+  SearchCounter GetNode() const;
+
+  //! @brief 証明木の取得結果を追加する
+  //! @param thread_index 探索スレッドのindex
+  //! @param is_generated 証明木の取得が成功したかどうかのフラグ
+  void AddGetProofTreeResult(const size_t thread_index, const bool is_generated);
+
+  //! @brief 全スレッドの証明木の取得回数を集計して返す
+  SearchCounter GetProofTreeCount() const;
+
+  //! @brief 全スレッドの証明木の取得成功回数を集計して返す
+  SearchCounter GetProofTreeSuccessCount() const;
+
+  //! @brief Simulation結果を追加する
+  //! @param thread_index 探索スレッドのindex
+  //! @param is_simulation_success Simulationが成功したかどうかのフラグ
+  void AddSimulationResult(const size_t thread_index, const bool is_simulation_success);
+
+  //! @brief 全スレッドのSimulation回数を集計して返す
+  SearchCounter GetSimulationCount() const;
+
+  //! @brief 全スレッドのSimulation成功回数を集計して返す
+  SearchCounter GetSimulationSuccessCount() const;
+
+  //! @brief 探索ノード上限を設定する
+  void SetNodeLimit(const SearchCounter node_limit);
+
+  //! @brief 探索時間上限(ms)を設定する
+  void SetSearchTimeLimit(const SearchCounter elapsed_time_limit);
+
+  //! @brief 探索ノード上限を返す(0: 無制限)
+  SearchCounter GetNodeLimit() const;
+
+  //! @brief 探索時間上限(ms)を返す(0: 無制限)
+  SearchCounter GetSearchTimeLimit() const;
+
+  //! @brief 別の探索の上限(ノード数/時間)の残りを上限として設定する
+  //! @param search_manager 上限を引き継ぐ探索情報
+  //! @note 上限に達している場合も0(無制限)にはせず、残りを1とする
+  void SetRemainingLimit(const SharedSearchManager &search_manager);
+
+  //! @brief 探索時間の計測を開始する
+  void SearchStart();
+
+  //! @brief 探索時間(ms)を取得する
+  SearchCounter GetSearchTime() const;
+
+  //! @brief 全スレッドに探索の停止を通知する
+  void Stop();
+
+  //! @brief 探索の停止が通知されているか返す
+  const bool IsStopped() const;
+
+  //! @brief 探索終了条件が成立しているか返す
+  //! @param thread_index 探索スレッドのindex
+  //! @note 終了条件が成立した場合は全スレッドに探索の停止を通知する
+  //! @note 探索時間とinterruptionのチェックはスレッドごとのTimeCheckCounterで間引いて行う
+  const bool IsTerminate(const size_t thread_index);
+
+private:
+  //! @brief スレッドのカウンタを返す
+  SearchCounterShard& GetShard(const size_t thread_index);
+
+  //! @brief 探索ノード数が上限を超えているか返す
+  //! @note 共有カウンタで上限から十分離れていると判定できない場合のみ全スレッドのカウンタを集計する
+  const bool IsNodeLimitExceeded() const;
+
+  //! @brief 指定したカウンタを全スレッド分集計する
+  SearchCounter GetTotalCount(std::atomic<SearchCounter> SearchCounterShard::*counter) const;
+
+  //! @brief カウンタを加算する
+  //! @note カウンタは担当スレッドのみが更新するためatomicなread-modify-writeは用いない
+  static const SearchCounter IncrementCounter(std::atomic<SearchCounter> * const counter);
+
+  const size_t thread_num_;     //!< 探索スレッド数
+  std::unique_ptr<SearchCounterShard[]> shard_list_;   //!< スレッドごとの探索カウンタ
+
+  std::atomic<SearchCounter> flushed_node_;   //!< kNodeFlushInterval単位で反映した全スレッドの探索ノード数
+  SearchCounter node_limit_;    //!< 探索ノード数の上限(0: 無制限)
+
+  SearchClock::time_point search_start_time_;   //!< 探索開始時間
+  SearchCounter elapsed_time_limit_;  //!< 探索時間の上限
+
+  bool catch_interrupt_exception_;    //!< Interrupt Exceptionをcatchするかどうかのフラグ
+  std::atomic<bool> stop_flag_;       //!< 探索の停止フラグ
+};
+
+}   // namespace realcore
+
+#include "SharedSearchManager-inl.h"
+
+#endif    // SHARED_SEARCH_MANAGER_H
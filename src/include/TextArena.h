@@ -0,0 +1,90 @@
+//! @file
+//! @brief 文字列を一括確保した領域に格納するArenaの定義
+//! @author Koichi NABETANI
+//! @date 2017/06/03
+#ifndef TEXT_ARENA_H
+#define TEXT_ARENA_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace realcore
+{
+
+// 前方宣言
+class TextArenaTest;
+
+//! @brief TextArenaに格納した文字列への参照
+//! @note 参照先のTextArenaを破棄/初期化するまで有効
+class ArenaText
+{
+public:
+  ArenaText();
+  ArenaText(const char * const data, const std::uint32_t size);
+
+  //! @brief 比較演算子
+  //! @note 格納位置ではなく文字列の内容で比較する
+  const bool operator==(const ArenaText &rhs) const;
+  const bool operator!=(const ArenaText &rhs) const;
+
+  //! @brief 文字列の先頭を返す
+  const char* data() const;
+
+  //! @brief 文字列長を返す
+  const size_t size() const;
+
+  //! @brief 空文字列かどうかを返す
+  const bool empty() const;
+
+  //! @brief std::stringに変換する
+  std::string str() const;
+
+private:
+  const char *data_;      //!< 文字列の先頭
+  std::uint32_t size_;    //!< 文字列長
+};
+
+//! @brief 文字列をチャンク単位で一括確保した領域に詰めて格納する
+//! @note 文字列ごとのメモリ確保を行わず、格納済の文字列は移動しない
+//! @note 個別の文字列の解放はできない
+class TextArena
+{
+  friend class TextArenaTest;
+
+public:
+  TextArena();
+
+  //! @param chunk_size 1チャンクのサイズ(byte)
+  explicit TextArena(const size_t chunk_size);
+
+  TextArena(const TextArena &) = delete;
+  TextArena& operator=(const TextArena &) = delete;
+
+  //! @brief 文字列を格納する
+  ArenaText Store(const std::string &text);
+  ArenaText Store(const char * const text, const size_t size);
+
+  //! @brief 格納した文字列の合計サイズを返す
+  const size_t GetUsedSize() const;
+
+  //! @brief 確保済の領域のサイズを返す
+  const size_t GetAllocatedSize() const;
+
+  //! @brief 格納した文字列をすべて破棄する
+  //! @note 確保済の領域は解放する
+  void clear();
+
+private:
+  size_t chunk_size_;                     //!< 1チャンクのサイズ
+  std::vector< std::unique_ptr<char[]> > chunk_list_;   //!< チャンクのリスト
+  size_t current_chunk_size_;             //!< 末尾のチャンクのサイズ
+  size_t current_chunk_used_;             //!< 末尾のチャンクの使用済サイズ
+  size_t used_size_;                      //!< 格納した文字列の合計サイズ
+  size_t allocated_size_;                 //!< 確保済の領域のサイズ
+};
+
+}   // namespace realcore
+
+#endif    // TEXT_ARENA_H
@@ -0,0 +1,32 @@
+#ifndef VCF_SEARCH_INL_H
+#define VCF_SEARCH_INL_H
+
+#include <cassert>
+
+#include "VCFSearch.h"
+
+namespace realcore
+{
+
+inline VCFTableData::VCFTableData()
+: hash_value(0), logic_counter(0), result(kVCFUnknown)
+{
+}
+
+inline void VCFSearch::MakeFourMove(const MovePair &four_pair)
+{
+  MakeMove(four_pair.first, kUpdateVCFOpenState);
+  MakeMove(four_pair.second, kUpdateVCFOpenState);
+}
+
+inline void VCFSearch::UndoFourMove()
+{
+  assert(board_move_sequence_.size() >= 2);
+
+  UndoMove();
+  UndoMove();
+}
+
+}   // namespace realcore
+
+#endif    // VCF_SEARCH_INL_H
@@ -0,0 +1,108 @@
+//! @file
+//! @brief VCF(四ノビのみでの勝ち)探索
+//! @author Koichi NABETANI
+//! @date 2017/06/25
+
+#ifndef VCF_SEARCH_H
+#define VCF_SEARCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Board.h"
+#include "HashTable.h"
+#include "MoveTree.h"
+#include "SharedSearchManager.h"
+
+namespace realcore
+{
+
+//! @brief VCF探索で差分更新する空点情報
+//! @note 四ノビ点の列挙以外は盤面(BitBoard)を直接参照するため、四ノビ点のみ更新する
+constexpr UpdateOpenStateFlag kUpdateVCFOpenState(kUpdateFlagFourBlack | kUpdateFlagFourWhite);
+
+//! @brief VCF探索の結果
+enum VCFResult : std::uint8_t
+{
+  kVCFUnknown,      //!< 探索打ち切りにより不明
+  kVCFProven,       //!< VCFあり
+  kVCFDisproven,    //!< VCFなし
+};
+
+//! @brief VCF探索の置換表の要素
+//! @note VCFありの局面は探索開始局面まで即座に伝播するため、VCFなしの局面のみ登録する
+struct VCFTableData
+{
+  VCFTableData();
+
+  HashValue hash_value;               //!< 局面のHash値
+  TableLogicCounter logic_counter;    //!< 論理カウンタ
+  VCFResult result;                   //!< 探索結果
+};
+
+//! @brief VCF探索の置換表
+//! @note 複数スレッドで共有する場合はkLockTableで確保する
+typedef HashTable<VCFTableData> VCFTable;
+
+// 前方宣言
+class VCFSearchTest;
+
+//! @brief VCF探索クラス
+//! @note 手番側が攻め方となり、四ノビと防手のペアを単位として盤面を進める
+//! @note 複数スレッドで探索する場合はスレッドごとにインスタンスを生成し、置換表と探索情報を共有する
+class VCFSearch
+: public Board
+{
+  friend class VCFSearchTest;
+
+public:
+  //! @param board 探索開始局面
+  //! @param vcf_table 置換表
+  //! @param search_manager 探索情報
+  //! @param thread_index 探索スレッドのindex
+  VCFSearch(const Board &board, VCFTable * const vcf_table, SharedSearchManager * const search_manager, const size_t thread_index);
+
+  //! @brief 現局面から手番側のVCFを探索する
+  //! @param proof_sequence VCFありの場合に現局面から終端手までの手順を格納する
+  const VCFResult Solve(MoveList * const proof_sequence);
+
+  //! @brief 現局面から手番側のVCFを探索する
+  //! @param proof_tree VCFありの場合に現局面をroot nodeとする証明木(一本道)を格納する
+  const VCFResult Solve(MoveTree * const proof_tree);
+
+  //! @brief 現局面を展開し、VCFの候補となる四ノビと防手のペアを生成する
+  //! @param candidate_list 候補の格納先
+  //! @param terminating_move 終端手の格納先
+  //! @retval kVCFProven 終端手がある
+  //! @retval kVCFDisproven 候補がない、または置換表にVCFなしとして登録済
+  //! @retval kVCFUnknown 候補がある、または探索打ち切り
+  //! @note 候補の四ノビは禁手ではなく、防手が終端手とならないものに限る
+  const VCFResult Expand(std::vector<MovePair> * const candidate_list, MovePosition * const terminating_move);
+
+  //! @brief 四ノビと防手を着手する
+  void MakeFourMove(const MovePair &four_pair);
+
+  //! @brief 四ノビと防手を戻す
+  void UndoFourMove();
+
+private:
+  //! @brief 現局面以下を探索する
+  const VCFResult SolveOR();
+
+  //! @brief 四ノビの候補を生成する
+  //! @retval true 終端手がある
+  const bool GetFourCandidate(std::vector<MovePair> * const candidate_list, MovePosition * const terminating_move) const;
+
+  VCFTable *vcf_table_;                 //!< 置換表
+  SharedSearchManager *search_manager_; //!< 探索情報
+  const size_t thread_index_;           //!< 探索スレッドのindex
+
+  MoveList proof_sequence_;                   //!< VCFの手順
+  size_t solve_start_move_count_;             //!< Solve開始時の手数
+};
+
+}   // namespace realcore
+
+#include "VCFSearch-inl.h"
+
+#endif    // VCF_SEARCH_H
@@ -0,0 +1,136 @@
+#ifndef VCT_SEARCH_INL_H
+#define VCT_SEARCH_INL_H
+
+#include <cassert>
+
+#include "VCTSearch.h"
+
+namespace realcore
+{
+
+inline VCTTableData::VCTTableData()
+: hash_value(0), logic_counter(0), remaining_depth(0), proof_number(1), disproof_number(1), work(0)
+{
+}
+
+inline const bool VCTTable::IsGarbageCollectionRequired() const
+{
+  return used_count_.load(std::memory_order_relaxed) * 100 >= size() * kVCTGCStartPercent;
+}
+
+inline const size_t VCTTable::GetUsedCount() const
+{
+  return used_count_;
+}
+
+inline const size_t VCTTable::GetGarbageCollectionCount() const
+{
+  return gc_count_;
+}
+
+inline void VCTTable::EnterNode(const HashValue hash_value)
+{
+  search_thread_count_list_[hash_value & (kSearchThreadCountSize - 1)].fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void VCTTable::ExitNode(const HashValue hash_value)
+{
+  search_thread_count_list_[hash_value & (kSearchThreadCountSize - 1)].fetch_sub(1, std::memory_order_relaxed);
+}
+
+inline const size_t VCTTable::GetSearchThreadCount(const HashValue hash_value) const
+{
+  return search_thread_count_list_[hash_value & (kSearchThreadCountSize - 1)].load(std::memory_order_relaxed);
+}
+
+inline void VCTSearch::SetMaxDepth(const size_t max_depth)
+{
+  assert(max_depth < kUnlimitedVCTDepth);
+  max_depth_ = max_depth;
+}
+
+inline const bool VCTSearch::IsAttackerTurn() const
+{
+  return board_move_sequence_.IsBlackTurn() == is_attacker_black_;
+}
+
+inline void VCTSearch::GetProofNumber(ProofNumber * const proof_number, ProofNumber * const disproof_number) const
+{
+  assert(proof_number != nullptr);
+  assert(disproof_number != nullptr);
+
+  VCTTableData table_data;
+
+  if(FindTableData(GetHashValue(), GetRemainingDepth(board_move_sequence_.size()), &table_data)){
+    *proof_number = table_data.proof_number;
+    *disproof_number = table_data.disproof_number;
+  }else{
+    *proof_number = 1;
+    *disproof_number = 1;
+  }
+}
+
+inline const bool VCTSearch::GetChildProofNumber(const MovePosition move, ProofNumber * const proof_number, ProofNumber * const disproof_number) const
+{
+  assert(proof_number != nullptr);
+  assert(disproof_number != nullptr);
+
+  const bool is_black_turn = board_move_sequence_.IsBlackTurn();
+  const HashValue hash_value = CalcHashValue(is_black_turn, move, GetHashValue());
+  VCTTableData table_data;
+
+  if(!FindTableData(hash_value, GetRemainingDepth(board_move_sequence_.size() + 1), &table_data)){
+    return false;
+  }
+
+  *proof_number = table_data.proof_number;
+  *disproof_number = table_data.disproof_number;
+
+  return true;
+}
+
+inline const bool VCTSearch::FindTableData(const HashValue hash_value, const VCTDepth remaining_depth, VCTTableData * const table_data) const
+{
+  assert(table_data != nullptr);
+
+  if(!vct_table_->find(hash_value, table_data)){
+    return false;
+  }
+
+  if(table_data->disproof_number == 0 && table_data->remaining_depth < remaining_depth){
+    // 手数上限による反証はより短い経路で到達した局面には適用できない
+    *table_data = VCTTableData();
+    return false;
+  }
+
+  return true;
+}
+
+inline const VCTDepth VCTSearch::GetRemainingDepth(const size_t move_count) const
+{
+  assert(move_count >= solve_start_move_count_);
+  const size_t depth = (move_count - solve_start_move_count_) / 2;
+
+  return depth < max_depth_ ? static_cast<VCTDepth>(max_depth_ - depth) : 0;
+}
+
+inline void VCTSearch::SetProofNumber(const ProofNumber proof_number, const ProofNumber disproof_number, const VCTWork work, const VCTDepth remaining_depth)
+{
+  VCTTableData table_data;
+
+  table_data.hash_value = GetHashValue();
+  table_data.remaining_depth = remaining_depth;
+  table_data.proof_number = proof_number;
+  table_data.disproof_number = disproof_number;
+  table_data.work = work;
+
+  vct_table_->Store(table_data);
+
+  if(vct_table_->IsGarbageCollectionRequired()){
+    vct_table_->CollectGarbage();
+  }
+}
+
+}   // namespace realcore
+
+#endif    // VCT_SEARCH_INL_H
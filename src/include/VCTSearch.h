@@ -0,0 +1,232 @@
+//! @file
+//! @brief df-pnによるVCT(四ノビ、三ノビ等の連続脅威での勝ち)探索
+//! @author Koichi NABETANI
+//! @date 2017/06/26
+
+#ifndef VCT_SEARCH_H
+#define VCT_SEARCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+#include "Board.h"
+#include "HashTable.h"
+#include "MoveTree.h"
+#include "SharedSearchManager.h"
+
+namespace realcore
+{
+
+//! @brief 証明数/反証数
+typedef std::uint32_t ProofNumber;
+
+//! @brief 証明数/反証数の無限大
+constexpr ProofNumber kInfinityProofNumber = 100000000;
+
+//! @brief VCT探索の攻め方の手数上限の既定値
+constexpr size_t kDefaultVCTDepth = 8;
+
+//! @brief 置換表の探索量
+typedef std::uint32_t VCTWork;
+
+//! @brief 攻め方の残り手数
+typedef std::uint16_t VCTDepth;
+
+//! @brief 手数上限によらない反証の残り手数
+constexpr VCTDepth kUnlimitedVCTDepth = 0xFFFF;
+
+//! @brief 置換表の使用率(%)がこの値以上になるとGCを行う
+constexpr size_t kVCTGCStartPercent = 75;
+
+//! @brief GCで使用率(%)をこの値以下まで削減する
+constexpr size_t kVCTGCTargetPercent = 50;
+
+//! @brief 局面ごとの探索中スレッド数を保持する要素数(2のべき乗)
+constexpr size_t kSearchThreadCountSize = 1 << 16;
+
+//! @brief VCT探索の結果
+enum VCTResult : std::uint8_t
+{
+  kVCTUnknown,      //!< 探索打ち切りにより不明
+  kVCTProven,       //!< VCTあり
+  kVCTDisproven,    //!< VCTなし
+};
+
+//! @brief VCT探索の置換表の要素
+//! @note 証明数/反証数は攻め方(探索開始局面の手番側)から見た値を保持する
+struct VCTTableData
+{
+  VCTTableData();
+
+  HashValue hash_value;               //!< 局面のHash値
+  TableLogicCounter logic_counter;    //!< 論理カウンタ
+  VCTDepth remaining_depth;           //!< 登録時の攻め方の残り手数(反証はこの手数以下の局面でのみ有効)
+  ProofNumber proof_number;           //!< 証明数
+  ProofNumber disproof_number;        //!< 反証数
+  VCTWork work;                       //!< 探索量(部分木の探索ノード数)
+};
+
+// 前方宣言
+class VCTTableTest;
+
+//! @brief VCT探索の置換表
+//! @note 別局面と競合する場合は探索量の大きい要素を残し、使用率が上がると探索量の小さい要素から削除(GC)する
+//! @note 並列探索向けに局面ごとの探索中スレッド数を保持し、仮想的な証明数/反証数に用いる
+//! @note 複数スレッドで共有する場合はkLockTableで確保する
+class VCTTable
+: public HashTable<VCTTableData>
+{
+  friend class VCTTableTest;
+
+public:
+  //! @param table_space 置換表のサイズ(MB)
+  //! @param lock_control 置換表のlockフラグ
+  VCTTable(const size_t table_space, const bool lock_control);
+
+  //! @brief 論理初期化を行う
+  void Initialize();
+
+  //! @brief 要素を登録する
+  //! @note 探索量がより大きい別局面の要素と競合する場合は登録しない
+  void Store(const VCTTableData &table_data);
+
+  //! @brief 使用率がGCの開始条件を満たしているか返す
+  const bool IsGarbageCollectionRequired() const;
+
+  //! @brief 探索量の小さい要素から削除し、使用率を下げる
+  //! @return 削除した要素数
+  //! @note 他スレッドがGC中の場合は何もしない
+  const size_t CollectGarbage();
+
+  //! @brief 使用中の要素数を返す
+  //! @note 並列探索時は登録の競合により概算値となる
+  const size_t GetUsedCount() const;
+
+  //! @brief GCの実行回数を返す
+  const size_t GetGarbageCollectionCount() const;
+
+  //! @brief 局面の探索を開始したスレッドを登録する
+  void EnterNode(const HashValue hash_value);
+
+  //! @brief 局面の探索を終了したスレッドを登録から外す
+  void ExitNode(const HashValue hash_value);
+
+  //! @brief 局面を探索中のスレッド数を返す
+  //! @note Hash値の下位bitで集計するため、別局面の探索中スレッドも含むことがある
+  const size_t GetSearchThreadCount(const HashValue hash_value) const;
+
+private:
+  std::atomic<size_t> used_count_;    //!< 使用中の要素数
+  std::atomic<size_t> gc_count_;      //!< GCの実行回数
+  boost::mutex gc_mutex_;             //!< GCのmutex
+
+  std::unique_ptr<std::atomic<std::uint8_t>[]> search_thread_count_list_;   //!< 局面ごとの探索中スレッド数
+};
+
+// 前方宣言
+class VCTSearchTest;
+
+//! @brief VCT探索クラス
+//! @note 手番側が攻め方となり、df-pn(depth-first proof-number search)で探索する
+//! @note 攻め方(OR node)の候補は四ノビ、見かけの三ノビ、ミセ手、防御側(AND node)の候補は攻め方の1手勝ちに対する防手とする
+//! @note 手数上限で打ち切った反証は残り手数とともに登録し、同一局面に残り手数の多い経路で到達した場合は再探索する
+class VCTSearch
+: public Board
+{
+  friend class VCTSearchTest;
+
+public:
+  //! @param board 探索開始局面
+  //! @param vct_table 置換表
+  //! @param search_manager 探索情報
+  //! @param thread_index 探索スレッドのindex
+  VCTSearch(const Board &board, VCTTable * const vct_table, SharedSearchManager * const search_manager, const size_t thread_index);
+
+  //! @brief 攻め方の手数上限を設定する
+  void SetMaxDepth(const size_t max_depth);
+
+  //! @brief 現局面から手番側のVCTを探索する(証明木は生成しない)
+  //! @note 探索結果は置換表に登録される
+  const VCTResult Search();
+
+  //! @brief 現局面から手番側のVCTを探索する
+  //! @param proof_tree VCTありの場合に現局面をroot nodeとする証明木を格納する
+  //! @note 証明木のOR nodeは攻め方の勝ち手1つ、AND nodeは防御側のすべての防手を子に持つ
+  const VCTResult Solve(MoveTree * const proof_tree);
+
+  //! @brief 現局面の証明数/反証数を置換表から取得する
+  //! @note 置換表に登録されていない場合は(1, 1)を返す
+  void GetProofNumber(ProofNumber * const proof_number, ProofNumber * const disproof_number) const;
+
+private:
+  //! @brief 現局面を閾値を超えるまで探索する(df-pnのMID)
+  //! @param proof_number 探索後の証明数の格納先
+  //! @param disproof_number 探索後の反証数の格納先
+  void SearchMID(const ProofNumber pn_threshold, const ProofNumber dn_threshold, ProofNumber * const proof_number, ProofNumber * const disproof_number);
+
+  //! @brief 現局面の子局面を生成する
+  //! @param child_list 子局面への指し手の格納先
+  //! @param terminating_move 攻め方の終端手の格納先(攻め方の勝ちが確定しない場合はkNullMove)
+  //! @param proof_number 末端局面の証明数の格納先
+  //! @param disproof_number 末端局面の反証数の格納先
+  //! @retval true 末端局面(勝敗が確定)
+  //! @note 末端局面の場合は証明数/反証数を置換表に登録する
+  const bool Expand(MoveList * const child_list, MovePosition * const terminating_move, ProofNumber * const proof_number, ProofNumber * const disproof_number);
+
+  //! @brief 攻め方の候補手を生成する
+  const bool ExpandOR(MoveList * const child_list, MovePosition * const terminating_move) const;
+
+  //! @brief 防御側の候補手を生成する
+  const bool ExpandAND(MoveList * const child_list) const;
+
+  //! @brief 証明数/反証数を置換表に登録する
+  //! @param remaining_depth 反証が有効な攻め方の残り手数
+  //! @note 置換表の使用率が上がった場合はGCを行う
+  void SetProofNumber(const ProofNumber proof_number, const ProofNumber disproof_number, const VCTWork work, const VCTDepth remaining_depth);
+
+  //! @brief 置換表から局面の要素を取得する
+  //! @param remaining_depth 局面での攻め方の残り手数
+  //! @retval true 置換表に登録されている
+  //! @note 登録時より残り手数が多く反証が無効な要素は登録されていないものとして扱う
+  const bool FindTableData(const HashValue hash_value, const VCTDepth remaining_depth, VCTTableData * const table_data) const;
+
+  //! @brief 手数がmove_countの局面での攻め方の残り手数を返す
+  const VCTDepth GetRemainingDepth(const size_t move_count) const;
+
+  //! @brief 子局面の証明数/反証数を置換表から取得する
+  //! @retval true 置換表に登録されている
+  //! @note 置換表に登録されていない場合は証明数/反証数を更新しない
+  const bool GetChildProofNumber(const MovePosition move, ProofNumber * const proof_number, ProofNumber * const disproof_number) const;
+
+  //! @brief 証明木を生成する
+  //! @retval true 生成成功
+  //! @note 置換表から証明済の子局面が見つからない場合は再探索する
+  const bool GetProofTree(MoveTree * const proof_tree);
+
+  //! @brief 子局面をroot nodeとする証明木をカレントノードの子に追加する
+  //! @retval true 生成成功
+  //! @note 子局面が証明済でない場合は再探索し、証明できた場合のみ追加する
+  const bool GetChildProofTree(const MovePosition move, MoveTree * const proof_tree);
+
+  //! @brief 攻め方の手番かどうかを返す
+  const bool IsAttackerTurn() const;
+
+  VCTTable *vct_table_;                 //!< 置換表
+  SharedSearchManager *search_manager_; //!< 探索情報
+  const size_t thread_index_;           //!< 探索スレッドのindex
+
+  bool is_attacker_black_;                    //!< 攻め方が黒番かどうか
+  size_t solve_start_move_count_;             //!< Solve開始時の手数
+  size_t max_depth_;                          //!< 攻め方の手数上限
+  SearchCounter node_count_;                  //!< 探索ノード数(探索量の算出用)
+};
+
+}   // namespace realcore
+
+#include "VCTSearch-inl.h"
+
+#endif    // VCT_SEARCH_H
@@ -0,0 +1,28 @@
+#ifndef WORK_STEALING_SCHEDULER_INL_H
+#define WORK_STEALING_SCHEDULER_INL_H
+
+#include <cassert>
+
+#include "WorkStealingScheduler.h"
+
+namespace realcore
+{
+
+inline const size_t WorkStealingScheduler::GetThreadNum() const
+{
+  return thread_num_;
+}
+
+inline const bool WorkStealingScheduler::IsStopped() const
+{
+  return stop_flag_.load(std::memory_order_relaxed);
+}
+
+inline SearchCounter WorkStealingScheduler::GetStealCount() const
+{
+  return steal_count_.load(std::memory_order_relaxed);
+}
+
+}   // namespace realcore
+
+#endif    // WORK_STEALING_SCHEDULER_INL_H
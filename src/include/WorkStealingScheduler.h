@@ -0,0 +1,103 @@
+//! @file
+//! @brief Work stealing方式のタスクスケジューラ
+//! @author Koichi NABETANI
+//! @date 2017/06/25
+
+#ifndef WORK_STEALING_SCHEDULER_H
+#define WORK_STEALING_SCHEDULER_H
+
+#include <cstdint>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+#include "SearchManager.h"
+
+namespace realcore
+{
+
+//! @brief スケジューラで実行するタスク
+//! @param worker_index タスクを実行するワーカーのindex
+typedef std::function<void(const size_t worker_index)> SchedulerTask;
+
+//! @brief ワーカーごとのタスクキュー
+//! @note 末尾は所有ワーカーが積む/取り出す側、先頭は他ワーカーが盗む側
+struct WorkerTaskQueue
+{
+  boost::mutex mutex;   //!< タスクキューのmutex
+  std::deque<SchedulerTask> task_deque;   //!< タスクキュー
+};
+
+// 前方宣言
+class WorkStealingSchedulerTest;
+
+//! @brief Work stealing方式のタスクスケジューラ
+//! @note 各ワーカーは自分のキューの末尾からLIFOでタスクを取り出し、キューが空の場合は他ワーカーのキューの先頭からタスクを盗む
+//! @note 実行中のタスクが積んだタスクも実行し、未完了のタスクがなくなるかStopが呼ばれるとRunから戻る
+class WorkStealingScheduler
+{
+  friend class WorkStealingSchedulerTest;
+
+public:
+  //! @param thread_num ワーカースレッド数
+  WorkStealingScheduler(const size_t thread_num);
+
+  //! @brief ワーカースレッド数を返す
+  const size_t GetThreadNum() const;
+
+  //! @brief タスクを積む
+  //! @param worker_index タスクを積むキューのワーカーindex
+  //! @note Run実行中のタスクからは実行中のワーカーindexを指定する
+  void Push(const size_t worker_index, const SchedulerTask &task);
+
+  //! @brief 全ワーカーを起動し、未完了のタスクがなくなるまで実行する
+  //! @note ワーカー0は呼出元のスレッドで実行する
+  //! @note 停止が通知されている場合は積まれたタスクを実行せずに破棄して戻る
+  void Run();
+
+  //! @brief 実行を停止する
+  //! @note 実行中のタスクは完了を待ち、未実行のタスクは破棄する
+  //! @note Run実行中か否か、呼出元のスレッドによらず呼び出せる
+  void Stop();
+
+  //! @brief 停止の通知を解除する
+  //! @note Stopの後に再度Runする場合に呼び出す
+  //! @pre Run実行中でないこと
+  void Reset();
+
+  //! @brief 停止が通知されているか返す
+  const bool IsStopped() const;
+
+  //! @brief 他ワーカーからタスクを盗んだ回数を返す
+  SearchCounter GetStealCount() const;
+
+private:
+  //! @brief 自ワーカーのキューの末尾からタスクを取り出す
+  const bool PopTask(const size_t worker_index, SchedulerTask * const task);
+
+  //! @brief 他ワーカーのキューの先頭からタスクを盗む
+  const bool StealTask(const size_t worker_index, SchedulerTask * const task);
+
+  //! @brief ワーカーの実行ループ
+  void WorkerLoop(const size_t worker_index);
+
+  //! @brief 全ワーカーのキューを空にする
+  void ClearQueue();
+
+  const size_t thread_num_;   //!< ワーカースレッド数
+  std::vector<std::unique_ptr<WorkerTaskQueue>> queue_list_;   //!< ワーカーごとのタスクキュー
+
+  std::atomic<size_t> pending_task_count_;    //!< 積まれて実行が完了していないタスク数
+  std::atomic<bool> stop_flag_;               //!< 停止フラグ
+  std::atomic<SearchCounter> steal_count_;    //!< タスクを盗んだ回数
+};
+
+}   // namespace realcore
+
+#include "WorkStealingScheduler-inl.h"
+
+#endif    // WORK_STEALING_SCHEDULER_H
@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+class BenchmarkTest
+: public ::testing::Test
+{
+public:
+  //! @brief 所要時間を指定した計測結果を生成する
+  static BenchmarkResult GetResult(const string &label, const uint64_t operation_count, const vector<uint64_t> &time_list)
+  {
+    BenchmarkResult result;
+
+    result.label = label;
+    result.operation_count = operation_count;
+    result.time_list = time_list;
+    result.cycle_list = time_list;
+
+    return result;
+  }
+
+  void PercentileTest()
+  {
+    ASSERT_EQ(0, GetPercentile(vector<uint64_t>(), 50));
+
+    const vector<uint64_t> sorted_list{10, 20, 30, 40, 50};
+
+    ASSERT_EQ(10, GetPercentile(sorted_list, 0));
+    ASSERT_EQ(30, GetPercentile(sorted_list, 50));
+    ASSERT_EQ(50, GetPercentile(sorted_list, 100));
+    ASSERT_DOUBLE_EQ(14, GetPercentile(sorted_list, 10));
+    ASSERT_DOUBLE_EQ(46, GetPercentile(sorted_list, 90));
+
+    const BenchmarkResult result = GetResult("label", 10, {100, 200, 300, 400});
+    ASSERT_EQ(250, result.GetTimePercentile(50));
+    ASSERT_EQ(25, result.GetTimePerOperation());
+    ASSERT_EQ(25, result.GetCyclePerOperation());
+  }
+
+  void RunTest()
+  {
+    Benchmark benchmark("run_test");
+    benchmark.SetWarmupCount(2);
+    benchmark.SetTrialCount(3);
+
+    size_t setup_count = 0, call_count = 0;
+
+    const BenchmarkResult &result = benchmark.Run("label", 100, [&setup_count]{
+      setup_count++;
+    }, [&call_count]{
+      call_count++;
+    });
+
+    // ウォームアップを含めて試行ごとに準備用の関数を呼び出す
+    ASSERT_EQ(5, setup_count);
+    ASSERT_EQ(5, call_count);
+
+    ASSERT_EQ("label", result.label);
+    ASSERT_EQ(100, result.operation_count);
+    ASSERT_EQ(3, result.time_list.size());
+    ASSERT_EQ(3, result.cycle_list.size());
+    ASSERT_TRUE(is_sorted(result.time_list.begin(), result.time_list.end()));
+    ASSERT_TRUE(is_sorted(result.cycle_list.begin(), result.cycle_list.end()));
+
+    benchmark.Run("label2", 1, [&call_count]{
+      call_count++;
+    });
+
+    ASSERT_EQ(10, call_count);
+    ASSERT_EQ(2, benchmark.GetResultList().size());
+  }
+
+  void JSONTest()
+  {
+    Benchmark benchmark("json \"test\"");
+    benchmark.result_list_.emplace_back(GetResult("SetState<kBlackStone>", 4, {100, 200, 300}));
+    benchmark.result_list_.emplace_back(GetResult("Get\\State", 2, {50}));
+
+    // 出力したJSONをベースラインとして読み込める
+    map<string, double> baseline_map;
+    ASSERT_TRUE(Benchmark::ParseBaseline(benchmark.GetJSON(), &baseline_map));
+
+    ASSERT_EQ(2, baseline_map.size());
+    ASSERT_DOUBLE_EQ(50, baseline_map["SetState<kBlackStone>"]);
+    ASSERT_DOUBLE_EQ(25, baseline_map["Get\\State"]);
+
+    // 制御文字を含む項目名と有効桁数の大きい値も読み戻せる
+    benchmark.result_list_.emplace_back(GetResult("tab\tnew\nline\x01", 1, {1234567891}));
+    benchmark.result_list_.emplace_back(GetResult("fraction", 3, {1234567891}));
+
+    const string json = benchmark.GetJSON();
+    ASSERT_EQ(string::npos, json.find('\t'));
+    ASSERT_NE(string::npos, json.find("tab\\u0009new\\u000aline\\u0001"));
+
+    ASSERT_TRUE(Benchmark::ParseBaseline(json, &baseline_map));
+    ASSERT_EQ(4, baseline_map.size());
+    ASSERT_EQ(1234567891, baseline_map["tab\tnew\nline\x01"]);
+    ASSERT_DOUBLE_EQ(1234567891 / 3.0, baseline_map["fraction"]);
+
+    ASSERT_FALSE(Benchmark::ParseBaseline("{\"results\":[", &baseline_map));
+    ASSERT_FALSE(Benchmark::ParseBaseline("{}", &baseline_map));
+    ASSERT_FALSE(Benchmark::LoadBaseline("not_found.json", &baseline_map));
+  }
+
+  void CompareBaselineTest()
+  {
+    Benchmark benchmark("compare_test");
+    benchmark.SetRegressionThreshold(0.1);
+
+    benchmark.result_list_.emplace_back(GetResult("faster", 1, {90}));
+    benchmark.result_list_.emplace_back(GetResult("within", 1, {110}));
+    benchmark.result_list_.emplace_back(GetResult("slower", 1, {111}));
+    benchmark.result_list_.emplace_back(GetResult("new", 1, {1000}));
+
+    map<string, double> baseline_map;
+    baseline_map["faster"] = 100;
+    baseline_map["within"] = 100;
+    baseline_map["slower"] = 100;
+    baseline_map["removed"] = 100;
+
+    vector<BenchmarkComparison> comparison_list;
+    benchmark.CompareBaseline(baseline_map, &comparison_list);
+
+    // ベースラインに存在しない項目は比較しない
+    ASSERT_EQ(3, comparison_list.size());
+
+    ASSERT_EQ("faster", comparison_list[0].label);
+    ASSERT_FALSE(comparison_list[0].is_regression);
+    ASSERT_EQ("within", comparison_list[1].label);
+    ASSERT_FALSE(comparison_list[1].is_regression);
+    ASSERT_EQ("slower", comparison_list[2].label);
+    ASSERT_TRUE(comparison_list[2].is_regression);
+    ASSERT_DOUBLE_EQ(100, comparison_list[2].baseline_time);
+    ASSERT_DOUBLE_EQ(111, comparison_list[2].current_time);
+  }
+};
+
+TEST_F(BenchmarkTest, PercentileTest)
+{
+  PercentileTest();
+}
+
+TEST_F(BenchmarkTest, RunTest)
+{
+  RunTest();
+}
+
+TEST_F(BenchmarkTest, JSONTest)
+{
+  JSONTest();
+}
+
+TEST_F(BenchmarkTest, CompareBaselineTest)
+{
+  CompareBaselineTest();
+}
+
+}   // namespace realcore
@@ -818,4 +818,25 @@ TEST_F(BitBoardTest, IsDoubleThreeTest)
     }
   }
 }
+
+TEST_F(BitBoardTest, EnumerateForbiddenMovesInPlaceTest)
+{
+  // 三々(禁点による否禁点の存在)を含む局面で、盤面直接更新版とconst版の列挙結果が一致する
+  for(const auto &move_list : {MoveList("hhhggiggjhghkifg"), MoveList("hhhdlfldjjddkgllghdljihl")}){
+    BitBoard bit_board(move_list);
+    const BitBoard &const_bit_board = bit_board;
+
+    MoveBitSet expect_set;
+    const_bit_board.EnumerateForbiddenMoves(&expect_set);
+
+    MoveBitSet move_bit_set;
+    bit_board.EnumerateForbiddenMoves(&move_bit_set);
+
+    ASSERT_EQ(expect_set, move_bit_set);
+    ASSERT_EQ(1, move_bit_set.count());
+
+    // チェック後は元の盤面に戻る
+    ASSERT_TRUE(bit_board == BitBoard(move_list));
+  }
+}
 }
\ No newline at end of file
@@ -1979,4 +1979,51 @@ TEST_F(BitBoardTest, IsOverlineMoveTest)
     ASSERT_FALSE(bit_board.IsOverline<kWhiteTurn>(kMoveGI));
   }
 }
+
+TEST_F(BitBoardTest, ScopedStoneTest)
+{
+  MoveList move_list("hhhgig");
+  const BitBoard original_bit_board(move_list);
+  BitBoard bit_board(move_list);
+
+  {
+    ScopedStone<kBlackStone> black_stone(kMoveHI, &bit_board);
+    EXPECT_EQ(kBlackStone, bit_board.GetState(kMoveHI));
+
+    {
+      ScopedStone<kWhiteStone> white_stone(kMoveII, &bit_board);
+      EXPECT_EQ(kWhiteStone, bit_board.GetState(kMoveII));
+    }
+
+    EXPECT_EQ(kOpenPosition, bit_board.GetState(kMoveII));
+  }
+
+  EXPECT_EQ(kOpenPosition, bit_board.GetState(kMoveHI));
+  EXPECT_TRUE(bit_board == original_bit_board);
+
+  // 盤外の指し手は盤面を変更しない
+  {
+    ScopedStone<kBlackStone> black_stone(kNullMove, &bit_board);
+    EXPECT_TRUE(bit_board == original_bit_board);
+  }
+
+  EXPECT_TRUE(bit_board == original_bit_board);
+}
+
+TEST_F(BitBoardTest, RemoveStoneTest)
+{
+  BitBoard bit_board;
+  const BitBoard empty_bit_board;
+
+  bit_board.SetState<kBlackStone>(kMoveHH);
+  bit_board.SetState<kWhiteStone>(kMoveAA);
+
+  bit_board.RemoveStone<kBlackStone>(kMoveHH);
+  EXPECT_EQ(kOpenPosition, bit_board.GetState(kMoveHH));
+
+  bit_board.RemoveStone<kWhiteStone>(kMoveAA);
+  EXPECT_EQ(kOpenPosition, bit_board.GetState(kMoveAA));
+
+  EXPECT_TRUE(bit_board == empty_bit_board);
+}
 }
@@ -6,6 +6,7 @@
 
 #include "Move.h"
 #include "MoveList.h"
+#include "Conversion.h"
 #include "BitBoard.h"
 
 using namespace std;
@@ -53,4 +54,32 @@ TEST_F(BitBoardTest, CopyTest)
   EXPECT_TRUE(IsEqual(bit_board_1, bit_board_2));
 }
 
+TEST_F(BitBoardTest, GetStateBitPositionListTest)
+{
+  for(const auto move : GetAllMove()){
+    const StateBitPosition * const position_list = GetStateBitPositionList(move);
+
+    if(!IsInBoardMove(move)){
+      // 盤外はmaskが0
+      for(const auto direction : GetBoardDirection()){
+        EXPECT_EQ(0, position_list[direction].mask);
+      }
+
+      continue;
+    }
+
+    Cordinate x = 0, y = 0;
+    GetMoveCordinate(move, &x, &y);
+
+    for(const auto direction : GetBoardDirection()){
+      const size_t index = GetBitBoardIndex(x, y, direction);
+      const size_t shift = GetBitBoardShift(x, y, direction);
+
+      EXPECT_EQ(index, position_list[direction].index);
+      EXPECT_EQ(shift, position_list[direction].shift);
+      EXPECT_EQ(0b11ULL << shift, position_list[direction].mask);
+    }
+  }
+}
+
 }   // namespace realcore
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "Move.h"
+#include "MoveList.h"
+#include "BitBoard.h"
+#include "BitPlaneBoard.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+class BitPlaneBoardTest
+: public ::testing::Test
+{
+public:
+  //! @brief 天元付近に石が集まった盤面の指し手リストを生成する
+  void GetRandomBoardMoveList(const size_t move_count, mt19937_64 * const random_engine, MoveList * const move_list) const
+  {
+    vector< pair<double, MovePosition> > move_priority_list;
+    uniform_real_distribution<double> noise(0.0, 6.0);
+
+    for(const auto move : GetAllInBoardMove()){
+      Cordinate x = 0, y = 0;
+      GetMoveCordinate(move, &x, &y);
+
+      const double distance = abs(static_cast<int>(x) - 8) + abs(static_cast<int>(y) - 8) + noise(*random_engine);
+      move_priority_list.emplace_back(distance, move);
+    }
+
+    sort(move_priority_list.begin(), move_priority_list.end());
+
+    for(size_t i=0; i<move_count; i++){
+      *move_list += move_priority_list[i].second;
+    }
+  }
+
+  //! @brief 比較に用いる盤面リストを生成する
+  void GetTestBoardList(vector<MoveList> * const board_list) const
+  {
+    board_list->emplace_back("hhihhgighfhiheifieiigi");
+    board_list->emplace_back("hhihhgighfhiheifieiigiikfj");
+    board_list->emplace_back("hhihhgighfhiheifhciihd");
+    board_list->emplace_back("hhhggghiighffhefgfejifkfjhkjegeleiglekilgeklgkcfiecjikdckgfckijckklcddmffdmjhdbhhlgnjdinldnhfmeahmeojmkahnko");
+
+    mt19937_64 random_engine(0);
+
+    for(size_t move_count=10; move_count<=60; move_count+=5){
+      for(size_t i=0; i<20; i++){
+        MoveList move_list;
+        GetRandomBoardMoveList(move_count, &random_engine, &move_list);
+        board_list->emplace_back(move_list);
+      }
+    }
+  }
+};
+
+TEST_F(BitPlaneBoardTest, DefaultConstructorTest)
+{
+  const BitPlaneBoard bit_plane_board;
+
+  for(const auto move : GetAllMove()){
+    const auto expect_state = IsInBoardMove(move) ? kOpenPosition : kOverBoard;
+    EXPECT_EQ(expect_state, bit_plane_board.GetState(move));
+  }
+}
+
+TEST_F(BitPlaneBoardTest, GetSetStateTest)
+{
+  BitPlaneBoard bit_plane_board;
+  BitBoard bit_board;
+
+  for(const auto move : GetAllInBoardMove()){
+    bit_plane_board.SetState<kBlackStone>(move);
+    bit_board.SetState<kBlackStone>(move);
+
+    EXPECT_EQ(kBlackStone, bit_plane_board.GetState(move));
+
+    bit_plane_board.SetState<kOpenPosition>(move);
+    EXPECT_EQ(kOpenPosition, bit_plane_board.GetState(move));
+
+    bit_plane_board.SetState<kWhiteStone>(move);
+    EXPECT_EQ(kWhiteStone, bit_plane_board.GetState(move));
+
+    bit_plane_board.SetState(move, kWhiteStone);
+    EXPECT_EQ(kOpenPosition, bit_plane_board.GetState(move));
+
+    bit_plane_board.SetState(move, kBlackStone);
+  }
+
+  // 盤外は変更されない
+  bit_plane_board.SetState<kBlackStone>(kNullMove);
+  EXPECT_EQ(kOverBoard, bit_plane_board.GetState(kNullMove));
+
+  EXPECT_TRUE(bit_plane_board == BitPlaneBoard(bit_board));
+}
+
+TEST_F(BitPlaneBoardTest, GetOpenPositionPlaneTest)
+{
+  MoveList move_list("hhihhgighfhiheifieiigi");
+  const BitPlaneBoard bit_plane_board(move_list);
+
+  BitPlane open_position_plane;
+  bit_plane_board.GetOpenPositionPlane(&open_position_plane);
+
+  const auto &black_plane = bit_plane_board.GetBlackStonePlane();
+  const auto &white_plane = bit_plane_board.GetWhiteStonePlane();
+  const auto &in_board_plane = GetInBoardBitPlane();
+
+  size_t open_count = 0;
+
+  for(size_t i=0; i<kBitPlaneElementNum; i++){
+    EXPECT_EQ(0, open_position_plane[i] & black_plane[i]);
+    EXPECT_EQ(0, open_position_plane[i] & white_plane[i]);
+    EXPECT_EQ(in_board_plane[i], open_position_plane[i] | black_plane[i] | white_plane[i]);
+
+    open_count += __builtin_popcountll(open_position_plane[i]);
+  }
+
+  // 盤内の各点は4方向のbitplaneに1つずつ現れる
+  EXPECT_EQ(kBoardDirectionNum * (kInBoardMoveNum - move_list.size()), open_count);
+}
+
+TEST_F(BitPlaneBoardTest, BitBoardConversionTest)
+{
+  vector<MoveList> board_list;
+  GetTestBoardList(&board_list);
+
+  for(const auto &move_list : board_list){
+    const BitBoard bit_board(move_list);
+    const BitPlaneBoard bit_plane_board(move_list);
+
+    BitBoard converted_bit_board;
+    bit_plane_board.GetBitBoard(&converted_bit_board);
+
+    EXPECT_TRUE(bit_board == converted_bit_board);
+    EXPECT_TRUE(bit_plane_board == BitPlaneBoard(bit_board));
+  }
+}
+
+TEST_F(BitPlaneBoardTest, GetBoardOpenStateTest)
+{
+  vector<MoveList> board_list;
+  GetTestBoardList(&board_list);
+
+  UpdateOpenStateFlag update_flag;
+  update_flag.set();
+
+  for(const auto &move_list : board_list){
+    const BitBoard bit_board(move_list);
+    const BitPlaneBoard bit_plane_board(move_list);
+
+    BoardOpenState expect_open_state(update_flag), open_state(update_flag);
+    bit_board.GetBoardOpenState(update_flag, &expect_open_state);
+    bit_plane_board.GetBoardOpenState(update_flag, &open_state);
+
+    EXPECT_TRUE(expect_open_state == open_state);
+  }
+}
+
+TEST_F(BitPlaneBoardTest, EnumerateForbiddenMovesTest)
+{
+  vector<MoveList> board_list;
+  GetTestBoardList(&board_list);
+
+  size_t forbidden_count = 0;
+
+  for(const auto &move_list : board_list){
+    const BitBoard bit_board(move_list);
+    const BitPlaneBoard bit_plane_board(move_list);
+
+    MoveBitSet expect_forbidden_move, forbidden_move;
+    bit_board.EnumerateForbiddenMoves(&expect_forbidden_move);
+    bit_plane_board.EnumerateForbiddenMoves(&forbidden_move);
+
+    EXPECT_EQ(expect_forbidden_move, forbidden_move);
+    forbidden_count += forbidden_move.count();
+  }
+
+  EXPECT_GT(forbidden_count, 0);
+}
+
+TEST_F(BitPlaneBoardTest, EnumerateFourMovesTest)
+{
+  vector<MoveList> board_list;
+  GetTestBoardList(&board_list);
+
+  for(const auto &move_list : board_list){
+    const BitBoard bit_board(move_list);
+    const BitPlaneBoard bit_plane_board(move_list);
+
+    UpdateOpenStateFlag update_flag(kUpdateFlagFourBlack | kUpdateFlagFourWhite);
+    BoardOpenState board_open_state(update_flag);
+    bit_board.GetBoardOpenState(update_flag, &board_open_state);
+
+    {
+      MoveBitSet expect_four_move, four_move;
+      bit_board.EnumerateFourMoves<kBlackTurn>(board_open_state, &expect_four_move);
+      bit_plane_board.EnumerateFourMoves<kBlackTurn>(&four_move);
+
+      EXPECT_EQ(expect_four_move, four_move);
+    }
+    {
+      MoveBitSet expect_four_move, four_move;
+      bit_board.EnumerateFourMoves<kWhiteTurn>(board_open_state, &expect_four_move);
+      bit_plane_board.EnumerateFourMoves<kWhiteTurn>(&four_move);
+
+      EXPECT_EQ(expect_four_move, four_move);
+    }
+  }
+}
+
+}   // namespace realcore
@@ -4,6 +4,7 @@
 #include "Move.h"
 #include "MoveList.h"
 #include "Board.h"
+#include "ForbiddenMoveTable.h"
 
 using namespace std;
 
@@ -522,5 +523,60 @@ TEST_F(BoardTest, EnumerateForbiddenTest1)
 //  EXPECT_TRUE(forbidden_move_set.none());
 }
 
+TEST_F(BoardTest, ForbiddenMoveTableTest)
+{
+  ForbiddenMoveTable forbidden_move_table(1, kLockFree);
+  MoveBitSet expect_set, forbidden_move_set;
+
+  {
+    // 長連(禁手点キャッシュなし)
+    Board board(MoveList("hhigihghjhhgmhhilhii"));
+    board.EnumerateForbiddenMoves(&expect_set);
 
-}
\ No newline at end of file
+    ASSERT_EQ(1, expect_set.count());
+  }
+  {
+    // 未登録の局面は列挙結果を登録する
+    Board board(MoveList("hhigihghjhhgmhhilhii"));
+    board.SetForbiddenMoveTable(&forbidden_move_table);
+    board.EnumerateForbiddenMoves(&forbidden_move_set);
+
+    ASSERT_EQ(expect_set, forbidden_move_set);
+    ASSERT_EQ(1, forbidden_move_table.GetLookupCount());
+    ASSERT_EQ(0, forbidden_move_table.GetHitCount());
+  }
+  {
+    // 手順が異なる同一局面はキャッシュを参照する
+    Board board(MoveList("jhigihghhhhgmhhilhii"));
+    board.SetForbiddenMoveTable(&forbidden_move_table);
+
+    // コピーした盤面もキャッシュを共有する
+    Board copy_board(board);
+    forbidden_move_set.reset();
+    copy_board.EnumerateForbiddenMoves(&forbidden_move_set);
+
+    ASSERT_EQ(expect_set, forbidden_move_set);
+    ASSERT_EQ(2, forbidden_move_table.GetLookupCount());
+    ASSERT_EQ(1, forbidden_move_table.GetHitCount());
+    ASSERT_DOUBLE_EQ(0.5, forbidden_move_table.GetHitRate());
+  }
+  {
+    // 白番はキャッシュを参照しない
+    Board board(MoveList("hhigihghjhhgmhhilh"));
+    board.SetForbiddenMoveTable(&forbidden_move_table);
+    board.MakeMove(kMoveII);
+    board.MakeMove(kMoveAA);
+
+    forbidden_move_set.reset();
+    board.EnumerateForbiddenMoves(&forbidden_move_set);
+
+    ASSERT_TRUE(forbidden_move_set.none());
+    ASSERT_EQ(2, forbidden_move_table.GetLookupCount());
+  }
+
+  forbidden_move_table.Initialize();
+  ASSERT_EQ(0, forbidden_move_table.GetLookupCount());
+  ASSERT_DOUBLE_EQ(0, forbidden_move_table.GetHitRate());
+}
+
+}
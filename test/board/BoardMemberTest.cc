@@ -218,6 +218,41 @@ public:
     ASSERT_TRUE(board.board_move_sequence_ == move_list);
   }
 
+  void HashValueTest(){
+    Board board;
+    ASSERT_EQ(1, board.board_hash_value_list_.size());
+    ASSERT_EQ(0, board.GetHashValue());
+
+    // パスを含む指し手列でも指し手リストから計算した値と一致する
+    MoveList board_move_list("hhigff");
+    board_move_list += kNullMove;
+    board_move_list += kMoveJJ;
+    board_move_list += kNullMove;
+    board_move_list += kNullMove;
+    board_move_list += kMoveKK;
+
+    MoveList move_list;
+
+    for(const auto move : board_move_list){
+      board.MakeMove(move);
+      move_list += move;
+
+      ASSERT_EQ(CalcHashValue(move_list), board.GetHashValue());
+    }
+
+    const Board copy_board(board);
+    ASSERT_EQ(board.GetHashValue(), copy_board.GetHashValue());
+
+    for(size_t i=0; i<board_move_list.size(); i++){
+      board.UndoMove();
+      --move_list;
+
+      ASSERT_EQ(CalcHashValue(move_list), board.GetHashValue());
+    }
+
+    ASSERT_EQ(1, board.board_hash_value_list_.size());
+  }
+
   void BoardOpenStateStackTest(){
     Board board;
 
@@ -515,6 +550,11 @@ TEST_F(BoardTest, MoveListTest)
   MoveListTest();
 }
 
+TEST_F(BoardTest, HashValueTest)
+{
+  HashValueTest();
+}
+
 TEST_F(BoardTest, BoardOpenStateStackTest)
 {
   BoardOpenStateStackTest();
@@ -0,0 +1,127 @@
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "ChunkedVector.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+class ChunkedVectorTest
+: public ::testing::Test
+{
+public:
+  void ChunkSizeTest(){
+    ChunkedVector<int, 2> chunked_vector;
+    ASSERT_EQ(4, (ChunkedVector<int, 2>::kChunkSize));
+
+    for(int i=0; i<9; i++){
+      chunked_vector.emplace_back(i);
+    }
+
+    ASSERT_EQ(3, chunked_vector.chunk_list_.size());
+    ASSERT_EQ(12, chunked_vector.capacity());
+  }
+};
+
+TEST_F(ChunkedVectorTest, DefaultConstructorTest)
+{
+  ChunkedVector<string> chunked_vector;
+
+  ASSERT_TRUE(chunked_vector.empty());
+  ASSERT_EQ(0, chunked_vector.size());
+  ASSERT_EQ(0, chunked_vector.capacity());
+}
+
+TEST_F(ChunkedVectorTest, ChunkSizeTest)
+{
+  ChunkSizeTest();
+}
+
+TEST_F(ChunkedVectorTest, EmplaceBackTest)
+{
+  ChunkedVector<string, 2> chunked_vector;
+
+  for(int i=0; i<100; i++){
+    chunked_vector.emplace_back(to_string(i));
+    ASSERT_EQ(to_string(i), chunked_vector.back());
+  }
+
+  ASSERT_EQ(100, chunked_vector.size());
+
+  for(int i=0; i<100; i++){
+    ASSERT_EQ(to_string(i), chunked_vector[i]);
+  }
+
+  chunked_vector[10] = "ten";
+  ASSERT_EQ("ten", chunked_vector[10]);
+
+  chunked_vector.push_back("last");
+  ASSERT_EQ("last", chunked_vector.back());
+}
+
+TEST_F(ChunkedVectorTest, StableReferenceTest)
+{
+  // 要素を追加しても既存要素は移動しない
+  ChunkedVector<string, 3> chunked_vector;
+  chunked_vector.emplace_back("first");
+
+  const string * const first_element = &chunked_vector[0];
+  const char * const first_data = chunked_vector[0].data();
+
+  for(int i=0; i<10000; i++){
+    chunked_vector.emplace_back(to_string(i));
+  }
+
+  ASSERT_EQ(first_element, &chunked_vector[0]);
+  ASSERT_EQ(first_data, chunked_vector[0].data());
+  ASSERT_EQ("first", *first_element);
+}
+
+TEST_F(ChunkedVectorTest, CopyTest)
+{
+  ChunkedVector<string, 2> chunked_vector;
+
+  for(int i=0; i<10; i++){
+    chunked_vector.emplace_back(to_string(i));
+  }
+
+  ChunkedVector<string, 2> copy_vector(chunked_vector);
+  ASSERT_TRUE(chunked_vector == copy_vector);
+
+  copy_vector[0] = "changed";
+  ASSERT_TRUE(chunked_vector != copy_vector);
+  ASSERT_EQ("0", chunked_vector[0]);
+
+  copy_vector = chunked_vector;
+  ASSERT_TRUE(chunked_vector == copy_vector);
+
+  ChunkedVector<string, 2> move_vector(std::move(copy_vector));
+  ASSERT_TRUE(chunked_vector == move_vector);
+  ASSERT_TRUE(copy_vector.empty());
+}
+
+TEST_F(ChunkedVectorTest, ReserveClearSwapTest)
+{
+  ChunkedVector<string, 2> chunked_vector, swap_vector;
+
+  chunked_vector.reserve(10);
+  ASSERT_EQ(12, chunked_vector.capacity());
+  ASSERT_TRUE(chunked_vector.empty());
+
+  chunked_vector.emplace_back("a");
+  swap_vector.swap(chunked_vector);
+
+  ASSERT_TRUE(chunked_vector.empty());
+  ASSERT_EQ(1, swap_vector.size());
+  ASSERT_EQ("a", swap_vector[0]);
+  ASSERT_EQ(12, swap_vector.capacity());
+
+  swap_vector.clear();
+  ASSERT_TRUE(swap_vector.empty());
+  ASSERT_EQ(12, swap_vector.capacity());
+}
+
+}   // namespace realcore
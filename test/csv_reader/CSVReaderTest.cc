@@ -62,3 +62,187 @@ TEST(CSVReaderTest, ReadCSVTest)
     EXPECT_EQ("3", string_list[2]);
   }
 }
+
+namespace realcore
+{
+
+class MappedCSVReaderTest
+: public ::testing::Test
+{
+public:
+  void AttachTest()
+  {
+    // 空行, CRLF, 終端の改行なしを含む
+    const string csv_text = "col1,col2,col3\r\na,,c\r\n\r\n,,\n1,2,3";
+    MappedCSVReader csv_reader;
+
+    ASSERT_TRUE(csv_reader.Attach(csv_text.data(), csv_text.size()));
+    ASSERT_EQ(csv_text.data() + 16, csv_reader.data_);
+    ASSERT_EQ(csv_text.data() + csv_text.size(), csv_reader.data_end_);
+
+    const StringVector expect_header{"col1", "col2", "col3"};
+    ASSERT_EQ(expect_header, csv_reader.GetHeader());
+    ASSERT_EQ(3, csv_reader.GetProjectionSize());
+
+    vector<StringVector> row_list;
+    
+    const bool is_read = csv_reader.ForEachRow(
+      [&row_list](const CSVRow &row){
+        row_list.emplace_back();
+
+        for(const auto &value : row){
+          row_list.back().emplace_back(value.to_string());
+        }
+      }
+    );
+
+    ASSERT_TRUE(is_read);
+    ASSERT_EQ(3, row_list.size());
+    EXPECT_EQ(StringVector({"a", "", "c"}), row_list[0]);
+    EXPECT_EQ(StringVector({"", "", ""}), row_list[1]);
+    EXPECT_EQ(StringVector({"1", "2", "3"}), row_list[2]);
+
+    // 改行数
+    ASSERT_EQ(3, csv_reader.CountLine(csv_reader.GetChunk()));
+
+    csv_reader.Close();
+    ASSERT_EQ(nullptr, csv_reader.data_);
+    ASSERT_TRUE(csv_reader.GetHeader().empty());
+  }
+
+  void SetProjectionTest()
+  {
+    const string csv_text = "col1,col2,col3\na,b,c\nd,e,f\n";
+    MappedCSVReader csv_reader;
+
+    ASSERT_TRUE(csv_reader.Attach(csv_text.data(), csv_text.size()));
+
+    // 存在しないカラムは設定できない
+    ASSERT_FALSE(csv_reader.SetProjection(StringVector{"col1", "col4"}));
+    ASSERT_EQ(3, csv_reader.GetProjectionSize());
+
+    ASSERT_TRUE(csv_reader.SetProjection(StringVector{"col3", "col1"}));
+    ASSERT_EQ(2, csv_reader.GetProjectionSize());
+    ASSERT_EQ(3, csv_reader.projection_index_list_.size());
+    ASSERT_EQ(1, csv_reader.projection_index_list_[0]);
+    ASSERT_EQ(0, csv_reader.projection_index_list_[2]);
+
+    StringVector value_list;
+    
+    const bool is_read = csv_reader.ForEachRow(
+      [&value_list](const CSVRow &row){
+        ASSERT_EQ(2, row.size());
+        value_list.emplace_back(row[0].to_string() + row[1].to_string());
+      }
+    );
+
+    ASSERT_TRUE(is_read);
+    EXPECT_EQ(StringVector({"ca", "fd"}), value_list);
+  }
+
+  void SplitChunkTest()
+  {
+    string csv_text = "id,value\n";
+
+    for(size_t i=0; i<100; i++){
+      csv_text += to_string(i) + "," + string(i % 7, 'x') + "\n";
+    }
+
+    MappedCSVReader csv_reader;
+    ASSERT_TRUE(csv_reader.Attach(csv_text.data(), csv_text.size()));
+
+    for(size_t chunk_count=1; chunk_count<=128; chunk_count*=2){
+      vector<CSVChunk> chunk_list;
+      csv_reader.SplitChunk(chunk_count, &chunk_list);
+
+      ASSERT_FALSE(chunk_list.empty());
+      ASSERT_TRUE(chunk_list.size() <= chunk_count);
+      ASSERT_EQ(csv_reader.data_, chunk_list.front().begin);
+      ASSERT_EQ(csv_reader.data_end_, chunk_list.back().end);
+
+      // チャンクは行の境界で連続する
+      StringVector id_list;
+
+      for(size_t i=0, size=chunk_list.size(); i<size; i++){
+        ASSERT_TRUE(chunk_list[i].begin < chunk_list[i].end);
+        ASSERT_EQ('\n', *(chunk_list[i].end - 1));
+
+        if(i > 0){
+          ASSERT_EQ(chunk_list[i - 1].end, chunk_list[i].begin);
+        }
+
+        const bool is_read = csv_reader.ForEachRow(chunk_list[i], 
+          [&id_list](const CSVRow &row){
+            id_list.emplace_back(row[0].to_string());
+          }
+        );
+
+        ASSERT_TRUE(is_read);
+      }
+
+      ASSERT_EQ(100, id_list.size());
+
+      for(size_t i=0; i<100; i++){
+        ASSERT_EQ(to_string(i), id_list[i]);
+      }
+    }
+  }
+};
+
+TEST_F(MappedCSVReaderTest, AttachTest)
+{
+  AttachTest();
+}
+
+TEST_F(MappedCSVReaderTest, SetProjectionTest)
+{
+  SetProjectionTest();
+}
+
+TEST_F(MappedCSVReaderTest, SplitChunkTest)
+{
+  SplitChunkTest();
+}
+
+TEST_F(MappedCSVReaderTest, OpenTest)
+{
+  MappedCSVReader csv_reader;
+
+  ASSERT_FALSE(csv_reader.Open("not_exist.csv"));
+  ASSERT_TRUE(csv_reader.Open("test_data.csv"));
+
+  const StringVector expect_header{"col1", "col2", "col3"};
+  ASSERT_EQ(expect_header, csv_reader.GetHeader());
+
+  ASSERT_TRUE(csv_reader.SetProjection(StringVector{"col3"}));
+  StringVector value_list;
+
+  const bool is_read = csv_reader.ForEachRow(
+    [&value_list](const CSVRow &row){
+      value_list.emplace_back(row[0].to_string());
+    }
+  );
+
+  ASSERT_TRUE(is_read);
+  EXPECT_EQ(StringVector({"c", "", "3"}), value_list);
+}
+
+TEST_F(MappedCSVReaderTest, ColumnNumberTest)
+{
+  MappedCSVReader csv_reader;
+
+  {
+    // カラムが不足
+    const string csv_text = "col1,col2\na\n";
+    ASSERT_TRUE(csv_reader.Attach(csv_text.data(), csv_text.size()));
+    ASSERT_FALSE(csv_reader.ForEachRow([](const CSVRow &row){}));
+  }
+  {
+    // カラムが過剰
+    const string csv_text = "col1,col2\na,b,c\n";
+    ASSERT_TRUE(csv_reader.Attach(csv_text.data(), csv_text.size()));
+    ASSERT_FALSE(csv_reader.ForEachRow([](const CSVRow &row){}));
+  }
+}
+
+}   // namespace realcore
@@ -0,0 +1,211 @@
+#include <cstdio>
+
+#include "gtest/gtest.h"
+
+#include "MoveList.h"
+#include "GameRecordDB.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+class GameRecordDBTest
+: public ::testing::Test
+{
+public:
+  void AttachTest()
+  {
+    GameRecordDBBuilder builder;
+
+    builder.Add(MoveList("hhhgig"), kBlackWin, kResign, 20170227, "alice", "bob");
+    builder.Add(MoveList(), kDraw, kAgreedDraw, 0, "bob", "alice");
+    builder.Add(MoveList("hhhiiiggjj"), kWhiteWin, kTimeup, 20170301, "carol", "bob");
+
+    ASSERT_EQ(3, builder.size());
+
+    string binary;
+    builder.Serialize(&binary);
+
+    GameRecordDB game_record_db;
+    const auto initial_generation = game_record_db.GetGeneration();
+    ASSERT_TRUE(game_record_db.Attach(binary.data(), binary.size()));
+    ASSERT_NE(initial_generation, game_record_db.GetGeneration());
+
+    ASSERT_EQ(3, game_record_db.size());
+    ASSERT_EQ(8, game_record_db.GetMoveCount());
+    ASSERT_EQ(3, game_record_db.GetPlayerCount());
+
+    // 指し手は文字列の解析なしにバイナリ形式の領域を参照する
+    const GameRecordView game_record = game_record_db.GetGameRecord(0);
+    ASSERT_EQ(3, game_record.size());
+    ASSERT_EQ(game_record_db.move_data_, game_record.begin());
+    ASSERT_EQ(kMoveHH, game_record[0]);
+    ASSERT_EQ(kMoveHG, game_record[1]);
+    ASSERT_EQ(kMoveIG, game_record[2]);
+
+    ASSERT_TRUE(game_record_db.GetGameRecord(1).empty());
+
+    MoveList move_list("aa");
+    game_record_db.GetMoveList(2, &move_list);
+    ASSERT_EQ(MoveList("hhhiiiggjj"), move_list);
+
+    // 対局情報
+    ASSERT_EQ(kBlackWin, game_record_db.GetGameResult(0));
+    ASSERT_EQ(kDraw, game_record_db.GetGameResult(1));
+    ASSERT_EQ(kWhiteWin, game_record_db.GetGameResult(2));
+
+    ASSERT_EQ(kResign, game_record_db.GetEndStatus(0));
+    ASSERT_EQ(kAgreedDraw, game_record_db.GetEndStatus(1));
+    ASSERT_EQ(kTimeup, game_record_db.GetEndStatus(2));
+
+    ASSERT_EQ(20170227, game_record_db.GetGameDate(0));
+    ASSERT_EQ(0, game_record_db.GetGameDate(1));
+    ASSERT_EQ(20170301, game_record_db.GetGameDate(2));
+
+    ASSERT_EQ("alice", game_record_db.GetBlackPlayerName(0));
+    ASSERT_EQ("bob", game_record_db.GetWhitePlayerName(0));
+    ASSERT_EQ("bob", game_record_db.GetBlackPlayerName(1));
+    ASSERT_EQ("alice", game_record_db.GetWhitePlayerName(1));
+    ASSERT_EQ("carol", game_record_db.GetBlackPlayerName(2));
+    ASSERT_EQ("bob", game_record_db.GetWhitePlayerName(2));
+
+    // 同一の領域を参照し直した場合も世代は変わる
+    const auto attach_generation = game_record_db.GetGeneration();
+    ASSERT_TRUE(game_record_db.Attach(binary.data(), binary.size()));
+    ASSERT_NE(attach_generation, game_record_db.GetGeneration());
+
+    const auto close_generation = game_record_db.GetGeneration();
+    game_record_db.Close();
+    ASSERT_EQ(0, game_record_db.size());
+    ASSERT_EQ(nullptr, game_record_db.move_data_);
+    ASSERT_NE(close_generation, game_record_db.GetGeneration());
+  }
+
+  void InvalidBinaryTest()
+  {
+    GameRecordDBBuilder builder;
+    builder.Add(MoveList("hhhgig"), kBlackWin, kResign, 20170227, "alice", "bob");
+
+    string binary;
+    builder.Serialize(&binary);
+
+    GameRecordDB game_record_db;
+
+    {
+      // 識別子が異なる
+      string invalid_binary(binary);
+      invalid_binary[0] = 'X';
+      ASSERT_FALSE(game_record_db.Attach(invalid_binary.data(), invalid_binary.size()));
+    }
+    {
+      // サイズが異なる
+      ASSERT_FALSE(game_record_db.Attach(binary.data(), binary.size() - 1));
+      ASSERT_FALSE(game_record_db.Attach(binary.data(), kGameRecordDBHeaderSize - 1));
+    }
+    {
+      // 棋譜の開始位置が指し手数を超える
+      string invalid_binary(binary);
+      invalid_binary[kGameRecordDBHeaderSize + 4] = 4;
+      ASSERT_FALSE(game_record_db.Attach(invalid_binary.data(), invalid_binary.size()));
+    }
+    {
+      // 盤内の位置でもパスでもない指し手を含む
+      const size_t move_data = kGameRecordDBHeaderSize + 8;
+      ASSERT_EQ(kMoveHH, static_cast<MovePosition>(binary[move_data]));
+
+      for(const auto invalid_move : {kInvalidMove, static_cast<MovePosition>(5 * 16)}){
+        string invalid_binary(binary);
+        invalid_binary[move_data + 1] = static_cast<char>(invalid_move);
+        ASSERT_FALSE(game_record_db.Attach(invalid_binary.data(), invalid_binary.size()));
+      }
+
+      // パスは許容する
+      string pass_binary(binary);
+      pass_binary[move_data + 1] = static_cast<char>(kNullMove);
+      ASSERT_TRUE(game_record_db.Attach(pass_binary.data(), pass_binary.size()));
+    }
+
+    ASSERT_TRUE(game_record_db.Attach(binary.data(), binary.size()));
+  }
+};
+
+TEST_F(GameRecordDBTest, AttachTest)
+{
+  AttachTest();
+}
+
+TEST_F(GameRecordDBTest, InvalidBinaryTest)
+{
+  InvalidBinaryTest();
+}
+
+TEST_F(GameRecordDBTest, GetGameResultTest)
+{
+  ASSERT_EQ(kBlackWin, GetGameResult("BlackWin"));
+  ASSERT_EQ(kWhiteWin, GetGameResult("WhiteWin"));
+  ASSERT_EQ(kDraw, GetGameResult("Draw"));
+  ASSERT_EQ(kUnknownResult, GetGameResult("Unknown"));
+  ASSERT_EQ(kUnknownResult, GetGameResult(""));
+
+  ASSERT_EQ(kResign, GetGameEndStatus("Resign"));
+  ASSERT_EQ(kTimeup, GetGameEndStatus("Timeup"));
+  ASSERT_EQ(kAgreedDraw, GetGameEndStatus("AgreedDraw"));
+  ASSERT_EQ(kUnknownEndStatus, GetGameEndStatus("Unknown"));
+}
+
+TEST_F(GameRecordDBTest, GetGameDateTest)
+{
+  ASSERT_EQ(20170227, GetGameDate("2017-02-27"));
+  ASSERT_EQ(20170301, GetGameDate("2017/03/01"));
+  ASSERT_EQ(20170302, GetGameDate("20170302"));
+  ASSERT_EQ(0, GetGameDate("2017-03"));
+  ASSERT_EQ(0, GetGameDate(""));
+}
+
+TEST_F(GameRecordDBTest, LoadTest)
+{
+  // test_data.csv:
+  // game_date,black_player_name,...,game_end_status,game_result,game_record,...
+  // 2017-02-27,alice,...,Resign,BlackWin,hhhgig,...
+  // 2017/03/01,bob,...,Timeup,WhiteWin,hhhiii,...
+  // ,carol,...,AgreedDraw,Draw,,...
+  // 2017-03-02,alice,...,Unknown,Unknown,hhzz,...    <- 不正な棋譜のため読み飛ばす
+  GameRecordDBBuilder builder;
+  size_t skip_count = 0;
+
+  ASSERT_FALSE(builder.AddCSV("not_exist.csv", &skip_count));
+  ASSERT_TRUE(builder.AddCSV("test_data.csv", &skip_count));
+  ASSERT_EQ(3, builder.size());
+  ASSERT_EQ(1, skip_count);
+
+  const string db_file = "test_data.rcgd";
+  ASSERT_TRUE(builder.WriteFile(db_file));
+
+  GameRecordDB game_record_db;
+
+  // CSVはOpenできず、Loadでは変換して読み込む
+  ASSERT_FALSE(game_record_db.Open("test_data.csv"));
+
+  for(const auto &file : {db_file, string("test_data.csv")}){
+    ASSERT_TRUE(game_record_db.Load(file));
+    ASSERT_EQ(3, game_record_db.size());
+    ASSERT_EQ(3, game_record_db.GetPlayerCount());
+
+    MoveList move_list;
+    game_record_db.GetMoveList(1, &move_list);
+    ASSERT_EQ(MoveList("hhhiii"), move_list);
+    ASSERT_TRUE(game_record_db.GetGameRecord(2).empty());
+
+    ASSERT_EQ(kWhiteWin, game_record_db.GetGameResult(1));
+    ASSERT_EQ(kTimeup, game_record_db.GetEndStatus(1));
+    ASSERT_EQ(20170301, game_record_db.GetGameDate(1));
+    ASSERT_EQ("bob", game_record_db.GetBlackPlayerName(1));
+    ASSERT_EQ("carol", game_record_db.GetWhitePlayerName(1));
+    ASSERT_EQ(0, game_record_db.GetGameDate(2));
+  }
+
+  remove(db_file.c_str());
+}
+
+}   // namespace realcore
@@ -0,0 +1,342 @@
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "MoveList.h"
+#include "Board.h"
+#include "HashTable.h"
+#include "GameRecordDB.h"
+#include "GameRecordDBTraverser.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+class GameRecordDBTraverserTest
+: public ::testing::Test
+{
+public:
+  GameRecordDBTraverserTest()
+  {
+    // 共通の手順を持つ棋譜, 同一の棋譜, 手順前後で同一局面となる棋譜を含む
+    const vector<string> game_record_list{
+      "hhhgig", "hhhggg", "hhhgig", "hhij", "", "hh", "hhigjj", "iihhgg", "hhhgigjj", "ighghh", "hhij"
+    };
+
+    GameRecordDBBuilder builder;
+
+    for(const auto &game_record : game_record_list){
+      builder.Add(MoveList(game_record), kBlackWin, kResign, 0, "alice", "bob");
+    }
+
+    builder.Serialize(&db_binary_);
+    game_record_db_.Attach(db_binary_.data(), db_binary_.size());
+  }
+
+  //! @brief (棋譜index, 手数)のリスト
+  typedef vector<pair<size_t, size_t>> VisitList;
+
+  static void ReduceVisitList(VisitList * const visit_list, const VisitList &chunk_visit_list)
+  {
+    visit_list->insert(visit_list->end(), chunk_visit_list.begin(), chunk_visit_list.end());
+  }
+
+  void ForEachGameTest()
+  {
+    map<size_t, VisitList> thread_visit_list;
+
+    for(const size_t thread_num : {1, 3}){
+      GameRecordDBTraverser traverser(game_record_db_, thread_num, kUpdateAllOpenState);
+      traverser.SetChunkSize(2);
+
+      VisitList visit_list;
+      const bool is_completed = traverser.ForEachGame([](Board * const board, const size_t game_index, const GameRecordView &game_record, VisitList * const chunk_visit_list){
+        ASSERT_TRUE(*board == Board());
+        chunk_visit_list->emplace_back(game_index, game_record.size());
+      }, ReduceVisitList, &visit_list);
+
+      ASSERT_TRUE(is_completed);
+      ASSERT_EQ(game_record_db_.size(), traverser.GetProcessedGameCount());
+      thread_visit_list[thread_num] = visit_list;
+    }
+
+    // スレッド数によらず棋譜DBの順に統合する
+    const VisitList &visit_list = thread_visit_list[1];
+    ASSERT_EQ(game_record_db_.size(), visit_list.size());
+
+    for(size_t i=0; i<visit_list.size(); i++){
+      ASSERT_EQ(i, visit_list[i].first);
+      ASSERT_EQ(game_record_db_.GetGameRecord(i).size(), visit_list[i].second);
+    }
+
+    ASSERT_TRUE(thread_visit_list[1] == thread_visit_list[3]);
+  }
+
+  void ForEachPositionTest()
+  {
+    map<size_t, VisitList> thread_visit_list;
+
+    for(const size_t thread_num : {1, 3}){
+      GameRecordDBTraverser traverser(game_record_db_, thread_num, kUpdateAllOpenState);
+      traverser.SetChunkSize(3);
+
+      VisitList visit_list;
+      const bool is_completed = traverser.ForEachPosition([](const Board &board, const GameRecordDBPosition &position, VisitList * const chunk_visit_list){
+        ASSERT_EQ(position.depth, position.move_list->size());
+        ASSERT_TRUE(board == Board(*position.move_list));
+        ASSERT_EQ(CalcHashValue(*position.move_list), position.hash_value);
+
+        for(size_t i=0; i<position.depth; i++){
+          ASSERT_EQ((*position.game_record)[i], (*position.move_list)[i]);
+        }
+
+        chunk_visit_list->emplace_back(position.game_index, position.depth);
+      }, ReduceVisitList, &visit_list);
+
+      ASSERT_TRUE(is_completed);
+      thread_visit_list[thread_num] = visit_list;
+
+      // 走査後のBoardは初期局面に戻る
+      for(size_t i=0; i<thread_num; i++){
+        ASSERT_TRUE(*traverser.GetBoard(i) == Board());
+      }
+    }
+
+    // 棋譜ごとに初期局面から終局図まで訪問する
+    size_t position_count = 0;
+
+    for(size_t i=0, size=game_record_db_.size(); i<size; i++){
+      position_count += game_record_db_.GetGameRecord(i).size() + 1;
+    }
+
+    ASSERT_EQ(position_count, thread_visit_list[1].size());
+    ASSERT_TRUE(thread_visit_list[1] == thread_visit_list[3]);
+  }
+
+  void EndPositionTest()
+  {
+    // 終局図を訪問しない場合は着手前の局面のみを訪問する
+    GameRecordDBTraverser traverser(game_record_db_, 2, kUpdateAllOpenState);
+    traverser.SetChunkSize(3);
+    traverser.SetEndPosition(false);
+
+    VisitList visit_list;
+    const bool is_completed = traverser.ForEachPosition([](const Board &, const GameRecordDBPosition &position, VisitList * const chunk_visit_list){
+      ASSERT_TRUE(position.depth < position.game_record->size());
+      chunk_visit_list->emplace_back(position.game_index, position.depth);
+    }, ReduceVisitList, &visit_list);
+
+    ASSERT_TRUE(is_completed);
+
+    size_t position_count = 0;
+
+    for(size_t i=0, size=game_record_db_.size(); i<size; i++){
+      position_count += game_record_db_.GetGameRecord(i).size();
+    }
+
+    ASSERT_EQ(position_count, visit_list.size());
+  }
+
+  void UniquePositionTest()
+  {
+    // 棋譜DBの順に再生して局面が最初に現れる棋譜を求める
+    map<HashValue, size_t> expect_first_game;
+
+    for(size_t i=0, size=game_record_db_.size(); i<size; i++){
+      MoveList move_list;
+      expect_first_game.insert(make_pair(CalcHashValue(move_list), i));
+
+      for(const auto move : game_record_db_.GetGameRecord(i)){
+        move_list += move;
+        expect_first_game.insert(make_pair(CalcHashValue(move_list), i));
+      }
+    }
+
+    map<size_t, VisitList> thread_visit_list;
+
+    for(const size_t thread_num : {1, 3}){
+      GameRecordDBTraverser traverser(game_record_db_, thread_num, kUpdateAllOpenState);
+      traverser.SetChunkSize(2);
+      traverser.SetUniquePosition(true);
+
+      set<HashValue> visit_set;
+      VisitList visit_list;
+
+      const bool is_completed = traverser.ForEachPosition([](const Board &, const GameRecordDBPosition &position, VisitList * const chunk_visit_list){
+        chunk_visit_list->emplace_back(position.game_index, position.hash_value);
+      }, ReduceVisitList, &visit_list);
+
+      ASSERT_TRUE(is_completed);
+
+      for(const auto &visit : visit_list){
+        ASSERT_TRUE(visit_set.insert(visit.second).second);
+        ASSERT_EQ(expect_first_game[visit.second], visit.first);
+      }
+
+      ASSERT_EQ(expect_first_game.size(), visit_set.size());
+      thread_visit_list[thread_num] = visit_list;
+    }
+
+    ASSERT_TRUE(thread_visit_list[1] == thread_visit_list[3]);
+  }
+
+  void FirstGameListCacheTest()
+  {
+    GameRecordDBTraverser traverser(game_record_db_, 2, kUpdateAllOpenState);
+    traverser.SetUniquePosition(true);
+
+    const auto count_position = [&traverser](){
+      size_t position_count = 0;
+
+      const bool is_completed = traverser.ForEachPosition([](const Board &, const GameRecordDBPosition &, size_t * const chunk_count){
+        (*chunk_count)++;
+      }, [](size_t * const count, const size_t chunk_count){ *count += chunk_count; }, &position_count);
+
+      EXPECT_TRUE(is_completed);
+      return position_count;
+    };
+
+    const size_t position_count = count_position();
+    const auto *first_game_list_data = traverser.first_game_list_.data();
+    ASSERT_TRUE(traverser.IsFirstGameListBuilt());
+
+    // 同一の棋譜DB・設定では求め直さない
+    ASSERT_EQ(position_count, count_position());
+    ASSERT_EQ(first_game_list_data, traverser.first_game_list_.data());
+
+    // 終局図の設定を変えた場合は求め直す
+    traverser.SetEndPosition(false);
+    ASSERT_FALSE(traverser.IsFirstGameListBuilt());
+    ASSERT_GT(position_count, count_position());
+    ASSERT_TRUE(traverser.IsFirstGameListBuilt());
+
+    // 棋譜DBを開き直した場合は求め直す
+    GameRecordDBBuilder builder;
+    builder.Add(MoveList("hhhi"), kBlackWin, kResign, 0, "alice", "bob");
+
+    string db_binary;
+    builder.Serialize(&db_binary);
+    ASSERT_TRUE(game_record_db_.Attach(db_binary.data(), db_binary.size()));
+
+    ASSERT_FALSE(traverser.IsFirstGameListBuilt());
+    ASSERT_EQ(2, count_position());
+
+    // 同一のアドレスに棋譜数・指し手数が同じ別の棋譜DBを開き直した場合も求め直す
+    GameRecordDBBuilder other_builder;
+    other_builder.Add(MoveList("hhhj"), kBlackWin, kResign, 0, "alice", "bob");
+
+    string other_db_binary;
+    other_builder.Serialize(&other_db_binary);
+    ASSERT_EQ(db_binary.size(), other_db_binary.size());
+
+    copy(other_db_binary.begin(), other_db_binary.end(), db_binary.begin());
+    ASSERT_TRUE(game_record_db_.Attach(db_binary.data(), db_binary.size()));
+
+    ASSERT_FALSE(traverser.IsFirstGameListBuilt());
+    ASSERT_EQ(2, count_position());
+
+    game_record_db_.Attach(db_binary_.data(), db_binary_.size());
+  }
+
+  void CancelTest()
+  {
+    constexpr size_t kThreadNum = 2;
+    constexpr size_t kChunkSize = 2;
+
+    {
+      // 走査開始前に停止が通知されている場合
+      SharedSearchManager search_manager(kThreadNum, false);
+      search_manager.Stop();
+
+      GameRecordDBTraverser traverser(game_record_db_, kThreadNum, kUpdateAllOpenState);
+      traverser.SetSearchManager(&search_manager);
+
+      VisitList visit_list;
+      const bool is_completed = traverser.ForEachPosition([](const Board &, const GameRecordDBPosition &position, VisitList * const chunk_visit_list){
+        chunk_visit_list->emplace_back(position.game_index, position.depth);
+      }, ReduceVisitList, &visit_list);
+
+      ASSERT_FALSE(is_completed);
+      ASSERT_TRUE(visit_list.empty());
+      ASSERT_EQ(0, traverser.GetProcessedGameCount());
+    }
+    {
+      // 走査中に停止が通知された場合は完了したチャンクのみを統合する
+      SharedSearchManager search_manager(kThreadNum, false);
+
+      GameRecordDBTraverser traverser(game_record_db_, kThreadNum, kUpdateAllOpenState);
+      traverser.SetChunkSize(kChunkSize);
+      traverser.SetSearchManager(&search_manager);
+
+      VisitList visit_list;
+      const bool is_completed = traverser.ForEachGame([&search_manager](Board * const, const size_t game_index, const GameRecordView &game_record, VisitList * const chunk_visit_list){
+        // チャンク(4, 5)の途中で停止する
+        if(game_index == 4){
+          search_manager.Stop();
+        }
+
+        chunk_visit_list->emplace_back(game_index, game_record.size());
+      }, ReduceVisitList, &visit_list);
+
+      ASSERT_FALSE(is_completed);
+      ASSERT_EQ(visit_list.size(), traverser.GetProcessedGameCount());
+      ASSERT_TRUE(visit_list.size() < game_record_db_.size());
+
+      set<size_t> chunk_set;
+
+      for(size_t i=0; i<visit_list.size(); i++){
+        ASSERT_TRUE(i == 0 || visit_list[i - 1].first < visit_list[i].first);
+        ASSERT_NE(4, visit_list[i].first);
+        chunk_set.insert(visit_list[i].first / kChunkSize);
+      }
+
+      // 統合したチャンクは全棋譜を含む
+      size_t chunk_game_count = 0;
+
+      for(const auto chunk_index : chunk_set){
+        chunk_game_count += min((chunk_index + 1) * kChunkSize, game_record_db_.size()) - chunk_index * kChunkSize;
+      }
+
+      ASSERT_EQ(chunk_game_count, visit_list.size());
+    }
+  }
+
+private:
+  string db_binary_;
+  GameRecordDB game_record_db_;
+};
+
+TEST_F(GameRecordDBTraverserTest, ForEachGameTest)
+{
+  ForEachGameTest();
+}
+
+TEST_F(GameRecordDBTraverserTest, ForEachPositionTest)
+{
+  ForEachPositionTest();
+}
+
+TEST_F(GameRecordDBTraverserTest, EndPositionTest)
+{
+  EndPositionTest();
+}
+
+TEST_F(GameRecordDBTraverserTest, UniquePositionTest)
+{
+  UniquePositionTest();
+}
+
+TEST_F(GameRecordDBTraverserTest, FirstGameListCacheTest)
+{
+  FirstGameListCacheTest();
+}
+
+TEST_F(GameRecordDBTraverserTest, CancelTest)
+{
+  CancelTest();
+}
+
+}   // namespace realcore
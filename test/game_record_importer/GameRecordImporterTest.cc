@@ -0,0 +1,183 @@
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+
+#include "gtest/gtest.h"
+
+#include "MoveList.h"
+#include "GameRecordDB.h"
+#include "GameRecordImporter.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+class GameRecordImporterTest
+: public ::testing::Test
+{
+public:
+  GameRecordImporterTest()
+  : test_dir_("import_test_data")
+  {
+    boost::filesystem::remove_all(test_dir_);
+    boost::filesystem::create_directories(test_dir_ + "/sub");
+
+    // 黒: hh, ig 白: hg
+    WriteFile("01.sgf", "(;GM[4]FF[4]SZ[15]PB[alice]PW[bob]RE[B+Resign]DT[2017-02-27];B[hh];W[hg];B[ig])");
+
+    // 01.sgfの左右反転
+    WriteFile("sub/02.SGF", "(;GM[4]FF[4]SZ[15]PB[carol]PW[dave]RE[W+Time]DT[2017-03-01];B[hh];W[hg];B[gg])");
+
+    // 手番が交互でない
+    WriteFile("03.sgf", "(;GM[4]FF[4]SZ[15]PB[alice]PW[bob]RE[B+Resign];B[hh];B[hg])");
+
+    // POS形式: 先頭1byteは手数, 以降は(y - 1) * 15 + (x - 1)
+    // 黒: hh 白: ij
+    WriteFile("sub/04.pos", string{2, static_cast<char>(7 * 15 + 7), static_cast<char>(9 * 15 + 8)});
+
+    // 対象外の拡張子
+    WriteFile("05.txt", "(;B[aa])");
+  }
+
+  ~GameRecordImporterTest()
+  {
+    boost::filesystem::remove_all(test_dir_);
+  }
+
+  void EnumerateGameRecordFileTest()
+  {
+    vector<string> file_list;
+    GameRecordImporter::EnumerateGameRecordFile(test_dir_, &file_list);
+
+    const vector<string> expect_list{test_dir_ + "/01.sgf", test_dir_ + "/03.sgf", test_dir_ + "/sub/02.SGF", test_dir_ + "/sub/04.pos"};
+    EXPECT_EQ(expect_list, file_list);
+
+    // ファイルを指定した場合は追記する
+    GameRecordImporter::EnumerateGameRecordFile(test_dir_ + "/01.sgf", &file_list);
+    GameRecordImporter::EnumerateGameRecordFile(test_dir_ + "/05.txt", &file_list);
+    GameRecordImporter::EnumerateGameRecordFile(test_dir_ + "/not_exist", &file_list);
+
+    ASSERT_EQ(5, file_list.size());
+    EXPECT_EQ(test_dir_ + "/01.sgf", file_list.back());
+  }
+
+  void ImportTest()
+  {
+    vector<string> file_list;
+    GameRecordImporter::EnumerateGameRecordFile(test_dir_, &file_list);
+
+    GameRecordImporter importer(2, kSGFCheckNone);
+    importer.SetBatchSize(3);
+
+    GameRecordDBBuilder builder;
+    importer.Import(file_list, &builder);
+
+    {
+      const GameRecordImportStats &stats = importer.GetStats();
+      EXPECT_EQ(4, stats.file_count);
+      EXPECT_EQ(2, stats.imported_count);
+      EXPECT_EQ(1, stats.duplicate_count);
+      EXPECT_EQ(1, stats.error_count);
+      EXPECT_LT(0, stats.byte_count);
+    }
+
+    string binary;
+    builder.Serialize(&binary);
+
+    GameRecordDB game_record_db;
+    ASSERT_TRUE(game_record_db.Attach(binary.data(), binary.size()));
+    ASSERT_EQ(2, game_record_db.size());
+
+    // ファイルリスト順に追加し、対称形の02.SGFは読み飛ばす
+    MoveList move_list;
+    game_record_db.GetMoveList(0, &move_list);
+    EXPECT_EQ(MoveList("hhhgig"), move_list);
+    EXPECT_EQ(kBlackWin, game_record_db.GetGameResult(0));
+    EXPECT_EQ(kResign, game_record_db.GetEndStatus(0));
+    EXPECT_EQ(20170227, game_record_db.GetGameDate(0));
+    EXPECT_EQ("alice", game_record_db.GetBlackPlayerName(0));
+    EXPECT_EQ("bob", game_record_db.GetWhitePlayerName(0));
+
+    game_record_db.GetMoveList(1, &move_list);
+    EXPECT_EQ(MoveList("hhij"), move_list);
+    EXPECT_EQ(kUnknownResult, game_record_db.GetGameResult(1));
+    EXPECT_EQ(0, game_record_db.GetGameDate(1));
+    EXPECT_EQ("", game_record_db.GetBlackPlayerName(1));
+
+    // 2回目以降のImportも追加済の棋譜との重複を判定する
+    importer.Import(file_list, &builder);
+
+    {
+      const GameRecordImportStats &stats = importer.GetStats();
+      EXPECT_EQ(8, stats.file_count);
+      EXPECT_EQ(2, stats.imported_count);
+      EXPECT_EQ(4, stats.duplicate_count);
+      EXPECT_EQ(2, stats.error_count);
+    }
+
+    EXPECT_EQ(2, builder.size());
+  }
+
+  void ReadPOSGameRecordFileTest()
+  {
+    boost::filesystem::create_directories(test_dir_ + "/pos");
+
+    // 0byte, 指し手なし, 途中で切れたファイル, 盤外の値を含むファイル
+    WriteFile("pos/01.pos", "");
+    WriteFile("pos/02.pos", string(1, 0));
+    WriteFile("pos/03.pos", string{3, static_cast<char>(7 * 15 + 7), static_cast<char>(9 * 15 + 8)});
+    WriteFile("pos/04.pos", string{2, static_cast<char>(7 * 15 + 7), static_cast<char>(230)});
+
+    GameRecordImporter importer(1, kSGFCheckNone);
+
+    for(const auto &file : {"01.pos", "02.pos", "03.pos", "04.pos", "not_exist.pos"}){
+      ImportedGameRecord game_record;
+      importer.ReadGameRecordFile(test_dir_ + "/pos/" + file, &game_record);
+
+      EXPECT_FALSE(game_record.is_valid) << file;
+    }
+
+    ImportedGameRecord game_record;
+    importer.ReadGameRecordFile(test_dir_ + "/sub/04.pos", &game_record);
+
+    ASSERT_TRUE(game_record.is_valid);
+    EXPECT_EQ(MoveList("hhij"), game_record.game_record);
+    EXPECT_EQ(3, game_record.byte_count);
+
+    // 読込に失敗したファイルはエラーとして数える
+    GameRecordDBBuilder builder;
+    importer.Import({test_dir_ + "/pos/01.pos", test_dir_ + "/pos/03.pos", test_dir_ + "/sub/04.pos"}, &builder);
+
+    const GameRecordImportStats &stats = importer.GetStats();
+    EXPECT_EQ(1, stats.imported_count);
+    EXPECT_EQ(0, stats.duplicate_count);
+    EXPECT_EQ(2, stats.error_count);
+  }
+
+private:
+  void WriteFile(const string &file_name, const string &data) const
+  {
+    ofstream ofs(test_dir_ + "/" + file_name, ios::out | ios::binary);
+    ofs << data;
+  }
+
+  const string test_dir_;
+};
+
+TEST_F(GameRecordImporterTest, EnumerateGameRecordFileTest)
+{
+  EnumerateGameRecordFileTest();
+}
+
+TEST_F(GameRecordImporterTest, ImportTest)
+{
+  ImportTest();
+}
+
+TEST_F(GameRecordImporterTest, ReadPOSGameRecordFileTest)
+{
+  ReadPOSGameRecordFileTest();
+}
+
+}   // namespace realcore
@@ -0,0 +1,213 @@
+#include <map>
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "MoveList.h"
+#include "Board.h"
+#include "GameRecordDB.h"
+#include "GameRecordTrie.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+class GameRecordTrieTest
+: public ::testing::Test
+{
+public:
+  GameRecordTrieTest()
+  {
+    // 3番目の棋譜は1番目の棋譜と同一
+    GameRecordDBBuilder builder;
+
+    builder.Add(MoveList("hhhgig"), kBlackWin, kResign, 0, "alice", "bob");
+    builder.Add(MoveList("hhhggg"), kWhiteWin, kResign, 0, "bob", "alice");
+    builder.Add(MoveList("hhhgig"), kDraw, kAgreedDraw, 0, "alice", "bob");
+    builder.Add(MoveList("hhij"), kBlackWin, kResign, 0, "bob", "alice");
+    builder.Add(MoveList(), kDraw, kAgreedDraw, 0, "alice", "bob");
+    builder.Add(MoveList("hh"), kWhiteWin, kResign, 0, "bob", "alice");
+
+    builder.Serialize(&db_binary_);
+    game_record_db_.Attach(db_binary_.data(), db_binary_.size());
+  }
+
+  void BuildTest()
+  {
+    GameRecordTrie game_record_trie;
+    game_record_trie.Build(game_record_db_);
+
+    ASSERT_EQ(6, game_record_trie.GetGameCount());
+
+    // 初期局面, hh, hhhg, hhhggg, hhhgig, hhij
+    ASSERT_EQ(6, game_record_trie.GetPrefixCount());
+    ASSERT_EQ(1 + 4 + 4 + 4 + 3 + 2, game_record_trie.GetReplayPositionCount());
+
+    // 辞書順に並べる(同一の棋譜は棋譜DBのindex順)
+    ASSERT_EQ(4, game_record_trie.sorted_game_list_[0]);
+    ASSERT_EQ(5, game_record_trie.sorted_game_list_[1]);
+
+    // 再構築
+    game_record_trie.Build(game_record_db_);
+    ASSERT_EQ(6, game_record_trie.GetPrefixCount());
+  }
+
+  void TraverseTest()
+  {
+    GameRecordTrie game_record_trie;
+    game_record_trie.Build(game_record_db_);
+
+    // 局面ごとの(経由する棋譜数, 終わる棋譜のindex)
+    map<string, pair<size_t, vector<uint32_t>>> expect_map;
+
+    expect_map[""] = make_pair(6, vector<uint32_t>{4});
+    expect_map["hh"] = make_pair(5, vector<uint32_t>{5});
+    expect_map["hhhg"] = make_pair(3, vector<uint32_t>{});
+    expect_map["hhhggg"] = make_pair(1, vector<uint32_t>{1});
+    expect_map["hhhgig"] = make_pair(2, vector<uint32_t>{0, 2});
+    expect_map["hhij"] = make_pair(1, vector<uint32_t>{3});
+
+    Board board;
+    set<string> visit_set;
+    size_t previous_depth = 0;
+
+    game_record_trie.Traverse(&board, [&](const Board &visit_board, const GameRecordTriePosition &position){
+      const string move_string = position.move_list->str();
+
+      // 手順ごとに1度だけ訪問する
+      ASSERT_TRUE(visit_set.insert(move_string).second);
+      ASSERT_TRUE(expect_map.find(move_string) != expect_map.end());
+
+      ASSERT_EQ(position.move_list->size(), position.depth);
+      ASSERT_TRUE(position.depth <= previous_depth + 1);
+      ASSERT_TRUE(visit_board == Board(*position.move_list));
+
+      const auto &expect = expect_map[move_string];
+      ASSERT_EQ(expect.first, position.game_count);
+      ASSERT_EQ(expect.second, vector<uint32_t>(position.end_game_index, position.end_game_index + position.end_game_count));
+
+      previous_depth = position.depth;
+    });
+
+    ASSERT_EQ(expect_map.size(), visit_set.size());
+
+    // 走査後は元の局面に戻る
+    ASSERT_TRUE(board == Board());
+  }
+
+  void SubtreeTraverseTest()
+  {
+    // 走査開始局面からの相対的な指し手列として走査する
+    GameRecordDBBuilder builder;
+    builder.Add(MoveList("hgig"), kBlackWin, kResign, 0, "alice", "bob");
+    builder.Add(MoveList("ij"), kWhiteWin, kResign, 0, "bob", "alice");
+
+    string binary;
+    builder.Serialize(&binary);
+
+    GameRecordDB game_record_db;
+    ASSERT_TRUE(game_record_db.Attach(binary.data(), binary.size()));
+
+    GameRecordTrie game_record_trie;
+    game_record_trie.Build(game_record_db);
+
+    Board board(MoveList("hh"));
+    vector<string> visit_list;
+
+    game_record_trie.Traverse(&board, [&](const Board &visit_board, const GameRecordTriePosition &position){
+      MoveList board_move_list("hh");
+
+      for(const auto move : *position.move_list){
+        board_move_list += move;
+      }
+
+      ASSERT_TRUE(visit_board == Board(board_move_list));
+      visit_list.emplace_back(position.move_list->str());
+    });
+
+    ASSERT_EQ(4, visit_list.size());
+    ASSERT_TRUE(board == Board(MoveList("hh")));
+  }
+
+  void EmptyTest()
+  {
+    GameRecordDB game_record_db;
+    GameRecordTrie game_record_trie;
+    game_record_trie.Build(game_record_db);
+
+    ASSERT_EQ(0, game_record_trie.GetGameCount());
+    ASSERT_EQ(1, game_record_trie.GetPrefixCount());
+    ASSERT_EQ(0, game_record_trie.GetReplayPositionCount());
+
+    Board board;
+    size_t visit_count = 0;
+
+    game_record_trie.Traverse(&board, [&](const Board &, const GameRecordTriePosition &position){
+      ASSERT_EQ(0, position.game_count);
+      visit_count++;
+    });
+
+    ASSERT_EQ(1, visit_count);
+  }
+
+  void TranspositionTest()
+  {
+    // 手順前後で同一局面となる棋譜
+    GameRecordDBBuilder builder;
+    builder.Add(MoveList("hhhiii"), kBlackWin, kResign, 0, "alice", "bob");
+    builder.Add(MoveList("iihihh"), kBlackWin, kResign, 0, "alice", "bob");
+
+    string db_binary;
+    builder.Serialize(&db_binary);
+
+    GameRecordDB game_record_db;
+    ASSERT_TRUE(game_record_db.Attach(db_binary.data(), db_binary.size()));
+
+    GameRecordTrie game_record_trie;
+    game_record_trie.Build(game_record_db);
+
+    // 手順は合流しないため、終局図は同一局面でも別に数える
+    ASSERT_EQ(1 + 3 + 3, game_record_trie.GetPrefixCount());
+
+    Board board;
+    set<HashValue> position_set;
+
+    game_record_trie.Traverse(&board, [&position_set](const Board &, const GameRecordTriePosition &position){
+      position_set.insert(CalcHashValue(*position.move_list));
+    });
+
+    ASSERT_EQ(game_record_trie.GetPrefixCount() - 1, position_set.size());
+  }
+
+private:
+  string db_binary_;
+  GameRecordDB game_record_db_;
+};
+
+TEST_F(GameRecordTrieTest, BuildTest)
+{
+  BuildTest();
+}
+
+TEST_F(GameRecordTrieTest, TraverseTest)
+{
+  TraverseTest();
+}
+
+TEST_F(GameRecordTrieTest, SubtreeTraverseTest)
+{
+  SubtreeTraverseTest();
+}
+
+TEST_F(GameRecordTrieTest, TranspositionTest)
+{
+  TranspositionTest();
+}
+
+TEST_F(GameRecordTrieTest, EmptyTest)
+{
+  EmptyTest();
+}
+
+}   // namespace realcore
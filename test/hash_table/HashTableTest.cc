@@ -247,6 +247,70 @@ TEST_F(HashTableTest, IsConflictTest)
   ASSERT_EQ(1, data.value);
 }
 
+TEST_F(HashTableTest, ForEachTest)
+{
+  HashTable<TestData> hash_table(test_table_space, kLockTable);
+
+  for(HashValue hash_value=1; hash_value<=10; hash_value++){
+    TestData data;
+    data.hash_value = hash_value;
+    data.value = hash_value;
+    hash_table.Upsert(hash_value, data);
+  }
+
+  size_t count = 0;
+  uint64_t sum = 0;
+
+  hash_table.ForEach([&count, &sum](const TestData &data){
+    count++;
+    sum += data.value;
+  });
+
+  ASSERT_EQ(10, count);
+  ASSERT_EQ(55, sum);
+
+  // 論理初期化後の要素は対象外
+  hash_table.Initialize();
+  count = 0;
+
+  hash_table.ForEach([&count](const TestData &data){
+    count++;
+  });
+
+  ASSERT_EQ(0, count);
+}
+
+TEST_F(HashTableTest, EraseIfTest)
+{
+  HashTable<TestData> hash_table(test_table_space, kLockFree);
+
+  for(HashValue hash_value=1; hash_value<=10; hash_value++){
+    TestData data;
+    data.hash_value = hash_value;
+    data.value = hash_value;
+    hash_table.Upsert(hash_value, data);
+  }
+
+  const size_t erase_count = hash_table.EraseIf([](const TestData &data){
+    return data.value % 2 == 0;
+  });
+
+  ASSERT_EQ(5, erase_count);
+
+  for(HashValue hash_value=1; hash_value<=10; hash_value++){
+    TestData data;
+    ASSERT_EQ(hash_value % 2 == 1, hash_table.find(hash_value, &data));
+    ASSERT_EQ(hash_value % 2 == 1, hash_table.IsConflict(hash_value, &data));
+  }
+
+  // 削除済の位置には再登録できる
+  TestData data;
+  data.hash_value = 2;
+  data.value = 2;
+  hash_table.Upsert(data.hash_value, data);
+  ASSERT_TRUE(hash_table.find(data.hash_value, &data));
+}
+
 TEST_F(HashTableTest, UpsertTest)
 {
   UpsertTest();
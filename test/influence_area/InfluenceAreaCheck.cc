@@ -1,5 +1,5 @@
 #include <iostream>
-#include <set>
+#include <sstream>
 
 #include <boost/program_options.hpp>
 
@@ -17,10 +17,12 @@ int main(int argc, char* argv[])
   options_description option;
   
   option.add_options()
-    ("db", value<string>(), "棋譜データベース(csv)")
+    ("db", value<string>(), "棋譜データベース(csv or ConvertGameRecordDBで変換したバイナリ形式)")
     ("line", "直線近傍によるパターン判定テスト(長連/四々/見かけの三々)")
     ("dbl-three", "三々判定テスト")
     ("guard", "1手勝ちの防手テスト")
+    ("thread", value<size_t>()->default_value(1), "チェックのスレッド数")
+    ("time", value<SearchCounter>()->default_value(0), "チェック時間の上限(ms, 0: 無制限)")
     ("help,h", "ヘルプを表示");
   
   variables_map arg_map;
@@ -40,62 +42,88 @@ int main(int argc, char* argv[])
 
   cerr << "Read game_record DB: " << diagram_db_file << endl;
 
-  map<string, StringVector> diagram_db;
-  ReadCSV(diagram_db_file, &diagram_db);
+  GameRecordDB game_record_db;
 
-  const auto record_string_list = diagram_db["game_record"];
-  const auto record_count = record_string_list.size();
+  if(!game_record_db.Load(diagram_db_file)){
+    cerr << "Failed to read game_record DB: " << diagram_db_file << endl;
+    return 1;
+  }
+
+  const auto record_count = game_record_db.size();
   cerr << "Game count: " << record_count << endl;
 
+  // 着手前の異なる局面をスレッド数によらず棋譜DBの順に集計する
+  const size_t thread_num = max<size_t>(1, arg_map["thread"].as<size_t>());
+  SharedSearchManager search_manager(thread_num, false);
+  search_manager.SetSearchTimeLimit(arg_map["time"].as<SearchCounter>());
+  search_manager.SearchStart();
+
+  GameRecordDBTraverser traverser(game_record_db, thread_num, kUpdateAllOpenState);
+  traverser.SetUniquePosition(true);
+  traverser.SetEndPosition(false);
+  traverser.SetSearchManager(&search_manager);
+
+  bool is_completed = true;
+
   // LineNeighborhood::ForbiddenCheckの影響領域チェック
   if(arg_map.count("line")){
     cerr << "LineNeighborhood::ForbiddenCheck" << endl;
-    LineNeighborhoodForbiddenTest(record_string_list);
+    is_completed &= LineNeighborhoodForbiddenTest(&traverser);
   }
   
   // 三々のチェック
   if(arg_map.count("dbl-three")){
     cerr << "BitBoard::IsForbiddenMove" << endl;
-    DoubleThreeTest(record_string_list);
+    is_completed &= DoubleThreeTest(&traverser);
   }
 
   if(arg_map.count("guard")){
     cerr << "Board::GetTerminateGuard" << endl;
-    GetTerminateGuardTest(record_string_list);
+    is_completed &= GetTerminateGuardTest(&traverser);
+  }
+
+  cerr << "Time(ms): " << search_manager.GetSearchTime() << endl;
+
+  if(!is_completed){
+    cerr << "Interrupted: checked " << traverser.GetProcessedGameCount() << " / " << record_count << " games" << endl;
   }
 
   return 0;
 }
 
-void LineNeighborhoodForbiddenTest(const realcore::StringVector &record_string_list)
+void ReduceInfluenceAreaCheckResult(InfluenceAreaCheckResult * const check_result, const InfluenceAreaCheckResult &chunk_result)
 {
-  map<string, SearchCounter> line_neighborhood_forbidden_check;
-  set<HashValue> checked_board;
-  const auto record_count = record_string_list.size();
-
-  for(size_t i=0; i<record_count; ++i){
-    const auto& board_string = record_string_list[i];
-    MoveList board_move_sequence(board_string);
-    MoveList board_move;
-
-    for(const auto move : board_move_sequence){
-      if(board_move.IsBlackTurn()){
-        const auto hash_value = CalcHashValue(board_move);
-
-        if(checked_board.find(hash_value) == checked_board.end()){
-          LineNeighborhoodForbiddenCheck(board_move, &line_neighborhood_forbidden_check);
-          checked_board.insert(hash_value);
-        }
-      }
-
-      board_move += move;
-    }
+  assert(check_result != nullptr);
 
-    if(i % 1000 == 0){
-      cerr << i << endl;
-    }
+  for(const auto &check_count : chunk_result.check_count){
+    check_result->check_count[check_count.first] += check_count.second;
   }
 
+  check_result->log << chunk_result.log.str();
+}
+
+template<class CheckFunction>
+const bool InfluenceAreaTest(realcore::GameRecordDBTraverser * const traverser, const CheckFunction &check_function, InfluenceAreaCheckResult * const check_result)
+{
+  assert(traverser != nullptr);
+  assert(check_result != nullptr);
+
+  const bool is_completed = traverser->ForEachPosition([&check_function](const Board &board, const GameRecordDBPosition &position, InfluenceAreaCheckResult * const chunk_result){
+    check_function(board, *position.move_list, chunk_result);
+  }, ReduceInfluenceAreaCheckResult, check_result);
+
+  cout << check_result->log.str();
+  cerr << "Checked games: " << traverser->GetProcessedGameCount() << endl;
+
+  return is_completed;
+}
+
+const bool LineNeighborhoodForbiddenTest(realcore::GameRecordDBTraverser * const traverser)
+{
+  InfluenceAreaCheckResult influence_area_check;
+  const bool is_completed = InfluenceAreaTest(traverser, LineNeighborhoodForbiddenCheck, &influence_area_check);
+  map<string, SearchCounter> &line_neighborhood_forbidden_check = influence_area_check.check_count;
+
   // LineNeighborhood::ForbiddenCheckの影響領域チェック結果
   cerr << "kForbiddenMove:" << endl;
   cerr << "  Exact: " << line_neighborhood_forbidden_check[kCheckExactForbidden] << endl;
@@ -109,9 +137,11 @@ void LineNeighborhoodForbiddenTest(const realcore::StringVector &record_string_l
   cerr << "  Exact: " << line_neighborhood_forbidden_check[kCheckExactNonForbidden] << endl;
   cerr << "  Calc: " << line_neighborhood_forbidden_check[kCheckCalcNonForbidden] << endl;
   cerr << "  Calc/Exact: " << 1.0 * line_neighborhood_forbidden_check[kCheckCalcNonForbidden] / line_neighborhood_forbidden_check[kCheckExactNonForbidden] << endl;
+
+  return is_completed;
 }
 
-void LineNeighborhoodForbiddenCheck(const realcore::MoveList &board_sequence, std::map<std::string, realcore::SearchCounter> *check_result)
+void LineNeighborhoodForbiddenCheck(const realcore::Board &, const realcore::MoveList &board_sequence, InfluenceAreaCheckResult * const check_result)
 {
   const bool is_black_turn = board_sequence.IsBlackTurn();
 
@@ -201,51 +231,28 @@ void LineNeighborhoodForbiddenCheck(const realcore::MoveList &board_sequence, st
       MoveList influence_move, exact_influence_move;
       GetMoveList(influence_area, &influence_move);
       GetMoveList(exact_influence_area, &exact_influence_move);
-      cout << "[Not Include]board: " << board_sequence.str() << " , Move: " << MoveString(move) << ", ";
-      cout << "exact: " << exact_influence_move.str() << " , calc: " << influence_move.str() << endl;
+      check_result->log << "[Not Include]board: " << board_sequence.str() << " , Move: " << MoveString(move) << ", ";
+      check_result->log << "exact: " << exact_influence_move.str() << " , calc: " << influence_move.str() << endl;
     }
 
     if(forbidden_state == kForbiddenMove){
-      (*check_result)[kCheckExactForbidden] += exact_influence_area.count();
-      (*check_result)[kCheckCalcForbidden] += influence_area.count();
+      check_result->check_count[kCheckExactForbidden] += exact_influence_area.count();
+      check_result->check_count[kCheckCalcForbidden] += influence_area.count();
     }else if(forbidden_state == kPossibleForbiddenMove){
-      (*check_result)[kCheckExactPossibleForbidden] += exact_influence_area.count();
-      (*check_result)[kCheckCalcPossibleForbidden] += influence_area.count();
+      check_result->check_count[kCheckExactPossibleForbidden] += exact_influence_area.count();
+      check_result->check_count[kCheckCalcPossibleForbidden] += influence_area.count();
     }else{
-      (*check_result)[kCheckExactNonForbidden] += exact_influence_area.count();
-      (*check_result)[kCheckCalcNonForbidden] += influence_area.count();
+      check_result->check_count[kCheckExactNonForbidden] += exact_influence_area.count();
+      check_result->check_count[kCheckCalcNonForbidden] += influence_area.count();
     }
   }
 }
 
-void DoubleThreeTest(const realcore::StringVector &record_string_list)
+const bool DoubleThreeTest(realcore::GameRecordDBTraverser * const traverser)
 {
-  map<string, SearchCounter> double_three_forbidden_check;
-  set<HashValue> checked_board;
-  const auto record_count = record_string_list.size();
-
-  for(size_t i=0; i<record_count; ++i){
-    const auto& board_string = record_string_list[i];
-    MoveList board_move_sequence(board_string);
-    MoveList board_move;
-
-    for(const auto move : board_move_sequence){
-      if(board_move.IsBlackTurn()){
-        const auto hash_value = CalcHashValue(board_move);
-
-        if(checked_board.find(hash_value) == checked_board.end()){
-          DoubleThreeCheck(board_move, &double_three_forbidden_check);
-          checked_board.insert(hash_value);
-        }
-      }
-
-      board_move += move;
-    }
-
-    if(i % 1000 == 0){
-      cerr << i << endl;
-    }
-  }
+  InfluenceAreaCheckResult influence_area_check;
+  const bool is_completed = InfluenceAreaTest(traverser, DoubleThreeCheck, &influence_area_check);
+  map<string, SearchCounter> &double_three_forbidden_check = influence_area_check.check_count;
 
   // BitBoard::IsForbiddenMoveの影響領域チェック結果
   cerr << "DoubleThree(black):" << endl;
@@ -265,9 +272,11 @@ void DoubleThreeTest(const realcore::StringVector &record_string_list)
   cerr << "  Exact: " << double_three_forbidden_check[kExactCheckNonDoubleThreeWhite] << endl;
   cerr << "  Calc: " << double_three_forbidden_check[kCalcCheckNonDoubleThreeWhite] << endl;
   cerr << "  Calc/Exact: " << 1.0 * double_three_forbidden_check[kCalcCheckNonDoubleThreeWhite] / double_three_forbidden_check[kExactCheckNonDoubleThreeWhite] << endl;
+
+  return is_completed;
 }
 
-void DoubleThreeCheck(const realcore::MoveList &board_sequence, std::map<std::string, realcore::SearchCounter> *check_result)
+void DoubleThreeCheck(const realcore::Board &, const realcore::MoveList &board_sequence, InfluenceAreaCheckResult * const check_result)
 {
   const bool is_black_turn = board_sequence.IsBlackTurn();
 
@@ -336,29 +345,29 @@ void DoubleThreeCheck(const realcore::MoveList &board_sequence, std::map<std::st
       MoveList influence_move, exact_influence_move;
       GetMoveList(black_influence_area, &influence_move);
       GetMoveList(black_exact_influence_area, &exact_influence_move);
-      cout << "[Not Include(black)]board: " << board_sequence.str() << " , Move: " << MoveString(move) << ", ";
-      cout << "exact: " << exact_influence_move.str() << " , calc: " << influence_move.str() << endl;
+      check_result->log << "[Not Include(black)]board: " << board_sequence.str() << " , Move: " << MoveString(move) << ", ";
+      check_result->log << "exact: " << exact_influence_move.str() << " , calc: " << influence_move.str() << endl;
     }
 
     if(!is_white_include){
       MoveList influence_move, exact_influence_move;
       GetMoveList(white_influence_area, &influence_move);
       GetMoveList(white_exact_influence_area, &exact_influence_move);
-      cout << "[Not Include(white)]board: " << board_sequence.str() << " , Move: " << MoveString(move) << ", ";
-      cout << "exact: " << exact_influence_move.str() << " , calc: " << influence_move.str() << endl;
+      check_result->log << "[Not Include(white)]board: " << board_sequence.str() << " , Move: " << MoveString(move) << ", ";
+      check_result->log << "exact: " << exact_influence_move.str() << " , calc: " << influence_move.str() << endl;
     }
 
     const auto black_exact_label = is_forbidden ? kExactCheckDoubleThreeBlack : kExactCheckNonDoubleThreeBlack;
     const auto black_calc_label = is_forbidden ? kCalcCheckDoubleThreeBlack : kCalcCheckNonDoubleThreeBlack;
 
-    (*check_result)[black_exact_label] += black_exact_influence_area.count();
-    (*check_result)[black_calc_label] += black_influence_area.count();
+    check_result->check_count[black_exact_label] += black_exact_influence_area.count();
+    check_result->check_count[black_calc_label] += black_influence_area.count();
 
     const auto white_exact_label = is_forbidden ? kExactCheckDoubleThreeWhite : kExactCheckNonDoubleThreeWhite;
     const auto white_calc_label = is_forbidden ? kCalcCheckDoubleThreeWhite : kCalcCheckNonDoubleThreeWhite;
 
-    (*check_result)[white_exact_label] += white_exact_influence_area.count();
-    (*check_result)[white_calc_label] += white_influence_area.count();
+    check_result->check_count[white_exact_label] += white_exact_influence_area.count();
+    check_result->check_count[white_calc_label] += white_influence_area.count();
 
     // 差分領域のチェック
     const auto black_diff_area = black_influence_area ^ black_exact_influence_area;
@@ -366,8 +375,8 @@ void DoubleThreeCheck(const realcore::MoveList &board_sequence, std::map<std::st
     if(!is_forbidden && black_diff_area.count() >= 7){
       MoveList diff_move;
       GetMoveList(black_diff_area, &diff_move);
-      cout << "[Diff(black)]board: " << board_sequence.str() << " , Move: " << MoveString(move) << ", ";
-      cout << "diff: " << diff_move.str() << endl;
+      check_result->log << "[Diff(black)]board: " << board_sequence.str() << " , Move: " << MoveString(move) << ", ";
+      check_result->log << "diff: " << diff_move.str() << endl;
     }
 
     const auto white_diff_area = white_influence_area ^ white_exact_influence_area;
@@ -375,49 +384,30 @@ void DoubleThreeCheck(const realcore::MoveList &board_sequence, std::map<std::st
     if(!is_forbidden && white_diff_area.count() >= 7){
       MoveList diff_move;
       GetMoveList(white_diff_area, &diff_move);
-      cout << "[Diff(white)]board: " << board_sequence.str() << " , Move: " << MoveString(move) << ", ";
-      cout << "diff: " << diff_move.str() << endl;
+      check_result->log << "[Diff(white)]board: " << board_sequence.str() << " , Move: " << MoveString(move) << ", ";
+      check_result->log << "diff: " << diff_move.str() << endl;
     }
   }
 }
 
-void GetTerminateGuardTest(const realcore::StringVector &record_string_list)
+const bool GetTerminateGuardTest(realcore::GameRecordDBTraverser * const traverser)
 {
-  map<string, SearchCounter> check_result;
-  set<HashValue> checked_board;
-  const auto record_count = record_string_list.size();
-
-  for(size_t i=0; i<record_count; ++i){
-    const auto& board_string = record_string_list[i];
-    MoveList board_move_sequence(board_string);
-    MoveList board_move;
-
-    for(const auto move : board_move_sequence){
-      const auto hash_value = CalcHashValue(board_move);
-
-      if(checked_board.find(hash_value) == checked_board.end()){
-        GetTerminateGuardCheck(board_move, &check_result);
-        checked_board.insert(hash_value);
-      }
-
-      board_move += move;
-    }
-
-    if(i % 1000 == 0){
-      cerr << i << endl;
-    }
-  }
+  InfluenceAreaCheckResult influence_area_check;
+  const bool is_completed = InfluenceAreaTest(traverser, GetTerminateGuardCheck, &influence_area_check);
+  map<string, SearchCounter> &check_result = influence_area_check.check_count;
 
   // Board::GetTerminateGuardの影響領域チェック結果
   cerr << "GetTerminateGuard:" << endl;
   cerr << "  Exact: " << check_result[kExactCheckTerminateGuard] << endl;
   cerr << "  Calc: " << check_result[kCalcCheckTerminateGuard] << endl;
   cerr << "  Calc/Exact: " << 1.0 * check_result[kCalcCheckTerminateGuard] / check_result[kExactCheckTerminateGuard] << endl;
+
+  return is_completed;
 }
 
-void GetTerminateGuardCheck(const realcore::MoveList &board_sequence, std::map<std::string, realcore::SearchCounter> *check_result)
+void GetTerminateGuardCheck(const realcore::Board &visit_board, const realcore::MoveList &board_sequence, InfluenceAreaCheckResult * const check_result)
 {
-  Board board(board_sequence);
+  Board board(visit_board);
 
   MovePosition terminating_move;
   
@@ -445,7 +435,7 @@ void GetTerminateGuardCheck(const realcore::MoveList &board_sequence, std::map<s
       MoveList guard_move;
       GetMoveList(guard_move_bit, &guard_move);
 
-      cout << "[Guard move on non-threat]board: " << board_sequence.str() << " , guard: " << guard_move.str() << endl;
+      check_result->log << "[Guard move on non-threat]board: " << board_sequence.str() << " , guard: " << guard_move.str() << endl;
     }
 
     return;
@@ -481,12 +471,12 @@ void GetTerminateGuardCheck(const realcore::MoveList &board_sequence, std::map<s
     GetMoveList(guard_move_bit, &guard_move);
     GetMoveList(exact_guard_bit, &exact_guard_move);
     
-    cout << "[Not Include]board: " << board_sequence.str() << " , ";
-    cout << "exact: " << exact_guard_move.str() << " , calc: " << guard_move.str() << endl;
+    check_result->log << "[Not Include]board: " << board_sequence.str() << " , ";
+    check_result->log << "exact: " << exact_guard_move.str() << " , calc: " << guard_move.str() << endl;
   }
 
-  (*check_result)[kExactCheckTerminateGuard] += exact_guard_bit.count();
-  (*check_result)[kCalcCheckTerminateGuard] += guard_move_bit.count();
+  check_result->check_count[kExactCheckTerminateGuard] += exact_guard_bit.count();
+  check_result->check_count[kCalcCheckTerminateGuard] += guard_move_bit.count();
 
   // 差分領域のチェック
   const auto diff_area = guard_move_bit ^ exact_guard_bit;
@@ -494,7 +484,7 @@ void GetTerminateGuardCheck(const realcore::MoveList &board_sequence, std::map<s
   if(diff_area.count() >= 5){
     MoveList diff_move;
     GetMoveList(diff_area, &diff_move);
-    cout << "[Diff]board: " << board_sequence.str() << " , ";
-    cout << "diff: " << diff_move.str() << endl;
+    check_result->log << "[Diff]board: " << board_sequence.str() << " , ";
+    check_result->log << "diff: " << diff_move.str() << endl;
   }
 }
@@ -2,12 +2,30 @@
 #define INFLUENCE_AREA_CHECK_H
 
 #include <string>
+#include <sstream>
 #include <map>
 
 #include "MoveList.h"
 #include "Board.h"
 #include "SearchManager.h"
-#include "CSVReader.h"
+#include "GameRecordDB.h"
+#include "GameRecordDBTraverser.h"
+
+//! @brief 影響領域チェックの集計結果
+struct InfluenceAreaCheckResult
+{
+  std::map<std::string, realcore::SearchCounter> check_count;   //!< 影響領域のサイズの集計
+  std::ostringstream log;    //!< 影響領域の不整合などの出力
+};
+
+//! @brief チャンクの集計結果を統合する
+void ReduceInfluenceAreaCheckResult(InfluenceAreaCheckResult * const check_result, const InfluenceAreaCheckResult &chunk_result);
+
+//! @brief 棋譜DBの異なる局面ごとに影響領域をチェックする
+//! @param check_function 局面ごとに(const Board&, const MoveList&, InfluenceAreaCheckResult * const)で呼び出す関数
+//! @retval false 走査が中断された
+template<class CheckFunction>
+const bool InfluenceAreaTest(realcore::GameRecordDBTraverser * const traverser, const CheckFunction &check_function, InfluenceAreaCheckResult * const check_result);
 
 static const std::string kCheckExactForbidden = "ExactForbidden";                   // 戻り値がkForbiddenMove時の正確な影響領域
 static const std::string kCheckExactPossibleForbidden = "ExactPossibleForbidden";   // 戻り値がkPossibleForbiddenMove時の正確な影響領域
@@ -17,8 +35,8 @@ static const std::string kCheckCalcForbidden = "CalcForbidden";
 static const std::string kCheckCalcPossibleForbidden = "CalcPossibleForbidden";   // 戻り値がkPossibleForbiddenMove時の算出した影響領域
 static const std::string kCheckCalcNonForbidden = "CalcNonForbidden";             // 戻り値がkNonForbiddenMove時の算出した影響領域
 
-void LineNeighborhoodForbiddenCheck(const realcore::MoveList &board_sequence, std::map<std::string, realcore::SearchCounter> *check_result);
-void LineNeighborhoodForbiddenTest(const realcore::StringVector &record_string_list);
+void LineNeighborhoodForbiddenCheck(const realcore::Board &board, const realcore::MoveList &board_sequence, InfluenceAreaCheckResult * const check_result);
+const bool LineNeighborhoodForbiddenTest(realcore::GameRecordDBTraverser * const traverser);
 
 static const std::string kExactCheckDoubleThreeBlack = "ExactCheckDoubleThreeBlack";
 static const std::string kExactCheckNonDoubleThreeBlack = "ExactCheckNonDoubleThreeBlack";
@@ -30,13 +48,13 @@ static const std::string kExactCheckNonDoubleThreeWhite = "ExactCheckNonDoubleTh
 static const std::string kCalcCheckDoubleThreeWhite = "CalcCheckDoubleThreeWhite";
 static const std::string kCalcCheckNonDoubleThreeWhite = "CalcCheckNonDoubleThreeWhite";
 
-void DoubleThreeCheck(const realcore::MoveList &board_sequence, std::map<std::string, realcore::SearchCounter> *check_result);
-void DoubleThreeTest(const realcore::StringVector &record_string_list);
+void DoubleThreeCheck(const realcore::Board &board, const realcore::MoveList &board_sequence, InfluenceAreaCheckResult * const check_result);
+const bool DoubleThreeTest(realcore::GameRecordDBTraverser * const traverser);
 
 static const std::string kExactCheckTerminateGuard = "ExactCheckTerminateGuard";
 static const std::string kCalcCheckTerminateGuard = "CalcCheckTerminateGuard";
 
-void GetTerminateGuardCheck(const realcore::MoveList &board_sequence, std::map<std::string, realcore::SearchCounter> *check_result);
-void GetTerminateGuardTest(const realcore::StringVector &record_string_list);
+void GetTerminateGuardCheck(const realcore::Board &board, const realcore::MoveList &board_sequence, InfluenceAreaCheckResult * const check_result);
+const bool GetTerminateGuardTest(realcore::GameRecordDBTraverser * const traverser);
 
 #endif
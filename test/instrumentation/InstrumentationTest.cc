@@ -0,0 +1,214 @@
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "MoveList.h"
+#include "Board.h"
+#include "HashTable.h"
+#include "Instrumentation.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+typedef struct structInstrumentationTestData
+{
+  structInstrumentationTestData()
+  : hash_value(0), logic_counter(0)
+  {}
+
+  HashValue hash_value;
+  TableLogicCounter logic_counter;
+}InstrumentationTestData;
+
+class InstrumentationTest
+: public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    GetThreadInstrumentation().clear();
+  }
+
+  void DefaultConstructorTest()
+  {
+    InstrumentationSnapshot snapshot;
+
+    for(const auto &statistics : snapshot.statistics_list_){
+      ASSERT_EQ(0, statistics.count);
+      ASSERT_EQ(0, statistics.total_cycle);
+      ASSERT_EQ(0, statistics.max_cycle);
+
+      for(const auto bin_count : statistics.cycle_histogram){
+        ASSERT_EQ(0, bin_count);
+      }
+    }
+  }
+};
+
+TEST_F(InstrumentationTest, EnabledTest)
+{
+  ASSERT_TRUE(kInstrumentationEnabled);
+}
+
+TEST_F(InstrumentationTest, DefaultConstructorTest)
+{
+  DefaultConstructorTest();
+}
+
+TEST_F(InstrumentationTest, GetCycleHistogramBinTest)
+{
+  ASSERT_EQ(0, GetCycleHistogramBin(0));
+  ASSERT_EQ(0, GetCycleHistogramBin(1));
+  ASSERT_EQ(1, GetCycleHistogramBin(2));
+  ASSERT_EQ(1, GetCycleHistogramBin(3));
+  ASSERT_EQ(2, GetCycleHistogramBin(4));
+  ASSERT_EQ(10, GetCycleHistogramBin(1024));
+  ASSERT_EQ(kCycleHistogramBinNum - 1, GetCycleHistogramBin(1ULL << 40));
+}
+
+TEST_F(InstrumentationTest, AddCycleTest)
+{
+  InstrumentationSnapshot snapshot;
+
+  snapshot.AddCycle(kInstrumentMakeMove, 100);
+  snapshot.AddCycle(kInstrumentMakeMove, 300);
+  snapshot.AddCount(kInstrumentHashTableProbe);
+
+  const auto &statistics = snapshot.GetStatistics(kInstrumentMakeMove);
+  ASSERT_EQ(2, statistics.count);
+  ASSERT_EQ(400, statistics.total_cycle);
+  ASSERT_EQ(300, statistics.max_cycle);
+  ASSERT_EQ(1, statistics.cycle_histogram[6]);    // 100: [64, 128)
+  ASSERT_EQ(1, statistics.cycle_histogram[8]);    // 300: [256, 512)
+
+  ASSERT_EQ(1, snapshot.GetStatistics(kInstrumentHashTableProbe).count);
+  ASSERT_EQ(0, snapshot.GetStatistics(kInstrumentHashTableProbe).total_cycle);
+  ASSERT_EQ(0, snapshot.GetStatistics(kInstrumentUndoMove).count);
+
+  snapshot.clear();
+  ASSERT_EQ(0, snapshot.GetStatistics(kInstrumentMakeMove).count);
+}
+
+TEST_F(InstrumentationTest, MergeTest)
+{
+  InstrumentationSnapshot snapshot_1, snapshot_2;
+
+  snapshot_1.AddCycle(kInstrumentUndoMove, 10);
+  snapshot_2.AddCycle(kInstrumentUndoMove, 20);
+  snapshot_2.AddCount(kInstrumentHashTableHit);
+
+  snapshot_1.Merge(snapshot_2);
+
+  const auto &statistics = snapshot_1.GetStatistics(kInstrumentUndoMove);
+  ASSERT_EQ(2, statistics.count);
+  ASSERT_EQ(30, statistics.total_cycle);
+  ASSERT_EQ(20, statistics.max_cycle);
+  ASSERT_EQ(1, statistics.cycle_histogram[3]);
+  ASSERT_EQ(1, statistics.cycle_histogram[4]);
+  ASSERT_EQ(1, snapshot_1.GetStatistics(kInstrumentHashTableHit).count);
+}
+
+TEST_F(InstrumentationTest, ScopedOperationTimerTest)
+{
+  {
+    ScopedOperationTimer<kInstrumentIsForbiddenMove> operation_timer;
+  }
+  {
+    ScopedOperationTimer<kInstrumentIsForbiddenMove> operation_timer;
+  }
+
+  CountOperation<kInstrumentHashTableProbe>();
+
+  const auto &snapshot = GetThreadInstrumentation();
+  ASSERT_EQ(2, snapshot.GetStatistics(kInstrumentIsForbiddenMove).count);
+  ASSERT_EQ(1, snapshot.GetStatistics(kInstrumentHashTableProbe).count);
+
+  // 計測結果はスレッドごとに保持する
+  thread other_thread([](){
+    ASSERT_EQ(0, GetThreadInstrumentation().GetStatistics(kInstrumentIsForbiddenMove).count);
+  });
+
+  other_thread.join();
+}
+
+TEST_F(InstrumentationTest, BoardOperationTest)
+{
+  Board board(MoveList("hhhgig"));
+  GetThreadInstrumentation().clear();
+
+  board.MakeMove(kMoveGG);
+  board.MakeMove(kMoveJF);
+  board.UndoMove();
+
+  MoveBitSet four_move_set;
+  board.EnumerateFourMoves<kBlackTurn>(&four_move_set);
+
+  // MakeMove内の正規手チェック(assert)でも禁手判定が行われるため呼出前後の差で確認する
+  const auto &snapshot = GetThreadInstrumentation();
+  const auto forbidden_check_count = snapshot.GetStatistics(kInstrumentIsForbiddenMove).count;
+
+  const BitBoard bit_board(MoveList("hhhgig"));
+  bit_board.IsForbiddenMove<kBlackTurn>(kMoveJJ);
+
+  ASSERT_EQ(2, snapshot.GetStatistics(kInstrumentMakeMove).count);
+  ASSERT_EQ(1, snapshot.GetStatistics(kInstrumentUndoMove).count);
+  ASSERT_EQ(2, snapshot.GetStatistics(kInstrumentBoardOpenState).count);
+  ASSERT_EQ(1, snapshot.GetStatistics(kInstrumentEnumerateFourMoves).count);
+  ASSERT_EQ(forbidden_check_count + 1, snapshot.GetStatistics(kInstrumentIsForbiddenMove).count);
+  ASSERT_LT(0, snapshot.GetStatistics(kInstrumentMakeMove).total_cycle);
+}
+
+TEST_F(InstrumentationTest, HashTableTest)
+{
+  HashTable<InstrumentationTestData> hash_table(1, kLockFree);
+
+  InstrumentationTestData data;
+  data.hash_value = 1;
+  hash_table.Upsert(1, data);
+
+  InstrumentationTestData find_data;
+  hash_table.find(1, &find_data);
+  hash_table.find(2, &find_data);
+
+  const auto &snapshot = GetThreadInstrumentation();
+  ASSERT_EQ(2, snapshot.GetStatistics(kInstrumentHashTableProbe).count);
+  ASSERT_EQ(1, snapshot.GetStatistics(kInstrumentHashTableHit).count);
+}
+
+TEST_F(InstrumentationTest, GetJSONTest)
+{
+  InstrumentationSnapshot snapshot;
+  snapshot.AddCycle(kInstrumentMakeMove, 3);
+
+  const string json = snapshot.GetJSON();
+
+  ASSERT_EQ(0, json.find("{\"enabled\":true,\"cycle_unit\":\""));
+  ASSERT_NE(string::npos, json.find("{\"name\":\"MakeMove\",\"count\":1,\"total_cycle\":3,\"max_cycle\":3,\"cycle_histogram\":[0,1,0,"));
+  ASSERT_NE(string::npos, json.find("{\"name\":\"EnumerateFourMoves\",\"count\":0,"));
+  ASSERT_EQ("]}]}", json.substr(json.size() - 4));
+}
+
+TEST_F(InstrumentationTest, GetCSVTest)
+{
+  InstrumentationSnapshot snapshot;
+  snapshot.AddCycle(kInstrumentUndoMove, 1);
+
+  const string csv = snapshot.GetCSV();
+
+  ASSERT_EQ(0, csv.find("operation,count,total_cycle,max_cycle,bin_0,bin_1,"));
+  ASSERT_NE(string::npos, csv.find("\nMakeMove,0,0,0,0,"));
+  ASSERT_NE(string::npos, csv.find("\nUndoMove,1,1,1,1,0,"));
+
+  size_t line_count = 0;
+
+  for(const auto c : csv){
+    line_count += (c == '\n');
+  }
+
+  ASSERT_EQ(kInstrumentOperationNum + 1, line_count);
+}
+
+}   // namespace realcore
@@ -221,6 +221,35 @@ public:
     ASSERT_EQ(local_bit_board[0], line_neighborhood.local_bit_board_[0]);
     ASSERT_EQ(local_bit_board[1], line_neighborhood.local_bit_board_[1]);
   }
+
+  //! @brief Create<N>の直線近傍がGetLineNeighborhoodStateBit<N>を結合した値と一致するかチェックする
+  template<size_t N>
+  void CreateTest(const BitBoard &bit_board){
+    for(const auto move : GetAllMove()){
+      std::array<StateBit, kBoardDirectionNum> line_neighborhood_list;
+      bit_board.GetLineNeighborhoodStateBit<N>(move, &line_neighborhood_list);
+
+      const StateBit expect_bit_0 = line_neighborhood_list[kLateralDirection] | (line_neighborhood_list[kVerticalDirection] << 32ULL);
+      const StateBit expect_bit_1 = line_neighborhood_list[kLeftDiagonalDirection] | (line_neighborhood_list[kRightDiagonalDirection] << 32ULL);
+
+      const auto line_neighborhood = LineNeighborhood::Create<N>(move, bit_board);
+
+      ASSERT_EQ(expect_bit_0, line_neighborhood.local_bit_board_[0]);
+      ASSERT_EQ(expect_bit_1, line_neighborhood.local_bit_board_[1]);
+      ASSERT_EQ(move, line_neighborhood.move_);
+      ASSERT_EQ(N, line_neighborhood.distance_);
+
+      if(!IsInBoardMove(move)){
+        continue;
+      }
+
+      // 実行時に長さを指定した場合と一致する
+      LineNeighborhood runtime_line_neighborhood(move, N, bit_board);
+
+      ASSERT_EQ(runtime_line_neighborhood.local_bit_board_[0], line_neighborhood.local_bit_board_[0]);
+      ASSERT_EQ(runtime_line_neighborhood.local_bit_board_[1], line_neighborhood.local_bit_board_[1]);
+    }
+  }
 };
 
 TEST_F(LineNeighborhoodTest, ForbiddenCheckTest)
@@ -425,4 +454,18 @@ TEST_F(LineNeighborhoodTest, GetLocalBitBoardTest)
   GetLocalBitBoardTest();
 }
 
+TEST_F(LineNeighborhoodTest, CreateTest)
+{
+  MoveList board_list("hhhggghiighffhefgfejifkfjhkjegeleiglekilgeklgkcfiecjikdckgfckijckklcddmffdmjhdbhhlgnjdinldnhfmeahmeojmkahnko");
+  BitBoard bit_board(board_list);
+
+  CreateTest<1>(bit_board);
+  CreateTest<2>(bit_board);
+  CreateTest<3>(bit_board);
+  CreateTest<4>(bit_board);
+  CreateTest<5>(bit_board);
+  CreateTest<6>(bit_board);
+  CreateTest<7>(bit_board);
+}
+
 }   // namespace realcore
@@ -0,0 +1,178 @@
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "MoveDAG.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+class MoveDAGBaseTest
+: public ::testing::Test
+{
+public:
+  void DefaultConstructorTest(){
+    MoveDAG move_dag;
+
+    ASSERT_EQ(1, move_dag.node_list_.size());
+    ASSERT_TRUE(move_dag.edge_list_.empty());
+    ASSERT_TRUE(move_dag.empty());
+
+    const auto &root_node = move_dag.node_list_[kRootDAGNodeIndex];
+    EXPECT_EQ(CalcHashValue(MoveList()), root_node.hash_value);
+    EXPECT_EQ(kNullDAGEdgeIndex, root_node.first_edge_index);
+    EXPECT_TRUE(root_node.is_black_turn);
+  }
+
+  void RootMoveSequenceTest(){
+    const MoveList root_move_sequence("hhhipp");
+    MoveDAG move_dag(root_move_sequence);
+
+    const auto &root_node = move_dag.node_list_[kRootDAGNodeIndex];
+    EXPECT_EQ(CalcHashValue(root_move_sequence), root_node.hash_value);
+    EXPECT_FALSE(root_node.is_black_turn);
+    EXPECT_EQ(1, root_node.black_pass_count);
+    EXPECT_EQ(0, root_node.white_pass_count);
+
+    // パスを含む手順も手順全体のHash値と一致する
+    MoveTree move_tree;
+    move_tree.AddChild(MoveList("ppiippjj"));
+    move_dag.AddTree(move_tree);
+
+    const auto node_index = move_dag.GetNodeIndex(MoveList("ppiippjj"));
+    ASSERT_NE(kNullDAGNodeIndex, node_index);
+    MoveList move_sequence(root_move_sequence);
+    move_sequence += MoveList("ppiippjj");
+    EXPECT_EQ(CalcHashValue(move_sequence), move_dag.node_list_[node_index].hash_value);
+  }
+};
+
+TEST_F(MoveDAGBaseTest, DefaultConstructorTest)
+{
+  DefaultConstructorTest();
+}
+
+TEST_F(MoveDAGBaseTest, RootMoveSequenceTest)
+{
+  RootMoveSequenceTest();
+}
+
+TEST_F(MoveDAGBaseTest, TranspositionTest)
+{
+  MoveTree move_tree;
+
+  // hh, hi, ijの順と ij, hi, hhの順は同一局面
+  move_tree.AddChild(MoveList("hhhiijkk"));
+  move_tree.AddChild(MoveList("ijhihhll"));
+  ASSERT_EQ(8, move_tree.size());
+
+  MoveDAG move_dag;
+  move_dag.AddTree(move_tree);
+
+  ASSERT_EQ(7, move_dag.size());
+  ASSERT_EQ(8, move_dag.GetEdgeCount());
+  ASSERT_EQ(10, move_dag.GetExpandedTreeSize());
+
+  ASSERT_EQ(move_dag.GetNodeIndex(MoveList("hhhiij")), move_dag.GetNodeIndex(MoveList("ijhihh")));
+  ASSERT_EQ(move_dag.GetNodeIndex(MoveList("hhhiij")), move_dag.FindNodeIndex(CalcHashValue(MoveList("ijhihh"))));
+  ASSERT_EQ(kNullDAGNodeIndex, move_dag.GetNodeIndex(MoveList("hhij")));
+
+  // 合流した局面の子ノードは両方の手順に展開される
+  ASSERT_EQ("(hhhiij(kk)(ll))(ijhihh(kk)(ll))", move_dag.str());
+
+  MoveTree expanded_tree;
+  move_dag.ExpandTree(&expanded_tree);
+  ASSERT_EQ(move_dag.GetExpandedTreeSize(), expanded_tree.size());
+  ASSERT_EQ(move_dag.GetSGFLabeledText(true), expanded_tree.GetSGFLabeledText(true));
+}
+
+TEST_F(MoveDAGBaseTest, NoTranspositionTest)
+{
+  // 合流しない探索木は展開すると元の探索木と一致する
+  MoveTree move_tree;
+
+  move_tree.AddChild(MoveList("hhhiij"));
+  move_tree.AddChild(MoveList("hhhgij"));
+  move_tree.AddChild(MoveList("hhhjpp"));
+  move_tree.AddChild(MoveList("hi"));
+
+  MoveDAG move_dag;
+  move_dag.AddTree(move_tree);
+
+  ASSERT_EQ(move_tree.size(), move_dag.size());
+  ASSERT_EQ(move_tree.size(), move_dag.GetExpandedTreeSize());
+  ASSERT_EQ(move_tree.str(), move_dag.str());
+  ASSERT_EQ(move_tree.GetSGFLabeledText(true), move_dag.GetSGFLabeledText(true));
+}
+
+TEST_F(MoveDAGBaseTest, AddSubtreeTest)
+{
+  MoveTree sub_tree;
+  sub_tree.AddChild(MoveList("iijj"));
+  sub_tree.AddChild(MoveList("ik"));
+
+  MoveDAG move_dag;
+  move_dag.AddSubtree(MoveList("hhhi"), sub_tree);
+  move_dag.AddSubtree(MoveList("hghi"), sub_tree);
+
+  ASSERT_EQ("(hhhi(iijj)(ik))(hghi(iijj)(ik))", move_dag.str());
+  ASSERT_EQ(10, move_dag.GetExpandedTreeSize());
+  ASSERT_EQ(10, move_dag.size());
+
+  // 合流する局面
+  MoveTree transposition_tree;
+  transposition_tree.AddChild(MoveList("iihihh"));
+  move_dag.AddTree(transposition_tree);
+
+  ASSERT_EQ(move_dag.GetNodeIndex(MoveList("hhhiii")), move_dag.GetNodeIndex(MoveList("iihihh")));
+  ASSERT_EQ("(hhhi(iijj)(ik))(hghi(iijj)(ik))(iihihhjj)", move_dag.str());
+
+  move_dag.clear();
+  ASSERT_TRUE(move_dag.empty());
+  ASSERT_EQ("", move_dag.str());
+}
+
+TEST_F(MoveDAGBaseTest, AdditionalDataTest)
+{
+  MoveTextTree move_tree;
+  move_tree.AddChild(MoveList("hhhiij"));
+  move_tree.AddChild(MoveList("ijhihh"));
+  move_tree.MoveChildNode(MoveList("hhhiij"));
+  move_tree.SetAdditionalData("proof");
+
+  MoveTextDAG move_dag;
+  move_dag.AddTree(move_tree);
+
+  MoveTextTree expanded_tree;
+  move_dag.ExpandTree(&expanded_tree);
+
+  ASSERT_TRUE(expanded_tree.MoveChildNode(MoveList("ijhihh")));
+  ASSERT_EQ("proof", expanded_tree.GetAdditionalData());
+}
+
+TEST_F(MoveDAGBaseTest, ValueInitializedAdditionalDataTest)
+{
+  MoveTreeBase<int> sub_tree;
+  sub_tree.AddChild(kMoveII);
+  sub_tree.MoveChildNode(kMoveII);
+  sub_tree.SetAdditionalData(1);
+
+  MoveDAGBase<int> move_dag;
+  move_dag.AddSubtree(MoveList("hhhi"), sub_tree);
+
+  // 手順上で追加したノードの付加情報は値初期化される
+  MoveTreeBase<int> expanded_tree;
+  move_dag.ExpandTree(&expanded_tree);
+
+  ASSERT_EQ(0, expanded_tree.GetAdditionalData());
+  ASSERT_TRUE(expanded_tree.MoveChildNode(kMoveHH));
+  ASSERT_EQ(0, expanded_tree.GetAdditionalData());
+  ASSERT_TRUE(expanded_tree.MoveChildNode(kMoveHI));
+  ASSERT_EQ(0, expanded_tree.GetAdditionalData());
+  ASSERT_TRUE(expanded_tree.MoveChildNode(kMoveII));
+  ASSERT_EQ(1, expanded_tree.GetAdditionalData());
+}
+
+}   // namespace realcore
@@ -1,3 +1,7 @@
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -244,6 +248,85 @@ public:
     move_tree.MoveRootNode();
     ASSERT_TRUE(move_tree.IsRootNode());
   }
+
+  void ChildIndexTest(){
+    MoveTree move_tree(kUseChildIndex), sub_tree;
+    ASSERT_TRUE(move_tree.UseChildIndex());
+    
+    ASSERT_EQ(kNullNodeIndex, move_tree.GetChildNodeIndex(kMoveHH));
+
+    move_tree.AddChild(kMoveHH);
+    move_tree.AddChild(kMoveHI);
+    move_tree.AddChild(kMoveHH);    // 登録済の手は追加されない
+
+    ASSERT_EQ(2, move_tree.size());
+    ASSERT_EQ(1, move_tree.GetChildNodeIndex(kMoveHH));
+    ASSERT_EQ(2, move_tree.GetChildNodeIndex(kMoveHI));
+    ASSERT_EQ(2, move_tree.GetYoungestChildNodeIndex());
+    
+    sub_tree.AddChild(kMoveHG);
+    sub_tree.AddChild(kMoveIG);
+    sub_tree.MoveChildNode(kMoveIG);
+    sub_tree.AddChild(kMoveII);
+    
+    ASSERT_TRUE(move_tree.MoveChildNode(kMoveHH));
+    move_tree.AddSubtree(sub_tree);
+    ASSERT_EQ(5, move_tree.size());
+    ASSERT_EQ(4, move_tree.GetYoungestChildNodeIndex());
+
+    move_tree.MoveRootNode();
+    ASSERT_TRUE(move_tree.MoveChildNode(MoveList("hhigii")));
+    ASSERT_EQ(5, move_tree.current_node_index_);
+    ASSERT_EQ("(hh(hg)(igii))(hi)", move_tree.str());
+
+    move_tree.clear();
+    ASSERT_EQ(kNullNodeIndex, move_tree.GetChildNodeIndex(kMoveHH));
+    ASSERT_TRUE(move_tree.child_index_.empty());
+  }
+
+  void CompactNodeLayoutTest(){
+    for(const auto use_child_index : {kNoChildIndex, kUseChildIndex}){
+      MoveTree move_tree(use_child_index);
+
+      move_tree.AddChild(MoveList("hhhgii"));
+      move_tree.AddChild(MoveList("hhhigg"));
+      move_tree.AddChild(MoveList("hiii"));
+      move_tree.AddChild(MoveList("hhhj"));
+      move_tree.MoveChildNode(MoveList("hhhi"));
+
+      const auto tree_str = move_tree.str();
+      const auto tree_size = move_tree.size();
+      ASSERT_EQ("(hh(hgii)(higg)(hj))(hiii)", tree_str);
+
+      move_tree.CompactNodeLayout();
+
+      ASSERT_EQ(tree_str, move_tree.str());
+      ASSERT_EQ(tree_size, move_tree.size());
+
+      // 兄弟ノードが連続領域に並ぶ
+      const auto &root_node = move_tree.tree_[kRootNodeIndex];
+      ASSERT_EQ(1, root_node.GetFirstChildIndex());
+      ASSERT_EQ(2, move_tree.tree_[1].GetNextSiblingIndex());
+      ASSERT_EQ(3, move_tree.tree_[1].GetFirstChildIndex());
+      ASSERT_EQ(4, move_tree.tree_[3].GetNextSiblingIndex());
+      ASSERT_EQ(5, move_tree.tree_[4].GetNextSiblingIndex());
+
+      // カレントノードは同一ノードを指す
+      MoveList move_list;
+      move_tree.GetMoveList(&move_list);
+      ASSERT_EQ(MoveList("hhhi"), move_list);
+
+      // 再配置後も子ノードの追加・探索ができる
+      move_tree.AddChild(kMoveOO);
+      ASSERT_EQ(4, move_tree.current_node_index_);
+      ASSERT_EQ(9, move_tree.GetYoungestChildNodeIndex());
+      ASSERT_EQ("(hh(hgii)(hi(gg)(oo))(hj))(hiii)", move_tree.str());
+      
+      move_tree.MoveRootNode();
+      ASSERT_TRUE(move_tree.MoveChildNode(MoveList("hhhioo")));
+      ASSERT_EQ(9, move_tree.current_node_index_);
+    }
+  }
 };
 
 TEST_F(MoveTreeBaseTest, DefaultConstructorTest)
@@ -368,6 +451,179 @@ TEST_F(MoveTreeBaseTest, GetSGFLabeledTextTest){
   ASSERT_EQ("(;LB[hh:1]B[hh];LB[hh:1][oo:2]W[oo];LB[hh:1][oo:2][tt:3]B[tt])(;LB[hi:1]B[hi])", move_tree.GetSGFLabeledText(kBlackTurn));
 }
 
+TEST_F(MoveTreeBaseTest, WriteStrTest){
+  MoveTree move_tree;
+  mt19937 random_engine(0);
+  uniform_int_distribution<int> move_distribution(0, 8);
+
+  // 共通の手順の後に分岐する探索木
+  move_tree.AddChild(MoveList("hhhi"));
+  move_tree.MoveChildNode(MoveList("hhhi"));
+
+  for(size_t i=0; i<500; i++){
+    MoveList move_list;
+
+    for(size_t j=0; j<10; j++){
+      move_list += GetMove(6 + move_distribution(random_engine) % 3, 6 + move_distribution(random_engine) / 3);
+    }
+
+    move_tree.AddChild(move_list);
+  }
+
+  const auto tree_str = move_tree.str();
+  ASSERT_EQ("hhhi(", tree_str.substr(0, 5));
+
+  {
+    stringstream ss;
+    move_tree.WriteStr(ss);
+    ASSERT_EQ(tree_str, ss.str());
+  }
+  {
+    const string file_path = "move_tree_write_str.txt";
+    FILE *fp = fopen(file_path.c_str(), "w");
+    ASSERT_TRUE(fp != nullptr);
+    ASSERT_TRUE(move_tree.WriteStr(fileno(fp)));
+    fclose(fp);
+
+    ifstream ifs(file_path);
+    const string file_str((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+    ASSERT_EQ(tree_str, file_str);
+
+    remove(file_path.c_str());
+  }
+  
+  for(const size_t thread_num : {1, 2, 3, 8}){
+    ASSERT_EQ(tree_str, move_tree.GetStrParallel(thread_num));
+  }
+
+  constexpr bool kBlackTurn = true;
+  const auto sgf_text = move_tree.GetSGFLabeledText(kBlackTurn);
+  ASSERT_EQ(";LB[hh:1]B[hh];LB[hh:1][hi:2]W[hi](", sgf_text.substr(0, 35));
+
+  {
+    stringstream ss;
+    move_tree.WriteSGFLabeledText(kBlackTurn, ss);
+    ASSERT_EQ(sgf_text, ss.str());
+  }
+  {
+    const string file_path = "move_tree_write_sgf.txt";
+    FILE *fp = fopen(file_path.c_str(), "w");
+    ASSERT_TRUE(fp != nullptr);
+    ASSERT_TRUE(move_tree.WriteSGFLabeledText(kBlackTurn, fileno(fp)));
+    fclose(fp);
+
+    ifstream ifs(file_path);
+    const string file_str((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+    ASSERT_EQ(sgf_text, file_str);
+
+    remove(file_path.c_str());
+  }
+
+  for(const size_t thread_num : {1, 2, 3, 8}){
+    ASSERT_EQ(sgf_text, move_tree.GetSGFLabeledTextParallel(kBlackTurn, thread_num));
+  }
+
+  {
+    // 分岐のない探索木
+    MoveTree chain_tree;
+    chain_tree.AddChild(MoveList("hhhiij"));
+    ASSERT_EQ(chain_tree.str(), chain_tree.GetStrParallel(4));
+    ASSERT_EQ(chain_tree.GetSGFLabeledText(kBlackTurn), chain_tree.GetSGFLabeledTextParallel(kBlackTurn, 4));
+    
+    MoveTree empty_tree;
+    ASSERT_EQ("", empty_tree.GetStrParallel(4));
+    ASSERT_EQ("", empty_tree.GetSGFLabeledTextParallel(kBlackTurn, 4));
+  }
+}
+
+TEST_F(MoveTreeBaseTest, DeepTreeStrTest){
+  // 再帰で出力するとスタックを使い切る深さの探索木
+  constexpr size_t kDepth = 1000000;
+  MoveTree move_tree;
+
+  for(size_t i=0; i<kDepth; i++){
+    const auto move = (i % 2 == 0) ? kMoveHH : kMoveHI;
+    move_tree.AddChild(move);
+    move_tree.MoveChildNode(move);
+  }
+
+  const auto tree_str = move_tree.str();
+  ASSERT_EQ(2 * kDepth, tree_str.size());
+  ASSERT_EQ("hhhihh", tree_str.substr(0, 6));
+}
+
+TEST_F(MoveTreeBaseTest, ChunkedNodeStoreTest){
+  MoveArenaTextTree move_tree;
+
+  move_tree.AddChild(kMoveHH);
+  move_tree.MoveChildNode(kMoveHH);
+  move_tree.SetAdditionalData("first");
+
+  // ノードを追加しても既存のノードは再配置されない
+  const auto &first_node = move_tree.GetMoveTreeNodeList()[1];
+
+  for(size_t i=0; i<10000; i++){
+    const auto move = (i % 2 == 0) ? kMoveHI : kMoveHH;
+    move_tree.AddChild(move);
+    move_tree.MoveChildNode(move);
+    move_tree.SetAdditionalData(to_string(i));
+  }
+
+  ASSERT_EQ(&first_node, &move_tree.GetMoveTreeNodeList()[1]);
+  ASSERT_EQ("first", first_node.GetAdditionalData().str());
+  ASSERT_EQ(10001, move_tree.size());
+
+  move_tree.MoveRootNode();
+  ASSERT_TRUE(move_tree.MoveChildNode(MoveList("hhhihh")));
+  ASSERT_EQ("1", move_tree.GetAdditionalData().str());
+
+  // std::vectorのノード配列と同一の探索木になる
+  MoveTree vector_tree;
+  vector_tree.AddChild(MoveList("hhhgii"));
+  vector_tree.AddChild(MoveList("hhhigg"));
+  vector_tree.AddChild(MoveList("hiii"));
+
+  MoveArenaTextTree chunked_tree;
+  chunked_tree.AddChild(MoveList("hhhgii"));
+  chunked_tree.AddChild(MoveList("hhhigg"));
+  chunked_tree.AddChild(MoveList("hiii"));
+  ASSERT_EQ(vector_tree.str(), chunked_tree.str());
+  ASSERT_EQ(vector_tree.GetSGFLabeledText(true), chunked_tree.GetSGFLabeledText(true));
+
+  chunked_tree.CompactNodeLayout();
+  ASSERT_EQ(vector_tree.str(), chunked_tree.str());
+}
+
+TEST_F(MoveTreeBaseTest, ArenaTextLifetimeTest){
+  MoveArenaTextTree copied_tree, added_tree;
+
+  {
+    MoveArenaTextTree move_tree;
+    move_tree.AddChild(kMoveHH);
+    move_tree.MoveChildNode(kMoveHH);
+    move_tree.SetAdditionalData("copy");
+
+    MoveArenaTextTree subtree;
+    subtree.AddChild(kMoveHI);
+    subtree.MoveChildNode(kMoveHI);
+    subtree.SetAdditionalData("subtree");
+
+    // コピーはTextArenaを共有する
+    copied_tree = move_tree;
+    ASSERT_EQ(move_tree.GetTextArena(), copied_tree.GetTextArena());
+
+    added_tree.AddSubtree(subtree);
+  }
+
+  // 元の探索木を破棄しても付加情報の参照は有効
+  copied_tree.MoveRootNode();
+  ASSERT_TRUE(copied_tree.MoveChildNode(kMoveHH));
+  ASSERT_EQ("copy", copied_tree.GetAdditionalData().str());
+
+  ASSERT_TRUE(added_tree.MoveChildNode(kMoveHI));
+  ASSERT_EQ("subtree", added_tree.GetAdditionalData().str());
+}
+
 TEST_F(MoveTreeBaseTest, AddSubtreeTest){
   AddSubtreeTest();
 }
@@ -478,6 +734,14 @@ TEST_F(MoveTreeBaseTest, GetMoveListTest){
   }
 }
 
+TEST_F(MoveTreeBaseTest, ChildIndexTest){
+  ChildIndexTest();
+}
+
+TEST_F(MoveTreeBaseTest, CompactNodeLayoutTest){
+  CompactNodeLayoutTest();
+}
+
 TEST_F(MoveTreeBaseTest, GetMoveTreeNodeListTest){
   MoveTree move_tree;
 
@@ -0,0 +1,322 @@
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "MoveTreeSerializer.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+class MoveTreeSerializerTest
+: public ::testing::Test
+{
+public:
+  //! @brief テスト用のランダムな探索木を生成する
+  template<class T>
+  void GetRandomTree(const size_t sequence_count, MoveTreeBase<T> * const move_tree){
+    mt19937 random_engine(sequence_count);
+    uniform_int_distribution<int> length_distribution(1, 12);
+    uniform_int_distribution<int> move_distribution(0, 8);
+
+    for(size_t i=0; i<sequence_count; i++){
+      move_tree->MoveRootNode();
+      const int length = length_distribution(random_engine);
+
+      for(int j=0; j<length; j++){
+        // 中央付近の9点から選ぶことで共通の手順を作る
+        const auto move = GetMove(7 + move_distribution(random_engine) % 3, 7 + move_distribution(random_engine) / 3);
+        move_tree->AddChild(move);
+        move_tree->MoveChildNode(move);
+      }
+    }
+
+    move_tree->MoveRootNode();
+  }
+};
+
+TEST_F(MoveTreeSerializerTest, VarintTest)
+{
+  const vector<uint64_t> value_list{0, 1, 127, 128, 300, 16383, 16384, (1ULL << 32) + 5, numeric_limits<uint64_t>::max()};
+  string binary;
+
+  for(const auto value : value_list){
+    WriteVarint(value, &binary);
+  }
+
+  ASSERT_EQ(0, binary[0]);
+
+  const char *p = binary.data();
+  const char * const data_end = binary.data() + binary.size();
+
+  for(const auto value : value_list){
+    uint64_t read_value = 0;
+    ASSERT_TRUE(ReadVarint(&p, data_end, &read_value));
+    ASSERT_EQ(value, read_value);
+  }
+
+  ASSERT_EQ(data_end, p);
+
+  uint64_t read_value = 0;
+  ASSERT_FALSE(ReadVarint(&p, data_end, &read_value));
+}
+
+TEST_F(MoveTreeSerializerTest, EmptyTreeTest)
+{
+  MoveTree move_tree, restored_tree;
+  string binary;
+
+  MoveTreeSerializer<EmptyAditionalData>::Serialize(move_tree, &binary);
+  ASSERT_TRUE(MoveTreeSerializer<EmptyAditionalData>::Deserialize(binary.data(), binary.size(), &restored_tree));
+  ASSERT_TRUE(restored_tree.empty());
+  ASSERT_EQ("", restored_tree.str());
+}
+
+TEST_F(MoveTreeSerializerTest, RoundTripTest)
+{
+  for(const bool is_compact : {false, true}){
+    MoveTree move_tree;
+    GetRandomTree(200, &move_tree);
+
+    if(is_compact){
+      move_tree.CompactNodeLayout();
+    }
+
+    string binary;
+    MoveTreeSerializer<EmptyAditionalData>::Serialize(move_tree, &binary);
+
+    MoveTree restored_tree(kUseChildIndex);
+    ASSERT_TRUE(MoveTreeSerializer<EmptyAditionalData>::Deserialize(binary.data(), binary.size(), &restored_tree));
+
+    ASSERT_EQ(move_tree.size(), restored_tree.size());
+    ASSERT_EQ(move_tree.str(), restored_tree.str());
+    ASSERT_TRUE(restored_tree.IsRootNode());
+
+    // 復元後の探索木に子ノードを追加できる
+    const string tree_str = restored_tree.str();
+    restored_tree.AddChild(kMoveAA);
+    ASSERT_TRUE(restored_tree.MoveChildNode(kMoveAA));
+    ASSERT_EQ(tree_str + "(aa)", restored_tree.str());
+  }
+}
+
+TEST_F(MoveTreeSerializerTest, AdditionalDataTest)
+{
+  MoveTextTree move_tree;
+
+  move_tree.AddChild(MoveList("hhhiij"));
+  move_tree.AddChild(MoveList("hhhg"));
+  move_tree.MoveChildNode(MoveList("hhhi"));
+  move_tree.SetAdditionalData("proof");
+  move_tree.MoveChildNode(kMoveIJ);
+  move_tree.SetAdditionalData(string(300, 'x'));
+
+  string binary;
+  MoveTreeSerializer<string>::Serialize(move_tree, &binary);
+
+  MoveTextTree restored_tree;
+  ASSERT_TRUE(MoveTreeSerializer<string>::Deserialize(binary.data(), binary.size(), &restored_tree));
+  ASSERT_EQ(move_tree.str(), restored_tree.str());
+  ASSERT_TRUE(move_tree.GetMoveTreeNodeList() == restored_tree.GetMoveTreeNodeList());
+
+  ASSERT_TRUE(restored_tree.MoveChildNode(MoveList("hhhiij")));
+  ASSERT_EQ(string(300, 'x'), restored_tree.GetAdditionalData());
+}
+
+TEST_F(MoveTreeSerializerTest, InvalidBinaryTest)
+{
+  MoveTree move_tree;
+  GetRandomTree(10, &move_tree);
+
+  string binary;
+  MoveTreeSerializer<EmptyAditionalData>::Serialize(move_tree, &binary);
+
+  MoveTree restored_tree;
+
+  {
+    // magic不一致
+    string invalid_binary = binary;
+    invalid_binary[0] = 'X';
+    ASSERT_FALSE(MoveTreeSerializer<EmptyAditionalData>::Deserialize(invalid_binary.data(), invalid_binary.size(), &restored_tree));
+  }
+  {
+    // 途中で切れたデータ
+    const string invalid_binary = binary.substr(0, binary.size() - 1);
+    ASSERT_FALSE(MoveTreeSerializer<EmptyAditionalData>::Deserialize(invalid_binary.data(), invalid_binary.size(), &restored_tree));
+  }
+  {
+    ASSERT_FALSE(MoveTreeSerializer<EmptyAditionalData>::Deserialize(binary.data(), 4, &restored_tree));
+  }
+}
+
+TEST_F(MoveTreeSerializerTest, InvalidBlockTableTest)
+{
+  MoveTreeBinaryView<EmptyAditionalData> binary_view;
+
+  {
+    // ブロック表のサイズの計算がoverflowするブロック表の開始位置
+    const uint64_t node_count = kMaxMoveNodeIndex;
+    const uint64_t block_count = (node_count + kMoveTreeBinaryBlockSize - 1) / kMoveTreeBinaryBlockSize;
+
+    string binary(kMoveTreeBinaryMagic, kMoveTreeBinaryMagicSize);
+    binary.push_back(static_cast<char>(kMoveTreeBinaryVersion));
+    WriteVarint(node_count, &binary);
+    binary.append(8, '\0');
+
+    const uint64_t data_size = binary.size() + 8;
+    WriteFixed64(data_size - 8 * block_count - 8, &binary);
+
+    ASSERT_FALSE(binary_view.Attach(binary.data(), binary.size()));
+  }
+
+  MoveTree move_tree;
+  GetRandomTree(100, &move_tree);
+  ASSERT_GT(move_tree.size(), 2 * kMoveTreeBinaryBlockSize);
+
+  string binary;
+  MoveTreeSerializer<EmptyAditionalData>::Serialize(move_tree, &binary);
+  ASSERT_TRUE(binary_view.Attach(binary.data(), binary.size()));
+
+  const size_t block_table_offset = ReadFixed64(binary.data() + binary.size() - 8);
+
+  // 2番目のブロックの開始位置を書き換える
+  const auto GetInvalidBinary = [&binary, block_table_offset](const uint64_t block_offset){
+    string block_offset_binary;
+    WriteFixed64(block_offset, &block_offset_binary);
+
+    string invalid_binary = binary;
+    invalid_binary.replace(block_table_offset + 8, 8, block_offset_binary);
+
+    return invalid_binary;
+  };
+
+  {
+    // ノード列の範囲外
+    const string invalid_binary = GetInvalidBinary(numeric_limits<uint64_t>::max());
+    ASSERT_FALSE(binary_view.Attach(invalid_binary.data(), invalid_binary.size()));
+  }
+  {
+    // 直前のブロックの開始位置以下
+    const string invalid_binary = GetInvalidBinary(0);
+    ASSERT_FALSE(binary_view.Attach(invalid_binary.data(), invalid_binary.size()));
+  }
+}
+
+TEST_F(MoveTreeSerializerTest, CyclicLinkTest)
+{
+  MoveTree move_tree;
+  move_tree.AddChild(kMoveHH);
+  move_tree.AddChild(kMoveHI);
+
+  string binary;
+  MoveTreeSerializer<EmptyAditionalData>::Serialize(move_tree, &binary);
+
+  // 最後のノード(node index 2)の次の兄弟をnode index 1(差分-1をzigzag符号化した値+1 = 2)に書き換えて循環させる
+  const size_t block_table_offset = ReadFixed64(binary.data() + binary.size() - 8);
+  ASSERT_EQ(0, binary[block_table_offset - 1]);
+  binary[block_table_offset - 1] = 2;
+
+  MoveTree restored_tree;
+  ASSERT_FALSE(MoveTreeSerializer<EmptyAditionalData>::Deserialize(binary.data(), binary.size(), &restored_tree));
+
+  MoveTreeBinaryView<EmptyAditionalData> binary_view;
+  ASSERT_TRUE(binary_view.Attach(binary.data(), binary.size()));
+  ASSERT_EQ(kInvalidMove, binary_view.GetNode(2).GetMove());
+  ASSERT_EQ(kNullNodeIndex, binary_view.GetChildNodeIndex(kRootNodeIndex, kMoveAA));
+}
+
+TEST_F(MoveTreeSerializerTest, BinaryViewTest)
+{
+  MoveTree move_tree;
+  GetRandomTree(100, &move_tree);
+
+  string binary;
+  MoveTreeSerializer<EmptyAditionalData>::Serialize(move_tree, &binary);
+
+  MoveTreeBinaryView<EmptyAditionalData> binary_view;
+  ASSERT_TRUE(binary_view.Attach(binary.data(), binary.size()));
+
+  ASSERT_EQ(move_tree.size(), binary_view.size());
+  ASSERT_EQ(move_tree.str(), binary_view.str());
+
+  const auto& node_list = move_tree.GetMoveTreeNodeList();
+
+  for(size_t node_index=0; node_index<node_list.size(); node_index++){
+    const auto node = binary_view.GetNode(node_index);
+
+    ASSERT_EQ(node_list[node_index].GetParentIndex(), node.GetParentIndex());
+    ASSERT_EQ(node_list[node_index].GetFirstChildIndex(), node.GetFirstChildIndex());
+    ASSERT_EQ(node_list[node_index].GetNextSiblingIndex(), node.GetNextSiblingIndex());
+    ASSERT_EQ(node_list[node_index].GetMove(), node.GetMove());
+  }
+
+  const auto top_move = move_tree.GetTopNodeMove();
+  ASSERT_EQ(node_list[kRootNodeIndex].GetFirstChildIndex(), binary_view.GetChildNodeIndex(kRootNodeIndex, top_move));
+  ASSERT_EQ(kNullNodeIndex, binary_view.GetChildNodeIndex(kRootNodeIndex, kMoveAA));
+}
+
+TEST_F(MoveTreeSerializerTest, BinaryViewInvalidNodeTest)
+{
+  MoveTree move_tree;
+  move_tree.AddChild(kMoveHH);
+  move_tree.AddChild(kMoveHI);
+
+  string binary;
+  MoveTreeSerializer<EmptyAditionalData>::Serialize(move_tree, &binary);
+
+  // root nodeの子ノード(差分+1をzigzag符号化した値+1 = 3)をノード数以上のindex(差分+10 = 21)に書き換える
+  // [magic][version][ノード数][root node: 指し手, 親, 子, 兄弟]
+  const size_t root_first_child_offset = kMoveTreeBinaryMagicSize + 1 + 1 + 2;
+  ASSERT_EQ(3, binary[root_first_child_offset]);
+  binary[root_first_child_offset] = 21;
+
+  MoveTreeBinaryView<EmptyAditionalData> binary_view;
+  ASSERT_TRUE(binary_view.Attach(binary.data(), binary.size()));
+
+  // デコードできないノードは指し手がkInvalidMoveのノードとして返す
+  const auto node = binary_view.GetNode(kRootNodeIndex);
+  ASSERT_EQ(kInvalidMove, node.GetMove());
+  ASSERT_EQ(kNullNodeIndex, node.GetParentIndex());
+  ASSERT_EQ(kNullNodeIndex, node.GetFirstChildIndex());
+  ASSERT_EQ(kNullNodeIndex, node.GetNextSiblingIndex());
+}
+
+TEST_F(MoveTreeSerializerTest, FileTest)
+{
+  MoveTextTree move_tree;
+  GetRandomTree(50, &move_tree);
+  move_tree.MoveChildNode(move_tree.GetTopNodeMove());
+  move_tree.SetAdditionalData("top");
+
+  const string file_path = "move_tree_serializer_test.bin";
+  ASSERT_TRUE(MoveTreeSerializer<string>::WriteFile(move_tree, file_path));
+
+  {
+    MoveTextTree restored_tree;
+    ASSERT_TRUE(MoveTreeSerializer<string>::ReadFile(file_path, &restored_tree));
+    ASSERT_EQ(move_tree.str(), restored_tree.str());
+  }
+  {
+    // mmapで参照する
+    MoveTreeBinaryView<string> binary_view;
+    ASSERT_TRUE(binary_view.Open(file_path));
+    ASSERT_EQ(move_tree.str(), binary_view.str());
+
+    const auto top_node_index = binary_view.GetChildNodeIndex(kRootNodeIndex, move_tree.GetTopNodeMove());
+    ASSERT_EQ("top", binary_view.GetNode(top_node_index).GetAdditionalData());
+
+    binary_view.Close();
+    ASSERT_EQ(0, binary_view.size());
+  }
+
+  remove(file_path.c_str());
+
+  MoveTreeBinaryView<string> binary_view;
+  ASSERT_FALSE(binary_view.Open(file_path));
+}
+
+}   // namespace realcore
@@ -0,0 +1,257 @@
+#include <cstdio>
+
+#include "gtest/gtest.h"
+
+#include "MoveList.h"
+#include "HashTable.h"
+#include "GameRecordDB.h"
+#include "OpeningBook.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+class OpeningBookTest
+: public ::testing::Test
+{
+public:
+  OpeningBookTest()
+  {
+    // hhhgigとhhhgggは左右対称な棋譜
+    GameRecordDBBuilder builder;
+
+    builder.Add(MoveList("hhhgig"), kBlackWin, kResign, 0, "alice", "bob");
+    builder.Add(MoveList("hhhggg"), kWhiteWin, kResign, 0, "bob", "alice");
+    builder.Add(MoveList("hhijjk"), kDraw, kAgreedDraw, 0, "alice", "bob");
+
+    builder.Serialize(&db_binary_);
+    game_record_db_.Attach(db_binary_.data(), db_binary_.size());
+  }
+
+  void SymmetricHashStateTest()
+  {
+    // Passを含む棋譜
+    MoveList pass_list("hh");
+    pass_list += kNullMove;
+    pass_list += kNullMove;
+    pass_list += kMoveIJ;
+    pass_list += kNullMove;
+
+    for(const auto &move_list : {MoveList(), MoveList("hhhgig"), MoveList("hhijjk"), pass_list}){
+      SymmetricHashState hash_state;
+
+      for(const auto move : move_list){
+        hash_state.Play(move);
+      }
+
+      ASSERT_EQ(CalcSymmetricHashValue(move_list), hash_state.GetSymmetricHashValue());
+
+      // 正規形の局面はSymmetricHash値と同じHash値を持つ
+      MoveList canonical_list;
+      GetSymmetricMoveList(move_list, hash_state.GetCanonicalSymmetry(), &canonical_list);
+      ASSERT_EQ(hash_state.GetSymmetricHashValue(), CalcHashValue(canonical_list));
+    }
+  }
+
+  void FindTest()
+  {
+    OpeningBookBuilder builder;
+    builder.Build(game_record_db_, 1);
+
+    // 初期局面, hh, hhhg, hhhgig(=hhhggg), hhij, hhijjk
+    ASSERT_EQ(6, builder.GetPositionCount());
+
+    string binary;
+    builder.Serialize(&binary);
+
+    OpeningBook opening_book;
+    ASSERT_TRUE(opening_book.Attach(binary.data(), binary.size()));
+    ASSERT_EQ(6, opening_book.size());
+    ASSERT_EQ(3, opening_book.GetGameCount());
+
+    OpeningBookEntry entry;
+
+    {
+      // 初期局面
+      ASSERT_TRUE(opening_book.Find(MoveList(), &entry));
+      ASSERT_EQ(3, entry.stats.game_count);
+      ASSERT_EQ(1, entry.stats.black_win_count);
+      ASSERT_EQ(1, entry.stats.white_win_count);
+      ASSERT_EQ(1, entry.stats.draw_count);
+
+      ASSERT_EQ(1, entry.next_move_list.size());
+      ASSERT_EQ(kMoveHH, entry.next_move_list[0].move);
+      ASSERT_EQ(3, entry.next_move_list[0].stats.game_count);
+    }
+    {
+      // 次の一手は対局数の降順
+      ASSERT_TRUE(opening_book.Find(MoveList("hh"), &entry));
+      ASSERT_EQ(2, entry.next_move_list.size());
+      ASSERT_EQ(2, entry.next_move_list[0].stats.game_count);
+      ASSERT_EQ(1, entry.next_move_list[1].stats.game_count);
+    }
+    {
+      // 左右対称な次の一手は同一視する
+      ASSERT_TRUE(opening_book.Find(MoveList("hhhg"), &entry));
+      ASSERT_EQ(2, entry.stats.game_count);
+      ASSERT_EQ(1, entry.next_move_list.size());
+
+      const MovePosition next_move = entry.next_move_list[0].move;
+      ASSERT_TRUE(next_move == kMoveIG || next_move == kMoveGG);
+      ASSERT_EQ(2, entry.next_move_list[0].stats.game_count);
+      ASSERT_EQ(1, entry.next_move_list[0].stats.black_win_count);
+      ASSERT_EQ(1, entry.next_move_list[0].stats.white_win_count);
+    }
+    {
+      // 終局面は次の一手を持たない
+      ASSERT_TRUE(opening_book.Find(MoveList("hhhggg"), &entry));
+      ASSERT_EQ(2, entry.stats.game_count);
+      ASSERT_TRUE(entry.next_move_list.empty());
+    }
+    {
+      // 対称形の局面で検索すると次の一手も同じ対称変換をした指し手になる
+      for(const auto symmetry : GetBoardSymmetry()){
+        MoveList symmetric_list;
+        GetSymmetricMoveList(MoveList("hhij"), symmetry, &symmetric_list);
+
+        ASSERT_TRUE(opening_book.Find(symmetric_list, &entry));
+        ASSERT_EQ(1, entry.stats.game_count);
+        ASSERT_EQ(1, entry.stats.draw_count);
+        ASSERT_EQ(1, entry.next_move_list.size());
+        ASSERT_EQ(GetSymmetricMove(kMoveJK, symmetry), entry.next_move_list[0].move);
+      }
+    }
+
+    // 登録されていない局面
+    ASSERT_FALSE(opening_book.Find(MoveList("aa"), &entry));
+    ASSERT_FALSE(opening_book.Find(MoveList("hhhgii"), &entry));
+  }
+
+  void OptionTest()
+  {
+    OpeningBookEntry entry;
+
+    {
+      // 最大手数
+      OpeningBookBuilder builder;
+      builder.SetMaxDepth(1);
+      builder.Build(game_record_db_, 2);
+
+      ASSERT_EQ(2, builder.GetPositionCount());
+
+      string binary;
+      builder.Serialize(&binary);
+
+      OpeningBook opening_book;
+      ASSERT_TRUE(opening_book.Attach(binary.data(), binary.size()));
+
+      // 最大手数の局面も次の一手を持つ
+      ASSERT_TRUE(opening_book.Find(MoveList("hh"), &entry));
+      ASSERT_EQ(2, entry.next_move_list.size());
+      ASSERT_FALSE(opening_book.Find(MoveList("hhhg"), &entry));
+    }
+    {
+      // 最小対局数
+      OpeningBookBuilder builder;
+      builder.SetMinGameCount(2);
+      builder.Build(game_record_db_, 2);
+
+      ASSERT_EQ(4, builder.GetPositionCount());
+
+      string binary;
+      builder.Serialize(&binary);
+
+      OpeningBook opening_book;
+      ASSERT_TRUE(opening_book.Attach(binary.data(), binary.size()));
+
+      ASSERT_TRUE(opening_book.Find(MoveList("hhhgig"), &entry));
+      ASSERT_FALSE(opening_book.Find(MoveList("hhij"), &entry));
+    }
+  }
+
+  void ParallelBuildTest()
+  {
+    // スレッド数によらず同じバイナリ形式になる
+    string binary_1, binary_3;
+
+    {
+      OpeningBookBuilder builder;
+      builder.Build(game_record_db_, 1);
+      builder.Serialize(&binary_1);
+    }
+    {
+      OpeningBookBuilder builder;
+      builder.Build(game_record_db_, 3);
+      builder.Serialize(&binary_3);
+    }
+
+    ASSERT_EQ(binary_1, binary_3);
+  }
+
+  void OpenTest()
+  {
+    OpeningBookBuilder builder;
+    builder.Build(game_record_db_, 2);
+
+    string binary;
+    builder.Serialize(&binary);
+
+    OpeningBook opening_book;
+
+    // 不正なバイナリ形式
+    ASSERT_FALSE(opening_book.Attach(binary.data(), binary.size() - 1));
+    ASSERT_FALSE(opening_book.Attach(binary.data(), kOpeningBookHeaderSize - 1));
+
+    string invalid_binary = binary;
+    invalid_binary[0] = 'X';
+    ASSERT_FALSE(opening_book.Attach(invalid_binary.data(), invalid_binary.size()));
+
+    // ファイル
+    ASSERT_FALSE(opening_book.Open("not_exist.rcob"));
+    ASSERT_TRUE(builder.WriteFile("opening_book_test.rcob"));
+    ASSERT_TRUE(opening_book.Open("opening_book_test.rcob"));
+
+    OpeningBookEntry entry;
+    ASSERT_EQ(6, opening_book.size());
+    ASSERT_TRUE(opening_book.Find(MoveList("hhhg"), &entry));
+    ASSERT_EQ(2, entry.stats.game_count);
+
+    opening_book.Close();
+    ASSERT_EQ(0, opening_book.size());
+    ASSERT_FALSE(opening_book.Find(MoveList(), &entry));
+
+    remove("opening_book_test.rcob");
+  }
+
+private:
+  string db_binary_;
+  GameRecordDB game_record_db_;
+};
+
+TEST_F(OpeningBookTest, SymmetricHashStateTest)
+{
+  SymmetricHashStateTest();
+}
+
+TEST_F(OpeningBookTest, FindTest)
+{
+  FindTest();
+}
+
+TEST_F(OpeningBookTest, OptionTest)
+{
+  OptionTest();
+}
+
+TEST_F(OpeningBookTest, ParallelBuildTest)
+{
+  ParallelBuildTest();
+}
+
+TEST_F(OpeningBookTest, OpenTest)
+{
+  OpenTest();
+}
+
+}   // namespace realcore
@@ -0,0 +1,110 @@
+#include <cstdio>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+#include "MoveList.h"
+#include "POSFileBatch.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+class POSFileBatchTest
+: public ::testing::Test
+{
+public:
+  POSFileBatchTest()
+  {
+    // POS形式: 先頭1byteは手数, 以降は(y - 1) * 15 + (x - 1)
+    WriteFile("01.pos", MoveList("hhhgig"));
+    WriteFile("02.pos", MoveList());
+    WriteFile("03.pos", MoveList("hhhiiiggjj"));
+
+    // 0byteのファイル
+    ofstream("04.pos", ios::out | ios::binary);
+
+    // 手数より指し手が少ない(途中で切れた)ファイル
+    ofstream("05.pos", ios::out | ios::binary) << string{3, static_cast<char>(7 * 15 + 7), static_cast<char>(6 * 15 + 7)};
+
+    // 盤外の値を含むファイル
+    ofstream("06.pos", ios::out | ios::binary) << string{2, static_cast<char>(7 * 15 + 7), static_cast<char>(230)};
+  }
+
+  ~POSFileBatchTest()
+  {
+    for(const auto &file : {"01.pos", "02.pos", "03.pos", "04.pos", "05.pos", "06.pos"}){
+      remove(file);
+    }
+  }
+
+  void LoadTest()
+  {
+    const vector<string> pos_file_list{"01.pos", "not_exist.pos", "02.pos", "03.pos", "04.pos", "05.pos", "06.pos"};
+
+    for(const size_t thread_num : {1, 3}){
+      POSFileBatch pos_file_batch;
+      ASSERT_FALSE(pos_file_batch.Load(pos_file_list, thread_num));
+
+      ASSERT_EQ(7, pos_file_batch.size());
+      ASSERT_EQ(8, pos_file_batch.GetMoveCount());
+
+      // 指し手は連続した1つの領域に格納する
+      ASSERT_EQ(pos_file_batch.move_arena_.data(), pos_file_batch.GetMoveList(0).begin());
+      ASSERT_EQ(pos_file_batch.GetMoveList(0).end(), pos_file_batch.GetMoveList(3).begin());
+
+      const vector<bool> expect_loaded{true, false, true, true, false, false, false};
+      const vector<string> expect_list{"hhhgig", "", "", "hhhiiiggjj", "", "", ""};
+
+      for(size_t i=0; i<pos_file_list.size(); i++){
+        ASSERT_EQ(expect_loaded[i], pos_file_batch.IsLoaded(i));
+
+        MoveList move_list("aa");
+        pos_file_batch.GetMoveList(i, &move_list);
+        ASSERT_EQ(MoveList(expect_list[i]), move_list);
+
+        if(expect_loaded[i]){
+          // ReadPOSFileと同じ指し手列になる
+          MoveList read_list;
+          ReadPOSFile(pos_file_list[i], &read_list);
+          ASSERT_EQ(read_list, move_list);
+        }
+      }
+    }
+
+    {
+      // 再読込
+      POSFileBatch pos_file_batch;
+      ASSERT_TRUE(pos_file_batch.Load({"03.pos"}, 2));
+      ASSERT_TRUE(pos_file_batch.Load({"01.pos", "02.pos"}, 2));
+
+      ASSERT_EQ(2, pos_file_batch.size());
+      ASSERT_EQ(3, pos_file_batch.GetMoveCount());
+      ASSERT_EQ(kMoveIG, pos_file_batch.GetMoveList(0)[2]);
+      ASSERT_TRUE(pos_file_batch.GetMoveList(1).empty());
+    }
+  }
+
+private:
+  void WriteFile(const string &file_name, const MoveList &move_list) const
+  {
+    string pos_data(1, static_cast<char>(move_list.size()));
+
+    for(const auto move : move_list){
+      Cordinate x = 0, y = 0;
+      GetMoveCordinate(move, &x, &y);
+      pos_data += static_cast<char>((y - 1) * kBoardLineNum + (x - 1));
+    }
+
+    ofstream ofs(file_name, ios::out | ios::binary);
+    ofs << pos_data;
+  }
+};
+
+TEST_F(POSFileBatchTest, LoadTest)
+{
+  LoadTest();
+}
+
+}   // namespace realcore
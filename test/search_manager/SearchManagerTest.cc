@@ -24,11 +24,13 @@ public:
     ASSERT_EQ(0, search_manager.node_);
     ASSERT_EQ(0, search_manager.node_limit_);
 
-    auto elapsed_time = chrono::system_clock::now() - search_manager.search_start_time_;
+    auto elapsed_time = SearchClock::now() - search_manager.search_start_time_;
     auto elapsed_time_ms = chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
     ASSERT_GE(10, elapsed_time_ms);
 
     ASSERT_EQ(0, search_manager.elapsed_time_limit_);
+    ASSERT_EQ(1, search_manager.time_check_counter_.check_interval_);
+    ASSERT_FALSE(search_manager.time_over_);
     ASSERT_FALSE(search_manager.catch_interrupt_exception_);
     ASSERT_FALSE(search_manager.interruption_);
   }
@@ -61,6 +63,51 @@ public:
     auto elapsed_time_ms = chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
     ASSERT_NE(0, elapsed_time_ms);
   }
+
+  void TimeCheckCounterTest()
+  {
+    TimeCheckCounter time_check_counter;
+    const auto start_time = SearchClock::now();
+    time_check_counter.Reset(start_time);
+
+    // 初期状態は毎回時計を参照する
+    ASSERT_TRUE(time_check_counter.IsCheckTiming());
+
+    // 呼出頻度が高い場合は間隔を2倍ずつ伸ばす
+    time_check_counter.Update(start_time + chrono::microseconds(1));
+    ASSERT_EQ(2, time_check_counter.check_interval_);
+
+    ASSERT_FALSE(time_check_counter.IsCheckTiming());
+    ASSERT_TRUE(time_check_counter.IsCheckTiming());
+
+    time_check_counter.Update(start_time + chrono::microseconds(2));
+    ASSERT_EQ(4, time_check_counter.check_interval_);
+
+    // kTimeCheckIntervalUSの間に2回の呼出頻度であれば間隔は2回
+    for(size_t i=0; i<4; i++){
+      time_check_counter.IsCheckTiming();
+    }
+
+    time_check_counter.Update(start_time + chrono::microseconds(2 + 2 * kTimeCheckIntervalUS));
+    ASSERT_EQ(2, time_check_counter.check_interval_);
+
+    // 呼出頻度が低い場合は毎回時計を参照する
+    time_check_counter.IsCheckTiming();
+    time_check_counter.IsCheckTiming();
+    time_check_counter.Update(start_time + chrono::milliseconds(100));
+    ASSERT_EQ(1, time_check_counter.check_interval_);
+
+    // 間隔はkMaxTimeCheckCallIntervalを上限とする
+    for(size_t i=0; i<64; i++){
+      time_check_counter.Update(start_time + chrono::milliseconds(100));
+    }
+
+    ASSERT_EQ(kMaxTimeCheckCallInterval, time_check_counter.check_interval_);
+
+    time_check_counter.Reset(start_time);
+    ASSERT_EQ(1, time_check_counter.check_interval_);
+    ASSERT_EQ(0, time_check_counter.call_count_);
+  }
 };
 
 TEST_F(SearchManagerTest, DefaultConstructorTest)
@@ -128,6 +175,11 @@ TEST_F(SearchManagerTest, SearchStartTest)
   SearchStartTest();
 }
 
+TEST_F(SearchManagerTest, TimeCheckCounterTest)
+{
+  TimeCheckCounterTest();
+}
+
 TEST_F(SearchManagerTest, IsTerminateNodeTest)
 {
   SearchManager search_manager(kNoInterruptionPoint);
@@ -182,6 +234,27 @@ TEST_F(SearchManagerTest, IsTerminateInterruptionTest)
   thread_interrupt_wait.join();
 }
 
+TEST_F(SearchManagerTest, IsTerminateManyCallTest)
+{
+  // 時計の参照を間引いても探索時間の上限を検出できる
+  SearchManager search_manager(kNoInterruptionPoint);
+  search_manager.SetSearchTimeLimit(30);
+  search_manager.SearchStart();
+
+  SearchCounter call_count = 0;
+
+  while(!search_manager.IsTerminate()){
+    ++call_count;
+  }
+
+  const auto ms_time = search_manager.GetSearchTime();
+  ASSERT_LT(30, ms_time);
+  ASSERT_GT(40, ms_time);
+  ASSERT_LT(0, call_count);
+
+  ASSERT_TRUE(search_manager.IsTerminate());
+}
+
 TEST_F(SearchManagerTest, GetSearchTimeTest)
 {
   SearchManager search_manager(kNoInterruptionPoint);
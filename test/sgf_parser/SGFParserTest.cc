@@ -238,4 +238,32 @@ TEST_F(SGFParserTest, GetMoveListFromSGFBoardTest)
     EXPECT_EQ(expect_list, actual_list);
   }
 }
+
+TEST_F(SGFParserTest, ScanSGFPropertyTest)
+{
+  const string sgf_data = "(;GM[4]PB[Black \\]Player]C[DT[2017\\] ;B[aa\\]]AB [hh][ig] ;B[hh]C[x];W[hg]XX)";
+  vector<string> property_list;
+
+  ScanSGFProperty(sgf_data, [&](const SGFProperty &property){
+    string property_str = (property.is_node_head ? ";" : "") + property.id.to_string();
+
+    for(const auto &value : property.value_list){
+      property_str += "[" + value.to_string() + "]";
+    }
+
+    property_list.emplace_back(property_str);
+  });
+
+  // コメント内のプロパティ、エスケープされた']'は値の一部として扱い、値のない識別子は無視する
+  const vector<string> expect_list{";GM[4]", "PB[Black \\]Player]", "C[DT[2017\\] ;B[aa\\]]", "AB[hh][ig]", ";B[hh]", "C[x]", ";W[hg]"};
+  EXPECT_EQ(expect_list, property_list);
+
+  // 閉じられていない値で走査を終了する
+  property_list.clear();
+  ScanSGFProperty("(;GM[4]PB[Black", [&](const SGFProperty &property){
+    property_list.emplace_back(property.id.to_string());
+  });
+
+  EXPECT_EQ(vector<string>{"GM"}, property_list);
+}
 }   // namespace realcore
@@ -0,0 +1,354 @@
+#include <thread>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+#include "gtest/gtest.h"
+
+#include "SharedSearchManager.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+void SharedInterruptWait(SharedSearchManager * const search_manager, const size_t thread_index);
+
+class SharedSearchManagerTest
+: public ::testing::Test
+{
+public:
+  void DefaultConstructorTest(){
+    SharedSearchManager search_manager(4, kNoInterruptionPoint);
+
+    ASSERT_EQ(4, search_manager.thread_num_);
+    ASSERT_EQ(0, search_manager.flushed_node_);
+    ASSERT_EQ(0, search_manager.node_limit_);
+
+    for(size_t i=0; i<4; i++){
+      ASSERT_EQ(0, search_manager.shard_list_[i].node);
+      ASSERT_EQ(0, search_manager.shard_list_[i].get_proof_tree);
+      ASSERT_EQ(0, search_manager.shard_list_[i].get_proof_tree_success);
+      ASSERT_EQ(0, search_manager.shard_list_[i].simulation);
+      ASSERT_EQ(0, search_manager.shard_list_[i].simulation_success);
+    }
+
+    auto elapsed_time = SearchClock::now() - search_manager.search_start_time_;
+    auto elapsed_time_ms = chrono::duration_cast<chrono::milliseconds>(elapsed_time).count();
+    ASSERT_GE(10, elapsed_time_ms);
+
+    ASSERT_EQ(0, search_manager.elapsed_time_limit_);
+    ASSERT_FALSE(search_manager.catch_interrupt_exception_);
+    ASSERT_FALSE(search_manager.stop_flag_);
+  }
+
+  void ShardLayoutTest()
+  {
+    SharedSearchManager search_manager(2, kNoInterruptionPoint);
+
+    // 隣接スレッドのカウンタはkSearchCounterShardSize離れている
+    const auto shard_address_0 = reinterpret_cast<uintptr_t>(&search_manager.shard_list_[0].node);
+    const auto shard_address_1 = reinterpret_cast<uintptr_t>(&search_manager.shard_list_[1].node);
+    ASSERT_EQ(kSearchCounterShardSize, shard_address_1 - shard_address_0);
+  }
+
+  void FlushNodeTest()
+  {
+    SharedSearchManager search_manager(2, kNoInterruptionPoint);
+
+    for(size_t i=0; i<kNodeFlushInterval - 1; i++){
+      search_manager.AddNode(0);
+      search_manager.AddNode(1);
+    }
+
+    ASSERT_EQ(0, search_manager.flushed_node_);
+
+    search_manager.AddNode(0);
+    ASSERT_EQ(kNodeFlushInterval, search_manager.flushed_node_);
+
+    search_manager.AddNode(1);
+    ASSERT_EQ(2 * kNodeFlushInterval, search_manager.flushed_node_);
+    ASSERT_EQ(2 * kNodeFlushInterval, search_manager.GetNode());
+  }
+
+  void SetNodeLimitTest()
+  {
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+
+    search_manager.SetNodeLimit(1);
+    ASSERT_EQ(1, search_manager.node_limit_);
+  }
+
+  void SetSearchTimeLimitTest()
+  {
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+
+    search_manager.SetSearchTimeLimit(1000);
+    ASSERT_EQ(1000, search_manager.elapsed_time_limit_);
+  }
+
+  void SetRemainingLimitTest()
+  {
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+
+    {
+      // 上限なし
+      SharedSearchManager remaining_manager(1, kNoInterruptionPoint);
+      remaining_manager.SetRemainingLimit(search_manager);
+
+      ASSERT_EQ(0, remaining_manager.GetNodeLimit());
+      ASSERT_EQ(0, remaining_manager.GetSearchTimeLimit());
+    }
+
+    search_manager.SetNodeLimit(10);
+    search_manager.SetSearchTimeLimit(60 * 60 * 1000);
+
+    for(size_t i=0; i<4; i++){
+      search_manager.AddNode(0);
+    }
+
+    {
+      SharedSearchManager remaining_manager(1, kNoInterruptionPoint);
+      remaining_manager.SetRemainingLimit(search_manager);
+
+      ASSERT_EQ(6, remaining_manager.GetNodeLimit());
+      ASSERT_LT(0, remaining_manager.GetSearchTimeLimit());
+      ASSERT_GE(60 * 60 * 1000, remaining_manager.GetSearchTimeLimit());
+    }
+
+    for(size_t i=0; i<10; i++){
+      search_manager.AddNode(0);
+    }
+
+    {
+      // 上限に達している場合は無制限にしない
+      SharedSearchManager remaining_manager(1, kNoInterruptionPoint);
+      remaining_manager.SetRemainingLimit(search_manager);
+
+      ASSERT_EQ(1, remaining_manager.GetNodeLimit());
+    }
+  }
+};
+
+TEST_F(SharedSearchManagerTest, DefaultConstructorTest)
+{
+  DefaultConstructorTest();
+}
+
+TEST_F(SharedSearchManagerTest, ShardLayoutTest)
+{
+  ShardLayoutTest();
+}
+
+TEST_F(SharedSearchManagerTest, AddGetNodeTest)
+{
+  SharedSearchManager search_manager(3, kNoInterruptionPoint);
+  ASSERT_EQ(3, search_manager.GetThreadNum());
+  ASSERT_EQ(0, search_manager.GetNode());
+
+  search_manager.AddNode(0);
+  ASSERT_EQ(1, search_manager.GetNode());
+
+  search_manager.AddNode(1);
+  search_manager.AddNode(2);
+  search_manager.AddNode(2);
+  ASSERT_EQ(4, search_manager.GetNode());
+}
+
+TEST_F(SharedSearchManagerTest, FlushNodeTest)
+{
+  FlushNodeTest();
+}
+
+TEST_F(SharedSearchManagerTest, AddGetProofTreeTest)
+{
+  SharedSearchManager search_manager(2, kNoInterruptionPoint);
+
+  ASSERT_EQ(0, search_manager.GetProofTreeCount());
+  ASSERT_EQ(0, search_manager.GetProofTreeSuccessCount());
+
+  search_manager.AddGetProofTreeResult(0, true);
+
+  ASSERT_EQ(1, search_manager.GetProofTreeCount());
+  ASSERT_EQ(1, search_manager.GetProofTreeSuccessCount());
+
+  search_manager.AddGetProofTreeResult(1, false);
+
+  ASSERT_EQ(2, search_manager.GetProofTreeCount());
+  ASSERT_EQ(1, search_manager.GetProofTreeSuccessCount());
+}
+
+TEST_F(SharedSearchManagerTest, AddGetSimulationTest)
+{
+  SharedSearchManager search_manager(2, kNoInterruptionPoint);
+
+  ASSERT_EQ(0, search_manager.GetSimulationCount());
+  ASSERT_EQ(0, search_manager.GetSimulationSuccessCount());
+
+  search_manager.AddSimulationResult(1, true);
+
+  ASSERT_EQ(1, search_manager.GetSimulationCount());
+  ASSERT_EQ(1, search_manager.GetSimulationSuccessCount());
+
+  search_manager.AddSimulationResult(0, false);
+
+  ASSERT_EQ(2, search_manager.GetSimulationCount());
+  ASSERT_EQ(1, search_manager.GetSimulationSuccessCount());
+}
+
+TEST_F(SharedSearchManagerTest, SetNodeLimitTest)
+{
+  SetNodeLimitTest();
+}
+
+TEST_F(SharedSearchManagerTest, SetSearchTimeLimitTest)
+{
+  SetSearchTimeLimitTest();
+}
+
+TEST_F(SharedSearchManagerTest, SetRemainingLimitTest)
+{
+  SetRemainingLimitTest();
+}
+
+TEST_F(SharedSearchManagerTest, IsTerminateNodeTest)
+{
+  SharedSearchManager search_manager(2, kNoInterruptionPoint);
+
+  ASSERT_FALSE(search_manager.IsTerminate(0));
+
+  search_manager.AddNode(0);   // node: 1
+  ASSERT_FALSE(search_manager.IsTerminate(0));
+
+  search_manager.SetNodeLimit(2);
+  ASSERT_FALSE(search_manager.IsTerminate(0));
+
+  search_manager.AddNode(1);   // node: 2
+  ASSERT_FALSE(search_manager.IsTerminate(1));
+
+  search_manager.AddNode(0);   // node: 3
+  ASSERT_TRUE(search_manager.IsTerminate(1));
+
+  // 停止は全スレッドに通知される
+  ASSERT_TRUE(search_manager.IsStopped());
+  ASSERT_TRUE(search_manager.IsTerminate(0));
+}
+
+TEST_F(SharedSearchManagerTest, IsTerminateTimeTest)
+{
+  SharedSearchManager search_manager(2, kNoInterruptionPoint);
+
+  ASSERT_FALSE(search_manager.IsTerminate(0));
+  this_thread::sleep_for(chrono::milliseconds(10));
+
+  ASSERT_FALSE(search_manager.IsTerminate(0));
+
+  search_manager.SetSearchTimeLimit(30);
+  search_manager.SearchStart();
+
+  this_thread::sleep_for(chrono::milliseconds(10));
+  ASSERT_FALSE(search_manager.IsTerminate(0));
+
+  this_thread::sleep_for(chrono::milliseconds(30));
+  ASSERT_TRUE(search_manager.IsTerminate(0));
+  ASSERT_TRUE(search_manager.IsTerminate(1));
+}
+
+TEST_F(SharedSearchManagerTest, StopTest)
+{
+  SharedSearchManager search_manager(2, kNoInterruptionPoint);
+
+  ASSERT_FALSE(search_manager.IsStopped());
+  ASSERT_FALSE(search_manager.IsTerminate(0));
+  ASSERT_FALSE(search_manager.IsTerminate(1));
+
+  search_manager.Stop();
+
+  ASSERT_TRUE(search_manager.IsStopped());
+  ASSERT_TRUE(search_manager.IsTerminate(0));
+  ASSERT_TRUE(search_manager.IsTerminate(1));
+}
+
+TEST_F(SharedSearchManagerTest, MultiThreadAddNodeTest)
+{
+  constexpr size_t kThreadNum = 4;
+  constexpr SearchCounter kNodeCount = 100000;
+  SharedSearchManager search_manager(kThreadNum, kNoInterruptionPoint);
+
+  vector<thread> thread_list;
+
+  for(size_t thread_index=0; thread_index<kThreadNum; thread_index++){
+    thread_list.emplace_back([&search_manager, thread_index](){
+      for(SearchCounter i=0; i<kNodeCount; i++){
+        search_manager.AddNode(thread_index);
+        search_manager.AddSimulationResult(thread_index, i % 2 == 0);
+      }
+    });
+  }
+
+  for(auto &search_thread : thread_list){
+    search_thread.join();
+  }
+
+  ASSERT_EQ(kThreadNum * kNodeCount, search_manager.GetNode());
+  ASSERT_EQ(kThreadNum * kNodeCount, search_manager.GetSimulationCount());
+  ASSERT_EQ(kThreadNum * kNodeCount / 2, search_manager.GetSimulationSuccessCount());
+}
+
+TEST_F(SharedSearchManagerTest, MultiThreadNodeLimitTest)
+{
+  constexpr size_t kThreadNum = 4;
+  constexpr SearchCounter kNodeLimit = 100000;
+  SharedSearchManager search_manager(kThreadNum, kNoInterruptionPoint);
+  search_manager.SetNodeLimit(kNodeLimit);
+
+  vector<thread> thread_list;
+
+  for(size_t thread_index=0; thread_index<kThreadNum; thread_index++){
+    thread_list.emplace_back([&search_manager, thread_index](){
+      while(!search_manager.IsTerminate(thread_index)){
+        search_manager.AddNode(thread_index);
+      }
+    });
+  }
+
+  for(auto &search_thread : thread_list){
+    search_thread.join();
+  }
+
+  // 各スレッドは終了判定後に高々1ノード追加する
+  ASSERT_LT(kNodeLimit, search_manager.GetNode());
+  ASSERT_GE(kNodeLimit + kThreadNum, search_manager.GetNode());
+}
+
+void SharedInterruptWait(SharedSearchManager * const search_manager, const size_t thread_index)
+{
+  while(!search_manager->IsTerminate(thread_index)){
+  }
+}
+
+TEST_F(SharedSearchManagerTest, IsTerminateInterruptionTest)
+{
+  SharedSearchManager search_manager(2, kCatchInterruptException);
+
+  boost::thread thread_interrupt_wait(&SharedInterruptWait, &search_manager, 0);
+  boost::thread thread_wait(&SharedInterruptWait, &search_manager, 1);
+
+  // 一方のスレッドへのinterruptで他方のスレッドも終了する
+  thread_interrupt_wait.interrupt();
+  thread_interrupt_wait.join();
+  thread_wait.join();
+
+  ASSERT_TRUE(search_manager.IsStopped());
+}
+
+TEST_F(SharedSearchManagerTest, GetSearchTimeTest)
+{
+  SharedSearchManager search_manager(1, kNoInterruptionPoint);
+  this_thread::sleep_for(chrono::milliseconds(10));
+
+  const auto ms_time = search_manager.GetSearchTime();
+  ASSERT_NEAR(10, ms_time, 3);
+}
+
+}   // namespace realcore
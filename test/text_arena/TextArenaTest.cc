@@ -0,0 +1,95 @@
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "TextArena.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+class TextArenaTest
+: public ::testing::Test
+{
+public:
+  void ChunkTest(){
+    TextArena text_arena(8);
+
+    text_arena.Store("abcde");
+    ASSERT_EQ(1, text_arena.chunk_list_.size());
+
+    // 末尾のチャンクに収まる場合は同一チャンクに格納する
+    text_arena.Store("fgh");
+    ASSERT_EQ(1, text_arena.chunk_list_.size());
+
+    text_arena.Store("i");
+    ASSERT_EQ(2, text_arena.chunk_list_.size());
+
+    // チャンクサイズを超える文字列は専用のチャンクに格納する
+    text_arena.Store(string(20, 'x'));
+    ASSERT_EQ(3, text_arena.chunk_list_.size());
+
+    ASSERT_EQ(29, text_arena.GetUsedSize());
+    ASSERT_EQ(36, text_arena.GetAllocatedSize());
+  }
+};
+
+TEST_F(TextArenaTest, ArenaTextTest)
+{
+  ArenaText empty_text;
+  ASSERT_TRUE(empty_text.empty());
+  ASSERT_EQ("", empty_text.str());
+
+  const string text = "proof";
+  ArenaText arena_text(text.data(), text.size());
+  ASSERT_EQ(5, arena_text.size());
+  ASSERT_EQ("proof", arena_text.str());
+
+  const string same_text = "proof";
+  ASSERT_TRUE(arena_text == ArenaText(same_text.data(), same_text.size()));
+  ASSERT_TRUE(arena_text != empty_text);
+}
+
+TEST_F(TextArenaTest, StoreTest)
+{
+  TextArena text_arena;
+
+  const auto text_1 = text_arena.Store("hh:1");
+  const auto text_2 = text_arena.Store(string("hi:2"));
+  const auto text_empty = text_arena.Store("");
+
+  ASSERT_EQ("hh:1", text_1.str());
+  ASSERT_EQ("hi:2", text_2.str());
+  ASSERT_TRUE(text_empty.empty());
+
+  // 連続した領域に格納される
+  ASSERT_EQ(text_1.data() + text_1.size(), text_2.data());
+
+  // 格納後に文字列を追加しても移動しない
+  const char * const text_1_data = text_1.data();
+
+  for(int i=0; i<100000; i++){
+    text_arena.Store(to_string(i));
+  }
+
+  ASSERT_EQ(text_1_data, text_1.data());
+  ASSERT_EQ("hh:1", text_1.str());
+}
+
+TEST_F(TextArenaTest, ChunkTest)
+{
+  ChunkTest();
+}
+
+TEST_F(TextArenaTest, clearTest)
+{
+  TextArena text_arena;
+  text_arena.Store("abc");
+
+  text_arena.clear();
+  ASSERT_EQ(0, text_arena.GetUsedSize());
+  ASSERT_EQ(0, text_arena.GetAllocatedSize());
+}
+
+}   // namespace realcore
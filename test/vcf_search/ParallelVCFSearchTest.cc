@@ -0,0 +1,92 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ParallelVCFSearch.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+const bool IsValidVCFSequence(const MoveList &board_sequence, const MoveList &proof_sequence);
+
+class ParallelVCFSearchTest
+: public ::testing::Test
+{
+public:
+  void ConstructorTest()
+  {
+    const Board board(MoveList("hhhgig"));
+    VCFTable vcf_table(1, kLockTable);
+    SharedSearchManager search_manager(4, kNoInterruptionPoint);
+    ParallelVCFSearch parallel_vcf_search(board, &vcf_table, &search_manager);
+
+    ASSERT_EQ(&search_manager, parallel_vcf_search.search_manager_);
+    ASSERT_EQ(4, parallel_vcf_search.scheduler_.GetThreadNum());
+    ASSERT_EQ(4, parallel_vcf_search.vcf_search_list_.size());
+    ASSERT_FALSE(parallel_vcf_search.is_proven_);
+    ASSERT_FALSE(parallel_vcf_search.is_unknown_);
+  }
+};
+
+TEST_F(ParallelVCFSearchTest, ConstructorTest)
+{
+  ConstructorTest();
+}
+
+TEST_F(ParallelVCFSearchTest, SolveTest)
+{
+  // スレッド数によらず逐次探索と同じ結果となる
+  const vector<string> board_sequence_list{{
+    "lkkdjkljjjefffkihhleejjh",               // 黒番のVCF
+    "jgkjjlhghlhdkhgfdhfdhf",                 // 白番のVCF
+    "fjhifiefhljlfegellgfejdeiekkhgdkif",     // 相手の四ノビを防ぎつつ四ノビする
+    "dfgiedfjhhildjiidhji",                   // VCFなし
+    "hh",                                     // 四ノビなし
+  }};
+
+  for(const auto &board_text : board_sequence_list){
+    const MoveList board_sequence(board_text);
+    const Board board(board_sequence);
+
+    VCFTable serial_vcf_table(1, kLockFree);
+    SharedSearchManager serial_search_manager(1, kNoInterruptionPoint);
+    VCFSearch vcf_search(board, &serial_vcf_table, &serial_search_manager, 0);
+
+    MoveList serial_proof_sequence;
+    const auto serial_result = vcf_search.Solve(&serial_proof_sequence);
+
+    for(const size_t thread_num : {1, 2, 4, 8}){
+      VCFTable vcf_table(1, kLockTable);
+      SharedSearchManager search_manager(thread_num, kNoInterruptionPoint);
+      ParallelVCFSearch parallel_vcf_search(board, &vcf_table, &search_manager);
+
+      MoveList proof_sequence;
+      const auto result = parallel_vcf_search.Solve(&proof_sequence);
+
+      ASSERT_EQ(serial_result, result);
+
+      if(result == kVCFProven){
+        ASSERT_TRUE(IsValidVCFSequence(board_sequence, proof_sequence));
+      }else{
+        ASSERT_TRUE(proof_sequence.empty());
+      }
+    }
+  }
+}
+
+TEST_F(ParallelVCFSearchTest, SolveUnknownTest)
+{
+  const Board board(MoveList("dfgiedfjhhildjiidhji"));
+  VCFTable vcf_table(1, kLockTable);
+  SharedSearchManager search_manager(4, kNoInterruptionPoint);
+  ParallelVCFSearch parallel_vcf_search(board, &vcf_table, &search_manager);
+
+  search_manager.Stop();
+
+  MoveList proof_sequence;
+  ASSERT_EQ(kVCFUnknown, parallel_vcf_search.Solve(&proof_sequence));
+}
+
+}   // namespace realcore
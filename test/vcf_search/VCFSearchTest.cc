@@ -0,0 +1,350 @@
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "VCFSearch.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+//! @brief VCFの手順が正しいかチェックする
+//! @note 終端手の直前までは正規手かつ非終端手で、最後の手で終端すること
+const bool IsValidVCFSequence(const MoveList &board_sequence, const MoveList &proof_sequence)
+{
+  if(proof_sequence.size() % 2 == 0){
+    return false;
+  }
+
+  Board board(board_sequence);
+
+  for(size_t i=0; i+1<proof_sequence.size(); i++){
+    const auto move = proof_sequence[i];
+
+    if(!board.IsNormalMove(move) || board.IsTerminateMove(move)){
+      return false;
+    }
+
+    board.MakeMove(move);
+  }
+
+  MovePosition terminating_move;
+
+  if(!board.TerminateCheck(&terminating_move)){
+    return false;
+  }
+
+  return terminating_move == proof_sequence.GetLastMove();
+}
+
+class VCFSearchTest
+: public ::testing::Test
+{
+public:
+  void ConstructorTest()
+  {
+    const MoveList board_sequence("hhhgig");
+    const Board board(board_sequence);
+    VCFTable vcf_table(1, kLockFree);
+    SharedSearchManager search_manager(2, kNoInterruptionPoint);
+    VCFSearch vcf_search(board, &vcf_table, &search_manager, 1);
+
+    ASSERT_EQ(board_sequence, vcf_search.board_move_sequence_);
+    ASSERT_EQ(&vcf_table, vcf_search.vcf_table_);
+    ASSERT_EQ(&search_manager, vcf_search.search_manager_);
+    ASSERT_EQ(1, vcf_search.thread_index_);
+    ASSERT_EQ(CalcHashValue(board_sequence), vcf_search.GetHashValue());
+  }
+
+  void MakeFourMoveTest()
+  {
+    const MoveList board_sequence("lkkdjkljjjefffkihhleejjh");
+    const Board board(board_sequence);
+    VCFTable vcf_table(1, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCFSearch vcf_search(board, &vcf_table, &search_manager, 0);
+
+    vcf_search.MakeFourMove(MovePair(kMoveII, kMoveGG));
+
+    MoveList expect_sequence(board_sequence);
+    expect_sequence += kMoveII;
+    expect_sequence += kMoveGG;
+
+    ASSERT_EQ(expect_sequence, vcf_search.board_move_sequence_);
+    ASSERT_EQ(CalcHashValue(expect_sequence), vcf_search.GetHashValue());
+
+    vcf_search.UndoFourMove();
+    ASSERT_EQ(board_sequence, vcf_search.board_move_sequence_);
+    ASSERT_EQ(CalcHashValue(board_sequence), vcf_search.GetHashValue());
+  }
+};
+
+TEST_F(VCFSearchTest, ConstructorTest)
+{
+  ConstructorTest();
+}
+
+TEST_F(VCFSearchTest, MakeFourMoveTest)
+{
+  MakeFourMoveTest();
+}
+
+TEST_F(VCFSearchTest, SolveBlackTest)
+{
+  {
+    // 黒番のVCF
+    //   A B C D E F G H I J K L M N O
+    // A + --------------------------+ A
+    // B | . . . . . . . . . . . . . | B
+    // C | . . . . . . . . . . . . . | C
+    // D | . . * . . . . . . o * . . | D
+    // E | . . . . . . . . . . o . . | E
+    // F | . . . o x . . . . . . . . | F
+    // G | . . . . . . . . . . . . . | G
+    // H | . . . . . . x . o . . . . | H
+    // I | . . . . . . . . . o . . . | I
+    // J | . . . x . . . . x . o . . | J
+    // K | . . . . . . . . x . x . . | K
+    // L | . . * . . . . . . . * . . | L
+    // M | . . . . . . . . . . . . . | M
+    // N | . . . . . . . . . . . . . | N
+    // O + --------------------------+ O
+    //   A B C D E F G H I J K L M N O
+    const MoveList board_sequence("lkkdjkljjjefffkihhleejjh");
+    const Board board(board_sequence);
+    VCFTable vcf_table(1, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCFSearch vcf_search(board, &vcf_table, &search_manager, 0);
+
+    MoveList proof_sequence;
+    const auto result = vcf_search.Solve(&proof_sequence);
+
+    ASSERT_EQ(kVCFProven, result);
+    ASSERT_EQ(MoveList("iiggkkllik"), proof_sequence);
+    ASSERT_TRUE(IsValidVCFSequence(board_sequence, proof_sequence));
+
+    // 探索後は探索開始局面に戻る
+    ASSERT_EQ(CalcHashValue(board_sequence), vcf_search.GetHashValue());
+  }
+}
+
+TEST_F(VCFSearchTest, SolveProofTreeTest)
+{
+  const MoveList board_sequence("lkkdjkljjjefffkihhleejjh");
+  const Board board(board_sequence);
+  VCFTable vcf_table(1, kLockFree);
+  SharedSearchManager search_manager(1, kNoInterruptionPoint);
+  VCFSearch vcf_search(board, &vcf_table, &search_manager, 0);
+
+  MoveTree proof_tree;
+  const auto result = vcf_search.Solve(&proof_tree);
+
+  ASSERT_EQ(kVCFProven, result);
+  ASSERT_EQ(5, proof_tree.size());
+
+  // 証明木は終端手までの一本道となる
+  MoveList proof_sequence;
+
+  while(true){
+    MoveList child_list;
+    proof_tree.GetChildMoveList(&child_list);
+
+    if(child_list.empty()){
+      break;
+    }
+
+    ASSERT_EQ(1, child_list.size());
+    proof_sequence += child_list[0];
+    proof_tree.MoveChildNode(child_list[0]);
+  }
+
+  ASSERT_EQ(MoveList("iiggkkllik"), proof_sequence);
+}
+
+TEST_F(VCFSearchTest, SolveWhiteTest)
+{
+  {
+    // 白番のVCF
+    //   A B C D E F G H I J K L M N O
+    // A + --------------------------+ A
+    // B | . . . . . . . . . . . . . | B
+    // C | . . . . . . . . . . . . . | C
+    // D | . . * . o . o . . . * . . | D
+    // E | . . . . . . . . . . . . . | E
+    // F | . . . . . o x . . . . . . | F
+    // G | . . . . . . o . x . . . . | G
+    // H | . . x . . . * . . x . . . | H
+    // I | . . . . . . . . . . . . . | I
+    // J | . . . . . . . . . o . . . | J
+    // K | . . . . . . . . . . . . . | K
+    // L | . . * . . . x . x . * . . | L
+    // M | . . . . . . . . . . . . . | M
+    // N | . . . . . . . . . . . . . | N
+    // O + --------------------------+ O
+    //   A B C D E F G H I J K L M N O
+    const MoveList board_sequence("jgkjjlhghlhdkhgfdhfdhf");
+    const Board board(board_sequence);
+    VCFTable vcf_table(1, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCFSearch vcf_search(board, &vcf_table, &search_manager, 0);
+
+    MoveList proof_sequence;
+    const auto result = vcf_search.Solve(&proof_sequence);
+
+    ASSERT_EQ(kVCFProven, result);
+    ASSERT_EQ(MoveList("ihjiedfegd"), proof_sequence);
+    ASSERT_TRUE(IsValidVCFSequence(board_sequence, proof_sequence));
+  }
+}
+
+TEST_F(VCFSearchTest, SolveOpponentFourTest)
+{
+  {
+    // 相手の四ノビを防ぎつつ四ノビする
+    //   A B C D E F G H I J K L M N O
+    // A + --------------------------+ A
+    // B | . . . . . . . . . . . . . | B
+    // C | . . . . . . . . . . . . . | C
+    // D | . . * . . . . . . . * . . | D
+    // E | . . o . x o . x . . . . . | E
+    // F | . . . o . o . x . . . . . | F
+    // G | . . . . . . x . . . . . . | G
+    // H | . . . . . . * . . . . . . | H
+    // I | . . . . x . o . . . . . . | I
+    // J | . . . x x . . . . . . . . | J
+    // K | . . o . . . . . . o . . . | K
+    // L | . . * . . . x . o . x . . | L
+    // M | . . . . . . . . . . . . . | M
+    // N | . . . . . . . . . . . . . | N
+    // O + --------------------------+ O
+    //   A B C D E F G H I J K L M N O
+    const MoveList board_sequence("fjhifiefhljlfegellgfejdeiekkhgdkif");
+    const Board board(board_sequence);
+    VCFTable vcf_table(1, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCFSearch vcf_search(board, &vcf_table, &search_manager, 0);
+
+    MovePosition guard_move;
+    ASSERT_TRUE(board.IsOpponentFour(&guard_move));
+
+    MoveList proof_sequence;
+    const auto result = vcf_search.Solve(&proof_sequence);
+
+    ASSERT_EQ(kVCFProven, result);
+    ASSERT_EQ(MoveList("ghfggg"), proof_sequence);
+    ASSERT_EQ(guard_move, proof_sequence[0]);
+    ASSERT_TRUE(IsValidVCFSequence(board_sequence, proof_sequence));
+  }
+}
+
+TEST_F(VCFSearchTest, SolveDisprovenTest)
+{
+  {
+    // 四ノビはあるがVCFがない
+    //   A B C D E F G H I J K L M N O
+    // A + --------------------------+ A
+    // B | . . . . . . . . . . . . . | B
+    // C | . . . . . . . . . . . . . | C
+    // D | . . * x . . . . . . * . . | D
+    // E | . . . . . . . . . . . . . | E
+    // F | . . x . . . . . . . . . . | F
+    // G | . . . . . . . . . . . . . | G
+    // H | . . x . . . x . . . . . . | H
+    // I | . . . . . o . o o . . . . | I
+    // J | . . x . o . . . . . . . . | J
+    // K | . . . . . . . . . . . . . | K
+    // L | . . * . . . . o . . * . . | L
+    // M | . . . . . . . . . . . . . | M
+    // N | . . . . . . . . . . . . . | N
+    // O + --------------------------+ O
+    //   A B C D E F G H I J K L M N O
+    const MoveList board_sequence("dfgiedfjhhildjiidhji");
+    const Board board(board_sequence);
+    VCFTable vcf_table(1, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCFSearch vcf_search(board, &vcf_table, &search_manager, 0);
+
+    MoveList proof_sequence;
+    const auto result = vcf_search.Solve(&proof_sequence);
+
+    ASSERT_EQ(kVCFDisproven, result);
+    ASSERT_TRUE(proof_sequence.empty());
+
+    // VCFなしの結果は置換表に登録される
+    VCFTableData table_data;
+    ASSERT_TRUE(vcf_table.find(CalcHashValue(board_sequence), &table_data));
+    ASSERT_EQ(kVCFDisproven, table_data.result);
+
+    // 2回目の探索は置換表で打ち切る
+    const auto node_count = search_manager.GetNode();
+    ASSERT_EQ(kVCFDisproven, vcf_search.Solve(&proof_sequence));
+    ASSERT_EQ(node_count + 1, search_manager.GetNode());
+  }
+}
+
+TEST_F(VCFSearchTest, SolveUnknownTest)
+{
+  const MoveList board_sequence("lkkdjkljjjefffkihhleejjh");
+  const Board board(board_sequence);
+  VCFTable vcf_table(1, kLockFree);
+  SharedSearchManager search_manager(1, kNoInterruptionPoint);
+  VCFSearch vcf_search(board, &vcf_table, &search_manager, 0);
+
+  search_manager.Stop();
+
+  MoveList proof_sequence;
+  ASSERT_EQ(kVCFUnknown, vcf_search.Solve(&proof_sequence));
+  ASSERT_TRUE(proof_sequence.empty());
+
+  // 打ち切った局面は置換表に登録しない
+  VCFTableData table_data;
+  ASSERT_FALSE(vcf_table.find(CalcHashValue(board_sequence), &table_data));
+}
+
+TEST_F(VCFSearchTest, ExpandTest)
+{
+  {
+    // 終端手がある
+    const Board board(MoveList("lkkdjkljjjefffkihhleejjhiiggkkll"));
+    VCFTable vcf_table(1, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCFSearch vcf_search(board, &vcf_table, &search_manager, 0);
+
+    vector<MovePair> candidate_list;
+    MovePosition terminating_move;
+
+    ASSERT_EQ(kVCFProven, vcf_search.Expand(&candidate_list, &terminating_move));
+    ASSERT_EQ(kMoveIK, terminating_move);
+  }
+  {
+    // 候補を生成する
+    const Board board(MoveList("lkkdjkljjjefffkihhleejjh"));
+    VCFTable vcf_table(1, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCFSearch vcf_search(board, &vcf_table, &search_manager, 0);
+
+    vector<MovePair> candidate_list;
+    MovePosition terminating_move;
+
+    ASSERT_EQ(kVCFUnknown, vcf_search.Expand(&candidate_list, &terminating_move));
+    ASSERT_FALSE(candidate_list.empty());
+    ASSERT_NE(candidate_list.end(), find(candidate_list.begin(), candidate_list.end(), MovePair(kMoveII, kMoveGG)));
+  }
+  {
+    // 四ノビがない
+    const Board board(MoveList("hh"));
+    VCFTable vcf_table(1, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCFSearch vcf_search(board, &vcf_table, &search_manager, 0);
+
+    vector<MovePair> candidate_list;
+    MovePosition terminating_move;
+
+    ASSERT_EQ(kVCFDisproven, vcf_search.Expand(&candidate_list, &terminating_move));
+    ASSERT_TRUE(candidate_list.empty());
+  }
+}
+
+}   // namespace realcore
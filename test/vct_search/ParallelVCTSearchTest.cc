@@ -0,0 +1,98 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ParallelVCTSearch.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+const bool IsValidProofTree(Board * const board, MoveTree * const proof_tree, const bool is_or_node);
+
+class ParallelVCTSearchTest
+: public ::testing::Test
+{
+public:
+  void ConstructorTest()
+  {
+    const Board board(MoveList("hhhgig"));
+    VCTTable vct_table(1, kLockTable);
+    SharedSearchManager search_manager(4, kNoInterruptionPoint);
+    ParallelVCTSearch parallel_vct_search(board, &vct_table, &search_manager);
+
+    ASSERT_EQ(&vct_table, parallel_vct_search.vct_table_);
+    ASSERT_EQ(&search_manager, parallel_vct_search.search_manager_);
+    ASSERT_EQ(4, parallel_vct_search.scheduler_.GetThreadNum());
+    ASSERT_EQ(4, parallel_vct_search.vct_search_list_.size());
+    ASSERT_EQ(kDefaultVCTDepth, parallel_vct_search.max_depth_);
+    ASSERT_EQ(kVCTUnknown, parallel_vct_search.result_);
+
+    parallel_vct_search.SetMaxDepth(3);
+    ASSERT_EQ(3, parallel_vct_search.max_depth_);
+  }
+};
+
+TEST_F(ParallelVCTSearchTest, ConstructorTest)
+{
+  ConstructorTest();
+}
+
+TEST_F(ParallelVCTSearchTest, SolveTest)
+{
+  // スレッド数によらず逐次探索と同じ結果となる
+  const vector<string> board_sequence_list{{
+    "lkkdjkljjjefffkihhleejjh",               // 黒番のVCF
+    "jgkjjlhghlhdkhgfdhfdhf",                 // 白番のVCF
+    "fjhifiefhljlfegellgfejdeiekkhgdkif",     // 相手の四ノビを防ぐ
+    "hhaoihoaiioo",                           // 三ノビを含むVCT
+    "hhaoihoajhoogg",                         // VCTなし
+  }};
+
+  for(const auto &board_text : board_sequence_list){
+    Board board((MoveList(board_text)));
+
+    VCTTable serial_vct_table(4, kLockFree);
+    SharedSearchManager serial_search_manager(1, kNoInterruptionPoint);
+    VCTSearch vct_search(board, &serial_vct_table, &serial_search_manager, 0);
+    vct_search.SetMaxDepth(4);
+
+    MoveTree serial_proof_tree;
+    const auto serial_result = vct_search.Solve(&serial_proof_tree);
+
+    for(const size_t thread_num : {1, 2, 4}){
+      VCTTable vct_table(4, kLockTable);
+      SharedSearchManager search_manager(thread_num, kNoInterruptionPoint);
+      ParallelVCTSearch parallel_vct_search(board, &vct_table, &search_manager);
+      parallel_vct_search.SetMaxDepth(4);
+
+      MoveTree proof_tree;
+      const auto result = parallel_vct_search.Solve(&proof_tree);
+
+      ASSERT_EQ(serial_result, result);
+
+      if(result == kVCTProven){
+        ASSERT_TRUE(IsValidProofTree(&board, &proof_tree, true));
+      }else{
+        ASSERT_TRUE(proof_tree.empty());
+      }
+    }
+  }
+}
+
+TEST_F(ParallelVCTSearchTest, SolveUnknownTest)
+{
+  const Board board(MoveList("hhaoihoaiioo"));
+  VCTTable vct_table(1, kLockTable);
+  SharedSearchManager search_manager(4, kNoInterruptionPoint);
+  ParallelVCTSearch parallel_vct_search(board, &vct_table, &search_manager);
+
+  search_manager.Stop();
+
+  MoveTree proof_tree;
+  ASSERT_EQ(kVCTUnknown, parallel_vct_search.Solve(&proof_tree));
+  ASSERT_TRUE(proof_tree.empty());
+}
+
+}   // namespace realcore
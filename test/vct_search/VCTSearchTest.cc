@@ -0,0 +1,616 @@
+#include <algorithm>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+#include "VCTSearch.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+//! @brief カレントノードを攻め方の手番とする証明木が正しいかチェックする
+//! @note OR nodeは攻め方の勝ち手1つ、AND nodeは防御側のすべての防手を子に持つこと
+const bool IsValidProofTree(Board * const board, MoveTree * const proof_tree, const bool is_or_node)
+{
+  MoveList child_list;
+  proof_tree->GetChildMoveList(&child_list);
+
+  MovePosition terminating_move;
+  const bool is_terminate = board->TerminateCheck(&terminating_move);
+
+  if(is_or_node){
+    if(child_list.size() != 1){
+      return false;
+    }
+
+    if(is_terminate){
+      return terminating_move == child_list[0];
+    }
+
+    if(!board->IsNormalMove(child_list[0]) || board->IsTerminateMove(child_list[0])){
+      return false;
+    }
+  }else{
+    if(is_terminate){
+      return false;
+    }
+
+    MoveList guard_list;
+    MovePosition guard_move;
+
+    if(board->IsOpponentFour(&guard_move)){
+      if(board->IsNormalMove(guard_move)){
+        guard_list += guard_move;
+      }
+    }else{
+      MoveBitSet guard_move_set;
+
+      if(!board->GetTerminateGuard(&guard_move_set)){
+        return false;
+      }
+
+      MoveList guard_move_list;
+      GetMoveList(guard_move_set, &guard_move_list);
+
+      for(const auto move : guard_move_list){
+        if(board->IsNormalMove(move) && !board->IsTerminateMove(move)){
+          guard_list += move;
+        }
+      }
+    }
+
+    if(child_list.size() != guard_list.size()){
+      return false;
+    }
+  }
+
+  for(const auto move : child_list){
+    proof_tree->MoveChildNode(move);
+    board->MakeMove(move);
+
+    const bool is_valid = IsValidProofTree(board, proof_tree, !is_or_node);
+
+    board->UndoMove();
+    proof_tree->MoveParent();
+
+    if(!is_valid){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+class VCTTableTest
+: public ::testing::Test
+{
+public:
+  void ConstructorTest()
+  {
+    VCTTable vct_table(1, kLockFree);
+
+    ASSERT_EQ(0, vct_table.used_count_);
+    ASSERT_EQ(0, vct_table.gc_count_);
+
+    for(size_t i=0; i<kSearchThreadCountSize; i++){
+      ASSERT_EQ(0, vct_table.search_thread_count_list_[i]);
+    }
+  }
+
+  void StoreTest()
+  {
+    VCTTable vct_table(1, kLockFree);
+
+    VCTTableData table_data;
+    table_data.hash_value = 1;
+    table_data.proof_number = 2;
+    table_data.work = 10;
+
+    vct_table.Store(table_data);
+    ASSERT_EQ(1, vct_table.GetUsedCount());
+
+    // 同一局面は探索量によらず更新する
+    table_data.proof_number = 3;
+    table_data.work = 5;
+    vct_table.Store(table_data);
+
+    VCTTableData find_data;
+    ASSERT_TRUE(vct_table.find(1, &find_data));
+    ASSERT_EQ(3, find_data.proof_number);
+    ASSERT_EQ(1, vct_table.GetUsedCount());
+
+    // 探索量の小さい別局面は登録しない
+    VCTTableData conflict_data;
+    conflict_data.hash_value = 1 + vct_table.size();
+    conflict_data.work = 4;
+
+    vct_table.Store(conflict_data);
+    ASSERT_FALSE(vct_table.find(conflict_data.hash_value, &find_data));
+    ASSERT_TRUE(vct_table.find(1, &find_data));
+
+    // 探索量の大きい別局面で置き換える
+    conflict_data.work = 6;
+
+    vct_table.Store(conflict_data);
+    ASSERT_TRUE(vct_table.find(conflict_data.hash_value, &find_data));
+    ASSERT_FALSE(vct_table.find(1, &find_data));
+    ASSERT_EQ(1, vct_table.GetUsedCount());
+
+    vct_table.Initialize();
+    ASSERT_EQ(0, vct_table.GetUsedCount());
+  }
+
+  void CollectGarbageTest()
+  {
+    VCTTable vct_table(1, kLockFree);
+    const size_t table_size = vct_table.size();
+
+    HashValue hash_value = 0;
+
+    while(!vct_table.IsGarbageCollectionRequired()){
+      VCTTableData table_data;
+      table_data.hash_value = hash_value;
+      table_data.work = static_cast<VCTWork>(hash_value % 1024);
+
+      vct_table.Store(table_data);
+      ++hash_value;
+    }
+
+    ASSERT_EQ(hash_value, vct_table.GetUsedCount());
+    ASSERT_GE(100 * hash_value, kVCTGCStartPercent * table_size);
+
+    const size_t erase_count = vct_table.CollectGarbage();
+
+    ASSERT_EQ(hash_value - erase_count, vct_table.GetUsedCount());
+    ASSERT_LE(100 * vct_table.GetUsedCount(), kVCTGCTargetPercent * table_size);
+    ASSERT_EQ(1, vct_table.GetGarbageCollectionCount());
+
+    // 探索量の大きい要素が残る
+    VCTWork max_erased_work = 0, min_remain_work = numeric_limits<VCTWork>::max();
+
+    for(HashValue i=0; i<hash_value; i++){
+      VCTTableData table_data;
+
+      if(vct_table.find(i, &table_data)){
+        min_remain_work = min(min_remain_work, table_data.work);
+      }else{
+        max_erased_work = max(max_erased_work, static_cast<VCTWork>(i % 1024));
+      }
+    }
+
+    ASSERT_LT(max_erased_work, min_remain_work);
+
+    // 使用率が開始条件未満の場合は削除しない
+    ASSERT_EQ(0, vct_table.CollectGarbage());
+    ASSERT_EQ(1, vct_table.GetGarbageCollectionCount());
+  }
+
+  void SearchThreadCountTest()
+  {
+    VCTTable vct_table(1, kLockTable);
+    constexpr HashValue hash_value = 12345;
+
+    ASSERT_EQ(0, vct_table.GetSearchThreadCount(hash_value));
+
+    vct_table.EnterNode(hash_value);
+    vct_table.EnterNode(hash_value);
+    ASSERT_EQ(2, vct_table.GetSearchThreadCount(hash_value));
+    ASSERT_EQ(0, vct_table.GetSearchThreadCount(hash_value + 1));
+
+    vct_table.ExitNode(hash_value);
+    ASSERT_EQ(1, vct_table.GetSearchThreadCount(hash_value));
+
+    vct_table.ExitNode(hash_value);
+    ASSERT_EQ(0, vct_table.GetSearchThreadCount(hash_value));
+  }
+};
+
+TEST_F(VCTTableTest, ConstructorTest)
+{
+  ConstructorTest();
+}
+
+TEST_F(VCTTableTest, StoreTest)
+{
+  StoreTest();
+}
+
+TEST_F(VCTTableTest, CollectGarbageTest)
+{
+  CollectGarbageTest();
+}
+
+TEST_F(VCTTableTest, SearchThreadCountTest)
+{
+  SearchThreadCountTest();
+}
+
+class VCTSearchTest
+: public ::testing::Test
+{
+public:
+  void ConstructorTest()
+  {
+    const MoveList board_sequence("hhhgig");
+    const Board board(board_sequence);
+    VCTTable vct_table(1, kLockFree);
+    SharedSearchManager search_manager(2, kNoInterruptionPoint);
+    VCTSearch vct_search(board, &vct_table, &search_manager, 1);
+
+    ASSERT_EQ(board_sequence, vct_search.board_move_sequence_);
+    ASSERT_EQ(&vct_table, vct_search.vct_table_);
+    ASSERT_EQ(&search_manager, vct_search.search_manager_);
+    ASSERT_EQ(1, vct_search.thread_index_);
+    ASSERT_EQ(CalcHashValue(board_sequence), vct_search.GetHashValue());
+    ASSERT_EQ(kDefaultVCTDepth, vct_search.max_depth_);
+
+    vct_search.SetMaxDepth(3);
+    ASSERT_EQ(3, vct_search.max_depth_);
+  }
+
+  void MakeMoveTest()
+  {
+    const MoveList board_sequence("hhhgig");
+    const Board board(board_sequence);
+    VCTTable vct_table(1, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+
+    // 探索開始局面の手番側が攻め方となる
+    ASSERT_TRUE(vct_search.IsAttackerTurn());
+    vct_search.MakeMove(kMoveJF);
+    ASSERT_FALSE(vct_search.IsAttackerTurn());
+
+    MoveList expect_sequence(board_sequence);
+    expect_sequence += kMoveJF;
+
+    ASSERT_EQ(expect_sequence, vct_search.board_move_sequence_);
+    ASSERT_EQ(CalcHashValue(expect_sequence), vct_search.GetHashValue());
+
+    vct_search.UndoMove();
+    ASSERT_EQ(board_sequence, vct_search.board_move_sequence_);
+    ASSERT_EQ(CalcHashValue(board_sequence), vct_search.GetHashValue());
+  }
+
+  void ExpandORTest()
+  {
+    {
+      // 終端手がある
+      const Board board(MoveList("lkkdjkljjjefffkihhleejjhiiggkkll"));
+      VCTTable vct_table(1, kLockFree);
+      SharedSearchManager search_manager(1, kNoInterruptionPoint);
+      VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+
+      MoveList child_list;
+      MovePosition terminating_move;
+
+      ASSERT_TRUE(vct_search.ExpandOR(&child_list, &terminating_move));
+      ASSERT_EQ(kMoveIK, terminating_move);
+    }
+    {
+      // 相手に四がある場合は防手のみ
+      const Board board(MoveList("fjhifiefhljlfegellgfejdeiekkhgdkif"));
+      VCTTable vct_table(1, kLockFree);
+      SharedSearchManager search_manager(1, kNoInterruptionPoint);
+      VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+
+      MoveList child_list;
+      MovePosition terminating_move;
+
+      ASSERT_FALSE(vct_search.ExpandOR(&child_list, &terminating_move));
+      ASSERT_EQ(kNullMove, terminating_move);
+      ASSERT_EQ(MoveList("gh"), child_list);
+    }
+  }
+
+  void ExpandANDTest()
+  {
+    {
+      // 攻め方の四ノビは防手のみ
+      const Board board(MoveList("lkkdjkljjjefffkihhleejjhii"));
+      VCTTable vct_table(1, kLockFree);
+      SharedSearchManager search_manager(1, kNoInterruptionPoint);
+      VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+
+      MoveList child_list;
+
+      ASSERT_FALSE(vct_search.ExpandAND(&child_list));
+      ASSERT_EQ(MoveList("gg"), child_list);
+    }
+    {
+      // 攻め方に1手勝ちがない
+      const Board board(MoveList("hhao"));
+      VCTTable vct_table(1, kLockFree);
+      SharedSearchManager search_manager(1, kNoInterruptionPoint);
+      VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+
+      MoveList child_list;
+
+      ASSERT_TRUE(vct_search.ExpandAND(&child_list));
+      ASSERT_TRUE(child_list.empty());
+    }
+  }
+
+  void FindTableDataTest()
+  {
+    const MoveList board_sequence("hhhgig");
+    const Board board(board_sequence);
+    VCTTable vct_table(1, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+
+    vct_search.SetMaxDepth(4);
+    vct_search.solve_start_move_count_ = board_sequence.size();
+
+    // 攻め方の残り手数
+    ASSERT_EQ(4, vct_search.GetRemainingDepth(board_sequence.size()));
+    ASSERT_EQ(4, vct_search.GetRemainingDepth(board_sequence.size() + 1));
+    ASSERT_EQ(3, vct_search.GetRemainingDepth(board_sequence.size() + 2));
+    ASSERT_EQ(0, vct_search.GetRemainingDepth(board_sequence.size() + 10));
+
+    const HashValue hash_value = CalcHashValue(board_sequence);
+    VCTTableData table_data;
+
+    // 反証は登録時以下の残り手数でのみ有効
+    vct_search.SetProofNumber(kInfinityProofNumber, 0, 1, 2);
+
+    ASSERT_TRUE(vct_search.FindTableData(hash_value, 1, &table_data));
+    ASSERT_TRUE(vct_search.FindTableData(hash_value, 2, &table_data));
+    ASSERT_EQ(0, table_data.disproof_number);
+    ASSERT_EQ(2, table_data.remaining_depth);
+
+    ASSERT_FALSE(vct_search.FindTableData(hash_value, 3, &table_data));
+    ASSERT_EQ(1, table_data.proof_number);
+    ASSERT_EQ(1, table_data.disproof_number);
+
+    // 証明は残り手数によらず有効
+    vct_search.SetProofNumber(0, kInfinityProofNumber, 1, 0);
+    ASSERT_TRUE(vct_search.FindTableData(hash_value, 4, &table_data));
+    ASSERT_EQ(0, table_data.proof_number);
+
+    // 証明済/反証済以外も残り手数によらず取得できる
+    vct_search.SetProofNumber(3, 5, 1, 0);
+    ASSERT_TRUE(vct_search.FindTableData(hash_value, 4, &table_data));
+    ASSERT_EQ(3, table_data.proof_number);
+    ASSERT_EQ(5, table_data.disproof_number);
+  }
+
+  void GetProofTreeTest()
+  {
+    const MoveList board_sequence("hhaoihoaiioo");
+    Board board(board_sequence);
+    VCTTable vct_table(4, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+    vct_search.SetMaxDepth(4);
+
+    ASSERT_EQ(kVCTProven, vct_search.Search());
+
+    // 証明木を生成できない子局面を置換表上で証明済にする
+    MoveList child_list;
+    MovePosition terminating_move;
+    ASSERT_FALSE(vct_search.ExpandOR(&child_list, &terminating_move));
+
+    size_t fake_proven_count = 0;
+
+    for(const auto move : child_list){
+      ProofNumber proof_number = 1, disproof_number = 1;
+      vct_search.GetChildProofNumber(move, &proof_number, &disproof_number);
+
+      if(proof_number == 0){
+        continue;
+      }
+
+      vct_search.MakeMove(move);
+      vct_search.SetProofNumber(0, kInfinityProofNumber, numeric_limits<VCTWork>::max(), 0);
+      vct_search.UndoMove();
+
+      fake_proven_count++;
+    }
+
+    ASSERT_LT(0, fake_proven_count);
+
+    // 生成に失敗した子局面は証明木に残さず、他の証明済の子局面で生成する
+    MoveTree proof_tree;
+    ASSERT_TRUE(vct_search.GetProofTree(&proof_tree));
+
+    proof_tree.MoveRootNode();
+    ASSERT_TRUE(IsValidProofTree(&board, &proof_tree, true));
+  }
+};
+
+TEST_F(VCTSearchTest, ConstructorTest)
+{
+  ConstructorTest();
+}
+
+TEST_F(VCTSearchTest, MakeMoveTest)
+{
+  MakeMoveTest();
+}
+
+TEST_F(VCTSearchTest, ExpandORTest)
+{
+  ExpandORTest();
+}
+
+TEST_F(VCTSearchTest, ExpandANDTest)
+{
+  ExpandANDTest();
+}
+
+TEST_F(VCTSearchTest, FindTableDataTest)
+{
+  FindTableDataTest();
+}
+
+TEST_F(VCTSearchTest, GetProofTreeTest)
+{
+  GetProofTreeTest();
+}
+
+TEST_F(VCTSearchTest, SolveVCFTest)
+{
+  // VCFがある局面はVCTもある
+  const MoveList board_sequence("lkkdjkljjjefffkihhleejjh");
+  Board board(board_sequence);
+  VCTTable vct_table(1, kLockFree);
+  SharedSearchManager search_manager(1, kNoInterruptionPoint);
+  VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+
+  MoveTree proof_tree;
+  ASSERT_EQ(kVCTProven, vct_search.Solve(&proof_tree));
+  ASSERT_FALSE(proof_tree.empty());
+  ASSERT_TRUE(IsValidProofTree(&board, &proof_tree, true));
+
+  ProofNumber proof_number = 1, disproof_number = 1;
+  vct_search.GetProofNumber(&proof_number, &disproof_number);
+
+  ASSERT_EQ(0, proof_number);
+  ASSERT_EQ(kInfinityProofNumber, disproof_number);
+}
+
+TEST_F(VCTSearchTest, SolveVCTTest)
+{
+  // 三ノビを含むVCT
+  //   A B C D E F G H I J K L M N O
+  // A + --------------------------o A
+  // B | . . . . . . . . . . . . . | B
+  // C | . . . . . . . . . . . . . | C
+  // D | . . * . . . . . . . * . . | D
+  // E | . . . . . . . . . . . . . | E
+  // F | . . . . . . . . . . . . . | F
+  // G | . . . . . . . . . . . . . | G
+  // H | . . . . . . x x . . . . . | H
+  // I | . . . . . . . x . . . . . | I
+  // J | . . . . . . . . . . . . . | J
+  // K | . . . . . . . . . . . . . | K
+  // L | . . * . . . . . . . * . . | L
+  // M | . . . . . . . . . . . . . | M
+  // N | . . . . . . . . . . . . . | N
+  // O o --------------------------o O
+  //   A B C D E F G H I J K L M N O
+  const MoveList board_sequence("hhaoihoaiioo");
+  Board board(board_sequence);
+
+  {
+    // 攻め方4手以内のVCTがある
+    VCTTable vct_table(4, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+    vct_search.SetMaxDepth(4);
+
+    MoveTree proof_tree;
+    ASSERT_EQ(kVCTProven, vct_search.Solve(&proof_tree));
+    ASSERT_TRUE(IsValidProofTree(&board, &proof_tree, true));
+
+    // 四ノビ以外の手を含む
+    MoveList child_list;
+    proof_tree.GetChildMoveList(&child_list);
+    MoveBitSet four_move_set;
+    board.EnumerateFourMoves(true, &four_move_set);
+    ASSERT_FALSE(four_move_set[child_list[0]]);
+
+    // 探索後は探索開始局面に戻る
+    ProofNumber proof_number = 1, disproof_number = 1;
+    vct_search.GetProofNumber(&proof_number, &disproof_number);
+    ASSERT_EQ(0, proof_number);
+  }
+  {
+    // 攻め方3手以内のVCTはない
+    VCTTable vct_table(4, kLockFree);
+    SharedSearchManager search_manager(1, kNoInterruptionPoint);
+    VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+    vct_search.SetMaxDepth(3);
+
+    MoveTree proof_tree;
+    ASSERT_EQ(kVCTDisproven, vct_search.Solve(&proof_tree));
+    ASSERT_TRUE(proof_tree.empty());
+  }
+}
+
+TEST_F(VCTSearchTest, SolveWhiteTest)
+{
+  const MoveList board_sequence("jgkjjlhghlhdkhgfdhfdhf");
+  Board board(board_sequence);
+  VCTTable vct_table(1, kLockFree);
+  SharedSearchManager search_manager(1, kNoInterruptionPoint);
+  VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+
+  MoveTree proof_tree;
+  ASSERT_EQ(kVCTProven, vct_search.Solve(&proof_tree));
+  ASSERT_TRUE(IsValidProofTree(&board, &proof_tree, true));
+}
+
+TEST_F(VCTSearchTest, SolveOpponentFourTest)
+{
+  // 相手の四ノビを防ぐ手から始まる
+  const MoveList board_sequence("fjhifiefhljlfegellgfejdeiekkhgdkif");
+  Board board(board_sequence);
+  VCTTable vct_table(1, kLockFree);
+  SharedSearchManager search_manager(1, kNoInterruptionPoint);
+  VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+
+  MoveTree proof_tree;
+  ASSERT_EQ(kVCTProven, vct_search.Solve(&proof_tree));
+  ASSERT_TRUE(IsValidProofTree(&board, &proof_tree, true));
+
+  MoveList child_list;
+  proof_tree.GetChildMoveList(&child_list);
+  ASSERT_EQ(MoveList("gh"), child_list);
+}
+
+TEST_F(VCTSearchTest, SolveDisprovenTest)
+{
+  // 白に脅威となる手がない
+  //   A B C D E F G H I J K L M N O
+  // A + --------------------------o A
+  // B | . . . . . . . . . . . . . | B
+  // C | . . . . . . . . . . . . . | C
+  // D | . . * . . . . . . . * . . | D
+  // E | . . . . . . . . . . . . . | E
+  // F | . . . . . . . . . . . . . | F
+  // G | . . . . . x . . . . . . . | G
+  // H | . . . . . . x x x . . . . | H
+  // I | . . . . . . . . . . . . . | I
+  // J | . . . . . . . . . . . . . | J
+  // K | . . . . . . . . . . . . . | K
+  // L | . . * . . . . . . . * . . | L
+  // M | . . . . . . . . . . . . . | M
+  // N | . . . . . . . . . . . . . | N
+  // O o --------------------------o O
+  //   A B C D E F G H I J K L M N O
+  const MoveList board_sequence("hhaoihoajhoogg");
+  Board board(board_sequence);
+  VCTTable vct_table(1, kLockFree);
+  SharedSearchManager search_manager(1, kNoInterruptionPoint);
+  VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+
+  MoveTree proof_tree;
+  ASSERT_EQ(kVCTDisproven, vct_search.Solve(&proof_tree));
+  ASSERT_TRUE(proof_tree.empty());
+
+  // VCTなしの結果は置換表に登録される
+  VCTTableData table_data;
+  ASSERT_TRUE(vct_table.find(CalcHashValue(board_sequence), &table_data));
+  ASSERT_EQ(0, table_data.disproof_number);
+}
+
+TEST_F(VCTSearchTest, SolveUnknownTest)
+{
+  const MoveList board_sequence("hhaoihoaiioo");
+  Board board(board_sequence);
+  VCTTable vct_table(1, kLockFree);
+  SharedSearchManager search_manager(1, kNoInterruptionPoint);
+  VCTSearch vct_search(board, &vct_table, &search_manager, 0);
+
+  search_manager.Stop();
+
+  MoveTree proof_tree;
+  ASSERT_EQ(kVCTUnknown, vct_search.Solve(&proof_tree));
+  ASSERT_TRUE(proof_tree.empty());
+}
+
+}   // namespace realcore
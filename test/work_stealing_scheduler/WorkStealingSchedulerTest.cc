@@ -0,0 +1,201 @@
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "WorkStealingScheduler.h"
+
+using namespace std;
+
+namespace realcore
+{
+
+//! @brief 深さdepthの2分木状にタスクを積む
+void PushBinaryTreeTask(WorkStealingScheduler * const scheduler, const size_t worker_index, const size_t depth, atomic<size_t> * const leaf_count)
+{
+  if(depth == 0){
+    leaf_count->fetch_add(1);
+    return;
+  }
+
+  for(size_t i=0; i<2; i++){
+    scheduler->Push(worker_index, [scheduler, depth, leaf_count](const size_t child_worker_index){
+      PushBinaryTreeTask(scheduler, child_worker_index, depth - 1, leaf_count);
+    });
+  }
+}
+
+class WorkStealingSchedulerTest
+: public ::testing::Test
+{
+public:
+  void DefaultConstructorTest()
+  {
+    WorkStealingScheduler scheduler(4);
+
+    ASSERT_EQ(4, scheduler.thread_num_);
+    ASSERT_EQ(4, scheduler.queue_list_.size());
+    ASSERT_EQ(0, scheduler.pending_task_count_);
+    ASSERT_FALSE(scheduler.stop_flag_);
+    ASSERT_EQ(0, scheduler.steal_count_);
+  }
+
+  void PopStealTest()
+  {
+    WorkStealingScheduler scheduler(2);
+    vector<int> executed_list;
+
+    for(int i=0; i<3; i++){
+      scheduler.Push(0, [i, &executed_list](const size_t worker_index){
+        executed_list.emplace_back(i);
+      });
+    }
+
+    ASSERT_EQ(3, scheduler.pending_task_count_);
+
+    SchedulerTask task;
+
+    // 自ワーカーは末尾から取り出す
+    ASSERT_TRUE(scheduler.PopTask(0, &task));
+    task(0);
+
+    // 他ワーカーは先頭から盗む
+    ASSERT_TRUE(scheduler.StealTask(1, &task));
+    task(1);
+
+    ASSERT_FALSE(scheduler.PopTask(1, &task));
+    ASSERT_EQ(1, scheduler.GetStealCount());
+
+    ASSERT_EQ(2, executed_list.size());
+    ASSERT_EQ(2, executed_list[0]);
+    ASSERT_EQ(0, executed_list[1]);
+  }
+
+  void StopTest()
+  {
+    WorkStealingScheduler scheduler(1);
+    int executed_count = 0;
+
+    for(int i=0; i<10; i++){
+      scheduler.Push(0, [&scheduler, &executed_count](const size_t worker_index){
+        ++executed_count;
+        scheduler.Stop();
+      });
+    }
+
+    scheduler.Run();
+
+    ASSERT_TRUE(scheduler.IsStopped());
+    ASSERT_EQ(1, executed_count);
+
+    // 未実行のタスクは破棄される
+    ASSERT_TRUE(scheduler.queue_list_[0]->task_deque.empty());
+    ASSERT_EQ(0, scheduler.pending_task_count_);
+  }
+
+  void RunAfterStopTest()
+  {
+    WorkStealingScheduler scheduler(2);
+    int executed_count = 0;
+
+    scheduler.Push(0, [&scheduler, &executed_count](const size_t worker_index){
+      ++executed_count;
+      scheduler.Stop();
+    });
+
+    scheduler.Run();
+    ASSERT_TRUE(scheduler.IsStopped());
+    ASSERT_EQ(1, executed_count);
+
+    // 停止を解除するまではRunでタスクを実行しない
+    atomic<size_t> leaf_count(0);
+    PushBinaryTreeTask(&scheduler, 0, 4, &leaf_count);
+
+    scheduler.Run();
+    ASSERT_TRUE(scheduler.IsStopped());
+    ASSERT_EQ(0, leaf_count);
+
+    // 解除後は積んだタスクを実行する
+    scheduler.Reset();
+    ASSERT_FALSE(scheduler.IsStopped());
+    PushBinaryTreeTask(&scheduler, 0, 4, &leaf_count);
+
+    scheduler.Run();
+
+    ASSERT_FALSE(scheduler.IsStopped());
+    ASSERT_EQ(16, leaf_count);
+    ASSERT_EQ(0, scheduler.pending_task_count_);
+  }
+};
+
+TEST_F(WorkStealingSchedulerTest, DefaultConstructorTest)
+{
+  DefaultConstructorTest();
+}
+
+TEST_F(WorkStealingSchedulerTest, PopStealTest)
+{
+  PopStealTest();
+}
+
+TEST_F(WorkStealingSchedulerTest, RunTest)
+{
+  constexpr size_t kTaskNum = 1000;
+
+  for(const size_t thread_num : {1, 2, 4, 8}){
+    WorkStealingScheduler scheduler(thread_num);
+    vector<atomic<size_t>> executed_count_list(kTaskNum);
+    atomic<bool> is_valid_worker(true);
+
+    for(auto &executed_count : executed_count_list){
+      executed_count = 0;
+    }
+
+    for(size_t i=0; i<kTaskNum; i++){
+      scheduler.Push(i % thread_num, [i, thread_num, &executed_count_list, &is_valid_worker](const size_t worker_index){
+        executed_count_list[i].fetch_add(1);
+
+        if(worker_index >= thread_num){
+          is_valid_worker = false;
+        }
+      });
+    }
+
+    scheduler.Run();
+
+    for(const auto &executed_count : executed_count_list){
+      ASSERT_EQ(1, executed_count);
+    }
+
+    ASSERT_TRUE(is_valid_worker);
+    ASSERT_FALSE(scheduler.IsStopped());
+  }
+}
+
+TEST_F(WorkStealingSchedulerTest, NestedTaskTest)
+{
+  // 実行中のタスクが積んだタスクもRunの中で実行される
+  constexpr size_t kDepth = 10;
+
+  for(const size_t thread_num : {1, 3, 8}){
+    WorkStealingScheduler scheduler(thread_num);
+    atomic<size_t> leaf_count(0);
+
+    PushBinaryTreeTask(&scheduler, 0, kDepth, &leaf_count);
+    scheduler.Run();
+
+    ASSERT_EQ(1 << kDepth, leaf_count);
+  }
+}
+
+TEST_F(WorkStealingSchedulerTest, StopTest)
+{
+  StopTest();
+}
+
+TEST_F(WorkStealingSchedulerTest, RunAfterStopTest)
+{
+  RunAfterStopTest();
+}
+
+}   // namespace realcore